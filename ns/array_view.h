@@ -97,7 +97,7 @@ namespace rtc {
             static_assert(Size > 0, "ArrayView size must be variable or non-negative");
 
         public:
-            ArrayViewBase(T *data, size_t size) : data_(data) {}
+            ArrayViewBase(T *data, size_t /* size */) : data_(data) {}
 
             static constexpr size_t size() { return Size; }
 
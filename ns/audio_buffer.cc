@@ -45,12 +45,16 @@ namespace webrtc {
                              size_t buffer_rate,
                              size_t buffer_num_channels,
                              size_t output_rate,
-                             size_t output_num_channels)
+                             size_t /* output_num_channels */,
+                             TwoBandsFilterMode two_bands_filter_mode,
+                             NsAllocator *allocator)
             : AudioBuffer(static_cast<int>(input_rate) / 100,
                           input_num_channels,
                           static_cast<int>(buffer_rate) / 100,
                           buffer_num_channels,
-                          static_cast<int>(output_rate) / 100) {}
+                          static_cast<int>(output_rate) / 100,
+                          two_bands_filter_mode,
+                          allocator) {}
 
 // Performs the integer division a/b and returns the result. CHECKs that the
 // remainder is zero.
@@ -64,7 +68,9 @@ namespace webrtc {
                              size_t input_num_channels,
                              size_t buffer_num_frames,
                              size_t buffer_num_channels,
-                             size_t output_num_frames)
+                             size_t output_num_frames,
+                             TwoBandsFilterMode two_bands_filter_mode,
+                             NsAllocator *allocator)
             : input_num_frames_(input_num_frames),
               input_num_channels_(input_num_channels),
               buffer_num_frames_(buffer_num_frames),
@@ -74,8 +80,11 @@ namespace webrtc {
               num_channels_(buffer_num_channels),
               num_bands_(NumBandsFromFramesPerChannel(buffer_num_frames_)),
               num_split_frames_(CheckedDivExact(buffer_num_frames_, num_bands_)),
-              data_(
-                      new ChannelBuffer<float>(buffer_num_frames_, buffer_num_channels_)) {
+              data_(NsMakeUnique<ChannelBuffer<float>>(
+                      allocator, buffer_num_frames_, buffer_num_channels_, 1,
+                      allocator)),
+              input_resamplers_(allocator),
+              output_resamplers_(allocator) {
         RTC_DCHECK_GT(input_num_frames_, 0);
         RTC_DCHECK_GT(buffer_num_frames_, 0);
         RTC_DCHECK_GT(output_num_frames_, 0);
@@ -87,24 +96,69 @@ namespace webrtc {
         const bool output_resampling_needed =
                 output_num_frames_ != buffer_num_frames_;
         if (input_resampling_needed) {
+            input_resamplers_.reserve(buffer_num_channels_);
             for (size_t i = 0; i < buffer_num_channels_; ++i) {
-                input_resamplers_.push_back(std::make_unique<PushSincResampler>(
-                        input_num_frames_, buffer_num_frames_));
+                input_resamplers_.push_back(NsMakeUnique<PushSincResampler>(
+                        allocator, input_num_frames_, buffer_num_frames_, allocator));
             }
         }
 
         if (output_resampling_needed) {
+            output_resamplers_.reserve(buffer_num_channels_);
             for (size_t i = 0; i < buffer_num_channels_; ++i) {
-                output_resamplers_.push_back(std::make_unique<PushSincResampler>(
-                        buffer_num_frames_, output_num_frames_));
+                output_resamplers_.push_back(NsMakeUnique<PushSincResampler>(
+                        allocator, buffer_num_frames_, output_num_frames_, allocator));
             }
         }
 
         if (num_bands_ > 1) {
-            split_data_ = std::make_unique<ChannelBuffer<float>>(
-                    buffer_num_frames_, buffer_num_channels_, num_bands_);
-            splitting_filter_ = std::make_unique<SplittingFilter>(
-                    buffer_num_channels_, num_bands_, buffer_num_frames_);
+            split_data_ = NsMakeUnique<ChannelBuffer<float>>(
+                    allocator, buffer_num_frames_, buffer_num_channels_, num_bands_,
+                    allocator);
+            splitting_filter_ = NsMakeUnique<SplittingFilter>(
+                    allocator, buffer_num_channels_, num_bands_, buffer_num_frames_,
+                    two_bands_filter_mode, allocator);
+        }
+    }
+
+    void AudioBuffer::AddToLayout(NsArenaLayout *layout,
+                                  size_t input_rate,
+                                  size_t /* input_num_channels */,
+                                  size_t buffer_rate,
+                                  size_t buffer_num_channels,
+                                  size_t output_rate,
+                                  size_t /* output_num_channels */,
+                                  TwoBandsFilterMode two_bands_filter_mode) {
+        const size_t input_num_frames = input_rate / 100;
+        const size_t buffer_num_frames = buffer_rate / 100;
+        const size_t output_num_frames = output_rate / 100;
+        const size_t num_bands = NumBandsFromFramesPerChannel(buffer_num_frames);
+        layout->AddObject<ChannelBuffer<float>>();
+        ChannelBuffer<float>::AddToLayout(layout, buffer_num_frames,
+                                          buffer_num_channels);
+        if (input_num_frames != buffer_num_frames) {
+            layout->AddVector<NsUniquePtr<PushSincResampler>>(buffer_num_channels);
+            for (size_t i = 0; i < buffer_num_channels; ++i) {
+                layout->AddObject<PushSincResampler>();
+                PushSincResampler::AddToLayout(layout, input_num_frames,
+                                               buffer_num_frames);
+            }
+        }
+        if (output_num_frames != buffer_num_frames) {
+            layout->AddVector<NsUniquePtr<PushSincResampler>>(buffer_num_channels);
+            for (size_t i = 0; i < buffer_num_channels; ++i) {
+                layout->AddObject<PushSincResampler>();
+                PushSincResampler::AddToLayout(layout, buffer_num_frames,
+                                               output_num_frames);
+            }
+        }
+        if (num_bands > 1) {
+            layout->AddObject<ChannelBuffer<float>>();
+            ChannelBuffer<float>::AddToLayout(layout, buffer_num_frames,
+                                              buffer_num_channels, num_bands);
+            layout->AddObject<SplittingFilter>();
+            SplittingFilter::AddToLayout(layout, buffer_num_channels, num_bands,
+                                         two_bands_filter_mode);
         }
     }
 
@@ -132,7 +186,7 @@ namespace webrtc {
         if (downmix_needed) {
             RTC_DCHECK_GE(kMaxSamplesPerChannel, input_num_frames_);
 
-            std::array<float, kMaxSamplesPerChannel> downmix{};
+            std::array<float, kMaxSamplesPerChannel> downmix;
             if (downmix_by_averaging_) {
                 const float kOneByNumChannels = 1.f / input_num_channels_;
                 for (size_t i = 0; i < input_num_frames_; ++i) {
@@ -251,7 +305,7 @@ namespace webrtc {
         if (num_channels_ == 1) {
             if (input_num_channels_ == 1) {
                 if (resampling_required) {
-                    std::array<float, kMaxSamplesPerChannel> float_buffer{};
+                    std::array<float, kMaxSamplesPerChannel> float_buffer;
                     S16ToFloatS16(interleaved, input_num_frames_, float_buffer.data());
                     input_resamplers_[0]->Resample(float_buffer.data(), input_num_frames_,
                                                    data_->channels()[0],
@@ -260,7 +314,7 @@ namespace webrtc {
                     S16ToFloatS16(interleaved, input_num_frames_, data_->channels()[0]);
                 }
             } else {
-                std::array<float, kMaxSamplesPerChannel> float_buffer{};
+                std::array<float, kMaxSamplesPerChannel> float_buffer;
                 float *downmixed_data =
                         resampling_required ? float_buffer.data() : data_->channels()[0];
                 if (downmix_by_averaging_) {
@@ -285,29 +339,20 @@ namespace webrtc {
                 }
             }
         } else {
-            auto deinterleave_channel = [](size_t channel, size_t num_channels,
-                                           size_t samples_per_channel, const int16_t *x,
-                                           float *y) {
-                for (size_t j = 0, k = channel; j < samples_per_channel;
-                     ++j, k += num_channels) {
-                    y[j] = x[k];
-                }
-            };
-
             if (resampling_required) {
-                std::array<float, kMaxSamplesPerChannel> float_buffer{};
+                std::array<float, kMaxSamplesPerChannel> float_buffer;
                 for (size_t i = 0; i < num_channels_; ++i) {
-                    deinterleave_channel(i, num_channels_, input_num_frames_, interleaved,
-                                         float_buffer.data());
+                    for (size_t j = 0, k = i; j < input_num_frames_;
+                         ++j, k += num_channels_) {
+                        float_buffer[j] = interleaved[k];
+                    }
                     input_resamplers_[i]->Resample(float_buffer.data(), input_num_frames_,
                                                    data_->channels()[i],
                                                    buffer_num_frames_);
                 }
             } else {
-                for (size_t i = 0; i < num_channels_; ++i) {
-                    deinterleave_channel(i, num_channels_, input_num_frames_, interleaved,
-                                         data_->channels()[i]);
-                }
+                DeinterleaveS16ToFloatS16(interleaved, input_num_frames_, num_channels_,
+                                          data_->channels());
             }
         }
     }
@@ -323,7 +368,7 @@ namespace webrtc {
 
         int16_t *interleaved = interleaved_data;
         if (num_channels_ == 1) {
-            std::array<float, kMaxSamplesPerChannel> float_buffer{};
+            std::array<float, kMaxSamplesPerChannel> float_buffer;
 
             if (resampling_required) {
                 output_resamplers_[0]->Resample(data_->channels()[0], buffer_num_frames_,
@@ -333,9 +378,7 @@ namespace webrtc {
                     resampling_required ? float_buffer.data() : data_->channels()[0];
 
             if (config_num_channels == 1) {
-                for (size_t j = 0; j < output_num_frames_; ++j) {
-                    interleaved[j] = FloatS16ToS16(deinterleaved[j]);
-                }
+                FloatS16ToS16(deinterleaved, output_num_frames_, interleaved);
             } else {
                 for (size_t i = 0, k = 0; i < output_num_frames_; ++i) {
                     float tmp = FloatS16ToS16(deinterleaved[i]);
@@ -356,7 +399,7 @@ namespace webrtc {
 
             if (resampling_required) {
                 for (size_t i = 0; i < num_channels_; ++i) {
-                    std::array<float, kMaxSamplesPerChannel> float_buffer{};
+                    std::array<float, kMaxSamplesPerChannel> float_buffer;
                     output_resamplers_[i]->Resample(data_->channels()[i],
                                                     buffer_num_frames_, float_buffer.data(),
                                                     output_num_frames_);
@@ -364,10 +407,8 @@ namespace webrtc {
                                        float_buffer.data(), interleaved);
                 }
             } else {
-                for (size_t i = 0; i < num_channels_; ++i) {
-                    interleave_channel(i, config_num_channels, output_num_frames_,
-                                       data_->channels()[i], interleaved);
-                }
+                InterleaveFloatS16ToS16(data_->channels(), output_num_frames_,
+                                        num_channels_, interleaved);
             }
 
             for (size_t i = num_channels_; i < config_num_channels; ++i) {
@@ -18,6 +18,7 @@
 #include <vector>
 
 #include "channel_buffer.h"
+#include "splitting_filter.h"
 //#include "audio_processing.h"
 
 namespace webrtc {
@@ -90,8 +91,6 @@ namespace webrtc {
 
     class PushSincResampler;
 
-    class SplittingFilter;
-
     enum Band {
         kBand0To8kHz = 0, kBand8To16kHz = 1, kBand16To24kHz = 2
     };
@@ -103,19 +102,41 @@ namespace webrtc {
         static const int kSplitBandSize = 160;
         static const size_t kMaxSampleRate = 384000;
 
+        // |two_bands_filter_mode| selects the implementation of the 2-band
+        // splitting filter used at 32 kHz. If |allocator| is not null, the
+        // buffers, the splitting filter and the resamplers are allocated from it,
+        // which must then outlive the AudioBuffer.
         AudioBuffer(size_t input_rate,
                     size_t input_num_channels,
                     size_t buffer_rate,
                     size_t buffer_num_channels,
                     size_t output_rate,
-                    size_t output_num_channels);
+                    size_t output_num_channels,
+                    TwoBandsFilterMode two_bands_filter_mode =
+                    TwoBandsFilterMode::kFixedPoint,
+                    NsAllocator *allocator = nullptr);
 
         // The constructor below will be deprecated.
         AudioBuffer(size_t input_num_frames,
                     size_t input_num_channels,
                     size_t buffer_num_frames,
                     size_t buffer_num_channels,
-                    size_t output_num_frames);
+                    size_t output_num_frames,
+                    TwoBandsFilterMode two_bands_filter_mode =
+                    TwoBandsFilterMode::kFixedPoint,
+                    NsAllocator *allocator = nullptr);
+
+        // Adds the allocations of an AudioBuffer constructed with the same rates
+        // and numbers of channels and an allocator to |layout|.
+        static void AddToLayout(NsArenaLayout *layout,
+                                size_t input_rate,
+                                size_t input_num_channels,
+                                size_t buffer_rate,
+                                size_t buffer_num_channels,
+                                size_t output_rate,
+                                size_t output_num_channels,
+                                TwoBandsFilterMode two_bands_filter_mode =
+                                TwoBandsFilterMode::kFixedPoint);
 
         virtual ~AudioBuffer();
 
@@ -249,11 +270,11 @@ namespace webrtc {
         size_t num_bands_;
         size_t num_split_frames_;
 
-        std::unique_ptr<ChannelBuffer<float>> data_;
-        std::unique_ptr<ChannelBuffer<float>> split_data_;
-        std::unique_ptr<SplittingFilter> splitting_filter_;
-        std::vector<std::unique_ptr<PushSincResampler>> input_resamplers_;
-        std::vector<std::unique_ptr<PushSincResampler>> output_resamplers_;
+        NsUniquePtr<ChannelBuffer<float>> data_;
+        NsUniquePtr<ChannelBuffer<float>> split_data_;
+        NsUniquePtr<SplittingFilter> splitting_filter_;
+        NsVector<NsUniquePtr<PushSincResampler>> input_resamplers_;
+        NsVector<NsUniquePtr<PushSincResampler>> output_resamplers_;
         bool downmix_by_averaging_ = true;
         size_t channel_for_downmixing_ = 0;
     };
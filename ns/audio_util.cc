@@ -10,8 +10,58 @@
 
 #include "audio_util.h"
 
+#include "arch.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define WEBRTC_AUDIO_UTIL_SSE2
+#include <emmintrin.h>
+#elif defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace webrtc {
 
+    namespace {
+
+#if defined(WEBRTC_AUDIO_UTIL_SSE2)
+        // Converts 8 S16 values to FloatS16.
+        inline void S16ToFloatS16x8(__m128i x, __m128 *lo, __m128 *hi) {
+            *lo = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16));
+            *hi = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16));
+        }
+
+        // Converts 8 FloatS16 values to S16, rounding as FloatS16ToS16() does.
+        inline __m128i FloatS16ToS16x8(__m128 lo, __m128 hi) {
+            const __m128 kMax = _mm_set1_ps(32767.f);
+            const __m128 kMin = _mm_set1_ps(-32768.f);
+            const __m128 kSignMask = _mm_set1_ps(-0.f);
+            const __m128 kHalf = _mm_set1_ps(0.5f);
+            lo = _mm_max_ps(_mm_min_ps(lo, kMax), kMin);
+            hi = _mm_max_ps(_mm_min_ps(hi, kMax), kMin);
+            lo = _mm_add_ps(lo, _mm_or_ps(_mm_and_ps(lo, kSignMask), kHalf));
+            hi = _mm_add_ps(hi, _mm_or_ps(_mm_and_ps(hi, kSignMask), kHalf));
+            return _mm_packs_epi32(_mm_cvttps_epi32(lo), _mm_cvttps_epi32(hi));
+        }
+#elif defined(WEBRTC_HAS_NEON)
+        // Converts 4 S16 values to FloatS16.
+        inline float32x4_t S16ToFloatS16x4(int16x4_t x) {
+            return vcvtq_f32_s32(vmovl_s16(x));
+        }
+
+        // Converts 4 FloatS16 values to S16, rounding as FloatS16ToS16() does.
+        inline int16x4_t FloatS16ToS16x4(float32x4_t v) {
+            v = vmaxq_f32(vminq_f32(v, vdupq_n_f32(32767.f)), vdupq_n_f32(-32768.f));
+            const uint32x4_t sign =
+                    vandq_u32(vreinterpretq_u32_f32(v), vdupq_n_u32(0x80000000u));
+            const float32x4_t half = vreinterpretq_f32_u32(
+                    vorrq_u32(sign, vreinterpretq_u32_f32(vdupq_n_f32(0.5f))));
+            return vqmovn_s32(vcvtq_s32_f32(vaddq_f32(v, half)));
+        }
+#endif
+
+    }  // namespace
+
     void FloatToS16(const float *src, size_t size, int16_t *dest) {
         for (size_t i = 0; i < size; ++i)
             dest[i] = FloatToS16(src[i]);
@@ -23,12 +73,43 @@ namespace webrtc {
     }
 
     void S16ToFloatS16(const int16_t *src, size_t size, float *dest) {
-        for (size_t i = 0; i < size; ++i)
+        size_t i = 0;
+#if defined(WEBRTC_AUDIO_UTIL_SSE2)
+        for (; i + 8 <= size; i += 8) {
+            __m128 lo, hi;
+            S16ToFloatS16x8(
+                    _mm_loadu_si128(reinterpret_cast<const __m128i *>(&src[i])), &lo,
+                    &hi);
+            _mm_storeu_ps(&dest[i], lo);
+            _mm_storeu_ps(&dest[i + 4], hi);
+        }
+#elif defined(WEBRTC_HAS_NEON)
+        for (; i + 8 <= size; i += 8) {
+            const int16x8_t x = vld1q_s16(&src[i]);
+            vst1q_f32(&dest[i], S16ToFloatS16x4(vget_low_s16(x)));
+            vst1q_f32(&dest[i + 4], S16ToFloatS16x4(vget_high_s16(x)));
+        }
+#endif
+        for (; i < size; ++i)
             dest[i] = src[i];
     }
 
     void FloatS16ToS16(const float *src, size_t size, int16_t *dest) {
-        for (size_t i = 0; i < size; ++i)
+        size_t i = 0;
+#if defined(WEBRTC_AUDIO_UTIL_SSE2)
+        for (; i + 8 <= size; i += 8) {
+            _mm_storeu_si128(
+                    reinterpret_cast<__m128i *>(&dest[i]),
+                    FloatS16ToS16x8(_mm_loadu_ps(&src[i]), _mm_loadu_ps(&src[i + 4])));
+        }
+#elif defined(WEBRTC_HAS_NEON)
+        for (; i + 8 <= size; i += 8) {
+            vst1q_s16(&dest[i],
+                      vcombine_s16(FloatS16ToS16x4(vld1q_f32(&src[i])),
+                                   FloatS16ToS16x4(vld1q_f32(&src[i + 4]))));
+        }
+#endif
+        for (; i < size; ++i)
             dest[i] = FloatS16ToS16(src[i]);
     }
 
@@ -42,6 +123,89 @@ namespace webrtc {
             dest[i] = FloatS16ToFloat(src[i]);
     }
 
+    void DeinterleaveS16ToFloatS16(const int16_t *interleaved,
+                                   size_t num_frames,
+                                   size_t num_channels,
+                                   float *const *deinterleaved) {
+        if (num_channels == 1) {
+            S16ToFloatS16(interleaved, num_frames, deinterleaved[0]);
+            return;
+        }
+
+        size_t j = 0;
+        if (num_channels == 2) {
+            float *left = deinterleaved[0];
+            float *right = deinterleaved[1];
+#if defined(WEBRTC_AUDIO_UTIL_SSE2)
+            // Each 32 bit lane holds one frame, with the left sample in the lower half.
+            for (; j + 4 <= num_frames; j += 4) {
+                const __m128i x =
+                        _mm_loadu_si128(reinterpret_cast<const __m128i *>(&interleaved[2 * j]));
+                _mm_storeu_ps(&left[j],
+                              _mm_cvtepi32_ps(_mm_srai_epi32(_mm_slli_epi32(x, 16), 16)));
+                _mm_storeu_ps(&right[j], _mm_cvtepi32_ps(_mm_srai_epi32(x, 16)));
+            }
+#elif defined(WEBRTC_HAS_NEON)
+            for (; j + 8 <= num_frames; j += 8) {
+                const int16x8x2_t x = vld2q_s16(&interleaved[2 * j]);
+                vst1q_f32(&left[j], S16ToFloatS16x4(vget_low_s16(x.val[0])));
+                vst1q_f32(&left[j + 4], S16ToFloatS16x4(vget_high_s16(x.val[0])));
+                vst1q_f32(&right[j], S16ToFloatS16x4(vget_low_s16(x.val[1])));
+                vst1q_f32(&right[j + 4], S16ToFloatS16x4(vget_high_s16(x.val[1])));
+            }
+#endif
+        }
+
+        for (size_t k = j * num_channels; j < num_frames; ++j) {
+            for (size_t i = 0; i < num_channels; ++i, ++k) {
+                deinterleaved[i][j] = interleaved[k];
+            }
+        }
+    }
+
+    void InterleaveFloatS16ToS16(const float *const *deinterleaved,
+                                 size_t num_frames,
+                                 size_t num_channels,
+                                 int16_t *interleaved) {
+        if (num_channels == 1) {
+            FloatS16ToS16(deinterleaved[0], num_frames, interleaved);
+            return;
+        }
+
+        size_t j = 0;
+        if (num_channels == 2) {
+            const float *left = deinterleaved[0];
+            const float *right = deinterleaved[1];
+#if defined(WEBRTC_AUDIO_UTIL_SSE2)
+            for (; j + 8 <= num_frames; j += 8) {
+                const __m128i l =
+                        FloatS16ToS16x8(_mm_loadu_ps(&left[j]), _mm_loadu_ps(&left[j + 4]));
+                const __m128i r = FloatS16ToS16x8(_mm_loadu_ps(&right[j]),
+                                                  _mm_loadu_ps(&right[j + 4]));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(&interleaved[2 * j]),
+                                 _mm_unpacklo_epi16(l, r));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(&interleaved[2 * j + 8]),
+                                 _mm_unpackhi_epi16(l, r));
+            }
+#elif defined(WEBRTC_HAS_NEON)
+            for (; j + 8 <= num_frames; j += 8) {
+                int16x8x2_t x;
+                x.val[0] = vcombine_s16(FloatS16ToS16x4(vld1q_f32(&left[j])),
+                                        FloatS16ToS16x4(vld1q_f32(&left[j + 4])));
+                x.val[1] = vcombine_s16(FloatS16ToS16x4(vld1q_f32(&right[j])),
+                                        FloatS16ToS16x4(vld1q_f32(&right[j + 4])));
+                vst2q_s16(&interleaved[2 * j], x);
+            }
+#endif
+        }
+
+        for (size_t k = j * num_channels; j < num_frames; ++j) {
+            for (size_t i = 0; i < num_channels; ++i, ++k) {
+                interleaved[k] = FloatS16ToS16(deinterleaved[i][j]);
+            }
+        }
+    }
+
     template<>
     void DownmixInterleavedToMono<int16_t>(const int16_t *interleaved,
                                            size_t num_frames,
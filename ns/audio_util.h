@@ -75,6 +75,21 @@ namespace webrtc {
 
     void FloatS16ToFloat(const float *src, size_t size, float *dest);
 
+// Deinterleaves |interleaved| S16 audio into the FloatS16 channel buffers
+// pointed to by |deinterleaved|, converting in the same pass.
+    void DeinterleaveS16ToFloatS16(const int16_t *interleaved,
+                                   size_t num_frames,
+                                   size_t num_channels,
+                                   float *const *deinterleaved);
+
+// Converts the FloatS16 channel buffers pointed to by |deinterleaved| to S16
+// with saturation, as FloatS16ToS16() does, and interleaves them into
+// |interleaved| in the same pass.
+    void InterleaveFloatS16ToS16(const float *const *deinterleaved,
+                                 size_t num_frames,
+                                 size_t num_channels,
+                                 int16_t *interleaved);
+
     inline float DbToRatio(float v) {
         return std::pow(10.0f, v / 20.0f);
     }
@@ -0,0 +1,150 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "audio_util.h"
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace webrtc {
+    namespace {
+
+        // Frame counts around the vector widths, including ones that are not
+        // multiples of 4 or 8, so that both the vectorized loops and the scalar
+        // tails are covered.
+        constexpr size_t kNumFrames[] = {0, 1, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 160, 441};
+        constexpr size_t kNumChannels[] = {1, 2, 3, 8};
+
+        // The rounding and saturation boundaries of FloatS16ToS16, values out of
+        // range, and ordinary values.
+        const float kFloatS16Values[] = {
+                0.f,      -0.f,      0.5f,     -0.5f,     0.49f,    -0.49f,
+                1.5f,     -1.5f,     2.5f,     -2.5f,     32766.5f, -32767.5f,
+                32767.f,  -32767.f,  32767.5f, -32768.f,  32768.f,  -32768.5f,
+                32769.f,  -32769.f,  40000.f,  -40000.f,  1e10f,    -1e10f,
+                123.25f,  -123.75f,  1000.5f,  -1000.5f};
+
+        // Returns |size| FloatS16 samples that cycle through kFloatS16Values, offset
+        // by |offset| so that each value appears in every position of a vector.
+        std::vector<float> GenerateFloatS16(size_t size, size_t offset) {
+            constexpr size_t kNumValues =
+                    sizeof(kFloatS16Values) / sizeof(kFloatS16Values[0]);
+            std::vector<float> x(size);
+            for (size_t n = 0; n < size; ++n) {
+                x[n] = kFloatS16Values[(n + offset) % kNumValues];
+            }
+            return x;
+        }
+
+        // Returns |size| S16 samples that include the extremes.
+        std::vector<int16_t> GenerateS16(size_t size, size_t offset) {
+            const int16_t kExtremes[] = {-32768, 32767, -1, 0, 1};
+            std::vector<int16_t> x(size);
+            uint32_t seed = static_cast<uint32_t>(offset + 1);
+            for (size_t n = 0; n < size; ++n) {
+                seed = seed * 1664525u + 1013904223u;
+                x[n] = (n + offset) % 3 == 0 ? kExtremes[(n + offset) / 3 % 5]
+                                             : static_cast<int16_t>(seed >> 16);
+            }
+            return x;
+        }
+
+    }  // namespace
+
+    TEST(AudioUtilTest, FloatS16ToS16MatchesScalar) {
+        for (size_t num_frames : kNumFrames) {
+            for (size_t offset = 0; offset < 8; ++offset) {
+                SCOPED_TRACE(num_frames);
+                SCOPED_TRACE(offset);
+                const std::vector<float> x = GenerateFloatS16(num_frames, offset);
+                std::vector<int16_t> y(num_frames);
+                FloatS16ToS16(x.data(), num_frames, y.data());
+                for (size_t n = 0; n < num_frames; ++n) {
+                    ASSERT_EQ(FloatS16ToS16(x[n]), y[n]) << x[n];
+                }
+            }
+        }
+        // The boundaries as stated by the conversion.
+        EXPECT_EQ(32767, FloatS16ToS16(32767.5f));
+        EXPECT_EQ(-32768, FloatS16ToS16(-32767.5f));
+        EXPECT_EQ(-32768, FloatS16ToS16(-32768.f));
+        EXPECT_EQ(32767, FloatS16ToS16(40000.f));
+        EXPECT_EQ(1, FloatS16ToS16(0.5f));
+        EXPECT_EQ(-1, FloatS16ToS16(-0.5f));
+    }
+
+    TEST(AudioUtilTest, S16ToFloatS16MatchesScalar) {
+        for (size_t num_frames : kNumFrames) {
+            SCOPED_TRACE(num_frames);
+            const std::vector<int16_t> x = GenerateS16(num_frames, 0);
+            std::vector<float> y(num_frames);
+            S16ToFloatS16(x.data(), num_frames, y.data());
+            for (size_t n = 0; n < num_frames; ++n) {
+                ASSERT_EQ(static_cast<float>(x[n]), y[n]);
+            }
+        }
+    }
+
+    TEST(AudioUtilTest, DeinterleaveS16ToFloatS16MatchesScalar) {
+        for (size_t num_channels : kNumChannels) {
+            for (size_t num_frames : kNumFrames) {
+                SCOPED_TRACE(num_channels);
+                SCOPED_TRACE(num_frames);
+                const std::vector<int16_t> x =
+                        GenerateS16(num_frames * num_channels, num_channels);
+                std::vector<std::vector<float>> y(num_channels,
+                                                  std::vector<float>(num_frames));
+                std::vector<float *> y_ptrs;
+                for (auto &y_ch : y) {
+                    y_ptrs.push_back(y_ch.data());
+                }
+                DeinterleaveS16ToFloatS16(x.data(), num_frames, num_channels,
+                                          y_ptrs.data());
+                for (size_t j = 0; j < num_frames; ++j) {
+                    for (size_t i = 0; i < num_channels; ++i) {
+                        ASSERT_EQ(static_cast<float>(x[j * num_channels + i]), y[i][j])
+                                << "channel " << i << ", frame " << j;
+                    }
+                }
+            }
+        }
+    }
+
+    TEST(AudioUtilTest, InterleaveFloatS16ToS16MatchesScalar) {
+        for (size_t num_channels : kNumChannels) {
+            for (size_t num_frames : kNumFrames) {
+                SCOPED_TRACE(num_channels);
+                SCOPED_TRACE(num_frames);
+                std::vector<std::vector<float>> x;
+                std::vector<const float *> x_ptrs;
+                for (size_t i = 0; i < num_channels; ++i) {
+                    x.push_back(GenerateFloatS16(num_frames, i));
+                }
+                for (const auto &x_ch : x) {
+                    x_ptrs.push_back(x_ch.data());
+                }
+                std::vector<int16_t> y(num_frames * num_channels);
+                InterleaveFloatS16ToS16(x_ptrs.data(), num_frames, num_channels,
+                                        y.data());
+                for (size_t j = 0; j < num_frames; ++j) {
+                    for (size_t i = 0; i < num_channels; ++i) {
+                        ASSERT_EQ(FloatS16ToS16(x[i][j]), y[j * num_channels + i])
+                                << "channel " << i << ", frame " << j << ", value "
+                                << x[i][j];
+                    }
+                }
+            }
+        }
+    }
+
+}  // namespace webrtc
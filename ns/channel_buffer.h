@@ -13,13 +13,12 @@
 
 #include <string.h>
 
-#include <memory>
-#include <vector>
-
 #include "array_view.h"
 #include "audio_util.h"
 #include "checks.h"
 #include "gtest_prod_util.h"
+#include "ns_allocator.h"
+#include "ns_arena.h"
 
 namespace webrtc {
 
@@ -42,41 +41,47 @@ namespace webrtc {
     template<typename T>
     class ChannelBuffer {
     public:
-        ChannelBuffer(size_t num_frames, size_t num_channels, size_t num_bands = 1)
-                : data_(new T[num_frames * num_channels]()),
-                  channels_(new T *[num_channels * num_bands]),
-                  bands_(new T *[num_channels * num_bands]),
+        // If |allocator| is not null, the buffers are allocated from it.
+        ChannelBuffer(size_t num_frames,
+                      size_t num_channels,
+                      size_t num_bands = 1,
+                      NsAllocator *allocator = nullptr)
+                : data_(num_frames * num_channels, allocator),
+                  channels_(num_channels * num_bands, allocator),
+                  bands_(num_channels * num_bands, allocator),
                   num_frames_(num_frames),
                   num_frames_per_band_(num_frames / num_bands),
                   num_allocated_channels_(num_channels),
                   num_channels_(num_channels),
                   num_bands_(num_bands),
-                  bands_view_(num_allocated_channels_,
-                              std::vector<rtc::ArrayView<T>>(num_bands_)),
-                  channels_view_(
-                          num_bands_,
-                          std::vector<rtc::ArrayView<T>>(num_allocated_channels_)) {
-            // Temporarily cast away const_ness to allow populating the array views.
-            auto *bands_view =
-                    const_cast<std::vector<std::vector<rtc::ArrayView<T>>> *>(&bands_view_);
-            auto *channels_view =
-                    const_cast<std::vector<std::vector<rtc::ArrayView<T>>> *>(
-                            &channels_view_);
-
+                  bands_view_(num_channels * num_bands, allocator),
+                  channels_view_(num_channels * num_bands, allocator) {
             for (size_t ch = 0; ch < num_allocated_channels_; ++ch) {
                 for (size_t band = 0; band < num_bands_; ++band) {
-                    (*channels_view)[band][ch] = rtc::ArrayView<T>(
+                    rtc::ArrayView<T> view(
                             &data_[ch * num_frames_ + band * num_frames_per_band_],
                             num_frames_per_band_);
-                    (*bands_view)[ch][band] = channels_view_[band][ch];
-                    channels_[band * num_allocated_channels_ + ch] =
-                            channels_view_[band][ch].data();
-                    bands_[ch * num_bands_ + band] =
-                            channels_[band * num_allocated_channels_ + ch];
+                    channels_view_[band * num_allocated_channels_ + ch] = view;
+                    bands_view_[ch * num_bands_ + band] = view;
+                    channels_[band * num_allocated_channels_ + ch] = view.data();
+                    bands_[ch * num_bands_ + band] = view.data();
                 }
             }
         }
 
+        // Adds the buffers of a ChannelBuffer constructed with the same arguments
+        // and an allocator to |layout|.
+        static void AddToLayout(NsArenaLayout *layout,
+                                size_t num_frames,
+                                size_t num_channels,
+                                size_t num_bands = 1) {
+            layout->AddVector<T>(num_frames * num_channels);
+            layout->AddVector<T *>(num_channels * num_bands);
+            layout->AddVector<T *>(num_channels * num_bands);
+            layout->AddVector<rtc::ArrayView<T>>(num_channels * num_bands);
+            layout->AddVector<rtc::ArrayView<T>>(num_channels * num_bands);
+        }
+
         // Returns a pointer array to the channels.
         // If band is explicitly specificed, the channels for a specific band are
         // returned and the usage becomes: channels(band)[channel][sample].
@@ -100,12 +105,11 @@ namespace webrtc {
             return const_cast<T *const *>(t->channels(band));
         }
 
-        rtc::ArrayView<const rtc::ArrayView<T>> channels_view(size_t band = 0) {
-            return channels_view_[band];
-        }
-
         rtc::ArrayView<const rtc::ArrayView<T>> channels_view(size_t band = 0) const {
-            return channels_view_[band];
+            RTC_DCHECK_LT(band, num_bands_);
+            return rtc::ArrayView<const rtc::ArrayView<T>>(
+                    &channels_view_[band * num_allocated_channels_],
+                    num_allocated_channels_);
         }
 
         // Returns a pointer array to the bands for a specific channel.
@@ -117,7 +121,6 @@ namespace webrtc {
         // 0 <= sample < |num_frames_per_band_|
         const T *const *bands(size_t channel) const {
             RTC_DCHECK_LT(channel, num_channels_);
-            RTC_DCHECK_GE(channel, 0);
             return &bands_[channel * num_bands_];
         }
 
@@ -126,12 +129,10 @@ namespace webrtc {
             return const_cast<T *const *>(t->bands(channel));
         }
 
-        rtc::ArrayView<const rtc::ArrayView<T>> bands_view(size_t channel) {
-            return bands_view_[channel];
-        }
-
         rtc::ArrayView<const rtc::ArrayView<T>> bands_view(size_t channel) const {
-            return bands_view_[channel];
+            RTC_DCHECK_LT(channel, num_allocated_channels_);
+            return rtc::ArrayView<const rtc::ArrayView<T>>(
+                    &bands_view_[channel * num_bands_], num_bands_);
         }
 
         // Sets the |slice| pointers to the |start_frame| position for each channel.
@@ -165,13 +166,13 @@ namespace webrtc {
 
         void SetDataForTesting(const T *data, size_t size) {
             RTC_CHECK_EQ(size, this->size());
-            memcpy(data_.get(), data, size * sizeof(*data));
+            memcpy(data_.data(), data, size * sizeof(*data));
         }
 
     private:
-        std::unique_ptr<T[]> data_;
-        std::unique_ptr<T *[]> channels_;
-        std::unique_ptr<T *[]> bands_;
+        NsVector<T> data_;
+        NsVector<T *> channels_;
+        NsVector<T *> bands_;
         const size_t num_frames_;
         const size_t num_frames_per_band_;
         // Number of channels the internal buffer holds.
@@ -179,8 +180,10 @@ namespace webrtc {
         // Number of channels the user sees.
         size_t num_channels_;
         const size_t num_bands_;
-        const std::vector<std::vector<rtc::ArrayView<T>>> bands_view_;
-        const std::vector<std::vector<rtc::ArrayView<T>>> channels_view_;
+        // The views of the bands of each channel, indexed as [ch][band].
+        NsVector<rtc::ArrayView<T>> bands_view_;
+        // The views of the channels of each band, indexed as [band][ch].
+        NsVector<rtc::ArrayView<T>> channels_view_;
     };
 
 }  // namespace webrtc
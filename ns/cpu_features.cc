@@ -0,0 +1,120 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Parts of this file derived from Chromium's base/cpu.cc.
+
+#include "cpu_features_wrapper.h"
+
+#include <stdint.h>
+
+#include "arch.h"
+
+#if defined(WEBRTC_ARCH_X86_FAMILY) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace webrtc {
+
+    namespace {
+
+// No CPU feature is available => straight C path.
+        int GetCPUInfoNoASM(CPUFeature feature) {
+            (void) feature;
+            return 0;
+        }
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+
+#if defined(_MSC_VER)
+        void Cpuid(int cpu_info[4], int info_type) {
+            __cpuidex(cpu_info, info_type, 0);
+        }
+
+        uint64_t Xgetbv(int xcr) {
+            return _xgetbv(xcr);
+        }
+#else
+// Intrinsic for "cpuid".
+        void Cpuid(int cpu_info[4], int info_type) {
+#if defined(__pic__) && defined(__i386__)
+            __asm__ volatile(
+                    "mov %%ebx, %%edi\n"
+                    "cpuid\n"
+                    "xchg %%edi, %%ebx\n"
+                    : "=a"(cpu_info[0]), "=D"(cpu_info[1]), "=c"(cpu_info[2]),
+                      "=d"(cpu_info[3])
+                    : "a"(info_type), "c"(0));
+#else
+            __asm__ volatile("cpuid\n"
+                    : "=a"(cpu_info[0]), "=b"(cpu_info[1]), "=c"(cpu_info[2]),
+                      "=d"(cpu_info[3])
+                    : "a"(info_type), "c"(0));
+#endif
+        }
+
+// Reads the extended control register |xcr|.
+        uint64_t Xgetbv(int xcr) {
+            uint32_t eax, edx;
+            __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(xcr));
+            return (static_cast<uint64_t>(edx) << 32) | eax;
+        }
+#endif  // _MSC_VER
+
+// Actual feature detection for x86.
+        int GetCPUInfo(CPUFeature feature) {
+            int cpu_info[4];
+            Cpuid(cpu_info, 1);
+            if (feature == kSSE2) {
+                return 0 != (cpu_info[3] & 0x04000000);
+            }
+            if (feature == kSSE3) {
+                return 0 != (cpu_info[2] & 0x00000001);
+            }
+            if (feature == kAVX2 || feature == kAVX512) {
+                int cpu_info7[4];
+                Cpuid(cpu_info7, 0);
+                if (cpu_info7[0] < 7) {
+                    return 0;
+                }
+                Cpuid(cpu_info7, 7);
+                if (feature == kAVX512) {
+                    // The OS must also save the opmask and ZMM registers (XCR0
+                    // bits 5-7).
+                    return (cpu_info[2] & 0x08000000) != 0 /* OSXSAVE */ &&
+                           (Xgetbv(0) & 0xe6) == 0xe6 &&
+                           (cpu_info7[1] & 0x00010000) != 0 /* AVX-512F */;
+                }
+                // AVX2 can be used when it is supported by the CPU and the OS saves
+                // the XMM and YMM registers on context switches (OSXSAVE and XCR0).
+                // The AVX2 code paths are compiled with FMA3 enabled, so require
+                // that as well.
+                return (cpu_info[2] & 0x00001000) != 0 /* FMA3 */ &&
+                       (cpu_info[2] & 0x10000000) != 0 /* AVX */ &&
+                       (cpu_info[2] & 0x08000000) != 0 /* OSXSAVE */ &&
+                       (Xgetbv(0) & 0x6) == 0x6 &&
+                       (cpu_info7[1] & 0x00000020) != 0 /* AVX2 */;
+            }
+            return 0;
+        }
+
+#else
+// Default to straight C for other platforms.
+        int GetCPUInfo(CPUFeature feature) {
+            (void) feature;
+            return 0;
+        }
+#endif
+
+    }  // namespace
+
+    WebRtc_CPUInfo WebRtc_GetCPUInfo = GetCPUInfo;
+    WebRtc_CPUInfo WebRtc_GetCPUInfoNoASM = GetCPUInfoNoASM;
+
+}  // namespace webrtc
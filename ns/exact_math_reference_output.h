@@ -0,0 +1,696 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_NS_EXACT_MATH_REFERENCE_OUTPUT_H_
+#define MODULES_AUDIO_PROCESSING_NS_EXACT_MATH_REFERENCE_OUTPUT_H_
+
+#include <stdint.h>
+
+namespace webrtc {
+
+// Output of chunks 250 to 299 of NoiseSuppressor at 16 kHz for the input of
+// GenerateSpeechAndSilence(300) in noise_suppressor_unittest.cc, with the
+// functions of fast_math.h replaced by the exact double precision log, exp,
+// exp2, pow, sqrt and tanh of libm. Used as the reference for the accuracy of
+// the approximations at the level of the suppressor output.
+    constexpr int kExactMathReferenceFirstChunk = 250;
+    constexpr int16_t kExactMathReferenceOutput[] = {
+            -343, -235, -442, -426, -505, -419, -473, -598, -500, -499, -640, -661,
+            -533, -593, -678, -573, -643, -596, -704, -695, -588, -553, -607, -488,
+            -471, -543, -558, -466, -455, -455, -444, -328, -293, -281, -229, -258,
+            -130, -165, -40, 66, 101, 5, 88, 136, 190, 147, 241, 236,
+            256, 378, 400, 471, 537, 411, 488, 504, 485, 579, 510, 501,
+            600, 566, 620, 641, 559, 637, 562, 604, 470, 527, 590, 568,
+            454, 373, 453, 350, 269, 347, 300, 244, 151, 216, 142, 51,
+            3, 53, -76, -194, -245, -269, -236, -304, -298, -277, -357, -404,
+            -430, -482, -498, -626, -543, -493, -621, -522, -649, -590, -621, -617,
+            -569, -548, -654, -530, -507, -632, -506, -489, -533, -441, -470, -323,
+            -386, -250, -313, -239, -162, -220, -90, -31, 39, -13, 65, 188,
+            147, 164, 321, 255, 282, 350, 461, 485, 548, 547, 544, 511,
+            551, 511, 582, 603, 552, 588, 696, 588, 650, 629, 690, 656,
+            494, 534, 637, 610, 439, 418, 489, 365, 375, 377, 363, 280,
+            238, 274, 158, 115, 22, 38, 34, -141, -180, -102, -129, -144,
+            -211, -231, -339, -447, -313, -495, -492, -476, -511, -562, -532, -574,
+            -601, -516, -536, -636, -507, -642, -596, -543, -606, -544, -501, -586,
+            -578, -420, -544, -405, -368, -340, -372, -253, -230, -187, -107, -214,
+            -156, -4, -53, 38, 129, 120, 70, 104, 239, 200, 392, 306,
+            307, 430, 398, 448, 544, 618, 500, 567, 626, 565, 641, 702,
+            598, 726, 637, 615, 599, 664, 651, 510, 580, 474, 547, 420,
+            529, 488, 293, 343, 354, 369, 144, 205, 231, 75, 52, -63,
+            -73, -46, -203, -221, -282, -319, -302, -247, -406, -456, -538, -440,
+            -459, -509, -546, -587, -540, -695, -666, -632, -582, -764, -571, -665,
+            -693, -734, -633, -566, -684, -539, -605, -567, -577, -567, -403, -465,
+            -302, -348, -229, -229, -208, -148, -40, -67, -104, 92, 141, 139,
+            154, 159, 265, 242, 272, 338, 424, 451, 408, 495, 598, 540,
+            558, 538, 552, 601, 692, 736, 659, 602, 595, 571, 639, 623,
+            640, 641, 509, 580, 462, 548, 541, 493, 437, 423, 337, 366,
+            345, 157, 135, 95, 46, 106, 60, -4, -75, -218, -115, -171,
+            -335, -270, -369, -276, -454, -441, -449, -493, -460, -540, -612, -546,
+            -649, -560, -667, -649, -601, -718, -520, -669, -538, -632, -581, -464,
+            -590, -543, -472, -510, -445, -423, -278, -382, -337, -324, -262, -174,
+            -137, -112, 55, -65, 65, 42, 169, 150, 193, 242, 226, 272,
+            453, 389, 476, 395, 395, 575, 559, 594, 542, 624, 669, 569,
+            622, 548, 692, 696, 549, 588, 666, 488, 620, 509, 482, 472,
+            440, 361, 305, 350, 287, 256, 270, 127, 233, 57, 67, 35,
+            7, -20, -209, -94, -193, -147, -266, -390, -309, -318, -424, -357,
+            -407, -448, -543, -512, -504, -486, -502, -612, -648, -526, -593, -571,
+            -508, -542, -558, -549, -557, -440, -422, -412, -421, -335, -321, -387,
+            -211, -185, -207, -259, -114, -165, 18, 61, 80, 46, 103, 216,
+            239, 206, 383, 366, 297, 469, 397, 419, 502, 570, 559, 604,
+            624, 653, 690, 560, 640, 702, 651, 668, 717, 685, 551, 635,
+            533, 623, 584, 535, 414, 425, 423, 365, 358, 253, 318, 275,
+            211, 153, 120, 46, -35, 68, -129, -133, -100, -221, -286, -208,
+            -403, -313, -465, -479, -464, -519, -434, -534, -522, -660, -654, -636,
+            -592, -617, -575, -646, -678, -659, -640, -670, -537, -605, -681, -609,
+            -528, -507, -508, -461, -414, -429, -237, -217, -188, -111, -253, -109,
+            -51, 17, 45, 116, 112, 202, 271, 175, 359, 378, 334, 353,
+            360, 431, 598, 497, 506, 651, 525, 586, 697, 683, 702, 657,
+            642, 611, 698, 666, 610, 709, 492, 488, 499, 568, 561, 388,
+            481, 315, 445, 377, 314, 300, 241, 76, 95, 49, 85, 14,
+            -61, -48, -191, -172, -209, -227, -375, -319, -312, -414, -535, -526,
+            -490, -487, -579, -616, -671, -566, -582, -620, -667, -666, -628, -546,
+            -649, -534, -660, -648, -573, -571, -479, -409, -362, -446, -413, -410,
+            -229, -234, -131, -137, -97, -130, -138, -4, 86, 61, 26, 182,
+            222, 219, 325, 312, 422, 380, 485, 443, 437, 477, 548, 496,
+            605, 497, 617, 624, 602, 557, 489, 600, 616, 627, 544, 484,
+            468, 436, 503, 506, 529, 344, 294, 311, 381, 207, 332, 155,
+            101, 102, 31, 63, 43, -58, -30, -211, -184, -289, -212, -306,
+            -291, -285, -411, -420, -434, -414, -407, -552, -586, -584, -610, -488,
+            -601, -550, -661, -589, -619, -558, -562, -601, -530, -534, -504, -563,
+            -495, -478, -442, -400, -369, -311, -251, -300, -219, -231, -114, -31,
+            -96, 5, 92, 90, 90, 170, 152, 163, 334, 257, 342, 347,
+            353, 442, 416, 506, 537, 518, 493, 524, 641, 620, 572, 622,
+            633, 658, 634, 665, 639, 589, 599, 593, 495, 507, 524, 470,
+            495, 375, 393, 277, 204, 266, 210, 162, 181, 44, 108, -10,
+            31, -80, -118, -102, -234, -321, -330, -380, -399, -448, -518, -415,
+            -523, -541, -545, -492, -590, -590, -677, -559, -689, -679, -714, -650,
+            -654, -624, -605, -514, -511, -534, -436, -544, -431, -456, -465, -359,
+            -382, -276, -145, -263, -182, -28, 28, 27, 67, 153, 219, 159,
+            274, 245, 305, 366, 530, 602, 488, 587, 648, 699, 777, 757,
+            881, 781, 954, 924, 908, 845, 934, 998, 954, 992, 950, 860,
+            874, 881, 858, 808, 666, 733, 668, 491, 499, 354, 351, 234,
+            73, 58, -140, -292, -396, -425, -615, -695, -976, -1136, -1291, -1480,
+            -1645, -1780, -1821, -1930, -2069, -2183, -2415, -2442, -2595, -2697, -2708, -2773,
+            -2738, -2773, -2776, -2848, -2816, -2792, -2743, -2591, -2607, -2489, -2333, -2303,
+            -2173, -1988, -1967, -1791, -1576, -1433, -1217, -1090, -792, -582, -421, -229,
+            16, 191, 331, 598, 769, 1033, 1170, 1455, 1570, 1836, 1887, 2129,
+            2278, 2461, 2590, 2576, 2792, 2886, 2868, 2965, 3018, 3003, 3081, 3111,
+            3103, 3009, 2957, 2878, 2948, 2863, 2767, 2543, 2449, 2327, 2261, 1955,
+            1871, 1661, 1479, 1250, 1151, 871, 773, 518, 280, 113, -139, -320,
+            -510, -709, -849, -999, -1339, -1478, -1540, -1690, -1966, -2068, -2152, -2304,
+            -2475, -2629, -2683, -2684, -2716, -2914, -2828, -2948, -2910, -2925, -2866, -2915,
+            -2799, -2695, -2683, -2677, -2429, -2423, -2284, -2147, -1910, -1821, -1611, -1474,
+            -1385, -1051, -898, -662, -509, -394, -75, 97, 235, 540, 700, 877,
+            1092, 1309, 1400, 1578, 1827, 2058, 2204, 2312, 2481, 2452, 2553, 2662,
+            2747, 2848, 2871, 2947, 2997, 2941, 3003, 2888, 2887, 2894, 2757, 2789,
+            2622, 2482, 2506, 2335, 2231, 2095, 1930, 1673, 1471, 1326, 1141, 1011,
+            646, 467, 326, 160, -110, -314, -531, -686, -924, -1099, -1326, -1607,
+            -1783, -1829, -2006, -2234, -2350, -2436, -2549, -2724, -2863, -2958, -3036, -3079,
+            -3099, -3014, -3097, -3146, -3023, -3049, -3011, -2954, -2767, -2724, -2539, -2433,
+            -2316, -2142, -2022, -1905, -1787, -1481, -1364, -1223, -1012, -719, -594, -348,
+            -165, 114, 266, 595, 776, 906, 1127, 1282, 1486, 1632, 1866, 2062,
+            2131, 2313, 2528, 2554, 2755, 2768, 2820, 2906, 2943, 3047, 3047, 2960,
+            2899, 2883, 2893, 2918, 2746, 2717, 2606, 2429, 2369, 2261, 2069, 1932,
+            1817, 1608, 1314, 1128, 1013, 762, 610, 494, 151, -47, -266, -478,
+            -537, -851, -1093, -1144, -1431, -1601, -1800, -1927, -2014, -2236, -2424, -2541,
+            -2621, -2746, -2827, -2915, -2850, -2883, -2922, -3008, -3004, -2924, -2894, -2936,
+            -2791, -2805, -2635, -2681, -2520, -2374, -2226, -2087, -1883, -1789, -1595, -1343,
+            -1197, -1057, -763, -604, -355, -265, -3, 136, 401, 653, 841, 1033,
+            1283, 1392, 1595, 1775, 1909, 1989, 2162, 2367, 2421, 2584, 2623, 2760,
+            2802, 2877, 2968, 2920, 2953, 3047, 2984, 3039, 2998, 2806, 2737, 2713,
+            2671, 2468, 2428, 2293, 2027, 2007, 1864, 1702, 1438, 1245, 1111, 885,
+            685, 429, 183, 15, -260, -398, -620, -880, -1005, -1236, -1449, -1608,
+            -1874, -1931, -2102, -2206, -2359, -2594, -2655, -2757, -2774, -2816, -3017, -2968,
+            -2983, -3009, -3044, -3034, -2975, -2979, -2802, -2854, -2649, -2563, -2546, -2375,
+            -2248, -2120, -1891, -1704, -1546, -1365, -1110, -947, -721, -487, -332, -202,
+            116, 293, 522, 689, 871, 1139, 1259, 1466, 1734, 1873, 2009, 2078,
+            2371, 2488, 2540, 2675, 2721, 2874, 2832, 3011, 3059, 2991, 2961, 2990,
+            3002, 3015, 2905, 2767, 2795, 2750, 2620, 2511, 2338, 2260, 2058, 1802,
+            1774, 1590, 1318, 1101, 967, 655, 452, 312, 115, -149, -388, -494,
+            -646, -934, -1101, -1348, -1546, -1691, -1825, -2015, -2095, -2352, -2402, -2616,
+            -2709, -2789, -2750, -2860, -2986, -2949, -2954, -2948, -2905, -2891, -2922, -2835,
+            -2829, -2761, -2594, -2559, -2335, -2315, -2196, -2062, -1779, -1620, -1472, -1238,
+            -1182, -992, -748, -523, -334, -201, 53, 341, 420, 743, 871, 1086,
+            1265, 1553, 1721, 1791, 2002, 2178, 2254, 2459, 2452, 2597, 2772, 2750,
+            2858, 2895, 2891, 2987, 2970, 2957, 2842, 2857, 2855, 2708, 2637, 2562,
+            2468, 2283, 2173, 2102, 1900, 1775, 1612, 1395, 1203, 1073, 957, 642,
+            522, 367, 132, -97, -302, -617, -747, -963, -1104, -1253, -1489, -1728,
+            -1869, -1991, -2104, -2389, -2491, -2519, -2704, -2818, -2778, -2884, -2990, -3002,
+            -3064, -3006, -3042, -3083, -3014, -2965, -2889, -2768, -2717, -2632, -2441, -2394,
+            -2261, -2075, -1934, -1708, -1571, -1313, -1113, -945, -755, -436, -290, -7,
+            112, 314, 605, 840, 970, 1229, 1384, 1636, 1825, 1920, 2023, 2281,
+            2344, 2468, 2632, 2741, 2882, 2909, 2973, 2971, 3001, 3090, 3045, 3066,
+            2934, 2912, 2897, 2802, 2676, 2605, 2504, 2391, 2193, 2037, 1905, 1711,
+            1493, 1435, 1291, 1077, 782, 592, 381, 131, -61, -189, -431, -649,
+            -874, -1006, -1179, -1341, -1496, -1656, -1854, -2016, -2202, -2255, -2381, -2603,
+            -2604, -2764, -2778, -2869, -2941, -2920, -3034, -2929, -2989, -2950, -2910, -2817,
+            -2757, -2669, -2616, -2507, -2425, -2169, -2142, -2032, -1706, -1614, -1367, -1285,
+            -1031, -884, -638, -406, -212, -33, 209, 433, 572, 823, 955, 1233,
+            1407, 1668, 1683, 1919, 2163, 2232, 2430, 2439, 2660, 2753, 2791, 2870,
+            2955, 2953, 3015, 2981, 3051, 2910, 2919, 2837, 2915, 2786, 2681, 2517,
+            2501, 2371, 2240, 2009, 1920, 1764, 1580, 1333, 1171, 948, 846, 574,
+            348, 165, -31, -223, -394, -671, -788, -1032, -1269, -1500, -1595, -1694,
+            -1945, -2075, -2251, -2301, -2532, -2669, -2617, -2711, -2905, -2983, -2926, -2944,
+            -2969, -3048, -2914, -2912, -2888, -2866, -2822, -2734, -2671, -2526, -2327, -2123,
+            -2131, -1900, -1733, -1477, -1420, -1091, -946, -746, -513, -360, -98, 146,
+            228, 539, 752, 982, 1058, 1347, 1452, 1621, 1902, 2061, 2126, 2336,
+            2468, 2521, 2715, 2781, 2740, 2851, 2972, 2913, 2936, 2970, 2968, 3004,
+            2882, 2946, 2798, 2663, 2634, 2485, 2445, 2280, 2236, 2003, 1902, 1650,
+            1532, 1324, 1185, 973, 838, 625, 396, 96, -128, -270, -413, -632,
+            -941, -1059, -1230, -1470, -1661, -1836, -1977, -2194, -2237, -2471, -2481, -2647,
+            -2709, -2850, -2902, -2991, -3014, -3089, -2964, -2968, -2945, -2901, -2880, -2806,
+            -2759, -2714, -2629, -2380, -2291, -2231, -2002, -1774, -1703, -1414, -1270, -1024,
+            -812, -683, -554, -186, 19, 188, 429, 533, 849, 1015, 1209, 1407,
+            1473, 1766, 1915, 1980, 2209, 2301, 2432, 2639, 2628, 2829, 2841, 2895,
+            2882, 2907, 2982, 2938, 2924, 3025, 2910, 2944, 2814, 2763, 2651, 2478,
+            2366, 2330, 2078, 1973, 1784, 1618, 1531, 1285, 1158, 923, 728, 477,
+            257, 28, -129, -412, -612, -809, -946, -1129, -1320, -1535, -1757, -1918,
+            -2101, -2222, -2327, -2384, -2606, -2720, -2812, -2862, -2855, -2994, -2958, -2999,
+            -2996, -2941, -2917, -2947, -2849, -2802, -2738, -2633, -2565, -2458, -2336, -2146,
+            -2045, -1889, -1623, -1494, -1252, -1069, -924, -757, -538, -369, -81, 149,
+            324, 547, 732, 891, 1107, 1309, 1507, 1645, 1872, 1976, 2116, 2231,
+            2409, 2592, 2731, 2806, 2782, 2834, 2980, 2945, 2937, 3034, 3018, 2941,
+            2973, 2816, 2803, 2669, 2687, 2587, 2369, 2353, 2177, 2017, 1809, 1578,
+            1411, 1217, 1018, 856, 735, 526, 302, -34, -104, -453, -612, -776,
+            -1051, -1198, -1426, -1658, -1745, -1949, -2058, -2151, -2296, -2420, -2577, -2770,
+            -2853, -2856, -2904, -2933, -3039, -2952, -3008, -2953, -2993, -3005, -2915, -2758,
+            -2643, -2684, -2586, -2340, -2257, -2051, -2003, -1775, -1567, -1417, -1293, -1035,
+            -929, -595, -425, -162, -45, 228, 405, 687, 783, 958, 1277, 1460,
+            1548, 1692, 1964, 2049, 2160, 2425, 2510, 2625, 2800, 2820, 2930, 2943,
+            2890, 2911, 2998, 3068, 2989, 2875, 2895, 2884, 2708, 2693, 2490, 2399,
+            2369, 2149, 2012, 1847, 1651, 1493, 1327, 1212, 941, 721, 551, 402,
+            181, 44, -151, -380, -718, -821, -1030, -1201, -1450, -1534, -1753, -1843,
+            -2015, -2265, -2371, -2397, -2606, -2645, -2753, -2819, -2961, -3012, -3023, -3064,
+            -2922, -2911, -2915, -2878, -2819, -2686, -2607, -2627, -2524, -2366, -2142, -1997,
+            -1820, -1762, -1510, -1378, -1246, -999, -691, -617, -297, -65, 84, 257,
+            522, 695, 805, 1096, 1349, 1396, 1661, 1846, 1962, 2204, 2282, 2360,
+            2500, 2656, 2692, 2861, 2855, 2955, 2963, 2945, 3016, 3076, 2994, 2909,
+            2989, 2862, 2832, 2739, 2537, 2387, 2356, 2119, 2107, 1828, 1684, 1501,
+            1361, 1161, 966, 788, 537, 322, 230, 8, -312, -448, -647, -903,
+            -1036, -1274, -1437, -1642, -1836, -1913, -2050, -2272, -2398, -2454, -2577, -2799,
+            -2827, -2897, -3023, -2974, -2976, -2966, -2950, -2909, -3023, -2878, -2914, -2844,
+            -2740, -2534, -2498, -2348, -2248, -2021, -1868, -1686, -1466, -1311, -1094, -982,
+            -735, -545, -307, -87, 30, 304, 478, 704, 926, 1196, 1381, 1569,
+            1634, 1888, 2024, 2145, 2333, 2376, 2533, 2637, 2658, 2826, 2947, 3009,
+            2985, 3025, 2998, 2920, 2962, 2873, 2858, 2858, 2764, 2711, 2572, 2508,
+            2354, 2179, 2105, 1971, 1663, 1606, 1428, 1204, 965, 715, 580, 271,
+            79, -93, -277, -470, -662, -944, -1192, -1355, -1616, -1664, -1893, -2061,
+            -2281, -2385, -2507, -2580, -2717, -2713, -2884, -3005, -2951, -2927, -2988, -2984,
+            -2972, -3061, -3014, -2911, -2847, -2748, -2597, -2565, -2429, -2308, -2109, -2053,
+            -1817, -1650, -1533, -1242, -1092, -870, -757, -402, -200, -118, 95, 316,
+            622, 682, 1041, 1114, 1407, 1506, 1784, 1823, 2008, 2150, 2246, 2477,
+            2606, 2596, 2792, 2855, 2932, 2911, 2959, 2956, 2930, 2979, 3028, 2996,
+            2851, 2752, 2729, 2573, 2557, 2441, 2312, 2246, 2062, 1930, 1718, 1477,
+            1294, 1181, 1012, 779, 596, 370, 163, -25, -347, -438, -648, -979,
+            -1122, -1332, -1473, -1749, -1786, -2017, -2229, -2288, -2525, -2539, -2625, -2710,
+            -2927, -2969, -3026, -3088, -3055, -3021, -3032, -2944, -2894, -2870, -2892, -2710,
+            -2683, -2505, -2431, -2235, -2155, -1951, -1760, -1629, -1531, -1267, -1040, -900,
+            -718, -375, -317, -76, 209, 336, 519, 814, 1022, 1263, 1331, 1538,
+            1687, 1963, 2095, 2235, 2359, 2408, 2585, 2750, 2845, 2903, 2861, 3053,
+            3044, 3007, 3106, 3071, 2944, 2997, 2951, 2814, 2823, 2622, 2569, 2488,
+            2282, 2038, 2013, 1723, 1586, 1469, 1299, 993, 802, 602, 478, 102,
+            -41, -262, -424, -743, -882, -1121, -1336, -1468, -1562, -1773, -2003, -2069,
+            -2194, -2291, -2413, -2562, -2640, -2701, -2913, -2829, -2982, -2883, -2959, -3018,
+            -2965, -2949, -2880, -2736, -2818, -2738, -2521, -2410, -2286, -2119, -2091, -1947,
+            -1680, -1498, -1438, -1194, -918, -738, -592, -296, -132, 104, 304, 552,
+            649, 911, 1013, 1197, 1435, 1561, 1854, 2012, 2052, 2304, 2441, 2474,
+            2655, 2681, 2764, 2865, 2945, 2850, 2912, 2990, 2970, 2931, 2913, 2905,
+            2783, 2699, 2628, 2511, 2405, 2346, 2134, 2132, 1969, 1821, 1519, 1429,
+            1233, 1014, 743, 596, 446, 206, 7, -252, -482, -599, -889, -1131,
+            -1221, -1539, -1652, -1876, -2013, -2176, -2259, -2447, -2577, -2737, -2724, -2825,
+            -2872, -2982, -3010, -3075, -3079, -3011, -2958, -2882, -2894, -2856, -2749, -2639,
+            -2637, -2513, -2395, -2162, -2061, -1983, -1784, -1574, -1409, -1239, -958, -748,
+            -666, -457, -217, 79, 266, 404, 705, 800, 1055, 1349, 1407, 1630,
+            1873, 2018, 2096, 2299, 2470, 2488, 2741, 2688, 2804, 2836, 2924, 2996,
+            2936, 3028, 3049, 2938, 2967, 2789, 2851, 2703, 2564, 2507, 2374, 2196,
+            2122, 1984, 1902, 1564, 1395, 1231, 1027, 930, 750, 506, 322, 159,
+            -44, -365, -544, -663, -935, -1112, -1249, -1487, -1681, -1850, -1979, -2149,
+            -2285, -2399, -2640, -2733, -2842, -2897, -2963, -3038, -3088, -3112, -3005, -2980,
+            -2981, -3026, -2924, -2830, -2747, -2753, -2488, -2410, -2359, -2134, -2069, -1923,
+            -1652, -1538, -1351, -1140, -891, -781, -434, -339, -49, 185, 388, 549,
+            661, 888, 1137, 1250, 1516, 1741, 1773, 1937, 2251, 2302, 2505, 2527,
+            2704, 2794, 2834, 2993, 3022, 3015, 3025, 2981, 2978, 3004, 2992, 2993,
+            2868, 2848, 2734, 2619, 2512, 2397, 2235, 2103, 1834, 1652, 1586, 1333,
+            1061, 951, 715, 439, 233, 102, -123, -309, -525, -788, -968, -1124,
+            -1303, -1521, -1698, -1820, -2042, -2139, -2302, -2347, -2541, -2582, -2771, -2774,
+            -2849, -2941, -2903, -2872, -2934, -2844, -2819, -2880, -2787, -2687, -2618, -2588,
+            -2420, -2303, -2272, -1979, -1851, -1760, -1500, -1321, -1170, -930, -828, -511,
+            -340, -184, 67, 322, 534, 713, 847, 1029, 1302, 1389, 1625, 1894,
+            2004, 2180, 2283, 2482, 2587, 2692, 2738, 2764, 2899, 2984, 2956, 2894,
+            2940, 3047, 2940, 2879, 2883, 2776, 2682, 2660, 2626, 2441, 2300, 2123,
+            2034, 1857, 1664, 1633, 1361, 1109, 939, 758, 630, 360, 209, 4,
+            -353, -502, -764, -967, -1158, -1276, -1539, -1683, -1880, -2042, -2230, -2258,
+            -2422, -2599, -2575, -2802, -2870, -2794, -2946, -2923, -2899, -2930, -2957, -3030,
+            -2867, -2846, -2796, -2684, -2602, -2604, -2428, -2346, -2253, -2003, -1900, -1844,
+            -1572, -1368, -1297, -974, -901, -636, -498, -273, -92, 204, 446, 555,
+            789, 1070, 1188, 1385, 1597, 1787, 1994, 2124, 2328, 2389, 2470, 2692,
+            2779, 2820, 2832, 2989, 2957, 3028, 2987, 2985, 3007, 2856, 2872, 2864,
+            2678, 2555, 2472, 2356, 2207, 2058, 1953, 1785, 1600, 1443, 1327, 1161,
+            951, 683, 516, 332, 194, -11, -256, -524, -662, -825, -1136, -1308,
+            -1514, -1759, -1844, -2084, -2214, -2361, -2417, -2645, -2735, -2842, -2823, -3026,
+            -2923, -2969, -2996, -3017, -3061, -3087, -3023, -2892, -2912, -2776, -2747, -2556,
+            -2543, -2351, -2245, -1970, -1902, -1729, -1488, -1429, -1109, -955, -771, -609,
+            -442, -196, 26, 212, 425, 551, 884, 971, 1132, 1308, 1498, 1800,
+            1846, 2160, 2166, 2353, 2495, 2531, 2640, 2864, 2914, 2970, 3049, 2954,
+            3046, 2958, 3027, 3015, 2994, 2928, 2821, 2602, 2572, 2482, 2247, 2184,
+            2060, 1757, 1651, 1427, 1238, 1091, 943, 708, 432, 275, 47, -81,
+            -273, -490, -702, -891, -1163, -1385, -1547, -1633, -1799, -2034, -2172, -2363,
+            -2439, -2649, -2708, -2795, -2868, -3012, -3029, -3057, -2994, -3059, -2978, -2945,
+            -2978, -2954, -2874, -2708, -2693, -2506, -2483, -2384, -2226, -1967, -1783, -1608,
+            -1480, -1300, -1043, -889, -708, -543, -353, -107, 177, 368, 584, 672,
+            921, 1185, 1396, 1531, 1654, 1849, 1996, 2117, 2340, 2432, 2492, 2549,
+            2694, 2782, 2913, 2966, 2970, 3044, 2932, 3019, 2997, 2879, 2895, 2863,
+            2762, 2613, 2474, 2404, 2325, 2131, 2022, 1829, 1577, 1438, 1187, 1058,
+            835, 715, 403, 249, 70, -93, -351, -587, -716, -1024, -1219, -1396,
+            -1543, -1758, -1981, -2077, -2199, -2289, -2493, -2665, -2719, -2856, -2903, -2950,
+            -2906, -3027, -3072, -3082, -3087, -3063, -2990, -2871, -2840, -2761, -2637, -2543,
+            -2457, -2291, -2179, -1927, -1796, -1664, -1535, -1275, -1171, -875, -741, -491,
+            -357, -117, 169, 317, 539, 676, 906, 1093, 1342, 1590, 1681, 1881,
+            2040, 2238, 2355, 2525, 2519, 2742, 2685, 2902, 2866, 2969, 2993, 2905,
+            3003, 2958, 2910, 2863, 2803, 2825, 2643, 2649, 2549, 2284, 2280, 2100,
+            1975, 1836, 1555, 1378, 1245, 1053, 813, 720, 387, 292, 8, -195,
+            -451, -603, -816, -977, -1262, -1517, -1648, -1844, -1967, -2217, -2321, -2461,
+            -2613, -2679, -2798, -2849, -2867, -2960, -3055, -3055, -3088, -3040, -2961, -2966,
+            -3006, -2959, -2830, -2734, -2687, -2574, -2322, -2305, -2166, -1847, -1821, -1576,
+            -1323, -1154, -948, -708, -531, -307, -138, 108, 199, 406, 749, 851,
+            1142, 1328, 1564, 1663, 1895, 2037, 2221, 2328, 2442, 2590, 2730, 2852,
+            2809, 2897, 2913, 3089, 3066, 3003, 3093, 2932, 3040, 2958, 2854, 2750,
+            2760, 2636, 2406, 2253, 2243, 1994, 1854, 1652, 1466, 1281, 1088, 1023,
+            716, 547, 346, 202, -99, -275, -527, -673, -808, -1013, -1321, -1461,
+            -1556, -1849, -1859, -2027, -2210, -2351, -2458, -2567, -2652, -2741, -2750, -2889,
+            -2823, -2855, -2996, -2926, -2864, -2881, -2794, -2803, -2660, -2561, -2464, -2417,
+            -2342, -2130, -1961, -1879, -1685, -1550, -1372, -1143, -905, -662, -523, -288,
+            -37, 162, 331, 529, 758, 955, 1050, 1270, 1436, 1722, 1796, 1927,
+            2059, 2285, 2412, 2461, 2549, 2672, 2814, 2788, 2872, 2990, 2998, 3017,
+            2932, 3006, 2982, 2799, 2829, 2695, 2709, 2477, 2453, 2396, 2244, 2027,
+            1832, 1700, 1461, 1376, 1069, 1026, 722, 533, 279, 47, -149, -317,
+            -469, -676, -870, -1192, -1225, -1457, -1679, -1922, -2092, -2280, -2349, -2507,
+            -2627, -2750, -2823, -2823, -3035, -2952, -3008, -3022, -3051, -3094, -3018, -3079,
+            -2996, -2920, -2871, -2648, -2570, -2445, -2347, -2124, -2055, -1762, -1585, -1524,
+            -1253, -1078, -928, -706, -357, -148, 10, 277, 484, 737, 964, 1045,
+            1336, 1557, 1605, 1843, 1938, 2049, 2247, 2356, 2409, 2494, 2660, 2608,
+            2723, 2628, 2757, 2645, 2652, 2556, 2430, 2357, 1440, 1423, 1284, 1234,
+            1060, 880, 846, 727, 754, 556, 470, 475, 415, 219, 170, 75,
+            9, 56, 14, -146, -131, -182, -176, -330, -390, -356, -358, -400,
+            -387, -438, -483, -565, -539, -507, -634, -551, -669, -712, -687, -716,
+            -692, -733, -651, -718, -695, -637, -676, -702, -637, -671, -562, -571,
+            -582, -581, -443, -464, -468, -445, -286, -294, -160, -128, -120, -101,
+            40, 32, 46, 72, 159, 193, 244, 246, 358, 426, 378, 499,
+            423, 524, 518, 599, 554, 729, 658, 618, 675, 649, 742, 796,
+            781, 626, 766, 691, 740, 694, 616, 592, 591, 397, 342, 342,
+            349, 245, 233, 271, 273, 149, 184, 12, 93, -28, -142, -151,
+            -134, -239, -129, -293, -258, -221, -269, -358, -343, -462, -351, -448,
+            -424, -429, -469, -495, -609, -589, -705, -712, -723, -754, -618, -615,
+            -721, -710, -676, -478, -571, -540, -401, -368, -407, -318, -438, -333,
+            -157, -203, -127, -45, 2, -81, 125, 143, 71, 63, 113, 253,
+            243, 419, 345, 468, 422, 485, 429, 489, 473, 536, 638, 655,
+            571, 577, 656, 692, 745, 654, 663, 727, 558, 601, 528, 535,
+            597, 612, 473, 550, 362, 272, 267, 222, 284, 124, 129, 60,
+            131, 42, -68, -149, -52, -214, -270, -331, -293, -285, -258, -310,
+            -308, -384, -342, -470, -487, -513, -573, -474, -504, -615, -576, -636,
+            -656, -640, -664, -532, -574, -502, -489, -550, -476, -535, -527, -540,
+            -399, -361, -405, -418, -335, -197, -270, -203, -187, -134, -98, -60,
+            -4, 108, 127, 146, 307, 253, 262, 359, 470, 339, 474, 372,
+            569, 493, 633, 574, 647, 660, 569, 720, 641, 532, 563, 547,
+            592, 540, 602, 652, 598, 566, 433, 493, 432, 413, 472, 357,
+            327, 392, 253, 298, 169, 234, 108, 24, -46, -68, -164, -189,
+            -109, -114, -136, -219, -201, -268, -361, -301, -361, -423, -500, -505,
+            -599, -534, -620, -529, -588, -672, -585, -542, -650, -547, -512, -569,
+            -581, -518, -572, -441, -441, -362, -463, -370, -325, -383, -373, -313,
+            -315, -231, -76, -153, -111, 55, -33, 165, 191, 237, 180, 317,
+            230, 328, 416, 485, 510, 553, 469, 474, 534, 631, 677, 547,
+            693, 566, 688, 623, 700, 609, 741, 746, 668, 622, 625, 574,
+            627, 471, 613, 489, 491, 512, 394, 316, 274, 331, 241, 151,
+            166, 41, 123, 22, -51, -143, -98, -84, -133, -161, -244, -291,
+            -467, -406, -555, -527, -563, -646, -640, -570, -540, -589, -581, -693,
+            -628, -725, -694, -740, -621, -643, -591, -664, -662, -502, -542, -493,
+            -442, -553, -458, -397, -331, -324, -331, -196, -202, -142, -143, -8,
+            107, 106, 194, 159, 148, 297, 373, 388, 398, 400, 387, 547,
+            513, 619, 534, 651, 602, 641, 504, 608, 554, 565, 552, 571,
+            610, 589, 553, 534, 586, 555, 563, 531, 397, 361, 440, 342,
+            387, 358, 184, 245, 106, 188, 52, 102, 55, -130, -147, -187,
+            -284, -199, -262, -226, -371, -399, -514, -483, -529, -556, -553, -503,
+            -603, -516, -538, -530, -664, -693, -598, -652, -703, -589, -600, -645,
+            -613, -557, -507, -554, -421, -485, -366, -357, -277, -258, -276, -196,
+            -253, -95, -2, -102, 27, 85, 107, 41, 90, 126, 282, 196,
+            376, 330, 447, 501, 510, 474, 570, 481, 516, 557, 567, 542,
+            551, 640, 546, 632, 706, 567, 541, 673, 541, 479, 575, 524,
+            530, 435, 439, 461, 476, 332, 299, 348, 153, 251, 129, 77,
+            110, -36, -106, -128, -115, -124, -278, -221, -348, -392, -375, -472,
+            -488, -382, -489, -532, -526, -543, -649, -549, -639, -530, -661, -599,
+            -670, -577, -583, -622, -681, -614, -625, -516, -526, -457, -419, -338,
+            -362, -335, -332, -250, -275, -223, -230, -121, -105, 17, -60, 32,
+            88, 111, 261, 296, 212, 308, 425, 323, 427, 520, 478, 542,
+            455, 504, 628, 525, 642, 643, 546, 713, 554, 714, 594, 579,
+            605, 701, 573, 610, 622, 487, 535, 466, 439, 454, 308, 330,
+            377, 259, 258, 159, 86, 189, 35, 63, -8, -14, -144, -234,
+            -242, -315, -343, -327, -343, -457, -372, -485, -457, -602, -594, -533,
+            -628, -691, -713, -555, -602, -723, -730, -658, -691, -586, -680, -605,
+            -517, -568, -567, -484, -437, -380, -495, -377, -329, -286, -302, -328,
+            -174, -188, -179, 38, -11, 43, 140, 130, 86, 191, 295, 267,
+            222, 282, 393, 468, 463, 542, 482, 540, 629, 553, 621, 682,
+            528, 580, 569, 672, 641, 698, 691, 661, 553, 637, 482, 508,
+            593, 470, 422, 490, 395, 401, 438, 390, 267, 312, 101, 134,
+            21, 43, -9, -32, -42, -26, -94, -211, -298, -232, -336, -324,
+            -317, -419, -499, -462, -566, -563, -442, -538, -522, -485, -607, -548,
+            -560, -588, -631, -645, -570, -495, -572, -582, -467, -542, -462, -395,
+            -476, -389, -413, -328, -258, -296, -202, -175, -27, -4, -105, 28,
+            70, 96, 236, 189, 275, 286, 282, 335, 349, 411, 508, 453,
+            569, 510, 589, 569, 548, 507, 569, 596, 568, 618, 617, 622,
+            677, 589, 527, 649, 508, 439, 565, 445, 493, 356, 283, 303,
+            272, 204, 268, 198, 111, 77, -48, -21, -48, -162, -92, -247,
+            -200, -285, -353, -313, -409, -519, -508, -551, -592, -480, -639, -564,
+            -639, -671, -698, -701, -599, -694, -617, -720, -682, -532, -555, -621,
+            -655, -471, -520, -587, -551, -442, -375, -373, -345, -325, -231, -236,
+            -168, -166, -154, -55, 21, 86, 44, 176, 212, 115, 144, 213,
+            264, 294, 309, 403, 413, 427, 412, 463, 567, 631, 663, 556,
+            519, 653, 540, 676, 635, 583, 580, 560, 648, 654, 578, 535,
+            440, 503, 491, 381, 426, 402, 386, 203, 269, 256, 127, 141,
+            93, -28, -61, -86, -57, -151, -239, -261, -282, -365, -423, -408,
+            -435, -471, -462, -592, -503, -560, -577, -606, -701, -662, -551, -631,
+            -714, -710, -640, -649, -673, -631, -641, -509, -560, -529, -493, -377,
+            -408, -416, -295, -285, -180, -288, -241, -149, -120, -88, -44, 96,
+            152, 60, 218, 306, 273, 317, 271, 347, 485, 448, 464, 464,
+            499, 624, 615, 535, 657, 594, 699, 672, 640, 583, 675, 727,
+            704, 586, 555, 615, 601, 560, 563, 508, 436, 478, 340, 278,
+            370, 276, 183, 247, 217, 32, 11, 59, -57, -42, -183, -239,
+            -198, -222, -326, -391, -331, -412, -446, -468, -472, -552, -513, -624,
+            -665, -630, -695, -598, -604, -672, -599, -690, -685, -654, -541, -676,
+            -627, -600, -460, -527, -518, -437, -423, -412, -397, -365, -277, -253,
+            -213, -119, -141, -32, -13, 102, 103, 174, 113, 206, 245, 298,
+            378, 355, 339, 380, 532, 551, 545, 500, 640, 562, 641, 656,
+            578, 573, 668, 612, 627, 609, 593, 547, 511, 562, 514, 431,
+            511, 476, 298, 258, 302, 271, 151, 200, 113, 20, 2, -34,
+            -62, -124, -129, -106, -153, -237, -236, -393, -342, -346, -376, -419,
+            -542, -541, -523, -453, -492, -621, -667, -612, -661, -611, -528, -592,
+            -672, -561, -552, -548, -628, -508, -516, -440, -406, -474, -498, -398,
+            -334, -336, -249, -217, -211, -123, -89, -74, -96, 10, 13, 21,
+            83, 151, 228, 164, 260, 263, 350, 427, 413, 469, 510, 505,
+            545, 602, 630, 532, 559, 615, 695, 613, 631, 652, 672, 606,
+            542, 538, 592, 559, 568, 439, 473, 419, 474, 380, 276, 279,
+            241, 235, 146, 48, 130, 30, -9, -109, -152, -133, -123, -220,
+            -321, -236, -335, -440, -396, -358, -375, -556, -520, -567, -479, -487,
+            -636, -619, -537, -586, -664, -643, -576, -623, -603, -471, -489, -492,
+            -418, -418, -392, -373, -319, -356, -244, -243, -163, -250, -196, -48,
+            -140, 20, 57, 65, 88, 126, 87, 256, 285, 343, 360, 370,
+            360, 386, 416, 480, 430, 478, 489, 569, 485, 642, 558, 558,
+            628, 621, 630, 618, 617, 654, 509, 540, 588, 545, 471, 496,
+            407, 334, 305, 277, 315, 292, 163, 161, 102, 128, -27, -25,
+            11, -116, -90, -251, -271, -263, -332, -325, -361, -474, -416, -498,
+            -543, -585, -574, -543, -640, -670, -604, -608, -657, -549, -593, -599,
+            -538, -608, -650, -655, -508, -495, -584, -508, -484, -392, -321, -301,
+            -287, -266, -211, -168, -94, -168, -140, -86, -32, 104, 117, 196,
+            235, 168, 278, 216, 307, 275, 390, 496, 406, 437, 552, 548,
+            467, 583, 666, 610, 649, 622, 646, 652, 671, 576, 562, 623,
+            569, 624, 547, 444, 428, 433, 513, 445, 347, 331, 316, 206,
+            162, 138, 119, 12, 14, -42, -127, -164, -159, -118, -210, -324,
+            -374, -376, -357, -378, -499, -425, -440, -539, -564, -473, -581, -603,
+            -533, -523, -561, -677, -644, -525, -644, -632, -474, -506, -594, -553,
+            -477, -509, -509, -427, -420, -278, -295, -353, -172, -252, -82, -86,
+            -39, -64, 26, 27, 104, 138, 191, 185, 237, 285, 385, 321,
+            328, 482, 474, 458, 492, 512, 577, 583, 530, 650, 509, 582,
+            673, 533, 602, 647, 639, 546, 580, 589, 520, 533, 430, 378,
+            385, 347, 415, 305, 253, 268, 214, 226, 140, 75, 120, 80,
+            59, -76, -141, -81, -182, -211, -209, -210, -364, -410, -336, -502,
+            -486, -400, -539, -605, -493, -540, -515, -571, -648, -540, -535, -609,
+            -579, -642, -557, -629, -518, -599, -436, -447, -487, -401, -469, -427,
+            -390, -341, -333, -265, -183, -157, -38, -117, -48, -31, 121, 144,
+            137, 134, 260, 211, 340, 280, 293, 420, 495, 505, 391, 420,
+            577, 552, 594, 627, 553, 590, 654, 627, 567, 519, 505, 541,
+            629, 551, 571, 482, 462, 528, 408, 343, 349, 343, 361, 307,
+            264, 233, 151, 38, 99, 18, -69, -40, -31, -196, -205, -236,
+            -220, -262, -328, -276, -411, -394, -451, -377, -448, -418, -538, -581,
+            -482, -474, -498, -584, -585, -501, -472, -506, -592, -443, -538, -477,
+            -452, -435, -335, -393, -349, -282, -341, -257, -260, -190, -131, -45,
+            -77, -78, 79, 124, 16, 71, 230, 286, 255, 250, 356, 428,
+            316, 470, 372, 514, 412, 542, 490, 513, 630, 562, 581, 492,
+            576, 566, 598, 550, 486, 605, 579, 560, 438, 398, 407, 507,
+            401, 393, 364, 314, 210, 272, 113, 77, 188, 28, 46, 78,
+            -55, -4, -119, -153, -154, -267, -324, -315, -431, -381, -319, -518,
+            -515, -526, -425, -465, -535, -603, -628, -581, -546, -631, -591, -530,
+            -492, -517, -574, -597, -509, -493, -408, -482, -523, -457, -317, -368,
+            -292, -291, -297, -245, -152, -150, -167, -95, 41, 8, 13, 89,
+            125, 175, 187, 171, 217, 285, 306, 461, 500, 438, 504, 436,
+            558, 510, 585, 530, 561, 635, 536, 572, 607, 555, 559, 617,
+            473, 477, 527, 389, 515, 475, 290, 284, 313, 215, 200, 250,
+            133, 113, 115, 72, -9, -130, -115, -168, -204, -176, -296, -355,
+            -374, -404, -392, -371, -391, -448, -420, -528, -479, -605, -566, -657,
+            -646, -590, -576, -553, -586, -575, -566, -602, -583, -542, -547, -466,
+            -374, -356, -475, -322, -323, -253, -352, -309, -253, -105, -149, -30,
+            27, -62, 48, 31, 45, 136, 236, 267, 290, 359, 404, 441,
+            441, 471, 464, 417, 527, 575, 519, 630, 566, 508, 558, 547,
+            500, 627, 642, 505, 592, 556, 516, 477, 441, 470, 454, 441,
+            449, 401, 299, 315, 340, 273, 214, 181, 108, 101, 120, 61,
+            -45, -107, -62, -137, -240, -229, -197, -243, -361, -286, -326, -365,
+            -441, -437, -511, -547, -481, -602, -565, -582, -490, -522, -623, -540,
+            -623, -544, -639, -629, -542, -526, -425, -411, -464, -447, -450, -309,
+            -298, -333, -229, -255, -165, -175, -177, -115, -15, 53, 0, 123,
+            231, 189, 164, 215, 252, 287, 368, 475, 441, 472, 447, 478,
+            588, 581, 618, 538, 650, 640, 572, 602, 598, 491, 535, 546,
+            573, 478, 402, 414, 335, 320, 414, 240, 203, 298, 151, 108,
+            99, 24, 118, 74, -72, -140, -180, -238, -192, -205, -306, -269,
+            -250, -359, -440, -493, -420, -542, -471, -433, -477, -554, -558, -575,
+            -568, -493, -582, -630, -541, -492, -631, -592, -522, -526, -514, -405,
+            -437, -446, -304, -353, -304, -241, -310, -200, -155, -237, -67, -99,
+            -98, 84, 26, 112, 42, 154, 104, 252, 203, 323, 267, 356,
+            320, 485, 475, 461, 412, 419, 545, 560, 592, 572, 502, 576,
+            612, 507, 650, 579, 571, 473, 588, 533, 569, 451, 517, 453,
+            405, 304, 371, 358, 198, 240, 205, 144, 199, 86, -34, -28,
+            10, -140, -151, -253, -274, -171, -330, -262, -276, -350, -382, -389,
+            -424, -528, -585, -573, -594, -537, -545, -618, -601, -577, -511, -605,
+            -642, -555, -454, -539, -409, -535, -445, -437, -474, -369, -339, -240,
+            -254, -261, -230, -124, -119, 13, -8, 37, 142, 140, 192, 239,
+            239, 344, 303, 387, 338, 473, 483, 532, 507, 457, 551, 476,
+            591, 520, 485, 481, 496, 579, 517, 563, 619, 479, 590, 488,
+            522, 448, 438, 333, 362, 401, 263, 217, 315, 210, 259, 195,
+            158, 160, 19, 48, -22, -78, -147, -170, -208, -197, -197, -323,
+            -285, -321, -360, -392, -415, -451, -461, -430, -474, -611, -534, -634,
+            -517, -583, -574, -560, -634, -584, -552, -633, -519, -514, -592, -460,
+            -541, -436, -377, -403, -334, -306, -319, -183, -272, -75, -35, -87,
+            31, 19, 132, 82, 53, 155, 280, 309, 361, 342, 392, 431,
+            345, 462, 510, 558, 473, 522, 490, 604, 512, 533, 522, 561,
+            521, 577, 579, 598, 545, 444, 587, 472, 515, 479, 405, 363,
+            416, 319, 261, 325, 216, 106, 161, 82, 95, -36, -33, -50,
+            -146, -64, -98, -183, -305, -228, -391, -418, -383, -408, -366, -489,
+            -391, -423, -446, -515, -441, -595, -487, -554, -605, -594, -503, -601,
+            -553, -493, -518, -409, -403, -336, -405, -427, -322, -358, -261, -229,
+            -208, -176, -181, -163, -87, 8, 73, 91, 58, 128, 130, 243,
+            279, 288, 255, 339, 337, 407, 504, 521, 456, 580, 617, 524,
+            491, 624, 617, 653, 497, 660, 500, 539, 543, 623, 612, 606,
+            470, 550, 497, 426, 323, 322, 295, 262, 288, 179, 278, 115,
+            179, 137, 57, 57, -48, -154, -178, -136, -228, -273, -302, -304,
+            -383, -345, -461, -431, -430, -525, -579, -597, -555, -517, -520, -602,
+            -486, -528, -563, -515, -599, -519, -562, -452, -527, -509, -424, -529,
+            -352, -313, -354, -353, -250, -250, -210, -229, -146, -157, -81, -151,
+            -127, -74, 68, 73, 21, 211, 188, 246, 211, 209, 400, 419,
+            376, 344, 381, 513, 469, 444, 583, 472, 573, 544, 503, 510,
+            638, 624, 574, 558, 457, 389, 394, 357, 406, 359, 397, 257,
+            331, 336, 314, 224, 228, 61, -20, -42, 5, -116, -197, -236,
+            -202, -301, -262, -422, -446, -461, -409, -597, -582, -558, -719, -778,
+            -728, -694, -705, -765, -708, -807, -735, -878, -750, -814, -735, -813,
+            -841, -726, -644, -687, -682, -567, -538, -507, -421, -476, -398, -164,
+            -134, -43, -65, 75, 186, 180, 367, 450, 643, 756, 938, 990,
+            1198, 1368, 1442, 1550, 1688, 1825, 1893, 2110, 2204, 2204, 2378, 2473,
+            2500, 2550, 2530, 2536, 2594, 2606, 2462, 2495, 2455, 2446, 2337, 2221,
+            2279, 2178, 2005, 1820, 1681, 1529, 1392, 1356, 1084, 1001, 784, 616,
+            396, 216, 86, -159, -352, -444, -698, -822, -1077, -1312, -1384, -1504,
+            -1744, -1848, -2007, -2082, -2175, -2288, -2446, -2480, -2665, -2647, -2648, -2663,
+            -2704, -2763, -2754, -2724, -2806, -2695, -2684, -2530, -2578, -2338, -2305, -2230,
+            -2134, -1920, -1853, -1712, -1446, -1447, -1270, -1041, -855, -677, -449, -333,
+            -40, 54, 222, 486, 615, 887, 1063, 1242, 1287, 1504, 1633, 1775,
+            1931, 2125, 2219, 2387, 2377, 2588, 2644, 2639, 2737, 2692, 2685, 2729,
+            2824, 2676, 2704, 2638, 2566, 2589, 2349, 2345, 2219, 2146, 1917, 1793,
+            1685, 1397, 1353, 1074, 928, 644, 546, 259, 115, -149, -308, -516,
+            -700, -948, -1133, -1299, -1502, -1654, -1749, -2020, -2146, -2289, -2396, -2422,
+            -2657, -2707, -2836, -2884, -2975, -3026, -2916, -3049, -2953, -3039, -2929, -2913,
+            -2864, -2841, -2727, -2529, -2545, -2407, -2138, -2130, -1969, -1759, -1624, -1287,
+            -1188, -1031, -791, -575, -309, -94, 69, 302, 492, 678, 883, 1207,
+            1411, 1516, 1758, 1899, 2097, 2110, 2278, 2419, 2610, 2626, 2678, 2776,
+            2886, 2922, 2952, 2901, 2896, 2930, 2962, 2870, 2785, 2792, 2708, 2612,
+            2405, 2314, 2241, 2041, 1904, 1698, 1582, 1412, 1186, 1028, 800, 738,
+            369, 275, -5, -105, -369, -470, -780, -909, -1095, -1277, -1445, -1645,
+            -1826, -1937, -2084, -2251, -2447, -2476, -2622, -2624, -2781, -2855, -2932, -2935,
+            -2960, -2875, -2987, -2914, -2832, -2752, -2700, -2653, -2517, -2404, -2280, -2139,
+            -1994, -1951, -1792, -1549, -1327, -1262, -943, -774, -608, -413, -170, 34,
+            175, 432, 528, 721, 982, 1172, 1307, 1549, 1668, 1858, 1955, 2064,
+            2207, 2387, 2518, 2533, 2779, 2789, 2928, 2939, 2899, 3031, 3024, 2973,
+            2883, 2942, 2848, 2775, 2725, 2586, 2409, 2375, 2244, 2048, 1840, 1712,
+            1491, 1437, 1097, 915, 805, 513, 351, 126, -104, -173, -497, -595,
+            -845, -978, -1234, -1352, -1499, -1722, -1857, -2043, -2103, -2262, -2483, -2471,
+            -2650, -2695, -2758, -2807, -2945, -2887, -2893, -2937, -3011, -2840, -2802, -2873,
+            -2696, -2725, -2599, -2482, -2317, -2093, -1961, -1814, -1673, -1465, -1318, -1148,
+            -890, -811, -493, -300, -87, 47, 310, 467, 718, 901, 1155, 1292,
+            1421, 1642, 1822, 2043, 2116, 2343, 2451, 2599, 2703, 2690, 2867, 2956,
+            2948, 3044, 3014, 2979, 3060, 2892, 2908, 2842, 2829, 2797, 2582, 2617,
+            2457, 2255, 2189, 1946, 1856, 1657, 1522, 1299, 1082, 952, 712, 561,
+            430, 98, -107, -320, -503, -701, -844, -980, -1197, -1348, -1628, -1689,
+            -1925, -2077, -2274, -2325, -2459, -2642, -2716, -2690, -2898, -2895, -2962, -3014,
+            -2993, -2917, -2989, -2894, -2777, -2732, -2781, -2657, -2477, -2356, -2353, -2090,
+            -2078, -1881, -1607, -1461, -1361, -1062, -874, -816, -604, -293, -177, 50,
+            212, 522, 635, 967, 1060, 1343, 1502, 1595, 1857, 2037, 2195, 2320,
+            2433, 2619, 2713, 2679, 2859, 2963, 2944, 3042, 2937, 2993, 2924, 2998,
+            2984, 2843, 2737, 2738, 2720, 2571, 2422, 2333, 2217, 1964, 1803, 1673,
+            1516, 1276, 1200, 910, 758, 504, 394, 191, -8, -241, -435, -638,
+            -933, -1126, -1331, -1369, -1547, -1796, -1906, -2155, -2191, -2450, -2578, -2541,
+            -2728, -2796, -2923, -2912, -2941, -2921, -2955, -2880, -2869, -2844, -2914, -2862,
+            -2674, -2683, -2521, -2383, -2311, -2055, -2001, -1754, -1577, -1489, -1226, -1015,
+            -886, -751, -444, -345, -28, 112, 340, 511, 631, 842, 1061, 1310,
+            1465, 1657, 1731, 1930, 2065, 2196, 2335, 2445, 2520, 2672, 2722, 2789,
+            2965, 2971, 2977, 3014, 2959, 2868, 2986, 2929, 2713, 2761, 2561, 2444,
+            2460, 2332, 2063, 1938, 1747, 1659, 1478, 1359, 1024, 851, 707, 473,
+            279, 31, -115, -367, -512, -647, -991, -1074, -1311, -1449, -1671, -1874,
+            -2071, -2170, -2342, -2333, -2567, -2656, -2758, -2808, -2830, -2925, -2959, -2926,
+            -2906, -2928, -2946, -2788, -2748, -2710, -2569, -2637, -2401, -2326, -2153, -2022,
+            -1890, -1814, -1614, -1339, -1133, -955, -799, -636, -442, -166, -17, 189,
+            472, 623, 855, 964, 1216, 1311, 1570, 1750, 1949, 1988, 2140, 2375,
+            2474, 2495, 2635, 2721, 2830, 2894, 2964, 2949, 3027, 2948, 2982, 2943,
+            2958, 2903, 2766, 2669, 2580, 2453, 2327, 2276, 2087, 1941, 1789, 1564,
+            1346, 1238, 1064, 792, 625, 477, 149, 38, -137, -418, -580, -758,
+            -1044, -1128, -1387, -1635, -1674, -1968, -2037, -2159, -2387, -2521, -2655, -2703,
+            -2811, -2822, -2928, -2928, -3007, -2985, -2895, -3001, -3003, -2835, -2880, -2724,
+            -2632, -2632, -2472, -2269, -2282, -2109, -1866, -1766, -1580, -1441, -1221, -1073,
+            -794, -712, -536, -315, -85, 106, 371, 514, 686, 1006, 1215, 1336,
+            1512, 1695, 1881, 1987, 2177, 2239, 2365, 2506, 2651, 2674, 2704, 2847,
+            2819, 2938, 2900, 2902, 2952, 2954, 2775, 2820, 2714, 2704, 2582, 2482,
+            2393, 2250, 1972, 1956, 1799, 1550, 1355, 1169, 935, 783, 502, 362,
+            224, -115, -347, -418, -740, -901, -1103, -1336, -1400, -1624, -1755, -1895,
+            -2031, -2164, -2388, -2522, -2566, -2627, -2771, -2874, -2870, -2970, -2952, -3022,
+            -2961, -2894, -2881, -2854, -2841, -2735, -2606, -2520, -2444, -2206, -2098, -2011,
+            -1841, -1636, -1473, -1272, -1110, -955, -731, -507, -275, -70, 32, 251,
+            459, 693, 907, 1033, 1180, 1487, 1682, 1820, 2004, 2094, 2221, 2440,
+            2442, 2601, 2726, 2825, 2896, 2946, 2867, 2866, 2925, 2889, 2938, 2849,
+            2901, 2803, 2664, 2584, 2613, 2509, 2296, 2160, 1988, 1954, 1755, 1580,
+            1353, 1232, 913, 835, 572, 332, 157, -35, -284, -542, -669, -920,
+            -1111, -1318, -1405, -1645, -1773, -1956, -2144, -2271, -2428, -2473, -2659, -2763,
+            -2834, -2796, -2952, -2898, -2951, -3063, -3042, -3002, -3041, -2919, -2791, -2818,
+            -2782, -2615, -2497, -2378, -2218, -2115, -1885, -1795, -1647, -1392, -1271, -932,
+            -730, -625, -396, -181, -59, 137, 408, 543, 862, 1015, 1215, 1374,
+            1651, 1732, 1889, 2122, 2288, 2429, 2477, 2564, 2625, 2823, 2856, 2903,
+            2907, 2959, 2885, 2853, 2894, 2930, 2843, 2719, 2699, 2478, 2399, 2368,
+            2166, 1994, 1837, 1676, 1529, 1444, 1204, 1095, 802, 642, 428, 217,
+            30, -221, -480, -681, -857, -1054, -1173, -1454, -1608, -1677, -1940, -1973,
+            -2188, -2387, -2427, -2559, -2694, -2729, -2737, -2785, -2894, -2972, -2992, -2881,
+            -2978, -2942, -2872, -2778, -2812, -2612, -2615, -2485, -2435, -2239, -2050, -1951,
+            -1805, -1565, -1456, -1243, -1041, -921, -744, -509, -237, -90, 193, 290,
+            538, 736, 934, 1175, 1310, 1455, 1672, 1773, 1996, 2063, 2218, 2392,
+            2498, 2673, 2697, 2857, 2874, 2905, 2881, 3018, 2933, 2930, 3003, 2835,
+            2797, 2814, 2707, 2602, 2402, 2272, 2216, 2092, 1876, 1780, 1582, 1348,
+            1177, 1009, 847, 695, 401, 235, 90, -200, -286, -601, -847, -931,
+            -1121, -1386, -1469, -1634, -1955, -2076, -2145, -2381, -2407, -2566, -2683, -2745,
+            -2869, -2837, -2912, -2890, -2980, -3012, -2980, -2975, -2912, -2946, -2857, -2733,
+            -2664, -2591, -2419, -2263, -2160, -1971, -1824, -1632, -1480, -1226, -1061, -849,
+            -640, -339, -170, -5, 152, 456, 697, 776, 1003, 1283, 1370, 1619,
+            1782, 1940, 2181, 2322, 2365, 2550, 2561, 2689, 2828, 2782, 2910, 2993,
+            2952, 3022, 2938, 2929, 2929, 2969, 2832, 2694, 2697, 2502, 2415, 2362,
+            2215, 2110, 1853, 1750, 1512, 1436, 1245, 939, 873, 579, 464, 212,
+            -21, -196, -427, -541, -805, -978, -1260, -1356, -1538, -1797, -1993, -2137,
+            -2165, -2364, -2502, -2594, -2643, -2820, -2847, -2928, -3003, -3026, -3006, -3028,
+            -3039, -3003, -2822, -2762, -2739, -2745, -2644, -2540, -2393, -2213, -2000, -1916,
+            -1795, -1564, -1366, -1113, -959, -843, -657, -424, -202, 6, 287, 347,
+            591, 889, 984, 1186, 1423, 1605, 1704, 1977, 2053, 2202, 2372, 2424,
+            2511, 2670, 2747, 2882, 2865, 2885, 2943, 2935, 2883, 2881, 2967, 2936,
+            2858, 2654, 2623, 2488, 2380, 2270, 2232, 1935, 1817, 1726, 1467, 1277,
+            1127, 996, 776, 576, 300, 100, 3, -212, -390, -637, -888, -968,
+            -1254, -1377, -1644, -1753, -1914, -1992, -2247, -2251, -2391, -2457, -2627, -2748,
+            -2688, -2737, -2905, -2842, -2939, -2790, -2913, -2751, -2703, -2662, -2546, -2524,
+            -2428, -2316, -2225, -2076, -1905, -1823, -1586, -1351, -1300, -1165, -857, -725,
+            -513, -279, -172, 38, 349, 460, 738, 990, 1062, 1272, 1515, 1607,
+            1787, 2034, 2130, 2318, 2395, 2486, 2631, 2654, 2770, 2881, 2847, 2955,
+            2871, 2887, 2859, 2866, 2918, 2764, 2779, 2616, 2661, 2462, 2437, 2233,
+            2168, 1896, 1874, 1643, 1443, 1355, 1045, 916, 739, 508, 337, 47,
+            -123, -362, -460, -680, -962, -1009, -1233, -1411, -1639, -1887, -1911, -2035,
+            -2229, -2352, -2506, -2553, -2668, -2743, -2835, -2946, -2874, -2868, -2888, -2985,
+            -2877, -2931, -2899, -2756, -2717, -2568, -2579, -2468, -2321, -2231, -2035, -1853,
+            -1720, -1436, -1262, -1153, -858, -701, -484, -388, -152, 7, 313, 506,
+            665, 953, 1129, 1369, 1473, 1614, 1800, 1897, 2159, 2219, 2407, 2485,
+            2653, 2700, 2826, 2873, 2815, 2918, 2981, 3005, 2941, 2862, 2905, 2916,
+            2826, 2732, 2614, 2598, 2416, 2228, 2117, 2046, 1918, 1568, 1437, 1346,
+            1146, 848, 648, 477, 314, 102, -81, -420, -509, -865, -977, -1107,
+            -1458, -1584, -1736, -1995, -2117, -2291, -2437, -2559, -2655, -2775, -2774, -2804,
+            -2964, -2937, -2980, -3059, -3042, -3042, -3040, -2974, -2807, -2825, -2715, -2689,
+            -2447, -2347, -2219, -2029, -1985, -1822, -1586, -1475, -1165, -1082, -865, -681,
+            -367, -177, 33, 148, 406, 531, 824, 962, 1180, 1334, 1604, 1693,
+            1837, 2151, 2257, 2407, 2508, 2634, 2654, 2709, 2851, 2851, 2934, 3021,
+            2948, 3046, 2964, 2872, 2936, 2873, 2755, 2646, 2663, 2475, 2331, 2283,
+            2110, 1902, 1676, 1509, 1450, 1173, 927, 817, 573, 444, 118, 67,
+            -195, -467, -661, -771, -1092, -1231, -1388, -1618, -1757, -1940, -2063, -2129,
+            -2338, -2502, -2601, -2719, -2758, -2885, -2827, -2896, -2935, -2949, -2983, -2912,
+            -2883, -2916, -2815, -2788, -2672, -2555, -2463, -2421, -2167, -1991, -1970, -1761,
+            -1662, -1371, -1171, -1006, -820, -560, -343, -145, -36, 167, 379, 680,
+            830, 976, 1126, 1426, 1635, 1659, 1837, 2105, 2120, 2296, 2509, 2564,
+            2642, 2768, 2867, 2841, 2914, 2928, 3032, 3042, 2862, 2871, 2813, 2873,
+            2786, 2715, 2545, 2414, 2327, 2242, 2090, 1899, 1707, 1583, 1310, 1184,
+            1011, 811, 512, 291, 89, -113, -322, -536, -736, -890, -1155, -1243,
+            -1509, -1730, -1851, -1997, -2175, -2255, -2483, -2604, -2657, -2785, -2835, -2819,
+            -3022, -2920, -2901, -3005, -3012, -3019, -2974, -2796, -2888, -2655, -2613, -2483,
+            -2444, -2344, -2194, -2081, -1854, -1608, -1492, -1320, -1110, -934, -811, -567,
+            -351, -143, -24, 220, 407, 695, 787, 982, 1325, 1474, 1513, 1752,
+            1914, 2021, 2153, 2356, 2447, 2587, 2753, 2693, 2759, 2910, 2833, 2926,
+            3023, 2986, 2899, 2918, 2795, 2713, 2736, 2669, 2441, 2410, 2223, 2099,
+            2044, 1765, 1637, 1540, 1334, 1050, 856, 653, 574, 332, 39, -182,
+            -236, -488, -633, -907, -1072, -1283, -1484, -1590, -1825, -1988, -2104, -2257,
+            -2371, -2539, -2598, -2728, -2794, -2858, -2915, -2910, -2987, -3037, -2930, -2865,
+            -2832, -2801, -2813, -2721, -2650, -2589, -2459, -2230, -2184, -1966, -1855, -1658,
+            -1477, -1297, -1114, -1005, -711, -548, -256, -158, 85, 373, 588, 702,
+            993, 1209, 1313, 1573, 1601, 1932, 2006, 2185, 2357, 2400, 2616, 2561,
+            2736, 2836, 2886, 2970, 2940, 2922, 2963, 2945, 2924, 2896, 2750, 2672,
+            2609, 2497, 2425, 2379, 2221, 2137, 1912, 1833, 1527, 1350, 1284, 1080,
+            876, 586, 483, 197, 106, -124, -316, -569, -732, -1056, -1077, -1328,
+            -1532, -1667, -1856, -2017, -2199, -2242, -2344, -2466, -2657, -2755, -2804, -2874,
+            -2803, -2929, -2840, -2886, -2926, -2898, -2766, -2797, -2634, -2599, -2451, -2372,
+            -2259, -2138, -1958, -1799, -1669, -1496, -1327, -1233, -1089, -804, -640, -410,
+            -261, -16, 136, 408, 518, 795, 910, 1154, 1346, 1528, 1725, 1918,
+            1940, 2082, 2299, 2352, 2552, 2584, 2752, 2720, 2861, 2892, 2886, 2875,
+            2975, 2885, 2846, 2797, 2873, 2852, 2771, 2639, 2549, 2341, 2310, 2168,
+            2024, 1776, 1669, 1422, 1257, 1028, 897, 697, 401, 250, 136, -204,
+            -307, -480, -818, -901, -1132, -1429, -1494, -1672, -1830, -2011, -2125, -2391,
+            -2340, -2596, -2654, -2638, -2792, -2891, -2848, -2869, -3006, -2896, -2935, -2950,
+            -2831, -2745, -2761, -2687, -2581, -2497, -2273, -2175, -2097, -1844, -1631, -1537,
+            -1302, -1235, -911, -700, -632, -462, -221, 33, 170, 402, 624, 872,
+            1016, 1157, 1353, 1548, 1789, 1900, 2020, 2264, 2347, 2400, 2551, 2769,
+            2709, 2897, 2981, 2856, 3014, 2974, 2996, 2946, 2878, 2848, 2910, 2834,
+            2589, 2578, 2549, 2296, 2130, 2062, 1954, 1756, 1570, 1299, 1126, 1043,
+            829, 525, 444, 139, -113, -247, -460, -623, -875, -1133, -1286, -1417,
+            -1547, -1732, -1967, -2128, -2146, -2327, -2475, -2567, -2686, -2695, -2771, -2811,
+            -2822, -2881, -2907, -2926, -2946, -2848, -2828, -2777, -2772, -2668, -2482, -2454,
+            -2379, -2245, -1953, -1926, -1727, -1473, -1315, -1084, -947, -828, -491, -368,
+            -77, 13, 339, 427, 602, 906, 1015, 1336, 1407, 1580, 1781, 1955,
+            2126, 2248, 2311, 2477, 2612, 2661, 2811, 2915, 2929, 3038, 3049, 2921,
+            2935, 2914, 2960, 2920, 2785, 2687, 2632, 2522, 2416, 2265, 2160, 1977,
+            1926, 1688, 1580, 1414, 1243, 1024, 881, 688, 334, 259, 7, -225,
+            -335, -649, -870, -971, -1259, -1487, -1577, -1801, -1948, -2083, -2331, -2435,
+            -2582, -2697, -2722, -2823, -2911, -2902, -3004, -3015, -2988, -2976, -2975, -2952,
+            -2805, -2758, -2651, -2658, -2445, -2405, -2277, -2160, -1965, -1823, -1582, -1400,
+            -1171, -1086, -894, -615, -402, -175, -47, 110, 406, 635, 810, 932,
+            1204, 1309, 1608, 1698, 1899, 1971, 2224, 2313, 2457, 2543, 2658, 2688,
+            2825, 2855, 2960, 3027, 2977, 3011, 3007, 3032, 3012, 2956, 2733, 2805,
+            2574, 2599, 2390, 2243, 2108, 1932, 1775, 1636, 1412, 1313, 992, 858,
+            687, 401, 252, -39, -245, -435, -527, -751, -1008, -1186, -1471, -1629,
+            -1793, -1980, -2065, -2247, -2397, -2579, -2599, -2667, -2855, -2943, -2935, -2993,
+            -3074, -2988, -3076, -2997, -2898, -2937, -2916, -2845, -2751, -2573, -2464, -2414,
+            -2292, -2070, -2016, -1882, -1616, -1496, -1309, -1029, -926, -729, -500, -279,
+            -84, 65, 357, 524, 690, 971, 1093, 1281, 1593, 1753, 1807, 1968,
+            2213, 2360, 2470, 2486, 2576, 2789, 2798, 2832, 2982, 2866, 2917, 3011,
+            2936, 2935, 2896, 2743, 2828, 2702, 2662, 2461, 2405, 2161, 2013, 1996,
+            1724, 1586, 1463, 1219, 972, 752, 569, 401, 163, -51, -136, -376,
+            -591, -833, -944, -1215, -1379, -1648, -1806, -1910, -1995, -2206, -2263, -2489,
+            -2540, -2594, -2740, -2756, -2798, -2896, -2974, -3038, -2967, -2909, -2982, -2859,
+            -2851, -2754, -2596, -2497, -2449, -2256, -2218, -2014, -1796, -1699, -1483, -1274,
+            -1166, -999, -773, -537, -354, -66, 81, 201, 483, 753, 943, 1116,
+            1226, 1470, 1640, 1888, 1980, 2148, 2349, 2437, 2518, 2673, 2675, 2865,
+            2822, 2948, 3006, 3008, 3012, 3085, 3003, 2938, 2944, 2823, 2721, 2722,
+            2602, 2440, 2348, 2235, 2144, 1895, 1716, 1612, 1393, 1225, 958, 782,
+            672, 397, 101, 5, -301, -469, -713, -811, -1128, -1339, -1409, -1706,
+            -1814, -2044, -2163, -2264, -2420, -2580, -2555, -2802,
+    };
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_NS_EXACT_MATH_REFERENCE_OUTPUT_H_
@@ -12,9 +12,20 @@
 
 #include <math.h>
 #include <stdint.h>
+#include <string.h>
+#include <algorithm>
 
+#include "arch.h"
 #include "checks.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define WEBRTC_FAST_MATH_SSE2
+#include <emmintrin.h>
+#elif defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace webrtc {
 
     namespace {
@@ -36,16 +47,150 @@ namespace webrtc {
             return out;
         }
 
+        // Coefficients of the polynomial approximating 2^f for f in [-0.5, 0.5]
+        // (Cephes exp2f), evaluated with Horner's scheme. The highest order
+        // coefficient comes first.
+        constexpr float kPow2Coefficients[] = {
+                1.535336188319500e-4f, 1.339887440266574e-3f, 9.618437357674640e-3f,
+                5.550332471162809e-2f, 2.402264791363012e-1f, 6.931472028550421e-1f};
+
+        // Limits of the argument of Pow2Approximation, chosen such that the result
+        // is a normal float.
+        constexpr float kPow2MinArgument = -126.f;
+        constexpr float kPow2MaxArgument = 127.f;
+
+        // log2(10) as computed by FastLog2f, which together with log10(e) forms the
+        // base conversion used by ExpApproximation.
+        constexpr float kFastLog2Of10 = 1092616192.f * 1.1920929e-7f - 126.942695f;
+        constexpr float kLog10Ofe = 0.4342944819f;
+
+        // Computes 2^p as 2^n * 2^f, with n being p rounded to the nearest integer
+        // and 2^f being evaluated by a polynomial. The rounding is done by
+        // truncation of the positive value p + 127.5, which directly yields the
+        // biased exponent of 2^n. The vectorized versions below perform the same
+        // operations in the same order, which makes their results bit-exact to
+        // this function.
+        float Pow2Polynomial(float p) {
+            p = p < kPow2MinArgument ? kPow2MinArgument : p;
+            p = p > kPow2MaxArgument ? kPow2MaxArgument : p;
+            const int32_t biased_exponent = static_cast<int32_t>(p + 127.5f);
+            const float f = p - static_cast<float>(biased_exponent - 127);
+
+            float y = kPow2Coefficients[0];
+            for (size_t k = 1; k < 6; ++k) {
+                y = y * f + kPow2Coefficients[k];
+            }
+            y = y * f + 1.f;
+
+            const uint32_t scale_bits = static_cast<uint32_t>(biased_exponent) << 23;
+            float scale;
+            memcpy(&scale, &scale_bits, sizeof(scale));
+            return y * scale;
+        }
+
+#if defined(WEBRTC_FAST_MATH_SSE2)
+        __m128 FastLog2Sse2(__m128 x) {
+            // The sign bit of the positive input is zero, so the signed conversion
+            // gives the same result as the unsigned one in FastLog2f.
+            __m128 out = _mm_cvtepi32_ps(_mm_castps_si128(x));
+            out = _mm_mul_ps(out, _mm_set1_ps(1.1920929e-7f));
+            return _mm_sub_ps(out, _mm_set1_ps(126.942695f));
+        }
+
+        __m128 Pow2Sse2(__m128 p) {
+            p = _mm_max_ps(p, _mm_set1_ps(kPow2MinArgument));
+            p = _mm_min_ps(p, _mm_set1_ps(kPow2MaxArgument));
+            const __m128i biased_exponent =
+                    _mm_cvttps_epi32(_mm_add_ps(p, _mm_set1_ps(127.5f)));
+            const __m128 f = _mm_sub_ps(
+                    p, _mm_cvtepi32_ps(
+                            _mm_sub_epi32(biased_exponent, _mm_set1_epi32(127))));
+
+            __m128 y = _mm_set1_ps(kPow2Coefficients[0]);
+            for (size_t k = 1; k < 6; ++k) {
+                y = _mm_add_ps(_mm_mul_ps(y, f), _mm_set1_ps(kPow2Coefficients[k]));
+            }
+            y = _mm_add_ps(_mm_mul_ps(y, f), _mm_set1_ps(1.f));
+
+            const __m128 scale = _mm_castsi128_ps(_mm_slli_epi32(biased_exponent, 23));
+            return _mm_mul_ps(y, scale);
+        }
+
+        __m128 ExpSse2(__m128 x) {
+            const __m128 p = _mm_mul_ps(x, _mm_set1_ps(kLog10Ofe));
+            return Pow2Sse2(_mm_mul_ps(p, _mm_set1_ps(kFastLog2Of10)));
+        }
+#elif defined(WEBRTC_HAS_NEON)
+        float32x4_t FastLog2Neon(float32x4_t x) {
+            float32x4_t out = vcvtq_f32_u32(vreinterpretq_u32_f32(x));
+            out = vmulq_f32(out, vdupq_n_f32(1.1920929e-7f));
+            return vsubq_f32(out, vdupq_n_f32(126.942695f));
+        }
+
+        float32x4_t Pow2Neon(float32x4_t p) {
+            p = vmaxq_f32(p, vdupq_n_f32(kPow2MinArgument));
+            p = vminq_f32(p, vdupq_n_f32(kPow2MaxArgument));
+            const int32x4_t biased_exponent =
+                    vcvtq_s32_f32(vaddq_f32(p, vdupq_n_f32(127.5f)));
+            const float32x4_t f = vsubq_f32(
+                    p, vcvtq_f32_s32(vsubq_s32(biased_exponent, vdupq_n_s32(127))));
+
+            // Separate multiplies and adds are used to match the rounding of the
+            // scalar version.
+            float32x4_t y = vdupq_n_f32(kPow2Coefficients[0]);
+            for (size_t k = 1; k < 6; ++k) {
+                y = vaddq_f32(vmulq_f32(y, f), vdupq_n_f32(kPow2Coefficients[k]));
+            }
+            y = vaddq_f32(vmulq_f32(y, f), vdupq_n_f32(1.f));
+
+            const float32x4_t scale =
+                    vreinterpretq_f32_s32(vshlq_n_s32(biased_exponent, 23));
+            return vmulq_f32(y, scale);
+        }
+
+        float32x4_t ExpNeon(float32x4_t x) {
+            const float32x4_t p = vmulq_f32(x, vdupq_n_f32(kLog10Ofe));
+            return Pow2Neon(vmulq_f32(p, vdupq_n_f32(kFastLog2Of10)));
+        }
+#endif
+
+        // The rational tanh approximations are monotonic until they reach 1, so
+        // the arguments are clamped to the point where that happens. This also
+        // avoids overflow for large arguments.
+        float TanhOrder3(float x) {
+            constexpr float kMaxArgument = 2.3230f;
+            x = std::max(std::min(x, kMaxArgument), -kMaxArgument);
+            const float x2 = x * x;
+            return x * (15.f + x2) / (15.f + 6.f * x2);
+        }
+
+        float TanhOrder5(float x) {
+            constexpr float kMaxArgument = 3.6469f;
+            x = std::max(std::min(x, kMaxArgument), -kMaxArgument);
+            const float x2 = x * x;
+            return x * (945.f + x2 * (105.f + x2)) /
+                   (945.f + x2 * (420.f + x2 * 15.f));
+        }
+
+        float TanhOrder7(float x) {
+            constexpr float kMaxArgument = 4.9718f;
+            x = std::max(std::min(x, kMaxArgument), -kMaxArgument);
+            const float x2 = x * x;
+            return x * (135135.f + x2 * (17325.f + x2 * (378.f + x2))) /
+                   (135135.f + x2 * (62370.f + x2 * (3150.f + x2 * 28.f)));
+        }
+
     }  // namespace
 
     float SqrtFastApproximation(float f) {
-        // TODO(peah): Add fast approximate implementation.
+        // sqrtf maps to a single hardware instruction on the supported
+        // platforms, which is both faster and more accurate than a bit-level
+        // approximation.
         return sqrtf(f);
     }
 
     float Pow2Approximation(float p) {
-        // TODO(peah): Add fast approximate implementation.
-        return powf(2.f, p);
+        return Pow2Polynomial(p);
     }
 
     float PowApproximation(float x, float p) {
@@ -58,27 +203,82 @@ namespace webrtc {
     }
 
     void LogApproximation(rtc::ArrayView<const float> x, rtc::ArrayView<float> y) {
-        for (size_t k = 0; k < x.size(); ++k) {
+        RTC_DCHECK_EQ(x.size(), y.size());
+        size_t k = 0;
+#if defined(WEBRTC_FAST_MATH_SSE2)
+        const __m128 kLogOf2 = _mm_set1_ps(0.69314718056f);
+        for (; k + 4 <= x.size(); k += 4) {
+            const __m128 x_k = _mm_loadu_ps(&x[k]);
+            _mm_storeu_ps(&y[k], _mm_mul_ps(FastLog2Sse2(x_k), kLogOf2));
+        }
+#elif defined(WEBRTC_HAS_NEON)
+        const float32x4_t kLogOf2 = vdupq_n_f32(0.69314718056f);
+        for (; k + 4 <= x.size(); k += 4) {
+            const float32x4_t x_k = vld1q_f32(&x[k]);
+            vst1q_f32(&y[k], vmulq_f32(FastLog2Neon(x_k), kLogOf2));
+        }
+#endif
+        for (; k < x.size(); ++k) {
             y[k] = LogApproximation(x[k]);
         }
     }
 
     float ExpApproximation(float x) {
-        constexpr float kLog10Ofe = 0.4342944819f;
-        return PowApproximation(10.f, x * kLog10Ofe);
+        return Pow2Approximation(x * kLog10Ofe * kFastLog2Of10);
     }
 
     void ExpApproximation(rtc::ArrayView<const float> x, rtc::ArrayView<float> y) {
-        for (size_t k = 0; k < x.size(); ++k) {
+        RTC_DCHECK_EQ(x.size(), y.size());
+        size_t k = 0;
+#if defined(WEBRTC_FAST_MATH_SSE2)
+        for (; k + 4 <= x.size(); k += 4) {
+            _mm_storeu_ps(&y[k], ExpSse2(_mm_loadu_ps(&x[k])));
+        }
+#elif defined(WEBRTC_HAS_NEON)
+        for (; k + 4 <= x.size(); k += 4) {
+            vst1q_f32(&y[k], ExpNeon(vld1q_f32(&x[k])));
+        }
+#endif
+        for (; k < x.size(); ++k) {
             y[k] = ExpApproximation(x[k]);
         }
     }
 
     void ExpApproximationSignFlip(rtc::ArrayView<const float> x,
                                   rtc::ArrayView<float> y) {
-        for (size_t k = 0; k < x.size(); ++k) {
+        RTC_DCHECK_EQ(x.size(), y.size());
+        size_t k = 0;
+#if defined(WEBRTC_FAST_MATH_SSE2)
+        const __m128 kSignBit = _mm_set1_ps(-0.f);
+        for (; k + 4 <= x.size(); k += 4) {
+            const __m128 x_k = _mm_xor_ps(_mm_loadu_ps(&x[k]), kSignBit);
+            _mm_storeu_ps(&y[k], ExpSse2(x_k));
+        }
+#elif defined(WEBRTC_HAS_NEON)
+        for (; k + 4 <= x.size(); k += 4) {
+            vst1q_f32(&y[k], ExpNeon(vnegq_f32(vld1q_f32(&x[k]))));
+        }
+#endif
+        for (; k < x.size(); ++k) {
             y[k] = ExpApproximation(-x[k]);
         }
     }
 
+    float TanhApproximation(float x, TanhAccuracy accuracy) {
+        float y;
+        switch (accuracy) {
+            case TanhAccuracy::kLow:
+                y = TanhOrder3(x);
+                break;
+            case TanhAccuracy::kMedium:
+                y = TanhOrder5(x);
+                break;
+            case TanhAccuracy::kHigh:
+            default:
+                y = TanhOrder7(x);
+                break;
+        }
+        return std::max(std::min(y, 1.f), -1.f);
+    }
+
 }  // namespace webrtc
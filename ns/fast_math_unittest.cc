@@ -0,0 +1,171 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "fast_math.h"
+
+#include <math.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace webrtc {
+    namespace {
+
+// The error bounds stated in fast_math.h. The bound of Pow2Approximation is
+// the max over all float arguments in [-126, 127], of which the test samples a
+// subset.
+        constexpr double kLogTolerance = 0.04;
+        constexpr double kPow2Tolerance = 1.04e-7;
+        constexpr double kExpTolerance = 1.6e-7;
+        constexpr double kExpToleranceUpTo87 = 7.1e-6;
+
+// The base conversion of ExpApproximation, log(10) log10(e) with the float
+// approximation of log2(10) of LogApproximation, so that the exact result is
+// e^(kExpScale x).
+        const double kExpScale =
+                log(2.) * static_cast<double>(0.4342944819f) *
+                static_cast<double>(1092616192.f * 1.1920929e-7f - 126.942695f);
+
+        // Returns the SNR in dB of |x| relative to |reference|.
+        double ComputeSnr(const std::vector<double> &reference,
+                          const std::vector<float> &x) {
+            double signal = 0.;
+            double error = 0.;
+            for (size_t k = 0; k < x.size(); ++k) {
+                signal += reference[k] * reference[k];
+                error += (x[k] - reference[k]) * (x[k] - reference[k]);
+            }
+            return 10. * log10(signal / error);
+        }
+
+        // Returns |size| values uniformly distributed in [min_value, max_value].
+        std::vector<float> GenerateValues(size_t size, float min_value,
+                                          float max_value) {
+            std::vector<float> x(size);
+            uint32_t seed = 1;
+            for (float &v : x) {
+                seed = seed * 1664525u + 1013904223u;
+                v = min_value + (max_value - min_value) * (seed >> 8) / 16777215.f;
+            }
+            return x;
+        }
+
+    }  // namespace
+
+    TEST(FastMathTest, Pow2Approximation) {
+        double max_error = 0.;
+        for (float p = -126.f; p <= 127.f; p += 1.f / 1024.f) {
+            const double exact = exp2(static_cast<double>(p));
+            max_error = std::max(max_error, fabs(Pow2Approximation(p) - exact) / exact);
+        }
+        EXPECT_LE(max_error, kPow2Tolerance);
+
+        // Arguments outside the range are clamped.
+        EXPECT_EQ(Pow2Approximation(-126.f), Pow2Approximation(-1000.f));
+        EXPECT_EQ(Pow2Approximation(127.f), Pow2Approximation(1000.f));
+    }
+
+    TEST(FastMathTest, LogApproximation) {
+        const std::vector<float> x = GenerateValues(1000, 1e-3f, 1e5f);
+        std::vector<float> y(x.size());
+        LogApproximation(x, y);
+        for (size_t k = 0; k < x.size(); ++k) {
+            // The vectorized version is bit-exact to the scalar one.
+            ASSERT_EQ(LogApproximation(x[k]), y[k]);
+        }
+
+        double max_error = 0.;
+        for (float v = 1e-30f; v < 1e30f; v *= 1.001f) {
+            max_error = std::max(max_error, fabs(LogApproximation(v) - log(static_cast<double>(v))));
+        }
+        EXPECT_LE(max_error, kLogTolerance);
+    }
+
+    TEST(FastMathTest, ExpApproximation) {
+        const std::vector<float> x = GenerateValues(1001, -87.f, 87.f);
+        std::vector<float> y(x.size());
+        std::vector<float> y_sign_flip(x.size());
+        ExpApproximation(x, y);
+        ExpApproximationSignFlip(x, y_sign_flip);
+        for (size_t k = 0; k < x.size(); ++k) {
+            // The vectorized versions are bit-exact to the scalar one.
+            ASSERT_EQ(ExpApproximation(x[k]), y[k]);
+            ASSERT_EQ(ExpApproximation(-x[k]), y_sign_flip[k]);
+        }
+
+        double max_error = 0.;
+        double max_error_up_to_87 = 0.;
+        for (float v = -87.f; v <= 87.f; v += 1.f / 1024.f) {
+            const double exact = exp(kExpScale * v);
+            const double error = fabs(ExpApproximation(v) - exact) / exact;
+            max_error_up_to_87 = std::max(max_error_up_to_87, error);
+            if (fabs(v) <= 1.f) {
+                max_error = std::max(max_error, error);
+            }
+        }
+        EXPECT_LE(max_error, kExpTolerance);
+        EXPECT_LE(max_error_up_to_87, kExpToleranceUpTo87);
+    }
+
+// Verifies the SNR of the array versions against exact math over the ranges of
+// the arguments in the suppressor: the log of spectral magnitudes and the
+// exponentials of the LRT and the sigmoid of the speech probability.
+    TEST(FastMathTest, SnrToExactMath) {
+        const std::vector<float> magnitudes = GenerateValues(129, 1e-3f, 1e5f);
+        std::vector<float> log_magnitudes(magnitudes.size());
+        LogApproximation(magnitudes, log_magnitudes);
+        std::vector<double> exact_log_magnitudes(magnitudes.size());
+        for (size_t k = 0; k < magnitudes.size(); ++k) {
+            exact_log_magnitudes[k] = log(static_cast<double>(magnitudes[k]));
+        }
+        EXPECT_GE(ComputeSnr(exact_log_magnitudes, log_magnitudes), 55.);
+
+        const std::vector<float> arguments = GenerateValues(129, -20.f, 20.f);
+        std::vector<float> exponentials(arguments.size());
+        ExpApproximation(arguments, exponentials);
+        std::vector<double> exact_exponentials(arguments.size());
+        for (size_t k = 0; k < arguments.size(); ++k) {
+            exact_exponentials[k] = exp(kExpScale * arguments[k]);
+        }
+        EXPECT_GE(ComputeSnr(exact_exponentials, exponentials), 120.);
+    }
+
+// Verifies the max absolute error of each accuracy level stated in
+// fast_math.h, and that the approximations are odd, monotonic and bounded by 1.
+    TEST(FastMathTest, TanhApproximation) {
+        const struct {
+            TanhAccuracy accuracy;
+            double tolerance;
+        } kLevels[] = {{TanhAccuracy::kLow, 2e-2},
+                       {TanhAccuracy::kMedium, 1.4e-3},
+                       {TanhAccuracy::kHigh, 1e-4}};
+        for (const auto &level : kLevels) {
+            SCOPED_TRACE(static_cast<int>(level.accuracy));
+            double max_error = 0.;
+            float previous = -1.f;
+            for (float x = -20.f; x <= 20.f; x += 1.f / 1024.f) {
+                const float y = TanhApproximation(x, level.accuracy);
+                max_error = std::max(max_error,
+                                     fabs(y - tanh(static_cast<double>(x))));
+                ASSERT_EQ(-y, TanhApproximation(-x, level.accuracy));
+                ASSERT_GE(y, previous);
+                ASSERT_LE(fabsf(y), 1.f);
+                previous = y;
+            }
+            EXPECT_LE(max_error, level.tolerance);
+        }
+        EXPECT_EQ(1.f, TanhApproximation(1e30f));
+        EXPECT_EQ(-1.f, TanhApproximation(-1e30f));
+    }
+
+}  // namespace webrtc
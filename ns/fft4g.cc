@@ -8,6 +8,8 @@
  *
  * Changes:
  * Trivial type modifications by the WebRTC authors.
+ * rdft split into the table initialization and a transform that only reads
+ * the table, by the WebRTC authors.
  */
 
 /*
@@ -301,17 +303,17 @@ namespace webrtc {
 
         void bitrv2(size_t n, size_t *ip, float *a);
 
-        void cftfsub(size_t n, float *a, float *w);
+        void cftfsub(size_t n, float *a, const float *w);
 
-        void cftbsub(size_t n, float *a, float *w);
+        void cftbsub(size_t n, float *a, const float *w);
 
-        void cft1st(size_t n, float *a, float *w);
+        void cft1st(size_t n, float *a, const float *w);
 
-        void cftmdl(size_t n, size_t l, float *a, float *w);
+        void cftmdl(size_t n, size_t l, float *a, const float *w);
 
-        void rftfsub(size_t n, float *a, size_t nc, float *c);
+        void rftfsub(size_t n, float *a, size_t nc, const float *c);
 
-        void rftbsub(size_t n, float *a, size_t nc, float *c);
+        void rftbsub(size_t n, float *a, size_t nc, const float *c);
 
 /* -------- initializing routines -------- */
 
@@ -459,7 +461,7 @@ namespace webrtc {
             }
         }
 
-        void cftfsub(size_t n, float *a, float *w) {
+        void cftfsub(size_t n, float *a, const float *w) {
             size_t j, j1, j2, j3, l;
             float x0r, x0i, x1r, x1i, x2r, x2i, x3r, x3i;
 
@@ -507,7 +509,7 @@ namespace webrtc {
             }
         }
 
-        void cftbsub(size_t n, float *a, float *w) {
+        void cftbsub(size_t n, float *a, const float *w) {
             size_t j, j1, j2, j3, l;
             float x0r, x0i, x1r, x1i, x2r, x2i, x3r, x3i;
 
@@ -555,7 +557,7 @@ namespace webrtc {
             }
         }
 
-        void cft1st(size_t n, float *a, float *w) {
+        void cft1st(size_t n, float *a, const float *w) {
             size_t j, k1, k2;
             float wk1r, wk1i, wk2r, wk2i, wk3r, wk3i;
             float x0r, x0i, x1r, x1i, x2r, x2i, x3r, x3i;
@@ -658,7 +660,7 @@ namespace webrtc {
             }
         }
 
-        void cftmdl(size_t n, size_t l, float *a, float *w) {
+        void cftmdl(size_t n, size_t l, float *a, const float *w) {
             size_t j, j1, j2, j3, k, k1, k2, m, m2;
             float wk1r, wk1i, wk2r, wk2i, wk3r, wk3i;
             float x0r, x0i, x1r, x1i, x2r, x2i, x3r, x3i;
@@ -783,7 +785,7 @@ namespace webrtc {
             }
         }
 
-        void rftfsub(size_t n, float *a, size_t nc, float *c) {
+        void rftfsub(size_t n, float *a, size_t nc, const float *c) {
             size_t j, k, kk, ks, m;
             float wkr, wki, xr, xi, yr, yi;
 
@@ -806,7 +808,7 @@ namespace webrtc {
             }
         }
 
-        void rftbsub(size_t n, float *a, size_t nc, float *c) {
+        void rftbsub(size_t n, float *a, size_t nc, const float *c) {
             size_t j, k, kk, ks, m;
             float wkr, wki, xr, xi, yr, yi;
 
@@ -834,8 +836,12 @@ namespace webrtc {
     }  // namespace
 
     void WebRtc_rdft(size_t n, int isgn, float *a, size_t *ip, float *w) {
+        WebRtc_rdft_init(n, ip, w);
+        WebRtc_rdft_transform(n, isgn, a, ip, w);
+    }
+
+    void WebRtc_rdft_init(size_t n, size_t *ip, float *w) {
         size_t nw, nc;
-        float xi;
 
         nw = ip[0];
         if (n > (nw << 2)) {
@@ -847,6 +853,15 @@ namespace webrtc {
             nc = n >> 2;
             makect(nc, ip, w + nw);
         }
+    }
+
+    void WebRtc_rdft_transform(size_t n, int isgn, float *a, size_t *ip,
+                               const float *w) {
+        size_t nw, nc;
+        float xi;
+
+        nw = ip[0];
+        nc = ip[1];
         if (isgn >= 0) {
             if (n > 4) {
                 bitrv2(n, ip + 2, a);
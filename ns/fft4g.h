@@ -16,6 +16,15 @@ namespace webrtc {
 // Refer to fft4g.c for documentation.
     void WebRtc_rdft(size_t n, int isgn, float *a, size_t *ip, float *w);
 
+// The two halves of WebRtc_rdft: WebRtc_rdft_init builds the cos/sin table in
+// |w| and sets its sizes in ip[0] and ip[1], unless they already cover |n|.
+// WebRtc_rdft_transform then runs the transform and only reads |w|, so that one
+// table can be shared by concurrent transforms, each with its own |ip|.
+    void WebRtc_rdft_init(size_t n, size_t *ip, float *w);
+
+    void WebRtc_rdft_transform(size_t n, int isgn, float *a, size_t *ip,
+                               const float *w);
+
 }  // namespace webrtc
 
 #endif  // COMMON_AUDIO_THIRD_PARTY_OOURA_FFT_SIZE_256_FFT4G_H_
@@ -10,6 +10,8 @@
 
 #include "histograms.h"
 
+#include "checks.h"
+
 namespace webrtc {
 
     Histograms::Histograms() {
@@ -22,7 +24,7 @@ namespace webrtc {
         spectral_diff_.fill(0);
     }
 
-    void Histograms::Update(const SignalModel &features_) {
+    void Histograms::Update(const SignalFeatures &features_) {
         // Update the histogram for the LRT.
         constexpr float kOneByBinSizeLrt = 1.f / kBinSizeLrt;
         if (features_.lrt < kHistogramSize * kBinSizeLrt && features_.lrt >= 0.f) {
@@ -44,4 +46,37 @@ namespace webrtc {
         }
     }
 
+    namespace {
+
+        void SaveHistogram(const std::array<uint16_t, kHistogramSize> &histogram,
+                           NsStateWriter *writer) {
+            for (uint16_t count : histogram) {
+                writer->Write(count);
+            }
+        }
+
+        bool LoadHistogram(NsStateReader *reader,
+                           std::array<uint16_t, kHistogramSize> *histogram) {
+            for (uint16_t &count : *histogram) {
+                if (!reader->Read(&count)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+    }  // namespace
+
+    void Histograms::SaveState(NsStateWriter *writer) const {
+        SaveHistogram(lrt_, writer);
+        SaveHistogram(spectral_flatness_, writer);
+        SaveHistogram(spectral_diff_, writer);
+    }
+
+    bool Histograms::LoadState(NsStateReader *reader) {
+        return LoadHistogram(reader, &lrt_) &&
+               LoadHistogram(reader, &spectral_flatness_) &&
+               LoadHistogram(reader, &spectral_diff_);
+    }
+
 }  // namespace webrtc
@@ -11,10 +11,13 @@
 #ifndef MODULES_AUDIO_PROCESSING_NS_HISTOGRAMS_H_
 #define MODULES_AUDIO_PROCESSING_NS_HISTOGRAMS_H_
 
+#include <stdint.h>
+
 #include <array>
 
 #include "array_view.h"
 #include "ns_common.h"
+#include "ns_state.h"
 #include "signal_model.h"
 
 namespace webrtc {
@@ -35,23 +38,41 @@ namespace webrtc {
 
         // Extracts thresholds for feature parameters and updates the corresponding
         // histogram.
-        void Update(const SignalModel &features_);
+        void Update(const SignalFeatures &features_);
 
         // Methods for accessing the histograms.
-        rtc::ArrayView<const int, kHistogramSize> get_lrt() const { return lrt_; }
+        rtc::ArrayView<const uint16_t, kHistogramSize> get_lrt() const { return lrt_; }
 
-        rtc::ArrayView<const int, kHistogramSize> get_spectral_flatness() const {
+        rtc::ArrayView<const uint16_t, kHistogramSize> get_spectral_flatness() const {
             return spectral_flatness_;
         }
 
-        rtc::ArrayView<const int, kHistogramSize> get_spectral_diff() const {
+        rtc::ArrayView<const uint16_t, kHistogramSize> get_spectral_diff() const {
             return spectral_diff_;
         }
 
+        // Appends the adaptive state to |writer|.
+        void SaveState(NsStateWriter *writer) const;
+
+        // Restores a state appended by SaveState(). Returns false if |reader| runs
+        // out of data.
+        bool LoadState(NsStateReader *reader);
+
+        // The largest count of a histogram bin.
+        static constexpr int kMaxCount = UINT16_MAX;
+
+        // The number of bytes appended by SaveState().
+        static constexpr size_t StateSize() {
+            return sizeof(lrt_) + sizeof(spectral_flatness_) + sizeof(spectral_diff_);
+        }
+
     private:
-        std::array<int, kHistogramSize> lrt_{};
-        std::array<int, kHistogramSize> spectral_flatness_{};
-        std::array<int, kHistogramSize> spectral_diff_{};
+        // The histograms are cleared every feature update window, so the counts
+        // fit in 16 bits as long as the windows are at most kMaxCount frames,
+        // which BasicSignalModelEstimator asserts.
+        std::array<uint16_t, kHistogramSize> lrt_{};
+        std::array<uint16_t, kHistogramSize> spectral_flatness_{};
+        std::array<uint16_t, kHistogramSize> spectral_diff_{};
     };
 
 }  // namespace webrtc
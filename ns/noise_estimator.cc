@@ -20,7 +20,7 @@ namespace webrtc {
     namespace {
 
 // Log(i).
-        constexpr std::array<float, 129> log_table = {
+        constexpr std::array<float, 257> log_table = {
                 0.f, 0.f, 0.f, 0.f, 0.f, 1.609438f, 1.791759f,
                 1.945910f, 2.079442f, 2.197225f, 2.302585f, 2.397895f, 2.484907f, 2.564949f,
                 2.639057f, 2.708050f, 2.772589f, 2.833213f, 2.890372f, 2.944439f, 2.995732f,
@@ -39,11 +39,31 @@ namespace webrtc {
                 4.653960f, 4.663439f, 4.672829f, 4.682131f, 4.691348f, 4.700480f, 4.709530f,
                 4.718499f, 4.727388f, 4.736198f, 4.744932f, 4.753591f, 4.762174f, 4.770685f,
                 4.779124f, 4.787492f, 4.795791f, 4.804021f, 4.812184f, 4.820282f, 4.828314f,
-                4.836282f, 4.844187f, 4.852030f};
+                4.836282f, 4.844187f, 4.852030f, 4.859812f, 4.867534f, 4.875197f, 4.882802f,
+                4.890349f, 4.897840f, 4.905275f, 4.912655f, 4.919981f, 4.927254f, 4.934474f,
+                4.941642f, 4.948760f, 4.955827f, 4.962845f, 4.969813f, 4.976734f, 4.983607f,
+                4.990433f, 4.997212f, 5.003946f, 5.010635f, 5.017280f, 5.023881f, 5.030438f,
+                5.036953f, 5.043425f, 5.049856f, 5.056246f, 5.062595f, 5.068904f, 5.075174f,
+                5.081404f, 5.087596f, 5.093750f, 5.099866f, 5.105945f, 5.111988f, 5.117994f,
+                5.123964f, 5.129899f, 5.135798f, 5.141664f, 5.147494f, 5.153292f, 5.159055f,
+                5.164786f, 5.170484f, 5.176150f, 5.181784f, 5.187386f, 5.192957f, 5.198497f,
+                5.204007f, 5.209486f, 5.214936f, 5.220356f, 5.225747f, 5.231109f, 5.236442f,
+                5.241747f, 5.247024f, 5.252273f, 5.257495f, 5.262690f, 5.267858f, 5.273000f,
+                5.278115f, 5.283204f, 5.288267f, 5.293305f, 5.298317f, 5.303305f, 5.308268f,
+                5.313206f, 5.318120f, 5.323010f, 5.327876f, 5.332719f, 5.337538f, 5.342334f,
+                5.347108f, 5.351858f, 5.356586f, 5.361292f, 5.365976f, 5.370638f, 5.375278f,
+                5.379897f, 5.384495f, 5.389072f, 5.393628f, 5.398163f, 5.402677f, 5.407172f,
+                5.411646f, 5.416100f, 5.420535f, 5.424950f, 5.429346f, 5.433722f, 5.438079f,
+                5.442418f, 5.446737f, 5.451038f, 5.455321f, 5.459586f, 5.463832f, 5.468060f,
+                5.472271f, 5.476464f, 5.480639f, 5.484797f, 5.488938f, 5.493061f, 5.497168f,
+                5.501258f, 5.505332f, 5.509388f, 5.513429f, 5.517453f, 5.521461f, 5.525453f,
+                5.529429f, 5.533389f, 5.537334f, 5.541264f, 5.545177f};
 
     }  // namespace
 
-    NoiseEstimator::NoiseEstimator(const SuppressionParams &suppression_params)
+    template<typename Geometry>
+    BasicNoiseEstimator<Geometry>::BasicNoiseEstimator(
+            const SuppressionParams &suppression_params)
             : suppression_params_(suppression_params) {
         noise_spectrum_.fill(0.f);
         prev_noise_spectrum_.fill(0.f);
@@ -51,20 +71,26 @@ namespace webrtc {
         parametric_noise_spectrum_.fill(0.f);
     }
 
-    void NoiseEstimator::PrepareAnalysis() {
+    template<typename Geometry>
+    void BasicNoiseEstimator<Geometry>::PrepareAnalysis() {
         std::copy(noise_spectrum_.begin(), noise_spectrum_.end(),
                   prev_noise_spectrum_.begin());
     }
 
-    void NoiseEstimator::PreUpdate(
+    template<typename Geometry>
+    void BasicNoiseEstimator<Geometry>::PreUpdate(
             int32_t num_analyzed_frames,
+            rtc::ArrayView<const float, kFftSizeBy2Plus1> quantile_noise_spectrum,
             rtc::ArrayView<const float, kFftSizeBy2Plus1> signal_spectrum,
             float signal_spectral_sum) {
-        quantile_noise_estimator_.Estimate(signal_spectrum, noise_spectrum_);
+        std::copy(quantile_noise_spectrum.begin(), quantile_noise_spectrum.end(),
+                  noise_spectrum_.begin());
 
-        if (num_analyzed_frames < kShortStartupPhaseBlocks) {
-            // Compute simplified noise model during startup.
-            const size_t kStartBand = 5;
+        if (num_analyzed_frames < Geometry::kShortStartupPhaseBlocks) {
+            // Compute simplified noise model during startup, above about 300 Hz.
+            constexpr size_t kStartBand = 5 * Geometry::kFftSize / kFftSize;
+            static_assert(kFftSizeBy2Plus1 <= log_table.size(),
+                          "The log table is too short");
             float sum_log_i_log_magn = 0.f;
             float sum_log_i = 0.f;
             float sum_log_i_square = 0.f;
@@ -119,7 +145,7 @@ namespace webrtc {
             }
 
             constexpr float kOneByShortStartupPhaseBlocks =
-                    1.f / kShortStartupPhaseBlocks;
+                    1.f / Geometry::kShortStartupPhaseBlocks;
             for (size_t i = 0; i < kFftSizeBy2Plus1; ++i) {
                 // Estimate the background noise using the white and pink noise
                 // parameters.
@@ -136,7 +162,7 @@ namespace webrtc {
             }
 
             // Weight quantile noise with modeled noise.
-            float w = (kShortStartupPhaseBlocks - num_analyzed_frames);
+            float w = (Geometry::kShortStartupPhaseBlocks - num_analyzed_frames);
             for (size_t i = 0; i < kFftSizeBy2Plus1; ++i) {
                 noise_spectrum_[i] *= num_analyzed_frames;
                 float tmp = parametric_noise_spectrum_[i] * w;
@@ -146,7 +172,8 @@ namespace webrtc {
         }
     }
 
-    void NoiseEstimator::PostUpdate(
+    template<typename Geometry>
+    void BasicNoiseEstimator<Geometry>::PostUpdate(
             rtc::ArrayView<const float> speech_probability,
             rtc::ArrayView<const float, kFftSizeBy2Plus1> signal_spectrum) {
         // Time-avg parameter for noise_spectrum update.
@@ -192,4 +219,44 @@ namespace webrtc {
         }
     }
 
+    template<typename Geometry>
+    void BasicNoiseEstimator<Geometry>::Seed(
+            rtc::ArrayView<const float, kFftSizeBy2Plus1> noise_spectrum) {
+        std::copy(noise_spectrum.begin(), noise_spectrum.end(),
+                  noise_spectrum_.begin());
+        std::copy(noise_spectrum.begin(), noise_spectrum.end(),
+                  prev_noise_spectrum_.begin());
+        std::copy(noise_spectrum.begin(), noise_spectrum.end(),
+                  conservative_noise_spectrum_.begin());
+        std::copy(noise_spectrum.begin(), noise_spectrum.end(),
+                  parametric_noise_spectrum_.begin());
+    }
+
+    template<typename Geometry>
+    void BasicNoiseEstimator<Geometry>::SaveState(
+            NsStateWriter *writer) const {
+        writer->Write(white_noise_level_);
+        writer->Write(pink_noise_numerator_);
+        writer->Write(pink_noise_exp_);
+        writer->Write(prev_noise_spectrum_);
+        writer->Write(conservative_noise_spectrum_);
+        writer->Write(parametric_noise_spectrum_);
+        writer->Write(noise_spectrum_);
+    }
+
+    template<typename Geometry>
+    bool BasicNoiseEstimator<Geometry>::LoadState(
+            NsStateReader *reader) {
+        return reader->Read(&white_noise_level_) &&
+               reader->Read(&pink_noise_numerator_) &&
+               reader->Read(&pink_noise_exp_) && reader->Read(&prev_noise_spectrum_) &&
+               reader->Read(&conservative_noise_spectrum_) &&
+               reader->Read(&parametric_noise_spectrum_) &&
+               reader->Read(&noise_spectrum_);
+    }
+
+    template class BasicNoiseEstimator<NsDefaultGeometry>;
+    template class BasicNoiseEstimator<NsLowDelayGeometry>;
+    template class BasicNoiseEstimator<NsHighEfficiencyGeometry>;
+
 }  // namespace webrtc
@@ -15,24 +15,31 @@
 
 #include "array_view.h"
 #include "ns_common.h"
-#include "quantile_noise_estimator.h"
+#include "ns_state.h"
 #include "suppression_params.h"
 
 namespace webrtc {
 
 // Class for estimating the spectral characteristics of the noise in an incoming
-// signal.
-    class NoiseEstimator {
+// signal, with the frame geometry |Geometry|, see NsGeometry. Instantiated for
+// the geometries in ns_common.h.
+    template<typename Geometry>
+    class BasicNoiseEstimator {
     public:
-        explicit NoiseEstimator(const SuppressionParams &suppression_params);
+        static constexpr size_t kFftSizeBy2Plus1 = Geometry::kFftSizeBy2Plus1;
+
+        explicit BasicNoiseEstimator(const SuppressionParams &suppression_params);
 
         // Prepare the estimator for analysis of a new frame.
         void PrepareAnalysis();
 
-        // Performs the first step of the estimator update.
-        void PreUpdate(int32_t num_analyzed_frames,
-                       rtc::ArrayView<const float, kFftSizeBy2Plus1> signal_spectrum,
-                       float signal_spectral_sum);
+        // Performs the first step of the estimator update, starting from the
+        // quantile noise estimate of the frame, see BasicQuantileNoiseEstimator.
+        void PreUpdate(
+                int32_t num_analyzed_frames,
+                rtc::ArrayView<const float, kFftSizeBy2Plus1> quantile_noise_spectrum,
+                rtc::ArrayView<const float, kFftSizeBy2Plus1> signal_spectrum,
+                float signal_spectral_sum);
 
         // Performs the second step of the estimator update.
         void PostUpdate(
@@ -61,6 +68,25 @@ namespace webrtc {
             return conservative_noise_spectrum_;
         }
 
+        // Starts the noise estimates at |noise_spectrum|. Analysis must then begin
+        // after the startup phase, with the quantile noise estimator seeded too.
+        void Seed(rtc::ArrayView<const float, kFftSizeBy2Plus1> noise_spectrum);
+
+        // Appends the adaptive state to |writer|.
+        void SaveState(NsStateWriter *writer) const;
+
+        // Restores a state appended by SaveState(). Returns false if |reader| runs
+        // out of data.
+        bool LoadState(NsStateReader *reader);
+
+        // The number of bytes appended by SaveState().
+        static constexpr size_t StateSize() {
+            return sizeof(white_noise_level_) + sizeof(pink_noise_numerator_) +
+                   sizeof(pink_noise_exp_) + sizeof(prev_noise_spectrum_) +
+                   sizeof(conservative_noise_spectrum_) +
+                   sizeof(parametric_noise_spectrum_) + sizeof(noise_spectrum_);
+        }
+
     private:
         const SuppressionParams &suppression_params_;
         float white_noise_level_ = 0.f;
@@ -70,9 +96,10 @@ namespace webrtc {
         std::array<float, kFftSizeBy2Plus1> conservative_noise_spectrum_{};
         std::array<float, kFftSizeBy2Plus1> parametric_noise_spectrum_{};
         std::array<float, kFftSizeBy2Plus1> noise_spectrum_{};
-        QuantileNoiseEstimator quantile_noise_estimator_;
     };
 
+    using NoiseEstimator = BasicNoiseEstimator<NsDefaultGeometry>;
+
 }  // namespace webrtc
 
 #endif  // MODULES_AUDIO_PROCESSING_NS_NOISE_ESTIMATOR_H_
@@ -0,0 +1,47 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_NS_NOISE_PROFILE_H_
+#define MODULES_AUDIO_PROCESSING_NS_NOISE_PROFILE_H_
+
+#include <array>
+
+#include "ns_common.h"
+
+namespace webrtc {
+
+// Prior signal model parameters of a noise profile, which do not depend on the
+// frame geometry.
+    struct NoiseProfileParameters {
+        // Average signal energy used to normalize the spectral difference feature.
+        float spectral_diff_normalization = 0.f;
+        // Prior signal model parameters, see PriorSignalModel.
+        float lrt = kLtrFeatureThr;
+        float flatness_threshold = .5f;
+        float template_diff_threshold = .5f;
+        float lrt_weighting = 1.f;
+        float flatness_weighting = 0.f;
+        float difference_weighting = 0.f;
+    };
+
+// Converged noise and prior model estimates that a NoiseSuppressor can be
+// seeded with, so that it starts in steady state instead of going through the
+// startup phase.
+    template<typename Geometry>
+    struct BasicNoiseProfile : NoiseProfileParameters {
+        // Magnitude spectrum of the noise.
+        std::array<float, Geometry::kFftSizeBy2Plus1> noise_spectrum{};
+    };
+
+    using NoiseProfile = BasicNoiseProfile<NsDefaultGeometry>;
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_NS_NOISE_PROFILE_H_
@@ -15,8 +15,10 @@
 #include <string.h>
 #include <algorithm>
 
-#include "fast_math.h"
 #include "checks.h"
+#include "ns_filter_bank.h"
+#include "ns_state.h"
+#include "upper_bands_gain.h"
 
 namespace webrtc {
 
@@ -45,120 +47,25 @@ namespace webrtc {
             return num_channels > kMaxNumChannelsOnStack ? num_channels : 0;
         }
 
-// Hybrib Hanning and flat window for the filterbank.
-        constexpr std::array<float, 96> kBlocks160w256FirstHalf = {
-                0.00000000f, 0.01636173f, 0.03271908f, 0.04906767f, 0.06540313f,
-                0.08172107f, 0.09801714f, 0.11428696f, 0.13052619f, 0.14673047f,
-                0.16289547f, 0.17901686f, 0.19509032f, 0.21111155f, 0.22707626f,
-                0.24298018f, 0.25881905f, 0.27458862f, 0.29028468f, 0.30590302f,
-                0.32143947f, 0.33688985f, 0.35225005f, 0.36751594f, 0.38268343f,
-                0.39774847f, 0.41270703f, 0.42755509f, 0.44228869f, 0.45690388f,
-                0.47139674f, 0.48576339f, 0.50000000f, 0.51410274f, 0.52806785f,
-                0.54189158f, 0.55557023f, 0.56910015f, 0.58247770f, 0.59569930f,
-                0.60876143f, 0.62166057f, 0.63439328f, 0.64695615f, 0.65934582f,
-                0.67155895f, 0.68359230f, 0.69544264f, 0.70710678f, 0.71858162f,
-                0.72986407f, 0.74095113f, 0.75183981f, 0.76252720f, 0.77301045f,
-                0.78328675f, 0.79335334f, 0.80320753f, 0.81284668f, 0.82226822f,
-                0.83146961f, 0.84044840f, 0.84920218f, 0.85772861f, 0.86602540f,
-                0.87409034f, 0.88192126f, 0.88951608f, 0.89687274f, 0.90398929f,
-                0.91086382f, 0.91749450f, 0.92387953f, 0.93001722f, 0.93590593f,
-                0.94154407f, 0.94693013f, 0.95206268f, 0.95694034f, 0.96156180f,
-                0.96592583f, 0.97003125f, 0.97387698f, 0.97746197f, 0.98078528f,
-                0.98384601f, 0.98664333f, 0.98917651f, 0.99144486f, 0.99344778f,
-                0.99518473f, 0.99665524f, 0.99785892f, 0.99879546f, 0.99946459f,
-                0.99986614f};
-
-// Applies the filterbank window to a buffer.
-        void ApplyFilterBankWindow(rtc::ArrayView<float, kFftSize> x) {
-            for (size_t i = 0; i < 96; ++i) {
-                x[i] = kBlocks160w256FirstHalf[i] * x[i];
-            }
-
-            for (size_t i = 161, k = 95; i < kFftSize; ++i, --k) {
-                RTC_DCHECK_NE(0, k);
-                x[i] = kBlocks160w256FirstHalf[k] * x[i];
-            }
-        }
-
-// Extends a frame with previous data.
-        void FormExtendedFrame(rtc::ArrayView<const float, kNsFrameSize> frame,
-                               rtc::ArrayView<float, kFftSize - kNsFrameSize> old_data,
-                               rtc::ArrayView<float, kFftSize> extended_frame) {
-            std::copy(old_data.begin(), old_data.end(), extended_frame.begin());
-            std::copy(frame.begin(), frame.end(),
-                      extended_frame.begin() + old_data.size());
-            std::copy(extended_frame.end() - old_data.size(), extended_frame.end(),
-                      old_data.begin());
-        }
-
-// Uses overlap-and-add to produce an output frame.
-        void OverlapAndAdd(rtc::ArrayView<const float, kFftSize> extended_frame,
-                           rtc::ArrayView<float, kOverlapSize> overlap_memory,
-                           rtc::ArrayView<float, kNsFrameSize> output_frame) {
-            for (size_t i = 0; i < kOverlapSize; ++i) {
-                output_frame[i] = overlap_memory[i] + extended_frame[i];
-            }
-            std::copy(extended_frame.begin() + kOverlapSize,
-                      extended_frame.begin() + kNsFrameSize,
-                      output_frame.begin() + kOverlapSize);
-            std::copy(extended_frame.begin() + kNsFrameSize, extended_frame.end(),
-                      overlap_memory.begin());
-        }
-
-// Produces a delayed frame.
-        void DelaySignal(rtc::ArrayView<const float, kNsFrameSize> frame,
-                         rtc::ArrayView<float, kFftSize - kNsFrameSize> delay_buffer,
-                         rtc::ArrayView<float, kNsFrameSize> delayed_frame) {
-            constexpr size_t kSamplesFromFrame = kNsFrameSize - (kFftSize - kNsFrameSize);
-            std::copy(delay_buffer.begin(), delay_buffer.end(), delayed_frame.begin());
-            std::copy(frame.begin(), frame.begin() + kSamplesFromFrame,
-                      delayed_frame.begin() + delay_buffer.size());
-
-            std::copy(frame.begin() + kSamplesFromFrame, frame.end(),
-                      delay_buffer.begin());
-        }
-
-// Computes the energy of an extended frame.
-        float ComputeEnergyOfExtendedFrame(rtc::ArrayView<const float, kFftSize> x) {
-            float energy = 0.f;
-            for (float x_k : x) {
-                energy += x_k * x_k;
-            }
+// Maximum number of channels that are passed to the batched FFTs at a time.
+        constexpr size_t kMaxNumChannelsPerFftBatch = 8;
 
-            return energy;
-        }
+// Header of the blobs produced by NoiseSuppressor::SaveState(). The version
+// must be bumped whenever the serialized state changes.
+        constexpr uint32_t kStateMagic = 0x5453534e;  // "NSST".
+        constexpr uint32_t kStateVersion = 4;
 
-// Computes the energy of an extended frame based on its subcomponents.
-        float ComputeEnergyOfExtendedFrame(
-                rtc::ArrayView<const float, kNsFrameSize> frame,
-                rtc::ArrayView<float, kFftSize - kNsFrameSize> old_data) {
+// Computes the energy of |size| samples.
+        float ComputeEnergy(const float *x, size_t size) {
             float energy = 0.f;
-            for (float v : old_data) {
-                energy += v * v;
+            for (size_t i = 0; i < size; ++i) {
+                energy += x[i] * x[i];
             }
-            for (float v : frame) {
-                energy += v * v;
-            }
-
             return energy;
         }
 
-// Computes the magnitude spectrum based on an FFT output.
-        void ComputeMagnitudeSpectrum(
-                rtc::ArrayView<const float, kFftSize> real,
-                rtc::ArrayView<const float, kFftSize> imag,
-                rtc::ArrayView<float, kFftSizeBy2Plus1> signal_spectrum) {
-            signal_spectrum[0] = fabsf(real[0]) + 1.f;
-            signal_spectrum[kFftSizeBy2Plus1 - 1] =
-                    fabsf(real[kFftSizeBy2Plus1 - 1]) + 1.f;
-
-            for (size_t i = 1; i < kFftSizeBy2Plus1 - 1; ++i) {
-                signal_spectrum[i] =
-                        SqrtFastApproximation(real[i] * real[i] + imag[i] * imag[i]) + 1.f;
-            }
-        }
-
 // Compute prior and post SNR.
+        template<size_t kFftSizeBy2Plus1>
         void ComputeSnr(rtc::ArrayView<const float, kFftSizeBy2Plus1> filter,
                         rtc::ArrayView<const float> prev_signal_spectrum,
                         rtc::ArrayView<const float> signal_spectrum,
@@ -183,66 +90,21 @@ namespace webrtc {
             }
         }
 
-// Computes the attenuating gain for the noise suppression of the upper bands.
-        float ComputeUpperBandsGain(
-                float minimum_attenuating_gain,
-                rtc::ArrayView<const float, kFftSizeBy2Plus1> filter,
-                rtc::ArrayView<const float> speech_probability,
-                rtc::ArrayView<const float, kFftSizeBy2Plus1> prev_analysis_signal_spectrum,
-                rtc::ArrayView<const float, kFftSizeBy2Plus1> signal_spectrum) {
-            // Average speech prob and filter gain for the end of the lowest band.
-            constexpr int kNumAvgBins = 32;
-            constexpr float kOneByNumAvgBins = 1.f / kNumAvgBins;
-
-            float avg_prob_speech = 0.f;
-            float avg_filter_gain = 0.f;
-            for (size_t i = kFftSizeBy2Plus1 - kNumAvgBins - 1; i < kFftSizeBy2Plus1 - 1;
-                 i++) {
-                avg_prob_speech += speech_probability[i];
-                avg_filter_gain += filter[i];
-            }
-            avg_prob_speech = avg_prob_speech * kOneByNumAvgBins;
-            avg_filter_gain = avg_filter_gain * kOneByNumAvgBins;
-
-            // If the speech was suppressed by a component between Analyze and Process, an
-            // example being by an AEC, it should not be considered speech for the purpose
-            // of high band suppression. To that end, the speech probability is scaled
-            // accordingly.
-            float sum_analysis_spectrum = 0.f;
-            float sum_processing_spectrum = 0.f;
-            for (size_t i = 0; i < kFftSizeBy2Plus1; ++i) {
-                sum_analysis_spectrum += prev_analysis_signal_spectrum[i];
-                sum_processing_spectrum += signal_spectrum[i];
-            }
-
-            // The magnitude spectrum computation enforces the spectrum to be strictly
-            // positive.
-            RTC_DCHECK_GT(sum_analysis_spectrum, 0.f);
-            avg_prob_speech *= sum_processing_spectrum / sum_analysis_spectrum;
-
-            // Compute gain based on speech probability.
-            float gain =
-                    0.5f * (1.f + static_cast<float>(tanh(2.f * avg_prob_speech - 1.f)));
-
-            // Combine gain with low band gain.
-            if (avg_prob_speech >= 0.5f) {
-                gain = 0.25f * gain + 0.75f * avg_filter_gain;
-            } else {
-                gain = 0.5f * gain + 0.5f * avg_filter_gain;
-            }
-
-            // Make sure gain is within flooring range.
-            return std::min(std::max(gain, minimum_attenuating_gain), 1.f);
-        }
-
     }  // namespace
 
-    NoiseSuppressor::ChannelState::ChannelState(
+    template<typename Geometry>
+    BasicNoiseSuppressor<Geometry>::ChannelState::ChannelState(
             const SuppressionParams &suppression_params,
-            size_t num_bands)
+            size_t num_bands,
+            NsAllocator *allocator)
             : wiener_filter(suppression_params),
               noise_estimator(suppression_params),
-              process_delay_memory(num_bands > 1 ? num_bands - 1 : 0) {
+              process_delay_memory(num_bands > 1 ? num_bands - 1 : 0,
+                                   allocator),
+              analysis_input(kFramesPerChunk > 1 || kChunksPerFrame > 1
+                             ? kFramesPerChunk * kFrameSize : 0,
+                             allocator),
+              process_input(kChunksPerFrame > 1 ? num_bands : 0, allocator) {
         analyze_analysis_memory.fill(0.f);
         prev_analysis_signal_spectrum.fill(1.f);
         process_analysis_memory.fill(0.f);
@@ -250,26 +112,217 @@ namespace webrtc {
         for (auto &d : process_delay_memory) {
             d.fill(0.f);
         }
+        for (auto &x : process_input) {
+            x.fill(0.f);
+        }
     }
 
-    NoiseSuppressor::NoiseSuppressor(const NsConfig &config,
-                                     size_t sample_rate_hz,
-                                     size_t num_channels)
+    template<typename Geometry>
+    BasicNoiseSuppressor<Geometry>::BasicNoiseSuppressor(const NsConfig &config,
+                                                         size_t sample_rate_hz,
+                                                         size_t num_channels,
+                                                         NsAllocator *allocator)
             : num_bands_(NumBandsForRate(sample_rate_hz)),
               num_channels_(num_channels),
               suppression_params_(config.target_level),
-              filter_bank_states_heap_(NumChannelsOnHeap(num_channels_)),
-              upper_band_gains_heap_(NumChannelsOnHeap(num_channels_)),
-              energies_before_filtering_heap_(NumChannelsOnHeap(num_channels_)),
-              gain_adjustments_heap_(NumChannelsOnHeap(num_channels_)),
-              channels_(num_channels_) {
+              enable_silence_bypass_(config.enable_silence_bypass),
+              silence_floor_(config.silence_floor),
+              filter_bank_states_heap_(NumChannelsOnHeap(num_channels_),
+                                       allocator),
+              upper_band_gains_heap_(NumChannelsOnHeap(num_channels_),
+                                     allocator),
+              energies_before_filtering_heap_(NumChannelsOnHeap(num_channels_),
+                                              allocator),
+              gain_adjustments_heap_(NumChannelsOnHeap(num_channels_),
+                                     allocator),
+              channels_(num_channels_, allocator),
+              analysis_frames_(num_channels_, allocator),
+              process_frames_(num_channels_ * num_bands_, allocator) {
         for (size_t ch = 0; ch < num_channels_; ++ch) {
-            channels_[ch] =
-                    std::make_unique<ChannelState>(suppression_params_, num_bands_);
+            channels_[ch] = NsMakeUnique<ChannelState>(
+                    allocator, suppression_params_, num_bands_, allocator);
+        }
+        const size_t num_threads = std::min(config.num_threads, num_channels_);
+        if (num_threads > 1) {
+            thread_pool_ = std::make_unique<NsThreadPool>(num_threads);
+        }
+    }
+
+    template<typename Geometry>
+    void BasicNoiseSuppressor<Geometry>::AddToLayout(NsArenaLayout *layout,
+                                                     size_t sample_rate_hz,
+                                                     size_t num_channels) {
+        const size_t num_bands = NumBandsForRate(sample_rate_hz);
+        const size_t num_channels_on_heap = NumChannelsOnHeap(num_channels);
+        layout->AddVector<FilterBankState>(num_channels_on_heap);
+        layout->AddVector<float>(num_channels_on_heap);
+        layout->AddVector<float>(num_channels_on_heap);
+        layout->AddVector<float>(num_channels_on_heap);
+        layout->AddVector<NsUniquePtr<ChannelState>>(num_channels);
+        layout->AddVector<const float *>(num_channels);
+        layout->AddVector<float *>(num_channels * num_bands);
+        for (size_t ch = 0; ch < num_channels; ++ch) {
+            layout->AddObject<ChannelState>();
+            layout->AddVector<std::array<float, kOverlapSize>>(
+                    num_bands > 1 ? num_bands - 1 : 0);
+            layout->AddVector<float>(kFramesPerChunk > 1 || kChunksPerFrame > 1
+                                     ? kFramesPerChunk * kFrameSize : 0);
+            layout->AddVector<std::array<float, kFrameSize>>(
+                    kChunksPerFrame > 1 ? num_bands : 0);
         }
     }
 
-    void NoiseSuppressor::AggregateWienerFilters(
+    template<typename Geometry>
+    void BasicNoiseSuppressor<Geometry>::SeedNoiseProfile(
+            const BasicNoiseProfile<Geometry> &profile) {
+        RTC_DCHECK_EQ(num_analyzed_frames_, -1);
+        for (auto &ch : channels_) {
+            ch->noise_estimator.Seed(profile.noise_spectrum);
+            ch->quantile_noise_estimator.Seed(profile.noise_spectrum);
+            ch->wiener_filter.Seed(profile.noise_spectrum);
+            ch->speech_probability_estimator.Seed(profile);
+        }
+        // The next analyzed frame is the first one after the startup phase.
+        num_analyzed_frames_ = Geometry::kLongStartupPhaseBlocks;
+    }
+
+    template<typename Geometry>
+    BasicNoiseProfile<Geometry> BasicNoiseSuppressor<Geometry>::GetNoiseProfile(
+            size_t ch) const {
+        RTC_DCHECK_LT(ch, num_channels_);
+        BasicNoiseProfile<Geometry> profile;
+        rtc::ArrayView<const float, kFftSizeBy2Plus1> noise_spectrum =
+                channels_[ch]->noise_estimator.get_noise_spectrum();
+        std::copy(noise_spectrum.begin(), noise_spectrum.end(),
+                  profile.noise_spectrum.begin());
+        channels_[ch]->speech_probability_estimator.GetProfile(&profile);
+        return profile;
+    }
+
+    template<typename Geometry>
+    void BasicNoiseSuppressor<Geometry>::SaveState(
+            std::vector<uint8_t> *state) const {
+        RTC_DCHECK(state);
+        state->clear();
+        NsStateWriter writer(state);
+        writer.Write(kStateMagic);
+        writer.Write(kStateVersion);
+        writer.Write(static_cast<uint32_t>(kFftSize));
+        writer.Write(static_cast<uint32_t>(num_bands_));
+        writer.Write(static_cast<uint32_t>(num_channels_));
+        writer.Write(num_analyzed_frames_);
+        writer.Write(static_cast<uint8_t>(analysis_pending_));
+        writer.Write(chunk_index_);
+        for (const auto &ch : channels_) {
+            ch->speech_probability_estimator.SaveState(&writer);
+            ch->wiener_filter.SaveState(&writer);
+            ch->noise_estimator.SaveState(&writer);
+            ch->quantile_noise_estimator.SaveState(&writer);
+            writer.Write(ch->prev_analysis_signal_spectrum);
+            writer.Write(ch->analyze_analysis_memory);
+            writer.Write(ch->process_analysis_memory);
+            writer.Write(ch->process_synthesis_memory);
+            for (const auto &d : ch->process_delay_memory) {
+                writer.Write(d);
+            }
+            for (float x : ch->analysis_input) {
+                writer.Write(x);
+            }
+            for (const auto &x : ch->process_input) {
+                writer.Write(x);
+            }
+        }
+        RTC_DCHECK_EQ(state->size(), StateSize());
+    }
+
+    template<typename Geometry>
+    bool BasicNoiseSuppressor<Geometry>::LoadState(
+            rtc::ArrayView<const uint8_t> state) {
+        NsStateReader reader(state);
+        uint32_t magic, version, fft_size, num_bands, num_channels;
+        if (!reader.Read(&magic) || !reader.Read(&version) ||
+            !reader.Read(&fft_size) || !reader.Read(&num_bands) ||
+            !reader.Read(&num_channels) || magic != kStateMagic ||
+            version != kStateVersion || fft_size != kFftSize ||
+            num_bands != num_bands_ || num_channels != num_channels_) {
+            return false;
+        }
+
+        // All the state has a fixed size, so a blob of the right size cannot run
+        // out of data half way through the channels.
+        if (state.size() != StateSize()) {
+            return false;
+        }
+
+        // The values that are used as flags or indices are validated before any
+        // state is changed. The analysis is only deferred, and thus pending, with
+        // the geometries that buffer it in analysis_input.
+        constexpr bool kDefersAnalysis = kFramesPerChunk > 1 || kChunksPerFrame > 1;
+        int32_t num_analyzed_frames;
+        uint8_t analysis_pending;
+        uint32_t chunk_index;
+        if (!reader.Read(&num_analyzed_frames) || !reader.Read(&analysis_pending) ||
+            !reader.Read(&chunk_index) || analysis_pending > 1 ||
+            (analysis_pending == 1 && !kDefersAnalysis) ||
+            chunk_index >= kChunksPerFrame) {
+            return false;
+        }
+        num_analyzed_frames_ = num_analyzed_frames;
+        analysis_pending_ = analysis_pending != 0;
+        chunk_index_ = chunk_index;
+
+        // The rest of the state consists of plain numbers, which are read in
+        // place, as the reads cannot fail anymore.
+        bool success = true;
+        for (auto &ch : channels_) {
+            success = success && ch->speech_probability_estimator.LoadState(&reader) &&
+                      ch->wiener_filter.LoadState(&reader) &&
+                      ch->noise_estimator.LoadState(&reader) &&
+                      ch->quantile_noise_estimator.LoadState(&reader) &&
+                      reader.Read(&ch->prev_analysis_signal_spectrum) &&
+                      reader.Read(&ch->analyze_analysis_memory) &&
+                      reader.Read(&ch->process_analysis_memory) &&
+                      reader.Read(&ch->process_synthesis_memory);
+            for (auto &d : ch->process_delay_memory) {
+                success = success && reader.Read(&d);
+            }
+            for (float &x : ch->analysis_input) {
+                success = success && reader.Read(&x);
+            }
+            for (auto &x : ch->process_input) {
+                success = success && reader.Read(&x);
+            }
+        }
+        RTC_DCHECK(success);
+        RTC_DCHECK_EQ(reader.remaining(), 0);
+        return success;
+    }
+
+    template<typename Geometry>
+    size_t BasicNoiseSuppressor<Geometry>::StateSize() const {
+        constexpr size_t kHeaderSize = 5 * sizeof(uint32_t) +
+                                       sizeof(num_analyzed_frames_) + sizeof(uint8_t) +
+                                       sizeof(chunk_index_);
+        constexpr size_t kEstimatorsSize =
+                BasicSpeechProbabilityEstimator<Geometry>::StateSize() +
+                BasicWienerFilter<Geometry>::StateSize() +
+                BasicNoiseEstimator<Geometry>::StateSize() +
+                BasicQuantileNoiseEstimator<Geometry>::StateSize();
+        // The buffers have the same sizes in all channels.
+        const ChannelState &ch = *channels_[0];
+        const size_t channel_size =
+                kEstimatorsSize + sizeof(ch.prev_analysis_signal_spectrum) +
+                sizeof(ch.analyze_analysis_memory) +
+                sizeof(ch.process_analysis_memory) +
+                sizeof(ch.process_synthesis_memory) +
+                ch.process_delay_memory.size() * sizeof(ch.process_delay_memory[0]) +
+                ch.analysis_input.size() * sizeof(ch.analysis_input[0]) +
+                ch.process_input.size() * sizeof(ch.process_input[0]);
+        return kHeaderSize + num_channels_ * channel_size;
+    }
+
+    template<typename Geometry>
+    void BasicNoiseSuppressor<Geometry>::AggregateWienerFilters(
             rtc::ArrayView<float, kFftSizeBy2Plus1> filter) const {
         rtc::ArrayView<const float, kFftSizeBy2Plus1> filter0 =
                 channels_[0]->wiener_filter.get_filter();
@@ -285,7 +338,113 @@ namespace webrtc {
         }
     }
 
-    void NoiseSuppressor::Analyze(const AudioBuffer &audio) {
+    template<typename Geometry>
+    void BasicNoiseSuppressor<Geometry>::ComputeFfts(
+            rtc::ArrayView<FilterBankState> filter_bank_states) {
+        if (filter_bank_states.size() == 1) {
+            fft_.Fft(filter_bank_states[0].extended_frame, filter_bank_states[0].real,
+                     filter_bank_states[0].imag);
+            return;
+        }
+
+        for (size_t ch0 = 0; ch0 < filter_bank_states.size();
+             ch0 += kMaxNumChannelsPerFftBatch) {
+            const size_t num_batch_channels = std::min(
+                    kMaxNumChannelsPerFftBatch, filter_bank_states.size() - ch0);
+            std::array<float *, kMaxNumChannelsPerFftBatch> time_data;
+            std::array<float *, kMaxNumChannelsPerFftBatch> real;
+            std::array<float *, kMaxNumChannelsPerFftBatch> imag;
+            for (size_t k = 0; k < num_batch_channels; ++k) {
+                time_data[k] = filter_bank_states[ch0 + k].extended_frame.data();
+                real[k] = filter_bank_states[ch0 + k].real.data();
+                imag[k] = filter_bank_states[ch0 + k].imag.data();
+            }
+            fft_.FftBatch(
+                    rtc::ArrayView<float *const>(time_data.data(), num_batch_channels),
+                    rtc::ArrayView<float *const>(real.data(), num_batch_channels),
+                    rtc::ArrayView<float *const>(imag.data(), num_batch_channels));
+        }
+    }
+
+    template<typename Geometry>
+    void BasicNoiseSuppressor<Geometry>::ComputeIffts(
+            rtc::ArrayView<FilterBankState> filter_bank_states) {
+        if (filter_bank_states.size() == 1) {
+            fft_.Ifft(filter_bank_states[0].real, filter_bank_states[0].imag,
+                      filter_bank_states[0].extended_frame);
+            return;
+        }
+
+        for (size_t ch0 = 0; ch0 < filter_bank_states.size();
+             ch0 += kMaxNumChannelsPerFftBatch) {
+            const size_t num_batch_channels = std::min(
+                    kMaxNumChannelsPerFftBatch, filter_bank_states.size() - ch0);
+            std::array<const float *, kMaxNumChannelsPerFftBatch> real;
+            std::array<const float *, kMaxNumChannelsPerFftBatch> imag;
+            std::array<float *, kMaxNumChannelsPerFftBatch> time_data;
+            for (size_t k = 0; k < num_batch_channels; ++k) {
+                real[k] = filter_bank_states[ch0 + k].real.data();
+                imag[k] = filter_bank_states[ch0 + k].imag.data();
+                time_data[k] = filter_bank_states[ch0 + k].extended_frame.data();
+            }
+            fft_.IfftBatch(
+                    rtc::ArrayView<const float *const>(real.data(), num_batch_channels),
+                    rtc::ArrayView<const float *const>(imag.data(), num_batch_channels),
+                    rtc::ArrayView<float *const>(time_data.data(), num_batch_channels));
+        }
+    }
+
+    template<typename Geometry>
+    template<typename F>
+    void BasicNoiseSuppressor<Geometry>::RunOnChannelRanges(const F &f) {
+        const size_t num_tasks = thread_pool_->num_threads();
+        thread_pool_->Run(num_tasks, [this, num_tasks, &f](size_t k) {
+            f(k * num_channels_ / num_tasks, (k + 1) * num_channels_ / num_tasks);
+        });
+    }
+
+    template<typename Geometry>
+    void BasicNoiseSuppressor<Geometry>::Analyze(const AudioBuffer &audio) {
+        if (kFramesPerChunk > 1 && analysis_pending_) {
+            // The previous chunk was never processed, so analyze it now to keep the
+            // estimates up to date.
+            for (size_t k = 0; k < kFramesPerChunk; ++k) {
+                AnalyzeStoredFrame(k * kFrameSize);
+            }
+            analysis_pending_ = false;
+        }
+
+        if (kFramesPerChunk == 1 && kChunksPerFrame == 1) {
+            for (size_t ch = 0; ch < num_channels_; ++ch) {
+                analysis_frames_[ch] = &audio.split_bands_const(ch)[0][0];
+            }
+            AnalyzeFrame();
+            return;
+        }
+
+        // Defer the analysis of the frames to Process() in order to interleave it
+        // with the processing of each frame.
+        const size_t offset = chunk_index_ * AudioBuffer::kSplitBandSize;
+        for (size_t ch = 0; ch < num_channels_; ++ch) {
+            const float *y_band0 = &audio.split_bands_const(ch)[0][0];
+            std::copy(y_band0, y_band0 + AudioBuffer::kSplitBandSize,
+                      channels_[ch]->analysis_input.begin() + offset);
+        }
+        analysis_pending_ = true;
+    }
+
+    template<typename Geometry>
+    void BasicNoiseSuppressor<Geometry>::AnalyzeStoredFrame(size_t offset) {
+        for (size_t ch = 0; ch < num_channels_; ++ch) {
+            analysis_frames_[ch] = channels_[ch]->analysis_input.data() + offset;
+        }
+        AnalyzeFrame();
+    }
+
+    template<typename Geometry>
+    void BasicNoiseSuppressor<Geometry>::AnalyzeFrame() {
+        NS_STAGE_TIMER(&profiler_);
+
         // Prepare the noise estimator for the analysis stage.
         for (size_t ch = 0; ch < num_channels_; ++ch) {
             channels_[ch]->noise_estimator.PrepareAnalysis();
@@ -294,9 +453,9 @@ namespace webrtc {
         // Check for zero frames.
         bool zero_frame = true;
         for (size_t ch = 0; ch < num_channels_; ++ch) {
-            rtc::ArrayView<const float, kNsFrameSize> y_band0(
-                    &audio.split_bands_const(ch)[0][0], kNsFrameSize);
-            float energy = ComputeEnergyOfExtendedFrame(
+            rtc::ArrayView<const float, kFrameSize> y_band0(analysis_frames_[ch],
+                                                            kFrameSize);
+            float energy = NsFilterBank<Geometry>::ComputeEnergyOfExtendedFrame(
                     y_band0, channels_[ch]->analyze_analysis_memory);
             if (energy > 0.f) {
                 zero_frame = false;
@@ -313,6 +472,7 @@ namespace webrtc {
             // Depending on the duration of the inactive signal it takes a
             // considerable amount of time for the system to learn what is noise and
             // what is speech.
+            NS_STAGE_LAP(NsStage::kFraming);
             return;
         }
 
@@ -321,24 +481,57 @@ namespace webrtc {
             num_analyzed_frames_ = 0;
         }
 
-        // Analyze all channels.
-        for (size_t ch = 0; ch < num_channels_; ++ch) {
-            std::unique_ptr<ChannelState> &ch_p = channels_[ch];
-            rtc::ArrayView<const float, kNsFrameSize> y_band0(
-                    &audio.split_bands_const(ch)[0][0], kNsFrameSize);
+        // Select the space for storing data during the analysis.
+        std::array<FilterBankState, kMaxNumChannelsOnStack> filter_bank_states_stack;
+        rtc::ArrayView<FilterBankState> filter_bank_states(
+                filter_bank_states_stack.data(), num_channels_);
+        if (NumChannelsOnHeap(num_channels_) > 0) {
+            // If the stack-allocated space is too small, use the heap for storing the
+            // data.
+            filter_bank_states = rtc::ArrayView<FilterBankState>(
+                    filter_bank_states_heap_.data(), num_channels_);
+        }
 
-            // Form an extended frame and apply analysis filter bank windowing.
-            std::array<float, kFftSize> extended_frame{};
-            FormExtendedFrame(y_band0, ch_p->analyze_analysis_memory, extended_frame);
-            ApplyFilterBankWindow(extended_frame);
+        if (thread_pool_) {
+            RunOnChannelRanges([&](size_t begin, size_t end) {
+                AnalyzeChannels(begin, end, filter_bank_states, nullptr);
+            });
+            NS_STAGE_LAP(NsStage::kChannelFanOut);
+        } else {
+            AnalyzeChannels(0, num_channels_, filter_bank_states,
+                            NS_STAGE_TIMER_PTR());
+        }
+    }
 
-            // Compute the magnitude spectrum.
-            std::array<float, kFftSize> real{};
-            std::array<float, kFftSize> imag{};
-            fft_.Fft(extended_frame, real, imag);
+    template<typename Geometry>
+    void BasicNoiseSuppressor<Geometry>::AnalyzeChannels(
+            size_t begin, size_t end,
+            rtc::ArrayView<FilterBankState> filter_bank_states,
+            NsStageTimer *timer) {
+        // Form extended frames and apply analysis filter bank windowing.
+        for (size_t ch = begin; ch < end; ++ch) {
+            rtc::ArrayView<const float, kFrameSize> y_band0(analysis_frames_[ch],
+                                                            kFrameSize);
+            NsFilterBank<Geometry>::FormExtendedFrame(
+                    y_band0, channels_[ch]->analyze_analysis_memory,
+                    filter_bank_states[ch].extended_frame);
+            NsFilterBank<Geometry>::ApplyWindow(filter_bank_states[ch].extended_frame);
+        }
+        NS_STAGE_LAP_ON(timer, NsStage::kFraming);
+
+        ComputeFfts(filter_bank_states.subview(begin, end - begin));
+        NS_STAGE_LAP_ON(timer, NsStage::kFft);
 
-            std::array<float, kFftSizeBy2Plus1> signal_spectrum{};
-            ComputeMagnitudeSpectrum(real, imag, signal_spectrum);
+        // Analyze all channels.
+        for (size_t ch = begin; ch < end; ++ch) {
+            NsUniquePtr<ChannelState> &ch_p = channels_[ch];
+            rtc::ArrayView<const float, kFftSize> real = filter_bank_states[ch].real;
+            rtc::ArrayView<const float, kFftSize> imag = filter_bank_states[ch].imag;
+
+            // Compute the magnitude spectrum.
+            std::array<float, kFftSizeBy2Plus1> signal_spectrum;
+            NsFilterBank<Geometry>::ComputeMagnitudeSpectrum(real, imag,
+                                                             signal_spectrum);
 
             // Compute energies.
             float signal_energy = 0.f;
@@ -351,15 +544,21 @@ namespace webrtc {
             for (size_t i = 0; i < kFftSizeBy2Plus1; ++i) {
                 signal_spectral_sum += signal_spectrum[i];
             }
+            NS_STAGE_LAP_ON(timer, NsStage::kMagnitudeSpectrum);
 
             // Estimate the noise spectra and the probability estimates of speech
             // presence.
-            ch_p->noise_estimator.PreUpdate(num_analyzed_frames_, signal_spectrum,
+            std::array<float, kFftSizeBy2Plus1> quantile_noise_spectrum;
+            ch_p->quantile_noise_estimator.Estimate(signal_spectrum,
+                                                    quantile_noise_spectrum);
+            ch_p->noise_estimator.PreUpdate(num_analyzed_frames_,
+                                            quantile_noise_spectrum, signal_spectrum,
                                             signal_spectral_sum);
+            NS_STAGE_LAP_ON(timer, NsStage::kNoiseEstimation);
 
-            std::array<float, kFftSizeBy2Plus1> post_snr{};
-            std::array<float, kFftSizeBy2Plus1> prior_snr{};
-            ComputeSnr(ch_p->wiener_filter.get_filter(),
+            std::array<float, kFftSizeBy2Plus1> post_snr;
+            std::array<float, kFftSizeBy2Plus1> prior_snr;
+            ComputeSnr<kFftSizeBy2Plus1>(ch_p->wiener_filter.get_filter(),
                        ch_p->prev_analysis_signal_spectrum, signal_spectrum,
                        ch_p->noise_estimator.get_prev_noise_spectrum(),
                        ch_p->noise_estimator.get_noise_spectrum(), prior_snr, post_snr);
@@ -368,6 +567,7 @@ namespace webrtc {
                     num_analyzed_frames_, prior_snr, post_snr,
                     ch_p->noise_estimator.get_conservative_noise_spectrum(),
                     signal_spectrum, signal_spectral_sum, signal_energy);
+            NS_STAGE_LAP_ON(timer, NsStage::kSpeechProbability);
 
             ch_p->noise_estimator.PostUpdate(
                     ch_p->speech_probability_estimator.get_probability(), signal_spectrum);
@@ -376,57 +576,174 @@ namespace webrtc {
             // method.
             std::copy(signal_spectrum.begin(), signal_spectrum.end(),
                       ch_p->prev_analysis_signal_spectrum.begin());
+            NS_STAGE_LAP_ON(timer, NsStage::kNoiseEstimation);
         }
     }
 
-    void NoiseSuppressor::Process(AudioBuffer *audio) {
-        // Select the space for storing data during the processing.
-        std::array<FilterBankState, kMaxNumChannelsOnStack> filter_bank_states_stack{};
-        rtc::ArrayView<FilterBankState> filter_bank_states(
-                filter_bank_states_stack.data(), num_channels_);
-        std::array<float, kMaxNumChannelsOnStack> upper_band_gains_stack{};
-        rtc::ArrayView<float> upper_band_gains(upper_band_gains_stack.data(),
-                                               num_channels_);
-        std::array<float, kMaxNumChannelsOnStack> energies_before_filtering_stack{};
-        rtc::ArrayView<float> energies_before_filtering(
-                energies_before_filtering_stack.data(), num_channels_);
-        std::array<float, kMaxNumChannelsOnStack> gain_adjustments_stack{};
-        rtc::ArrayView<float> gain_adjustments(gain_adjustments_stack.data(),
-                                               num_channels_);
-        if (NumChannelsOnHeap(num_channels_) > 0) {
-            // If the stack-allocated space is too small, use the heap for storing the
-            // data.
-            filter_bank_states = rtc::ArrayView<FilterBankState>(
-                    filter_bank_states_heap_.data(), num_channels_);
-            upper_band_gains =
-                    rtc::ArrayView<float>(upper_band_gains_heap_.data(), num_channels_);
-            energies_before_filtering = rtc::ArrayView<float>(
-                    energies_before_filtering_heap_.data(), num_channels_);
-            gain_adjustments =
-                    rtc::ArrayView<float>(gain_adjustments_heap_.data(), num_channels_);
+    template<typename Geometry>
+    void BasicNoiseSuppressor<Geometry>::Process(AudioBuffer *audio) {
+        RTC_DCHECK_EQ(audio->num_frames_per_band(), AudioBuffer::kSplitBandSize);
+        if (kChunksPerFrame > 1) {
+            // Gather the chunks into a frame and output the part of the previous
+            // frame that follows the chunk, as that part is not yet overwritten.
+            const size_t offset = chunk_index_ * AudioBuffer::kSplitBandSize;
+            const bool last_chunk = ++chunk_index_ == kChunksPerFrame;
+            for (size_t ch = 0; ch < num_channels_; ++ch) {
+                for (size_t b = 0; b < num_bands_; ++b) {
+                    float *y_band = &audio->split_bands(ch)[b][0];
+                    auto &frame = channels_[ch]->process_input[b];
+                    std::copy(y_band, y_band + AudioBuffer::kSplitBandSize,
+                              frame.begin() + offset);
+                    if (!last_chunk) {
+                        std::copy(frame.begin() + offset + AudioBuffer::kSplitBandSize,
+                                  frame.begin() + offset +
+                                  2 * AudioBuffer::kSplitBandSize,
+                                  y_band);
+                    }
+                }
+            }
+            if (!last_chunk) {
+                return;
+            }
+            chunk_index_ = 0;
+
+            if (analysis_pending_) {
+                AnalyzeStoredFrame(0);
+                analysis_pending_ = false;
+            }
+            for (size_t ch = 0; ch < num_channels_; ++ch) {
+                for (size_t b = 0; b < num_bands_; ++b) {
+                    process_frames_[ch * num_bands_ + b] =
+                            channels_[ch]->process_input[b].data();
+                }
+            }
+            ProcessFrame();
+
+            // Output the first part of the processed frame.
+            for (size_t ch = 0; ch < num_channels_; ++ch) {
+                for (size_t b = 0; b < num_bands_; ++b) {
+                    const auto &frame = channels_[ch]->process_input[b];
+                    std::copy(frame.begin(),
+                              frame.begin() + AudioBuffer::kSplitBandSize,
+                              &audio->split_bands(ch)[b][0]);
+                }
+            }
+            return;
         }
 
-        // Compute the suppression filters for all channels.
+        for (size_t k = 0; k < kFramesPerChunk; ++k) {
+            if (analysis_pending_) {
+                AnalyzeStoredFrame(k * kFrameSize);
+            }
+            for (size_t ch = 0; ch < num_channels_; ++ch) {
+                for (size_t b = 0; b < num_bands_; ++b) {
+                    process_frames_[ch * num_bands_ + b] =
+                            &audio->split_bands(ch)[b][k * kFrameSize];
+                }
+            }
+            ProcessFrame();
+        }
+        analysis_pending_ = false;
+    }
+
+    template<typename Geometry>
+    bool BasicNoiseSuppressor<Geometry>::IsSilentFrame() const {
+        // Each band of the frame forms kFftSize samples with its memory.
+        const float frame_floor = silence_floor_ * kFftSize;
+        const float overlap_floor = silence_floor_ * kOverlapSize;
+        for (size_t ch = 0; ch < num_channels_; ++ch) {
+            const ChannelState &channel = *channels_[ch];
+            if (ComputeEnergy(channel.process_synthesis_memory.data(),
+                              kOverlapSize) > overlap_floor) {
+                return false;
+            }
+            for (size_t b = 0; b < num_bands_; ++b) {
+                const float *memory = b == 0
+                                      ? channel.process_analysis_memory.data()
+                                      : channel.process_delay_memory[b - 1].data();
+                const float energy =
+                        ComputeEnergy(memory, kOverlapSize) +
+                        ComputeEnergy(process_frames_[ch * num_bands_ + b], kFrameSize);
+                if (energy > frame_floor) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    template<typename Geometry>
+    void BasicNoiseSuppressor<Geometry>::BypassFrame() {
+        // The magnitude spectrum of a frame of zeros.
+        std::array<float, kFftSizeBy2Plus1> signal_spectrum;
+        signal_spectrum.fill(1.f);
+
         for (size_t ch = 0; ch < num_channels_; ++ch) {
+            ChannelState &channel = *channels_[ch];
+            channel.wiener_filter.Update(
+                    num_analyzed_frames_, channel.noise_estimator.get_noise_spectrum(),
+                    channel.noise_estimator.get_prev_noise_spectrum(),
+                    channel.noise_estimator.get_parametric_noise_spectrum(),
+                    signal_spectrum);
+
+            // The lowest band has the same delay through the filter bank as the
+            // upper bands, and its analysis memory is updated in the same way.
+            for (size_t b = 0; b < num_bands_; ++b) {
+                rtc::ArrayView<float, kFrameSize> y_band(
+                        process_frames_[ch * num_bands_ + b], kFrameSize);
+                rtc::ArrayView<float, kOverlapSize> memory =
+                        b == 0 ? rtc::ArrayView<float, kOverlapSize>(
+                                channel.process_analysis_memory)
+                               : rtc::ArrayView<float, kOverlapSize>(
+                                channel.process_delay_memory[b - 1]);
+                std::array<float, kFrameSize> delayed_frame;
+                NsFilterBank<Geometry>::DelaySignal(y_band, memory, delayed_frame);
+                for (size_t j = 0; j < kFrameSize; ++j) {
+                    y_band[j] =
+                            suppression_params_.minimum_attenuating_gain * delayed_frame[j];
+                }
+            }
+            channel.process_synthesis_memory.fill(0.f);
+        }
+    }
+
+    template<typename Geometry>
+    void BasicNoiseSuppressor<Geometry>::ProcessChannels(
+            size_t begin, size_t end,
+            rtc::ArrayView<FilterBankState> filter_bank_states,
+            rtc::ArrayView<float> energies_before_filtering,
+            rtc::ArrayView<float> upper_band_gains,
+            NsStageTimer *timer) {
+        // Form the extended frames for all channels.
+        for (size_t ch = begin; ch < end; ++ch) {
             // Form an extended frame and apply analysis filter bank windowing.
-            rtc::ArrayView<float, kNsFrameSize> y_band0(&audio->split_bands(ch)[0][0],
-                                                        kNsFrameSize);
+            rtc::ArrayView<float, kFrameSize> y_band0(
+                    process_frames_[ch * num_bands_], kFrameSize);
 
-            FormExtendedFrame(y_band0, channels_[ch]->process_analysis_memory,
-                              filter_bank_states[ch].extended_frame);
+            NsFilterBank<Geometry>::FormExtendedFrame(
+                    y_band0, channels_[ch]->process_analysis_memory,
+                    filter_bank_states[ch].extended_frame);
 
-            ApplyFilterBankWindow(filter_bank_states[ch].extended_frame);
+            NsFilterBank<Geometry>::ApplyWindow(filter_bank_states[ch].extended_frame);
 
             energies_before_filtering[ch] =
-                    ComputeEnergyOfExtendedFrame(filter_bank_states[ch].extended_frame);
+                    NsFilterBank<Geometry>::ComputeEnergyOfExtendedFrame(
+                            filter_bank_states[ch].extended_frame);
+        }
+        NS_STAGE_LAP_ON(timer, NsStage::kFraming);
 
-            // Perform filter bank analysis and compute the magnitude spectrum.
-            fft_.Fft(filter_bank_states[ch].extended_frame, filter_bank_states[ch].real,
-                     filter_bank_states[ch].imag);
+        // Perform filter bank analysis.
+        ComputeFfts(filter_bank_states.subview(begin, end - begin));
+        NS_STAGE_LAP_ON(timer, NsStage::kFft);
 
-            std::array<float, kFftSizeBy2Plus1> signal_spectrum{};
-            ComputeMagnitudeSpectrum(filter_bank_states[ch].real,
-                                     filter_bank_states[ch].imag, signal_spectrum);
+        // Compute the suppression filters for all channels.
+        for (size_t ch = begin; ch < end; ++ch) {
+            // Compute the magnitude spectrum.
+            std::array<float, kFftSizeBy2Plus1> signal_spectrum;
+            NsFilterBank<Geometry>::ComputeMagnitudeSpectrum(
+                    filter_bank_states[ch].real, filter_bank_states[ch].imag,
+                    signal_spectrum);
+            NS_STAGE_LAP_ON(timer, NsStage::kMagnitudeSpectrum);
 
             // Compute the frequency domain gain filter for noise attenuation.
             channels_[ch]->wiener_filter.Update(
@@ -435,21 +752,74 @@ namespace webrtc {
                     channels_[ch]->noise_estimator.get_prev_noise_spectrum(),
                     channels_[ch]->noise_estimator.get_parametric_noise_spectrum(),
                     signal_spectrum);
+            NS_STAGE_LAP_ON(timer, NsStage::kWienerUpdate);
 
             if (num_bands_ > 1) {
                 // Compute the time-domain gain for attenuating the noise in the upper
                 // bands.
 
-                upper_band_gains[ch] = ComputeUpperBandsGain(
+                upper_band_gains[ch] = ComputeUpperBandsGain<Geometry>(
                         suppression_params_.minimum_attenuating_gain,
                         channels_[ch]->wiener_filter.get_filter(),
                         channels_[ch]->speech_probability_estimator.get_probability(),
                         channels_[ch]->prev_analysis_signal_spectrum, signal_spectrum);
+                NS_STAGE_LAP_ON(timer, NsStage::kUpperBandGain);
             }
         }
+    }
+
+    template<typename Geometry>
+    void BasicNoiseSuppressor<Geometry>::ProcessFrame() {
+        NS_STAGE_TIMER(&profiler_);
+
+        if (enable_silence_bypass_ && IsSilentFrame()) {
+            BypassFrame();
+            NS_STAGE_LAP(NsStage::kFraming);
+            return;
+        }
+
+        // Select the space for storing data during the processing.
+        std::array<FilterBankState, kMaxNumChannelsOnStack> filter_bank_states_stack;
+        rtc::ArrayView<FilterBankState> filter_bank_states(
+                filter_bank_states_stack.data(), num_channels_);
+        std::array<float, kMaxNumChannelsOnStack> upper_band_gains_stack;
+        rtc::ArrayView<float> upper_band_gains(upper_band_gains_stack.data(),
+                                               num_channels_);
+        std::array<float, kMaxNumChannelsOnStack> energies_before_filtering_stack;
+        rtc::ArrayView<float> energies_before_filtering(
+                energies_before_filtering_stack.data(), num_channels_);
+        std::array<float, kMaxNumChannelsOnStack> gain_adjustments_stack;
+        rtc::ArrayView<float> gain_adjustments(gain_adjustments_stack.data(),
+                                               num_channels_);
+        if (NumChannelsOnHeap(num_channels_) > 0) {
+            // If the stack-allocated space is too small, use the heap for storing the
+            // data.
+            filter_bank_states = rtc::ArrayView<FilterBankState>(
+                    filter_bank_states_heap_.data(), num_channels_);
+            upper_band_gains =
+                    rtc::ArrayView<float>(upper_band_gains_heap_.data(), num_channels_);
+            energies_before_filtering = rtc::ArrayView<float>(
+                    energies_before_filtering_heap_.data(), num_channels_);
+            gain_adjustments =
+                    rtc::ArrayView<float>(gain_adjustments_heap_.data(), num_channels_);
+        }
+
+        // Compute the suppression filters, with the channels split over the
+        // threads if there are several.
+        if (thread_pool_) {
+            RunOnChannelRanges([&](size_t begin, size_t end) {
+                ProcessChannels(begin, end, filter_bank_states,
+                                energies_before_filtering, upper_band_gains, nullptr);
+            });
+            NS_STAGE_LAP(NsStage::kChannelFanOut);
+        } else {
+            ProcessChannels(0, num_channels_, filter_bank_states,
+                            energies_before_filtering, upper_band_gains,
+                            NS_STAGE_TIMER_PTR());
+        }
 
         // Aggregate the Wiener filters for all channels.
-        std::array<float, kFftSizeBy2Plus1> filter_data{};
+        std::array<float, kFftSizeBy2Plus1> filter_data;
         rtc::ArrayView<const float, kFftSizeBy2Plus1> filter = filter_data;
         if (num_channels_ == 1) {
             filter = channels_[0]->wiener_filter.get_filter();
@@ -465,24 +835,25 @@ namespace webrtc {
             }
         }
 
+        NS_STAGE_LAP(NsStage::kWienerUpdate);
+
         // Perform filter bank synthesis
-        for (size_t ch = 0; ch < num_channels_; ++ch) {
-            fft_.Ifft(filter_bank_states[ch].real, filter_bank_states[ch].imag,
-                      filter_bank_states[ch].extended_frame);
-        }
+        ComputeIffts(filter_bank_states);
+        NS_STAGE_LAP(NsStage::kIfft);
 
         for (size_t ch = 0; ch < num_channels_; ++ch) {
             const float energy_after_filtering =
-                    ComputeEnergyOfExtendedFrame(filter_bank_states[ch].extended_frame);
+                    NsFilterBank<Geometry>::ComputeEnergyOfExtendedFrame(
+                            filter_bank_states[ch].extended_frame);
 
             // Apply synthesis window.
-            ApplyFilterBankWindow(filter_bank_states[ch].extended_frame);
+            NsFilterBank<Geometry>::ApplyWindow(filter_bank_states[ch].extended_frame);
 
             // Compute the adjustment of the noise attenuation filter based on the
             // effect of the attenuation.
             gain_adjustments[ch] =
-                    channels_[ch]->wiener_filter.ComputeOverallScalingFactor(
-                            num_analyzed_frames_,
+                    BasicWienerFilter<Geometry>::ComputeOverallScalingFactor(
+                            suppression_params_, num_analyzed_frames_,
                             channels_[ch]->speech_probability_estimator.get_prior_probability(),
                             energies_before_filtering[ch], energy_after_filtering);
         }
@@ -502,11 +873,13 @@ namespace webrtc {
 
         // Use overlap-and-add to form the output frame of the lowest band.
         for (size_t ch = 0; ch < num_channels_; ++ch) {
-            rtc::ArrayView<float, kNsFrameSize> y_band0(&audio->split_bands(ch)[0][0],
-                                                        kNsFrameSize);
-            OverlapAndAdd(filter_bank_states[ch].extended_frame,
-                          channels_[ch]->process_synthesis_memory, y_band0);
+            rtc::ArrayView<float, kFrameSize> y_band0(
+                    process_frames_[ch * num_bands_], kFrameSize);
+            NsFilterBank<Geometry>::OverlapAndAdd(
+                    filter_bank_states[ch].extended_frame,
+                    channels_[ch]->process_synthesis_memory, y_band0);
         }
+        NS_STAGE_LAP(NsStage::kOverlapAdd);
 
         if (num_bands_ > 1) {
             // Select the noise attenuating gain to apply to the upper band.
@@ -520,30 +893,39 @@ namespace webrtc {
                 for (size_t b = 1; b < num_bands_; ++b) {
                     // Delay the upper bands to match the delay of the filterbank applied to
                     // the lowest band.
-                    rtc::ArrayView<float, kNsFrameSize> y_band(
-                            &audio->split_bands(ch)[b][0], kNsFrameSize);
-                    std::array<float, kNsFrameSize> delayed_frame{};
-                    DelaySignal(y_band, channels_[ch]->process_delay_memory[b - 1],
-                                delayed_frame);
+                    rtc::ArrayView<float, kFrameSize> y_band(
+                            process_frames_[ch * num_bands_ + b], kFrameSize);
+                    std::array<float, kFrameSize> delayed_frame;
+                    NsFilterBank<Geometry>::DelaySignal(
+                            y_band, channels_[ch]->process_delay_memory[b - 1],
+                            delayed_frame);
 
                     // Apply the time-domain noise-attenuating gain.
-                    for (size_t j = 0; j < kNsFrameSize; j++) {
+                    for (size_t j = 0; j < kFrameSize; j++) {
                         y_band[j] = upper_band_gain * delayed_frame[j];
                     }
                 }
             }
+            NS_STAGE_LAP(NsStage::kUpperBandGain);
         }
 
         // Limit the output the allowed range.
         for (size_t ch = 0; ch < num_channels_; ++ch) {
             for (size_t b = 0; b < num_bands_; ++b) {
-                rtc::ArrayView<float, kNsFrameSize> y_band(&audio->split_bands(ch)[b][0],
-                                                           kNsFrameSize);
-                for (size_t j = 0; j < kNsFrameSize; j++) {
+                rtc::ArrayView<float, kFrameSize> y_band(
+                        process_frames_[ch * num_bands_ + b], kFrameSize);
+                for (size_t j = 0; j < kFrameSize; j++) {
                     y_band[j] = std::min(std::max(y_band[j], -32768.f), 32767.f);
                 }
             }
         }
+        NS_STAGE_LAP(NsStage::kOverlapAdd);
     }
 
+    template class BasicNoiseSuppressor<NsDefaultGeometry>;
+
+    template class BasicNoiseSuppressor<NsLowDelayGeometry>;
+
+    template class BasicNoiseSuppressor<NsHighEfficiencyGeometry>;
+
 }  // namespace webrtc
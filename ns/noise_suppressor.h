@@ -11,56 +11,134 @@
 #ifndef MODULES_AUDIO_PROCESSING_NS_NOISE_SUPPRESSOR_H_
 #define MODULES_AUDIO_PROCESSING_NS_NOISE_SUPPRESSOR_H_
 
+#include <stdint.h>
+
 #include <memory>
 #include <vector>
 
 #include "array_view.h"
 #include "audio_buffer.h"
 #include "noise_estimator.h"
+#include "noise_profile.h"
+#include "ns_allocator.h"
+#include "ns_arena.h"
 #include "ns_common.h"
 #include "ns_config.h"
 #include "ns_fft.h"
+#include "ns_profiler.h"
+#include "ns_thread_pool.h"
+#include "quantile_noise_estimator.h"
 #include "speech_probability_estimator.h"
 #include "wiener_filter.h"
 
 namespace webrtc {
 
-// Class for suppressing noise in a signal.
-    class NoiseSuppressor {
+// Class for suppressing noise in a signal, with the frame geometry |Geometry|,
+// see NsGeometry. Instantiated for NsDefaultGeometry, as NoiseSuppressor, for
+// NsLowDelayGeometry, as LowDelayNoiseSuppressor, and for
+// NsHighEfficiencyGeometry, as HighEfficiencyNoiseSuppressor.
+    template<typename Geometry>
+    class BasicNoiseSuppressor {
     public:
-        NoiseSuppressor(const NsConfig &config,
-                        size_t sample_rate_hz,
-                        size_t num_channels);
+        // If |allocator| is not null, the state of all channels is allocated from
+        // it, which must then outlive the suppressor. The thread pool, if any, is
+        // always allocated on the heap.
+        BasicNoiseSuppressor(const NsConfig &config,
+                             size_t sample_rate_hz,
+                             size_t num_channels,
+                             NsAllocator *allocator = nullptr);
+
+        // Adds the state of a suppressor constructed with the same rate and number
+        // of channels and an allocator to |layout|.
+        static void AddToLayout(NsArenaLayout *layout,
+                                size_t sample_rate_hz,
+                                size_t num_channels);
 
-        NoiseSuppressor(const NoiseSuppressor &) = delete;
+        BasicNoiseSuppressor(const BasicNoiseSuppressor &) = delete;
 
-        NoiseSuppressor &operator=(const NoiseSuppressor &) = delete;
+        BasicNoiseSuppressor &operator=(const BasicNoiseSuppressor &) = delete;
 
         // Analyses the signal (typically applied before the AEC to avoid analyzing
-        // any comfort noise signal).
+        // any comfort noise signal). When a 10 ms chunk does not hold exactly one
+        // frame, the chunk is stored and each frame is analyzed in Process() right
+        // before it is processed.
         void Analyze(const AudioBuffer &audio);
 
-        // Applies noise suppression.
+        // Applies noise suppression. When a frame spans several 10 ms chunks, the
+        // output is delayed by kFrameSize - AudioBuffer::kSplitBandSize samples in
+        // each band.
         void Process(AudioBuffer *audio);
 
+        // Seeds all channels with |profile|, e.g. from GetNoiseProfile() of a
+        // suppressor that ran in a similar acoustic environment, so that the
+        // startup phase is skipped. Must be called before the first Analyze().
+        void SeedNoiseProfile(const BasicNoiseProfile<Geometry> &profile);
+
+        // Returns the current noise profile of channel |ch|.
+        BasicNoiseProfile<Geometry> GetNoiseProfile(size_t ch) const;
+
+        // Serializes the adaptive state of all channels, including any buffered
+        // audio, into |state| as a versioned binary blob, in host byte order.
+        void SaveState(std::vector<uint8_t> *state) const;
+
+        // Restores a state produced by SaveState() on a suppressor with the same
+        // geometry, sample rate and number of channels. Returns false, and leaves
+        // the state unchanged, if |state| has the wrong version, layout or size,
+        // or holds an invalid chunk position.
+        bool LoadState(rtc::ArrayView<const uint8_t> state);
+
+#if defined(WEBRTC_NS_PROFILING)
+        // Returns the per-stage histograms of the time spent in Analyze() and
+        // Process().
+        const NsProfiler &profiler() const { return profiler_; }
+
+        void ResetProfiler() { profiler_.Reset(); }
+#endif
+
     private:
+        static constexpr size_t kFftSize = Geometry::kFftSize;
+        static constexpr size_t kFftSizeBy2Plus1 = Geometry::kFftSizeBy2Plus1;
+        static constexpr size_t kFrameSize = Geometry::kFrameSize;
+        static constexpr size_t kOverlapSize = Geometry::kOverlapSize;
+        static constexpr size_t kFramesPerChunk =
+                kFrameSize < AudioBuffer::kSplitBandSize
+                ? AudioBuffer::kSplitBandSize / kFrameSize : 1;
+        static constexpr size_t kChunksPerFrame =
+                kFrameSize > AudioBuffer::kSplitBandSize
+                ? kFrameSize / AudioBuffer::kSplitBandSize : 1;
+        static_assert(kFramesPerChunk * kFrameSize ==
+                      kChunksPerFrame * AudioBuffer::kSplitBandSize,
+                      "The 10 ms chunks must hold whole frames or the other way round");
+
         const size_t num_bands_;
         const size_t num_channels_;
         const SuppressionParams suppression_params_;
+        const bool enable_silence_bypass_;
+        const float silence_floor_;
         int32_t num_analyzed_frames_ = -1;
-        NrFft fft_;
+        typename NsFftForSize<kFftSize>::Type fft_;
 
         struct ChannelState {
-            ChannelState(const SuppressionParams &suppression_params, size_t num_bands);
-
-            SpeechProbabilityEstimator speech_probability_estimator;
-            WienerFilter wiener_filter;
-            NoiseEstimator noise_estimator;
+            ChannelState(const SuppressionParams &suppression_params,
+                         size_t num_bands,
+                         NsAllocator *allocator);
+
+            BasicSpeechProbabilityEstimator<Geometry> speech_probability_estimator;
+            BasicWienerFilter<Geometry> wiener_filter;
+            BasicNoiseEstimator<Geometry> noise_estimator;
+            BasicQuantileNoiseEstimator<Geometry> quantile_noise_estimator;
             std::array<float, kFftSizeBy2Plus1> prev_analysis_signal_spectrum{};
-            std::array<float, kFftSize - kNsFrameSize> analyze_analysis_memory{};
+            std::array<float, kOverlapSize> analyze_analysis_memory{};
             std::array<float, kOverlapSize> process_analysis_memory{};
             std::array<float, kOverlapSize> process_synthesis_memory{};
-            std::vector<std::array<float, kOverlapSize>> process_delay_memory;
+            NsVector<std::array<float, kOverlapSize>> process_delay_memory;
+            // The lowest band of the chunks passed to Analyze(), stored when the
+            // analysis is deferred to Process().
+            NsVector<float> analysis_input;
+            // The frame being gathered from the chunks passed to Process(), for each
+            // band, when a frame spans several chunks. The part after the gathered
+            // chunks still holds the output of the previous frame.
+            NsVector<std::array<float, kFrameSize>> process_input;
         };
 
         struct FilterBankState {
@@ -69,17 +147,94 @@ namespace webrtc {
             std::array<float, kFftSize> extended_frame;
         };
 
-        std::vector<FilterBankState> filter_bank_states_heap_;
-        std::vector<float> upper_band_gains_heap_;
-        std::vector<float> energies_before_filtering_heap_;
-        std::vector<float> gain_adjustments_heap_;
-        std::vector<std::unique_ptr<ChannelState>> channels_;
+        NsVector<FilterBankState> filter_bank_states_heap_;
+        NsVector<float> upper_band_gains_heap_;
+        NsVector<float> energies_before_filtering_heap_;
+        NsVector<float> gain_adjustments_heap_;
+        NsVector<NsUniquePtr<ChannelState>> channels_;
+        NsVector<const float *> analysis_frames_;
+        NsVector<float *> process_frames_;
+        // Set when the channels are split over several threads.
+        std::unique_ptr<NsThreadPool> thread_pool_;
+        bool analysis_pending_ = false;
+        // The index of the next chunk within the frame being gathered.
+        uint32_t chunk_index_ = 0;
+#if defined(WEBRTC_NS_PROFILING)
+        NsProfiler profiler_;
+#endif
+
+        // The number of bytes that SaveState() produces.
+        size_t StateSize() const;
+
+        // Analyzes one frame of each channel, starting at analysis_frames_[ch].
+        void AnalyzeFrame();
+
+        // Forms the extended frames of channels |begin|..|end|-1, transforms them
+        // and updates their estimates, timing the stages on |timer| if not null.
+        void AnalyzeChannels(size_t begin, size_t end,
+                             rtc::ArrayView<FilterBankState> filter_bank_states,
+                             NsStageTimer *timer);
+
+        // Analyzes the frame at |offset| in the chunk stored by Analyze().
+        void AnalyzeStoredFrame(size_t offset);
+
+        // Applies noise suppression to one frame of each band of each channel,
+        // starting at process_frames_[ch * num_bands_ + b].
+        void ProcessFrame();
+
+        // Forms and transforms the extended frames of channels |begin|..|end|-1
+        // and updates their Wiener filters and upper band gains, timing the
+        // stages on |timer| if not null.
+        void ProcessChannels(size_t begin, size_t end,
+                             rtc::ArrayView<FilterBankState> filter_bank_states,
+                             rtc::ArrayView<float> energies_before_filtering,
+                             rtc::ArrayView<float> upper_band_gains,
+                             NsStageTimer *timer);
+
+        // Calls f(begin, end) for contiguous ranges of channels on the threads of
+        // |thread_pool_|.
+        template<typename F>
+        void RunOnChannelRanges(const F &f);
+
+        // Returns true if the current frame of all bands of all channels, the
+        // samples kept for the analysis and delay of the next frame, and the
+        // pending overlap-and-add output are all at or below the silence floor.
+        // As the overlap-and-add output must have decayed, the bypass starts one
+        // frame after the audio goes silent.
+        bool IsSilentFrame() const;
+
+        // Counterpart of ProcessFrame() for silent frames, which skips the filter
+        // bank and outputs the delayed frame at the minimum gain. The filter bank
+        // memories and the Wiener filters are updated as for a frame of zeros,
+        // which keeps the output unchanged for digital silence. For a nonzero
+        // silence floor, the discarded synthesis memory and the zero spectrum make
+        // the first frames after the bypass differ from the full processing.
+        void BypassFrame();
 
         // Aggregates the Wiener filters into a single filter to use.
         void AggregateWienerFilters(
                 rtc::ArrayView<float, kFftSizeBy2Plus1> filter) const;
+
+        // Transforms the extended frames into the real and imaginary spectra for
+        // all channels, batching the channels when there are more than one.
+        void ComputeFfts(rtc::ArrayView<FilterBankState> filter_bank_states);
+
+        // Transforms the real and imaginary spectra into the extended frames for
+        // all channels, batching the channels when there are more than one.
+        void ComputeIffts(rtc::ArrayView<FilterBankState> filter_bank_states);
     };
 
+    using NoiseSuppressor = BasicNoiseSuppressor<NsDefaultGeometry>;
+
+// Noise suppressor with 5 ms frames, which halves the algorithmic delay of the
+// suppression to 3 ms, for a slightly weaker suppression.
+    using LowDelayNoiseSuppressor = BasicNoiseSuppressor<NsLowDelayGeometry>;
+
+// Noise suppressor with 20 ms frames, which halves the computations per second
+// at the cost of 10 ms of extra delay, for offline and batch processing.
+    using HighEfficiencyNoiseSuppressor =
+            BasicNoiseSuppressor<NsHighEfficiencyGeometry>;
+
 }  // namespace webrtc
 
 #endif  // MODULES_AUDIO_PROCESSING_NS_NOISE_SUPPRESSOR_H_
@@ -0,0 +1,723 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "noise_suppressor_batch.h"
+
+#include <math.h>
+#include <algorithm>
+
+#include "arch.h"
+#include "checks.h"
+#include "fast_math.h"
+#include "ns_filter_bank.h"
+#include "upper_bands_gain.h"
+#include "wiener_filter.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define WEBRTC_NOISE_SUPPRESSOR_BATCH_SSE2
+#include "simd_ops_sse2.h"
+#elif defined(WEBRTC_HAS_NEON)
+#include "simd_ops_neon.h"
+#endif
+
+namespace webrtc {
+
+    namespace {
+
+        using FilterBank = NsFilterBank<NsDefaultGeometry>;
+
+        constexpr size_t kNumLanes = NoiseSuppressorBatch::kNumLanes;
+        constexpr size_t kNumValues = kFftSizeBy2Plus1 * kNumLanes;
+
+        // Maps sample rate to number of bands.
+        size_t NumBandsForRate(size_t sample_rate_hz) {
+            RTC_DCHECK(sample_rate_hz == 16000 || sample_rate_hz == 32000 ||
+                       sample_rate_hz == 48000);
+            return sample_rate_hz / 16000;
+        }
+
+#if !defined(WEBRTC_NOISE_SUPPRESSOR_BATCH_SSE2) && !defined(WEBRTC_HAS_NEON)
+        // Counterpart of the SIMD ops with a single lane, for the platforms
+        // without SIMD support.
+        struct ScalarOps {
+            using V = float;
+            using M = bool;
+            static constexpr size_t kWidth = 1;
+
+            static V Load(const float *p) { return *p; }
+
+            static void Store(float *p, V v) { *p = v; }
+
+            static V Set1(float x) { return x; }
+
+            static V Add(V a, V b) { return a + b; }
+
+            static V Sub(V a, V b) { return a - b; }
+
+            static V Mul(V a, V b) { return a * b; }
+
+            static V Div(V a, V b) { return a / b; }
+
+            static V Min(V a, V b) { return std::min(a, b); }
+
+            static V Max(V a, V b) { return std::max(a, b); }
+
+            static V Abs(V v) { return fabsf(v); }
+
+            static M Greater(V a, V b) { return a > b; }
+
+            static M Less(V a, V b) { return a < b; }
+
+            static M LoadMask(const int *p) { return *p != 0; }
+
+            static V Select(M mask, V a, V b) { return mask ? a : b; }
+        };
+#endif
+
+        // The kernels below run over the interleaved spectra of a group, with
+        // one SIMD vector holding the same bin of kWidth sessions. They perform
+        // the same operations in the same order as the scalar code of the mono
+        // suppressor, with the branches replaced by masks, so their results are
+        // bit-exact to it.
+#if defined(WEBRTC_NOISE_SUPPRESSOR_BATCH_SSE2)
+        using LaneOps = Sse2Ops;
+#elif defined(WEBRTC_HAS_NEON)
+        using LaneOps = NeonOps;
+#else
+        using LaneOps = ScalarOps;
+#endif
+        static_assert(kNumLanes % LaneOps::kWidth == 0,
+                      "The lanes of a group must fill whole SIMD vectors");
+
+        // Interleaved counterpart of the update of one of the simultaneous
+        // quantile tracks in QuantileNoiseEstimator::Estimate, which only updates
+        // the lanes set in |active|.
+        template<typename Ops>
+        void UpdateQuantileTrack(const int *active,
+                                 const float *counter,
+                                 const float *one_by_counter_plus_1,
+                                 const float *log_spectrum,
+                                 float *density,
+                                 float *log_quantile) {
+            using V = typename Ops::V;
+            using M = typename Ops::M;
+            constexpr float kWidth = 0.01f;
+            constexpr float kOneByWidthPlus2 = 1.f / (2.f * kWidth);
+            const V one = Ops::Set1(1.f);
+            const V forty = Ops::Set1(40.f);
+            const V up_step = Ops::Set1(0.25f);
+            const V down_step = Ops::Set1(0.75f);
+            const V width = Ops::Set1(kWidth);
+            const V one_by_width_plus_2 = Ops::Set1(kOneByWidthPlus2);
+            for (size_t k = 0; k < kNumValues; k += Ops::kWidth) {
+                const size_t l = k % kNumLanes;
+                const M active_k = Ops::LoadMask(&active[l]);
+                const V counter_k = Ops::Load(&counter[l]);
+                const V one_by_counter_plus_1_k = Ops::Load(&one_by_counter_plus_1[l]);
+                const V log_spectrum_k = Ops::Load(&log_spectrum[k]);
+                const V density_k = Ops::Load(&density[k]);
+                const V log_quantile_k = Ops::Load(&log_quantile[k]);
+
+                // Update log quantile estimate.
+                const V delta = Ops::Select(Ops::Greater(density_k, one),
+                                            Ops::Div(forty, density_k), forty);
+                const V multiplier = Ops::Mul(delta, one_by_counter_plus_1_k);
+                const V new_log_quantile = Ops::Select(
+                        Ops::Greater(log_spectrum_k, log_quantile_k),
+                        Ops::Add(log_quantile_k, Ops::Mul(up_step, multiplier)),
+                        Ops::Sub(log_quantile_k, Ops::Mul(down_step, multiplier)));
+
+                // Update density estimate.
+                const V distance =
+                        Ops::Abs(Ops::Sub(log_spectrum_k, new_log_quantile));
+                const V new_density = Ops::Select(
+                        Ops::Less(distance, width),
+                        Ops::Mul(Ops::Add(Ops::Mul(counter_k, density_k),
+                                          one_by_width_plus_2),
+                                 one_by_counter_plus_1_k),
+                        density_k);
+
+                Ops::Store(&log_quantile[k],
+                           Ops::Select(active_k, new_log_quantile, log_quantile_k));
+                Ops::Store(&density[k], Ops::Select(active_k, new_density, density_k));
+            }
+        }
+
+        // Interleaved counterpart of ComputeSnr in noise_suppressor.cc.
+        template<typename Ops>
+        void ComputeSnr(const float *filter,
+                        const float *prev_signal_spectrum,
+                        const float *signal_spectrum,
+                        const float *prev_noise_spectrum,
+                        const float *noise_spectrum,
+                        float *prior_snr,
+                        float *post_snr) {
+            using V = typename Ops::V;
+            const V zero = Ops::Set1(0.f);
+            const V one = Ops::Set1(1.f);
+            const V regularization = Ops::Set1(0.0001f);
+            const V prev_weight = Ops::Set1(0.98f);
+            const V current_weight = Ops::Set1(1.f - 0.98f);
+            for (size_t k = 0; k < kNumValues; k += Ops::kWidth) {
+                const V signal_k = Ops::Load(&signal_spectrum[k]);
+                const V noise_k = Ops::Load(&noise_spectrum[k]);
+
+                // Previous estimate: based on previous frame with gain filter.
+                const V prev_estimate = Ops::Mul(
+                        Ops::Div(Ops::Load(&prev_signal_spectrum[k]),
+                                 Ops::Add(Ops::Load(&prev_noise_spectrum[k]),
+                                          regularization)),
+                        Ops::Load(&filter[k]));
+                // Post SNR.
+                const V post_snr_k = Ops::Select(
+                        Ops::Greater(signal_k, noise_k),
+                        Ops::Sub(Ops::Div(signal_k, Ops::Add(noise_k, regularization)),
+                                 one),
+                        zero);
+                // The directed decision estimate of the prior SNR is a sum the
+                // current and previous estimates.
+                Ops::Store(&prior_snr[k],
+                           Ops::Add(Ops::Mul(prev_weight, prev_estimate),
+                                    Ops::Mul(current_weight, post_snr_k)));
+                Ops::Store(&post_snr[k], post_snr_k);
+            }
+        }
+
+        // Interleaved counterpart of the directed decision update in
+        // WienerFilter::Update.
+        template<typename Ops>
+        void UpdateWienerFilter(const SuppressionParams &suppression_params,
+                                const float *noise_spectrum,
+                                const float *prev_noise_spectrum,
+                                const float *signal_spectrum,
+                                float *spectrum_prev_process,
+                                float *filter) {
+            using V = typename Ops::V;
+            const V zero = Ops::Set1(0.f);
+            const V one = Ops::Set1(1.f);
+            const V regularization = Ops::Set1(0.0001f);
+            const V prev_weight = Ops::Set1(0.98f);
+            const V current_weight = Ops::Set1(1.f - 0.98f);
+            const V over_subtraction_factor =
+                    Ops::Set1(suppression_params.over_subtraction_factor);
+            const V minimum_attenuating_gain =
+                    Ops::Set1(suppression_params.minimum_attenuating_gain);
+            for (size_t k = 0; k < kNumValues; k += Ops::kWidth) {
+                const V signal_k = Ops::Load(&signal_spectrum[k]);
+                const V noise_k = Ops::Load(&noise_spectrum[k]);
+
+                // Previous estimate based on previous frame with gain filter.
+                const V prev_tsa = Ops::Mul(
+                        Ops::Div(Ops::Load(&spectrum_prev_process[k]),
+                                 Ops::Add(Ops::Load(&prev_noise_spectrum[k]),
+                                          regularization)),
+                        Ops::Load(&filter[k]));
+
+                // Current estimate.
+                const V current_tsa = Ops::Select(
+                        Ops::Greater(signal_k, noise_k),
+                        Ops::Sub(Ops::Div(signal_k, Ops::Add(noise_k, regularization)),
+                                 one),
+                        zero);
+
+                // Directed decision estimate is sum of two terms: current estimate
+                // and previous estimate.
+                const V snr_prior = Ops::Add(Ops::Mul(prev_weight, prev_tsa),
+                                             Ops::Mul(current_weight, current_tsa));
+                const V filter_k =
+                        Ops::Div(snr_prior, Ops::Add(over_subtraction_factor, snr_prior));
+                Ops::Store(&filter[k], Ops::Max(Ops::Min(filter_k, one),
+                                                minimum_attenuating_gain));
+                Ops::Store(&spectrum_prev_process[k], signal_k);
+            }
+        }
+
+        // Interleaved counterpart of the startup phase in WienerFilter::Update,
+        // which only updates the lanes set in |startup|. |num_analyzed_frames|
+        // and |num_remaining_frames| hold the number of analyzed frames and the
+        // number of frames until the end of the startup phase of each lane.
+        template<typename Ops>
+        void UpdateInitialWienerFilter(const SuppressionParams &suppression_params,
+                                       const int *startup,
+                                       const float *num_analyzed_frames,
+                                       const float *num_remaining_frames,
+                                       const float *parametric_noise_spectrum,
+                                       const float *signal_spectrum,
+                                       float *initial_spectral_estimate,
+                                       float *filter) {
+            using V = typename Ops::V;
+            using M = typename Ops::M;
+            const V one = Ops::Set1(1.f);
+            const V regularization = Ops::Set1(0.0001f);
+            const V over_subtraction_factor =
+                    Ops::Set1(suppression_params.over_subtraction_factor);
+            const V minimum_attenuating_gain =
+                    Ops::Set1(suppression_params.minimum_attenuating_gain);
+            const V one_by_short_startup_phase_blocks =
+                    Ops::Set1(1.f / kShortStartupPhaseBlocks);
+            for (size_t k = 0; k < kNumValues; k += Ops::kWidth) {
+                const size_t l = k % kNumLanes;
+                const M startup_k = Ops::LoadMask(&startup[l]);
+                const V initial_k = Ops::Load(&initial_spectral_estimate[k]);
+                const V filter_k = Ops::Load(&filter[k]);
+
+                const V new_initial_k =
+                        Ops::Add(initial_k, Ops::Load(&signal_spectrum[k]));
+                V filter_initial = Ops::Sub(
+                        new_initial_k,
+                        Ops::Mul(over_subtraction_factor,
+                                 Ops::Load(&parametric_noise_spectrum[k])));
+                filter_initial = Ops::Div(filter_initial,
+                                          Ops::Add(new_initial_k, regularization));
+                filter_initial = Ops::Max(Ops::Min(filter_initial, one),
+                                          minimum_attenuating_gain);
+
+                // Weight the two suppression filters.
+                filter_initial =
+                        Ops::Mul(filter_initial, Ops::Load(&num_remaining_frames[l]));
+                V new_filter_k = Ops::Mul(filter_k, Ops::Load(&num_analyzed_frames[l]));
+                new_filter_k = Ops::Add(new_filter_k, filter_initial);
+                new_filter_k = Ops::Mul(new_filter_k, one_by_short_startup_phase_blocks);
+
+                Ops::Store(&initial_spectral_estimate[k],
+                           Ops::Select(startup_k, new_initial_k, initial_k));
+                Ops::Store(&filter[k], Ops::Select(startup_k, new_filter_k, filter_k));
+            }
+        }
+
+        // Stores |x| in lane |lane| of the interleaved spectrum |y|.
+        void InterleaveLane(rtc::ArrayView<const float, kFftSizeBy2Plus1> x,
+                            size_t lane,
+                            float *y) {
+            for (size_t i = 0; i < kFftSizeBy2Plus1; ++i) {
+                y[i * kNumLanes + lane] = x[i];
+            }
+        }
+
+        // Stores lane |lane| of the interleaved spectrum |x| in |y|.
+        void DeinterleaveLane(const float *x,
+                              size_t lane,
+                              rtc::ArrayView<float, kFftSizeBy2Plus1> y) {
+            for (size_t i = 0; i < kFftSizeBy2Plus1; ++i) {
+                y[i] = x[i * kNumLanes + lane];
+            }
+        }
+
+    }  // namespace
+
+    NoiseSuppressorBatch::SessionState::SessionState(
+            const SuppressionParams &suppression_params)
+            : noise_estimator(suppression_params) {}
+
+    template<size_t... kLanes>
+    NoiseSuppressorBatch::LaneGroup::LaneGroup(
+            const SuppressionParams &suppression_params,
+            std::index_sequence<kLanes...>)
+            : sessions{{(static_cast<void>(kLanes), suppression_params)...}} {
+        num_analyzed_frames.fill(-1);
+
+        // Initialize as QuantileNoiseEstimator.
+        for (auto &d : density) {
+            d.fill(0.3f);
+        }
+        for (auto &q : log_quantile) {
+            q.fill(8.f);
+        }
+        quantile.fill(0.f);
+        constexpr float kOneBySimult = 1.f / kSimult;
+        for (int s = 0; s < kSimult; ++s) {
+            counter[s].fill(
+                    floor(kLongStartupPhaseBlocks * (s + 1.f) * kOneBySimult));
+        }
+        num_updates.fill(1);
+
+        // Initialize as WienerFilter.
+        spectrum_prev_process.fill(0.f);
+        initial_spectral_estimate.fill(0.f);
+        filter.fill(1.f);
+
+        prev_analysis_signal_spectrum.fill(1.f);
+    }
+
+    NoiseSuppressorBatch::LaneGroup::LaneGroup(
+            const SuppressionParams &suppression_params)
+            : LaneGroup(suppression_params, std::make_index_sequence<kNumLanes>()) {}
+
+    NoiseSuppressorBatch::NoiseSuppressorBatch(const NsConfig &config,
+                                               size_t sample_rate_hz,
+                                               size_t num_sessions)
+            : num_bands_(NumBandsForRate(sample_rate_hz)),
+              num_sessions_(num_sessions),
+              suppression_params_(config.target_level),
+              groups_((num_sessions + kNumLanes - 1) / kNumLanes) {
+        RTC_DCHECK(!config.enable_silence_bypass);
+        for (auto &group : groups_) {
+            group = std::make_unique<LaneGroup>(suppression_params_);
+        }
+        // The lanes of the last group that hold no session are only read by the
+        // kernels, so they are kept at harmless values.
+        signal_spectrum_.fill(1.f);
+        noise_spectrum_.fill(1.f);
+        prev_noise_spectrum_.fill(1.f);
+        parametric_noise_spectrum_.fill(1.f);
+    }
+
+    NoiseSuppressorBatch::~NoiseSuppressorBatch() = default;
+
+    void NoiseSuppressorBatch::Analyze(
+            rtc::ArrayView<const AudioBuffer *const> audio) {
+        RTC_DCHECK_EQ(num_sessions_, audio.size());
+        for (size_t g = 0; g < groups_.size(); ++g) {
+            AnalyzeGroup(g, audio);
+        }
+    }
+
+    void NoiseSuppressorBatch::Process(rtc::ArrayView<AudioBuffer *const> audio) {
+        RTC_DCHECK_EQ(num_sessions_, audio.size());
+        for (size_t g = 0; g < groups_.size(); ++g) {
+            ProcessGroup(g, audio);
+        }
+    }
+
+    void NoiseSuppressorBatch::AnalyzeGroup(
+            size_t g, rtc::ArrayView<const AudioBuffer *const> audio) {
+        LaneGroup &group = *groups_[g];
+        const size_t num_lanes = std::min(kNumLanes, num_sessions_ - g * kNumLanes);
+
+        // Transform the frames of the sessions, skipping the zero frames as the
+        // mono suppressor does.
+        std::array<int, kNumLanes> active{};
+        std::array<float, kNumLanes> signal_energies;
+        std::array<float, kNumLanes> signal_spectral_sums;
+        std::array<float *, kNumLanes> time_data;
+        std::array<float *, kNumLanes> real;
+        std::array<float *, kNumLanes> imag;
+        size_t num_active = 0;
+        for (size_t l = 0; l < num_lanes; ++l) {
+            SessionState &session = group.sessions[l];
+            session.noise_estimator.PrepareAnalysis();
+
+            RTC_DCHECK_EQ(1, audio[g * kNumLanes + l]->num_channels());
+            rtc::ArrayView<const float, kNsFrameSize> y_band0(
+                    &audio[g * kNumLanes + l]->split_bands_const(0)[0][0],
+                    kNsFrameSize);
+            if (!(FilterBank::ComputeEnergyOfExtendedFrame(
+                    y_band0, session.analyze_analysis_memory) > 0.f)) {
+                continue;
+            }
+            active[l] = 1;
+            if (++group.num_analyzed_frames[l] < 0) {
+                group.num_analyzed_frames[l] = 0;
+            }
+
+            FilterBankState &state = filter_bank_states_[l];
+            FilterBank::FormExtendedFrame(y_band0, session.analyze_analysis_memory,
+                                          state.extended_frame);
+            FilterBank::ApplyWindow(state.extended_frame);
+            time_data[num_active] = state.extended_frame.data();
+            real[num_active] = state.real.data();
+            imag[num_active] = state.imag.data();
+            ++num_active;
+        }
+        if (num_active == 0) {
+            return;
+        }
+        fft_.FftBatch(rtc::ArrayView<float *const>(time_data.data(), num_active),
+                      rtc::ArrayView<float *const>(real.data(), num_active),
+                      rtc::ArrayView<float *const>(imag.data(), num_active));
+
+        for (size_t l = 0; l < num_lanes; ++l) {
+            if (!active[l]) {
+                continue;
+            }
+            const FilterBankState &state = filter_bank_states_[l];
+            FilterBank::ComputeMagnitudeSpectrum(state.real, state.imag,
+                                                 signal_spectra_[l]);
+
+            float signal_energy = 0.f;
+            for (size_t i = 0; i < kFftSizeBy2Plus1; ++i) {
+                signal_energy +=
+                        state.real[i] * state.real[i] + state.imag[i] * state.imag[i];
+            }
+            signal_energies[l] = signal_energy / kFftSizeBy2Plus1;
+
+            float signal_spectral_sum = 0.f;
+            for (size_t i = 0; i < kFftSizeBy2Plus1; ++i) {
+                signal_spectral_sum += signal_spectra_[l][i];
+            }
+            signal_spectral_sums[l] = signal_spectral_sum;
+            InterleaveLane(signal_spectra_[l], l, signal_spectrum_.data());
+        }
+
+        // Update the quantile noise estimates of the active sessions.
+        LaneSpectrum &log_spectrum = prior_snr_;
+        LogApproximation(signal_spectrum_, log_spectrum);
+        std::array<int, kNumLanes> quantile_index_to_return;
+        quantile_index_to_return.fill(-1);
+        for (int s = 0; s < kSimult; ++s) {
+            std::array<float, kNumLanes> counter;
+            std::array<float, kNumLanes> one_by_counter_plus_1;
+            for (size_t l = 0; l < kNumLanes; ++l) {
+                counter[l] = group.counter[s][l];
+                one_by_counter_plus_1[l] = 1.f / (group.counter[s][l] + 1.f);
+            }
+            UpdateQuantileTrack<LaneOps>(active.data(), counter.data(),
+                                         one_by_counter_plus_1.data(),
+                                         log_spectrum.data(), group.density[s].data(),
+                                         group.log_quantile[s].data());
+
+            for (size_t l = 0; l < num_lanes; ++l) {
+                if (!active[l]) {
+                    continue;
+                }
+                if (group.counter[s][l] >= kLongStartupPhaseBlocks) {
+                    group.counter[s][l] = 0;
+                    if (group.num_updates[l] >= kLongStartupPhaseBlocks) {
+                        quantile_index_to_return[l] = s;
+                    }
+                }
+                ++group.counter[s][l];
+            }
+        }
+
+        bool any_quantile_update = false;
+        for (size_t l = 0; l < num_lanes; ++l) {
+            if (!active[l]) {
+                continue;
+            }
+            // Sequentially update the noise during startup.
+            if (group.num_updates[l] < kLongStartupPhaseBlocks) {
+                // Use the last "s" to get noise during startup that differ from zero.
+                quantile_index_to_return[l] = kSimult - 1;
+                ++group.num_updates[l];
+            }
+            any_quantile_update =
+                    any_quantile_update || quantile_index_to_return[l] >= 0;
+        }
+
+        if (any_quantile_update) {
+            LaneSpectrum &selected_log_quantile = prior_snr_;
+            LaneSpectrum &selected_quantile = post_snr_;
+            for (size_t k = 0; k < kNumValues; ++k) {
+                const int s = quantile_index_to_return[k % kNumLanes];
+                selected_log_quantile[k] = s >= 0 ? group.log_quantile[s][k] : 0.f;
+            }
+            ExpApproximation(selected_log_quantile, selected_quantile);
+            for (size_t k = 0; k < kNumValues; ++k) {
+                if (quantile_index_to_return[k % kNumLanes] >= 0) {
+                    group.quantile[k] = selected_quantile[k];
+                }
+            }
+        }
+
+        // Estimate the noise spectra of the active sessions.
+        for (size_t l = 0; l < num_lanes; ++l) {
+            if (!active[l]) {
+                continue;
+            }
+            std::array<float, kFftSizeBy2Plus1> quantile_noise_spectrum;
+            DeinterleaveLane(group.quantile.data(), l, quantile_noise_spectrum);
+            NoiseEstimator &noise_estimator = group.sessions[l].noise_estimator;
+            noise_estimator.PreUpdate(group.num_analyzed_frames[l],
+                                      quantile_noise_spectrum, signal_spectra_[l],
+                                      signal_spectral_sums[l]);
+            InterleaveLane(noise_estimator.get_noise_spectrum(), l,
+                           noise_spectrum_.data());
+            InterleaveLane(noise_estimator.get_prev_noise_spectrum(), l,
+                           prev_noise_spectrum_.data());
+        }
+
+        ComputeSnr<LaneOps>(group.filter.data(),
+                            group.prev_analysis_signal_spectrum.data(),
+                            signal_spectrum_.data(), prev_noise_spectrum_.data(),
+                            noise_spectrum_.data(), prior_snr_.data(),
+                            post_snr_.data());
+
+        // Estimate the probabilities of speech presence and update the noise
+        // spectra of the active sessions.
+        for (size_t l = 0; l < num_lanes; ++l) {
+            if (!active[l]) {
+                continue;
+            }
+            SessionState &session = group.sessions[l];
+            std::array<float, kFftSizeBy2Plus1> prior_snr;
+            std::array<float, kFftSizeBy2Plus1> post_snr;
+            DeinterleaveLane(prior_snr_.data(), l, prior_snr);
+            DeinterleaveLane(post_snr_.data(), l, post_snr);
+            session.speech_probability_estimator.Update(
+                    group.num_analyzed_frames[l], prior_snr, post_snr,
+                    session.noise_estimator.get_conservative_noise_spectrum(),
+                    signal_spectra_[l], signal_spectral_sums[l], signal_energies[l]);
+            session.noise_estimator.PostUpdate(
+                    session.speech_probability_estimator.get_probability(),
+                    signal_spectra_[l]);
+
+            // Store the magnitude spectrum to make it available for Process().
+            InterleaveLane(signal_spectra_[l], l,
+                           group.prev_analysis_signal_spectrum.data());
+        }
+    }
+
+    void NoiseSuppressorBatch::ProcessGroup(size_t g,
+                                            rtc::ArrayView<AudioBuffer *const> audio) {
+        LaneGroup &group = *groups_[g];
+        const size_t num_lanes = std::min(kNumLanes, num_sessions_ - g * kNumLanes);
+
+        // Transform the frames of the sessions.
+        std::array<float, kNumLanes> energies_before_filtering;
+        std::array<float *, kNumLanes> time_data;
+        std::array<float *, kNumLanes> real;
+        std::array<float *, kNumLanes> imag;
+        std::array<int, kNumLanes> startup{};
+        std::array<float, kNumLanes> num_analyzed_frames{};
+        std::array<float, kNumLanes> num_remaining_frames{};
+        bool any_startup = false;
+        for (size_t l = 0; l < num_lanes; ++l) {
+            SessionState &session = group.sessions[l];
+            RTC_DCHECK_EQ(1, audio[g * kNumLanes + l]->num_channels());
+            rtc::ArrayView<const float, kNsFrameSize> y_band0(
+                    &audio[g * kNumLanes + l]->split_bands(0)[0][0], kNsFrameSize);
+
+            FilterBankState &state = filter_bank_states_[l];
+            FilterBank::FormExtendedFrame(y_band0, session.process_analysis_memory,
+                                          state.extended_frame);
+            FilterBank::ApplyWindow(state.extended_frame);
+            energies_before_filtering[l] =
+                    FilterBank::ComputeEnergyOfExtendedFrame(state.extended_frame);
+            time_data[l] = state.extended_frame.data();
+            real[l] = state.real.data();
+            imag[l] = state.imag.data();
+        }
+        fft_.FftBatch(rtc::ArrayView<float *const>(time_data.data(), num_lanes),
+                      rtc::ArrayView<float *const>(real.data(), num_lanes),
+                      rtc::ArrayView<float *const>(imag.data(), num_lanes));
+
+        for (size_t l = 0; l < num_lanes; ++l) {
+            SessionState &session = group.sessions[l];
+            const FilterBankState &state = filter_bank_states_[l];
+            FilterBank::ComputeMagnitudeSpectrum(state.real, state.imag,
+                                                 signal_spectra_[l]);
+
+            InterleaveLane(signal_spectra_[l], l, signal_spectrum_.data());
+            InterleaveLane(session.noise_estimator.get_noise_spectrum(), l,
+                           noise_spectrum_.data());
+            InterleaveLane(session.noise_estimator.get_prev_noise_spectrum(), l,
+                           prev_noise_spectrum_.data());
+
+            if (group.num_analyzed_frames[l] < kShortStartupPhaseBlocks) {
+                startup[l] = 1;
+                any_startup = true;
+                num_analyzed_frames[l] = group.num_analyzed_frames[l];
+                num_remaining_frames[l] =
+                        kShortStartupPhaseBlocks - group.num_analyzed_frames[l];
+                InterleaveLane(session.noise_estimator.get_parametric_noise_spectrum(),
+                               l, parametric_noise_spectrum_.data());
+            }
+        }
+
+        // Compute the frequency domain gain filters for noise attenuation. The
+        // spectrum of the frame is stored in the Wiener filter update, so the
+        // startup phase uses signal_spectrum_ instead.
+        UpdateWienerFilter<LaneOps>(suppression_params_, noise_spectrum_.data(),
+                                    prev_noise_spectrum_.data(),
+                                    signal_spectrum_.data(),
+                                    group.spectrum_prev_process.data(),
+                                    group.filter.data());
+        if (any_startup) {
+            UpdateInitialWienerFilter<LaneOps>(
+                    suppression_params_, startup.data(), num_analyzed_frames.data(),
+                    num_remaining_frames.data(), parametric_noise_spectrum_.data(),
+                    signal_spectrum_.data(), group.initial_spectral_estimate.data(),
+                    group.filter.data());
+        }
+
+        // Apply the filters to the lower bands.
+        for (size_t l = 0; l < num_lanes; ++l) {
+            FilterBankState &state = filter_bank_states_[l];
+            for (size_t i = 0; i < kFftSizeBy2Plus1; ++i) {
+                state.real[i] *= group.filter[i * kNumLanes + l];
+                state.imag[i] *= group.filter[i * kNumLanes + l];
+            }
+        }
+
+        // Perform filter bank synthesis.
+        fft_.IfftBatch(
+                rtc::ArrayView<const float *const>(real.data(), num_lanes),
+                rtc::ArrayView<const float *const>(imag.data(), num_lanes),
+                rtc::ArrayView<float *const>(time_data.data(), num_lanes));
+
+        for (size_t l = 0; l < num_lanes; ++l) {
+            SessionState &session = group.sessions[l];
+            AudioBuffer *session_audio = audio[g * kNumLanes + l];
+            FilterBankState &state = filter_bank_states_[l];
+
+            const float energy_after_filtering =
+                    FilterBank::ComputeEnergyOfExtendedFrame(state.extended_frame);
+
+            // Apply synthesis window.
+            FilterBank::ApplyWindow(state.extended_frame);
+
+            // Apply the adjustment of the noise attenuation filter based on the
+            // effect of the attenuation.
+            const float gain_adjustment = WienerFilter::ComputeOverallScalingFactor(
+                    suppression_params_, group.num_analyzed_frames[l],
+                    session.speech_probability_estimator.get_prior_probability(),
+                    energies_before_filtering[l], energy_after_filtering);
+            for (size_t i = 0; i < kFftSize; ++i) {
+                state.extended_frame[i] = gain_adjustment * state.extended_frame[i];
+            }
+
+            // Use overlap-and-add to form the output frame of the lowest band.
+            rtc::ArrayView<float, kNsFrameSize> y_band0(
+                    &session_audio->split_bands(0)[0][0], kNsFrameSize);
+            FilterBank::OverlapAndAdd(state.extended_frame,
+                                      session.process_synthesis_memory, y_band0);
+
+            if (num_bands_ > 1) {
+                // Compute the time-domain gain for attenuating the noise in the
+                // upper bands.
+                std::array<float, kFftSizeBy2Plus1> filter;
+                DeinterleaveLane(group.filter.data(), l, filter);
+                std::array<float, kFftSizeBy2Plus1> prev_analysis_signal_spectrum;
+                DeinterleaveLane(group.prev_analysis_signal_spectrum.data(), l,
+                                 prev_analysis_signal_spectrum);
+                const float upper_band_gain = ComputeUpperBandsGain<NsDefaultGeometry>(
+                        suppression_params_.minimum_attenuating_gain, filter,
+                        session.speech_probability_estimator.get_probability(),
+                        prev_analysis_signal_spectrum, signal_spectra_[l]);
+
+                for (size_t b = 1; b < num_bands_; ++b) {
+                    // Delay the upper bands to match the delay of the filter bank
+                    // applied to the lowest band.
+                    rtc::ArrayView<float, kNsFrameSize> y_band(
+                            &session_audio->split_bands(0)[b][0], kNsFrameSize);
+                    std::array<float, kNsFrameSize> delayed_frame;
+                    FilterBank::DelaySignal(y_band, session.process_delay_memory[b - 1],
+                                            delayed_frame);
+
+                    // Apply the time-domain noise-attenuating gain.
+                    for (size_t j = 0; j < kNsFrameSize; j++) {
+                        y_band[j] = upper_band_gain * delayed_frame[j];
+                    }
+                }
+            }
+
+            // Limit the output the allowed range.
+            for (size_t b = 0; b < num_bands_; ++b) {
+                float *y_band = &session_audio->split_bands(0)[b][0];
+                for (size_t j = 0; j < kNsFrameSize; j++) {
+                    y_band[j] = std::min(std::max(y_band[j], -32768.f), 32767.f);
+                }
+            }
+        }
+    }
+
+}  // namespace webrtc
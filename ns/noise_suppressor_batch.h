@@ -0,0 +1,148 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_NS_NOISE_SUPPRESSOR_BATCH_H_
+#define MODULES_AUDIO_PROCESSING_NS_NOISE_SUPPRESSOR_BATCH_H_
+
+#include <stdint.h>
+
+#include <array>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "array_view.h"
+#include "audio_buffer.h"
+#include "noise_estimator.h"
+#include "ns_common.h"
+#include "ns_config.h"
+#include "ns_fft.h"
+#include "quantile_noise_estimator.h"
+#include "speech_probability_estimator.h"
+#include "suppression_params.h"
+
+namespace webrtc {
+
+// Class for suppressing noise in a batch of independent mono sessions, e.g. one
+// session per call leg, with one call per 10 ms frame for all of them. Each
+// session produces the same output as a single-channel NoiseSuppressor.
+//
+// The sessions are grouped in lanes of kNumLanes. The state of the quantile
+// noise estimation and of the Wiener filter, and the spectra that the SNR
+// computation reads, are stored interleaved across the sessions of a group as
+// [bin][lane], so that those per-bin loops run across the sessions with SIMD.
+// The rest of the estimation uses a NoiseEstimator and a
+// SpeechProbabilityEstimator per session. The silence bypass and the threads of
+// NsConfig are not supported.
+    class NoiseSuppressorBatch {
+    public:
+        static constexpr size_t kNumLanes = 8;
+
+        NoiseSuppressorBatch(const NsConfig &config,
+                             size_t sample_rate_hz,
+                             size_t num_sessions);
+
+        ~NoiseSuppressorBatch();
+
+        NoiseSuppressorBatch(const NoiseSuppressorBatch &) = delete;
+
+        NoiseSuppressorBatch &operator=(const NoiseSuppressorBatch &) = delete;
+
+        size_t num_sessions() const { return num_sessions_; }
+
+        // Analyses one frame for each session. |audio| must contain one mono
+        // AudioBuffer per session.
+        void Analyze(rtc::ArrayView<const AudioBuffer *const> audio);
+
+        // Applies noise suppression to one frame for each session. |audio| must
+        // contain one mono AudioBuffer per session.
+        void Process(rtc::ArrayView<AudioBuffer *const> audio);
+
+    private:
+        // A spectrum for each session of a group, indexed as
+        // [bin * kNumLanes + lane].
+        using LaneSpectrum = std::array<float, kFftSizeBy2Plus1 * kNumLanes>;
+
+        // The state of a session that is not interleaved.
+        struct SessionState {
+            // Not explicit, so that the sessions of a group can be initialized
+            // from a list of parameters.
+            SessionState(const SuppressionParams &suppression_params);
+
+            SpeechProbabilityEstimator speech_probability_estimator;
+            NoiseEstimator noise_estimator;
+            std::array<float, kOverlapSize> analyze_analysis_memory{};
+            std::array<float, kOverlapSize> process_analysis_memory{};
+            std::array<float, kOverlapSize> process_synthesis_memory{};
+            std::array<std::array<float, kOverlapSize>, 2> process_delay_memory{};
+        };
+
+        // The state of the kNumLanes sessions of a group. The last group is
+        // padded with sessions that are never analyzed.
+        struct LaneGroup {
+            explicit LaneGroup(const SuppressionParams &suppression_params);
+
+            std::array<SessionState, kNumLanes> sessions;
+            std::array<int32_t, kNumLanes> num_analyzed_frames;
+
+            // Interleaved state of the quantile noise estimation, see
+            // QuantileNoiseEstimator.
+            std::array<LaneSpectrum, kSimult> density;
+            std::array<LaneSpectrum, kSimult> log_quantile;
+            LaneSpectrum quantile;
+            std::array<std::array<int, kNumLanes>, kSimult> counter;
+            std::array<int, kNumLanes> num_updates;
+
+            // Interleaved state of the Wiener filter, see WienerFilter.
+            LaneSpectrum spectrum_prev_process;
+            LaneSpectrum initial_spectral_estimate;
+            LaneSpectrum filter;
+
+            LaneSpectrum prev_analysis_signal_spectrum;
+
+        private:
+            template<size_t... kLanes>
+            LaneGroup(const SuppressionParams &suppression_params,
+                      std::index_sequence<kLanes...>);
+        };
+
+        struct FilterBankState {
+            std::array<float, kFftSize> real;
+            std::array<float, kFftSize> imag;
+            std::array<float, kFftSize> extended_frame;
+        };
+
+        // Analyzes the frames of the sessions of group |g|.
+        void AnalyzeGroup(size_t g, rtc::ArrayView<const AudioBuffer *const> audio);
+
+        // Applies noise suppression to the frames of the sessions of group |g|.
+        void ProcessGroup(size_t g, rtc::ArrayView<AudioBuffer *const> audio);
+
+        const size_t num_bands_;
+        const size_t num_sessions_;
+        const SuppressionParams suppression_params_;
+        NrFft fft_;
+        std::vector<std::unique_ptr<LaneGroup>> groups_;
+
+        // Scratch memory for the group being analyzed or processed.
+        std::array<FilterBankState, kNumLanes> filter_bank_states_;
+        std::array<std::array<float, kFftSizeBy2Plus1>, kNumLanes>
+                signal_spectra_;
+        LaneSpectrum signal_spectrum_;
+        LaneSpectrum noise_spectrum_;
+        LaneSpectrum prev_noise_spectrum_;
+        LaneSpectrum parametric_noise_spectrum_;
+        LaneSpectrum prior_snr_;
+        LaneSpectrum post_snr_;
+    };
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_NS_NOISE_SUPPRESSOR_BATCH_H_
@@ -0,0 +1,108 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "noise_suppressor_batch.h"
+
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "noise_suppressor.h"
+
+namespace webrtc {
+    namespace {
+
+// Fills |x| with noise, with bursts of louder noise, and with zeros for some
+// chunks so that the zero frame handling differs between the sessions.
+        void GenerateChunk(size_t session, int chunk, uint32_t *seed,
+                           std::vector<int16_t> *x) {
+            const bool zero = (chunk + session) % 23 < 3;
+            const bool burst = (chunk / 20 + session) % 2 == 0;
+            for (int16_t &v : *x) {
+                *seed = *seed * 1664525u + 1013904223u;
+                const int noise = static_cast<int>((*seed >> 16) & 0x7ff) - 1024;
+                v = zero ? 0 : static_cast<int16_t>(burst ? 8 * noise : noise);
+            }
+        }
+
+        void RunBatchAgainstMono(int sample_rate_hz, size_t num_sessions) {
+            const NsConfig config;
+            const StreamConfig stream_config(sample_rate_hz, 1);
+            NoiseSuppressorBatch batch(config, sample_rate_hz, num_sessions);
+
+            std::vector<std::unique_ptr<AudioBuffer>> batch_audio;
+            std::vector<std::unique_ptr<AudioBuffer>> mono_audio;
+            std::vector<std::unique_ptr<NoiseSuppressor>> mono;
+            std::vector<AudioBuffer *> audio_ptrs;
+            std::vector<const AudioBuffer *> const_audio_ptrs;
+            for (size_t k = 0; k < num_sessions; ++k) {
+                batch_audio.push_back(std::make_unique<AudioBuffer>(
+                        sample_rate_hz, 1, sample_rate_hz, 1, sample_rate_hz, 1));
+                mono_audio.push_back(std::make_unique<AudioBuffer>(
+                        sample_rate_hz, 1, sample_rate_hz, 1, sample_rate_hz, 1));
+                mono.push_back(
+                        std::make_unique<NoiseSuppressor>(config, sample_rate_hz, 1));
+                audio_ptrs.push_back(batch_audio.back().get());
+                const_audio_ptrs.push_back(batch_audio.back().get());
+            }
+
+            std::vector<uint32_t> seeds(num_sessions);
+            for (size_t k = 0; k < num_sessions; ++k) {
+                seeds[k] = static_cast<uint32_t>(k + 1);
+            }
+            std::vector<int16_t> x(stream_config.num_samples());
+            std::vector<int16_t> batch_output(x.size());
+            std::vector<int16_t> mono_output(x.size());
+            for (int chunk = 0; chunk < 300; ++chunk) {
+                for (size_t k = 0; k < num_sessions; ++k) {
+                    GenerateChunk(k, chunk, &seeds[k], &x);
+                    batch_audio[k]->CopyFrom(x.data(), stream_config);
+                    mono_audio[k]->CopyFrom(x.data(), stream_config);
+                    if (batch_audio[k]->num_bands() > 1) {
+                        batch_audio[k]->SplitIntoFrequencyBands();
+                        mono_audio[k]->SplitIntoFrequencyBands();
+                    }
+                }
+
+                batch.Analyze(const_audio_ptrs);
+                batch.Process(audio_ptrs);
+
+                for (size_t k = 0; k < num_sessions; ++k) {
+                    mono[k]->Analyze(*mono_audio[k]);
+                    mono[k]->Process(mono_audio[k].get());
+                    if (batch_audio[k]->num_bands() > 1) {
+                        batch_audio[k]->MergeFrequencyBands();
+                        mono_audio[k]->MergeFrequencyBands();
+                    }
+                    batch_audio[k]->CopyTo(stream_config, batch_output.data());
+                    mono_audio[k]->CopyTo(stream_config, mono_output.data());
+                    ASSERT_EQ(mono_output, batch_output)
+                            << "session " << k << ", chunk " << chunk;
+                }
+            }
+        }
+
+    }  // namespace
+
+// Covers a single session, and several groups with a partially filled last
+// group.
+    TEST(NoiseSuppressorBatchTest, MatchesMonoSuppressorPerSession) {
+        for (int sample_rate_hz : {16000, 32000, 48000}) {
+            for (size_t num_sessions : {1, 11, 19}) {
+                SCOPED_TRACE(sample_rate_hz);
+                SCOPED_TRACE(num_sessions);
+                RunBatchAgainstMono(sample_rate_hz, num_sessions);
+            }
+        }
+    }
+
+}  // namespace webrtc
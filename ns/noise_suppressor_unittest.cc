@@ -0,0 +1,372 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "noise_suppressor.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "exact_math_reference_output.h"
+#include "gtest/gtest.h"
+
+namespace webrtc {
+    namespace {
+
+        constexpr int kSampleRateHz = 16000;
+
+        // Offsets in the state blob of the int32_t frame counter following the
+        // header of five uint32_t, and of the values following the counter.
+        constexpr size_t kNumAnalyzedFramesOffset = 20;
+        constexpr size_t kAnalysisPendingOffset = 24;
+        constexpr size_t kChunkIndexOffset = 25;
+
+        // Suppresses |num_chunks| chunks of noise and returns the output.
+        template<typename Suppressor>
+        std::vector<int16_t> RunChunks(Suppressor *ns, int num_chunks, uint32_t *seed) {
+            const StreamConfig stream_config(kSampleRateHz, 1);
+            AudioBuffer audio(kSampleRateHz, 1, kSampleRateHz, 1, kSampleRateHz, 1);
+            std::vector<int16_t> x(stream_config.num_samples());
+            std::vector<int16_t> output;
+            for (int chunk = 0; chunk < num_chunks; ++chunk) {
+                for (int16_t &v : x) {
+                    *seed = *seed * 1664525u + 1013904223u;
+                    v = static_cast<int16_t>(static_cast<int>((*seed >> 16) & 0xfff) - 2048);
+                }
+                audio.CopyFrom(x.data(), stream_config);
+                ns->Analyze(audio);
+                ns->Process(&audio);
+                audio.CopyTo(stream_config, x.data());
+                output.insert(output.end(), x.begin(), x.end());
+            }
+            return output;
+        }
+
+        // Speech-like tone bursts in noise, with the chunks from
+        // kFirstSilentChunk to kFirstSpeechChunk replaced by noise with a peak of
+        // |silence_amplitude|.
+        constexpr int kFirstSilentChunk = 100;
+        constexpr int kFirstSpeechChunk = 200;
+        constexpr int kNumSilenceTestChunks = 300;
+
+        std::vector<int16_t> GenerateSpeechAndSilence(int silence_amplitude) {
+            const size_t chunk_size = StreamConfig(kSampleRateHz, 1).num_samples();
+            std::vector<int16_t> x(kNumSilenceTestChunks * chunk_size);
+            uint32_t seed = 1;
+            for (size_t n = 0; n < x.size(); ++n) {
+                seed = seed * 1664525u + 1013904223u;
+                const float noise = static_cast<int>(seed >> 16) / 32768.f - 1.f;
+                const int chunk = static_cast<int>(n / chunk_size);
+                if (chunk >= kFirstSilentChunk && chunk < kFirstSpeechChunk) {
+                    x[n] = static_cast<int16_t>(silence_amplitude * noise);
+                } else {
+                    const float level = (n / 2400) % 2 ? 3000.f : 600.f;
+                    x[n] = static_cast<int16_t>(300.f * noise + level * sinf(0.07f * n));
+                }
+            }
+            return x;
+        }
+
+        std::vector<int16_t> Suppress(const NsConfig &config,
+                                      const std::vector<int16_t> &input) {
+            const StreamConfig stream_config(kSampleRateHz, 1);
+            NoiseSuppressor ns(config, kSampleRateHz, 1);
+            AudioBuffer audio(kSampleRateHz, 1, kSampleRateHz, 1, kSampleRateHz, 1);
+            std::vector<int16_t> output(input.size());
+            for (size_t k = 0; k < input.size(); k += stream_config.num_samples()) {
+                audio.CopyFrom(&input[k], stream_config);
+                ns.Analyze(audio);
+                ns.Process(&audio);
+                audio.CopyTo(stream_config, &output[k]);
+            }
+            return output;
+        }
+
+        // Returns the max abs difference of |a| and |b| from chunk |begin| to chunk
+        // |end|.
+        int MaxDifference(const std::vector<int16_t> &a,
+                          const std::vector<int16_t> &b, int begin, int end) {
+            const size_t chunk_size = StreamConfig(kSampleRateHz, 1).num_samples();
+            int max_difference = 0;
+            for (size_t n = begin * chunk_size; n < end * chunk_size; ++n) {
+                max_difference = std::max(max_difference, abs(a[n] - b[n]));
+            }
+            return max_difference;
+        }
+
+        // Returns the SNR in dB of |x| relative to |reference|.
+        double ComputeSnr(const int16_t *reference, const int16_t *x, size_t size) {
+            double signal = 0.;
+            double error = 0.;
+            for (size_t n = 0; n < size; ++n) {
+                signal += static_cast<double>(reference[n]) * reference[n];
+                error += static_cast<double>(x[n] - reference[n]) * (x[n] - reference[n]);
+            }
+            return 10. * log10(signal / error);
+        }
+
+        // Verifies that restoring a saved state into a new suppressor continues
+        // bit-exactly, from a state saved half way through a frame when the frames
+        // span several chunks.
+        template<typename Suppressor>
+        void RunStateRoundTrip(int num_chunks_before_save) {
+            const NsConfig config;
+            Suppressor ns(config, kSampleRateHz, 1);
+            uint32_t seed = 1;
+            RunChunks(&ns, num_chunks_before_save, &seed);
+            std::vector<uint8_t> state;
+            ns.SaveState(&state);
+
+            Suppressor restored(config, kSampleRateHz, 1);
+            ASSERT_TRUE(restored.LoadState(state));
+            uint32_t restored_seed = seed;
+            EXPECT_EQ(RunChunks(&ns, 50, &seed),
+                      RunChunks(&restored, 50, &restored_seed));
+        }
+
+        // Verifies that LoadState() rejects |state| and leaves the state of |ns|
+        // unchanged.
+        template<typename Suppressor>
+        void ExpectRejected(Suppressor *ns, const std::vector<uint8_t> &state) {
+            std::vector<uint8_t> state_before;
+            ns->SaveState(&state_before);
+            EXPECT_FALSE(ns->LoadState(state));
+            std::vector<uint8_t> state_after;
+            ns->SaveState(&state_after);
+            EXPECT_EQ(state_before, state_after);
+        }
+
+        // Returns the number of analyzed frames of |ns|, from its saved state.
+        template<typename Suppressor>
+        int32_t NumAnalyzedFrames(const Suppressor &ns) {
+            std::vector<uint8_t> state;
+            ns.SaveState(&state);
+            int32_t num_analyzed_frames;
+            memcpy(&num_analyzed_frames, &state[kNumAnalyzedFramesOffset],
+                   sizeof(num_analyzed_frames));
+            return num_analyzed_frames;
+        }
+
+        // Returns the energy of the difference of |a| and |b|.
+        double DifferenceEnergy(const std::vector<int16_t> &a,
+                                const std::vector<int16_t> &b) {
+            double energy = 0.;
+            for (size_t n = 0; n < a.size(); ++n) {
+                energy += static_cast<double>(a[n] - b[n]) * (a[n] - b[n]);
+            }
+            return energy;
+        }
+
+        // Verifies that a noise profile round-trips through a seeded suppressor,
+        // that the seeded suppressor skips the startup phase, and that its first
+        // output is closer to that of the converged suppressor that the profile
+        // was taken from than the output of a suppressor without seeding is.
+        template<typename Geometry>
+        void RunSeedNoiseProfile() {
+            using Suppressor = BasicNoiseSuppressor<Geometry>;
+            const NsConfig config;
+            Suppressor converged(config, kSampleRateHz, 1);
+            uint32_t seed = 1;
+            RunChunks(&converged, 400, &seed);
+            const auto profile = converged.GetNoiseProfile(0);
+
+            Suppressor seeded(config, kSampleRateHz, 1);
+            seeded.SeedNoiseProfile(profile);
+            const auto seeded_profile = seeded.GetNoiseProfile(0);
+            EXPECT_EQ(profile.noise_spectrum, seeded_profile.noise_spectrum);
+            EXPECT_EQ(profile.spectral_diff_normalization,
+                      seeded_profile.spectral_diff_normalization);
+            EXPECT_EQ(profile.lrt, seeded_profile.lrt);
+            EXPECT_EQ(profile.flatness_threshold, seeded_profile.flatness_threshold);
+            EXPECT_EQ(profile.template_diff_threshold,
+                      seeded_profile.template_diff_threshold);
+            EXPECT_EQ(profile.lrt_weighting, seeded_profile.lrt_weighting);
+            EXPECT_EQ(profile.flatness_weighting, seeded_profile.flatness_weighting);
+            EXPECT_EQ(profile.difference_weighting,
+                      seeded_profile.difference_weighting);
+            EXPECT_GE(NumAnalyzedFrames(seeded), Geometry::kLongStartupPhaseBlocks);
+
+            // Two chunks, so that the frames spanning two chunks are output too.
+            Suppressor cold(config, kSampleRateHz, 1);
+            uint32_t converged_seed = seed;
+            uint32_t seeded_seed = seed;
+            uint32_t cold_seed = seed;
+            const std::vector<int16_t> converged_output =
+                    RunChunks(&converged, 2, &converged_seed);
+            const std::vector<int16_t> seeded_output =
+                    RunChunks(&seeded, 2, &seeded_seed);
+            const std::vector<int16_t> cold_output = RunChunks(&cold, 2, &cold_seed);
+            EXPECT_GT(NumAnalyzedFrames(seeded), Geometry::kLongStartupPhaseBlocks);
+            EXPECT_LT(DifferenceEnergy(converged_output, seeded_output),
+                      DifferenceEnergy(converged_output, cold_output));
+        }
+
+    }  // namespace
+
+    TEST(NoiseSuppressorTest, StateRoundTrip) {
+        RunStateRoundTrip<NoiseSuppressor>(120);
+        RunStateRoundTrip<LowDelayNoiseSuppressor>(120);
+        RunStateRoundTrip<HighEfficiencyNoiseSuppressor>(120);
+        RunStateRoundTrip<HighEfficiencyNoiseSuppressor>(121);
+    }
+
+    TEST(NoiseSuppressorTest, SeedNoiseProfile) {
+        RunSeedNoiseProfile<NsDefaultGeometry>();
+        RunSeedNoiseProfile<NsLowDelayGeometry>();
+        RunSeedNoiseProfile<NsHighEfficiencyGeometry>();
+    }
+
+    TEST(NoiseSuppressorTest, LoadStateRejectsInvalidState) {
+        const NsConfig config;
+        uint32_t seed = 1;
+        // Frames of two chunks, so that the chunk index is 1 after an odd number of
+        // chunks.
+        HighEfficiencyNoiseSuppressor ns(config, kSampleRateHz, 1);
+        RunChunks(&ns, 121, &seed);
+        std::vector<uint8_t> state;
+        ns.SaveState(&state);
+        uint32_t chunk_index;
+        memcpy(&chunk_index, &state[kChunkIndexOffset], sizeof(chunk_index));
+        ASSERT_EQ(1u, chunk_index);
+
+        HighEfficiencyNoiseSuppressor other(config, kSampleRateHz, 1);
+        RunChunks(&other, 30, &seed);
+
+        std::vector<uint8_t> wrong_size(state.begin(), state.end() - 1);
+        ExpectRejected(&other, wrong_size);
+
+        std::vector<uint8_t> invalid_flag = state;
+        invalid_flag[kAnalysisPendingOffset] = 2;
+        ExpectRejected(&other, invalid_flag);
+
+        std::vector<uint8_t> invalid_chunk_index = state;
+        chunk_index = 2;
+        memcpy(&invalid_chunk_index[kChunkIndexOffset], &chunk_index,
+               sizeof(chunk_index));
+        ExpectRejected(&other, invalid_chunk_index);
+
+        EXPECT_TRUE(other.LoadState(state));
+    }
+
+    TEST(NoiseSuppressorTest, LoadStateRejectsPendingAnalysisWithoutBuffer) {
+        const NsConfig config;
+        uint32_t seed = 1;
+        NoiseSuppressor ns(config, kSampleRateHz, 1);
+        RunChunks(&ns, 30, &seed);
+        std::vector<uint8_t> state;
+        ns.SaveState(&state);
+        ASSERT_EQ(0, state[kAnalysisPendingOffset]);
+
+        // The default geometry analyzes every frame right away, so it has no
+        // buffer to hold a pending analysis.
+        state[kAnalysisPendingOffset] = 1;
+        ExpectRejected(&ns, state);
+    }
+
+    // Verifies that splitting the channels over threads does not change the
+    // output, for more channels than threads and channel ranges of uneven size.
+    TEST(NoiseSuppressorTest, ThreadsMatchSingleThread) {
+        constexpr size_t kNumChannels = 8;
+        const StreamConfig stream_config(kSampleRateHz, kNumChannels);
+        NsConfig config;
+        NoiseSuppressor reference(config, kSampleRateHz, kNumChannels);
+        config.num_threads = 3;
+        NoiseSuppressor ns(config, kSampleRateHz, kNumChannels);
+        AudioBuffer reference_audio(kSampleRateHz, kNumChannels, kSampleRateHz,
+                                    kNumChannels, kSampleRateHz, kNumChannels);
+        AudioBuffer audio(kSampleRateHz, kNumChannels, kSampleRateHz, kNumChannels,
+                          kSampleRateHz, kNumChannels);
+        std::vector<int16_t> x(stream_config.num_samples());
+        std::vector<int16_t> reference_y(stream_config.num_samples());
+        std::vector<int16_t> y(stream_config.num_samples());
+        uint32_t seed = 1;
+        for (int chunk = 0; chunk < 200; ++chunk) {
+            for (int16_t &v : x) {
+                seed = seed * 1664525u + 1013904223u;
+                v = static_cast<int16_t>(static_cast<int>((seed >> 16) & 0xfff) - 2048);
+            }
+            reference_audio.CopyFrom(x.data(), stream_config);
+            reference.Analyze(reference_audio);
+            reference.Process(&reference_audio);
+            reference_audio.CopyTo(stream_config, reference_y.data());
+            audio.CopyFrom(x.data(), stream_config);
+            ns.Analyze(audio);
+            ns.Process(&audio);
+            audio.CopyTo(stream_config, y.data());
+            ASSERT_EQ(reference_y, y) << "chunk " << chunk;
+        }
+    }
+
+    // Verifies that bypassing digital silence leaves the output unchanged,
+    // including around the switches from speech to silence and back.
+    TEST(NoiseSuppressorTest, SilenceBypassIsBitExactForDigitalSilence) {
+        const std::vector<int16_t> input = GenerateSpeechAndSilence(0);
+        NsConfig config;
+        ASSERT_FALSE(config.enable_silence_bypass);
+        const std::vector<int16_t> reference = Suppress(config, input);
+        config.enable_silence_bypass = true;
+        const std::vector<int16_t> output = Suppress(config, input);
+        EXPECT_EQ(0, MaxDifference(reference, output, kFirstSilentChunk - 5,
+                                   kFirstSilentChunk + 5));
+        EXPECT_EQ(0, MaxDifference(reference, output, kFirstSpeechChunk - 5,
+                                   kFirstSpeechChunk + 5));
+        EXPECT_EQ(reference, output);
+    }
+
+    // Verifies that with a nonzero silence floor, the output differs from the full
+    // processing by at most the silence level while bypassing, and by a few times
+    // the silence level for a few frames after the speech resumes.
+    TEST(NoiseSuppressorTest, SilenceBypassWithSilenceFloor) {
+        constexpr int kSilenceAmplitude = 16;
+        const std::vector<int16_t> input =
+                GenerateSpeechAndSilence(kSilenceAmplitude);
+        NsConfig config;
+        const std::vector<int16_t> reference = Suppress(config, input);
+        config.enable_silence_bypass = true;
+        config.silence_floor = kSilenceAmplitude * kSilenceAmplitude;
+        const std::vector<int16_t> output = Suppress(config, input);
+
+        EXPECT_EQ(0, MaxDifference(reference, output, 0, kFirstSilentChunk));
+        EXPECT_LE(MaxDifference(reference, output, kFirstSilentChunk,
+                                kFirstSpeechChunk),
+                  kSilenceAmplitude);
+        // The bypassed frames leave no overlap-and-add output and a Wiener filter
+        // updated with zeros, so the resumption is not seamless.
+        const int resumption_difference = MaxDifference(
+                reference, output, kFirstSpeechChunk, kFirstSpeechChunk + 10);
+        EXPECT_GT(resumption_difference, 0);
+        EXPECT_LE(resumption_difference, 4 * kSilenceAmplitude);
+        EXPECT_LE(MaxDifference(reference, output, kFirstSpeechChunk + 10,
+                                kNumSilenceTestChunks),
+                  2);
+    }
+
+    // Verifies that the approximations of fast_math.h leave the output close to
+    // that of the suppressor with exact math, after the noise estimate has
+    // converged on a noise-only section. The measured SNR is 35 dB.
+    TEST(NoiseSuppressorTest, FastMathOutputSnrToExactMath) {
+        const std::vector<int16_t> output =
+                Suppress(NsConfig(), GenerateSpeechAndSilence(300));
+        const size_t chunk_size = StreamConfig(kSampleRateHz, 1).num_samples();
+        constexpr size_t kReferenceSize =
+                sizeof(kExactMathReferenceOutput) / sizeof(kExactMathReferenceOutput[0]);
+        ASSERT_EQ(kExactMathReferenceFirstChunk * chunk_size + kReferenceSize,
+                  output.size());
+        EXPECT_GE(ComputeSnr(kExactMathReferenceOutput,
+                             &output[kExactMathReferenceFirstChunk * chunk_size],
+                             kReferenceSize),
+                  30.);
+    }
+
+}  // namespace webrtc
@@ -0,0 +1,161 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_NS_NS_ALLOCATOR_H_
+#define MODULES_AUDIO_PROCESSING_NS_NS_ALLOCATOR_H_
+
+#include <stddef.h>
+
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "aligned_malloc.h"
+
+namespace webrtc {
+
+// Allocator hook for the state of a session. The constructors of AudioBuffer,
+// NoiseSuppressor and the classes they own accept an NsAllocator, from which
+// they then take all their memory, e.g. to create sessions from pre-reserved
+// memory without contending on the global heap. A null NsAllocator selects the
+// heap. An NsAllocator must outlive the objects allocated from it and is only
+// used by the thread that creates or destroys them.
+    class NsAllocator {
+    public:
+        // The largest alignment that is requested.
+        static constexpr size_t kMaxAlignment = 64;
+
+        virtual ~NsAllocator() = default;
+
+        // Returns |size| bytes aligned to |alignment|, a power of two of at most
+        // kMaxAlignment.
+        virtual void *Allocate(size_t size, size_t alignment) = 0;
+
+        // Returns memory obtained from Allocate() with the same size and alignment.
+        virtual void Deallocate(void *p, size_t size, size_t alignment) = 0;
+    };
+
+// Standard allocator that allocates from an NsAllocator, or from the heap when
+// there is none. Like std::pmr::polymorphic_allocator it converts implicitly
+// from the NsAllocator, so that containers can be constructed with an
+// NsAllocator pointer.
+    template<typename T>
+    class NsStlAllocator {
+    public:
+        using value_type = T;
+
+        NsStlAllocator(NsAllocator *allocator = nullptr) : allocator_(allocator) {}
+
+        template<typename U>
+        NsStlAllocator(const NsStlAllocator<U> &other)
+                : allocator_(other.allocator()) {}
+
+        T *allocate(size_t n) {
+            if (!allocator_) {
+                return std::allocator<T>().allocate(n);
+            }
+            return static_cast<T *>(allocator_->Allocate(n * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T *p, size_t n) {
+            if (!allocator_) {
+                std::allocator<T>().deallocate(p, n);
+                return;
+            }
+            allocator_->Deallocate(p, n * sizeof(T), alignof(T));
+        }
+
+        NsAllocator *allocator() const { return allocator_; }
+
+    private:
+        NsAllocator *allocator_;
+    };
+
+    template<typename T, typename U>
+    bool operator==(const NsStlAllocator<T> &a, const NsStlAllocator<U> &b) {
+        return a.allocator() == b.allocator();
+    }
+
+    template<typename T, typename U>
+    bool operator!=(const NsStlAllocator<T> &a, const NsStlAllocator<U> &b) {
+        return a.allocator() != b.allocator();
+    }
+
+// Vector from an NsAllocator. The vectors of the session state are sized at
+// construction, as an arena does not reuse the memory of a vector that grows.
+    template<typename T>
+    using NsVector = std::vector<T, NsStlAllocator<T>>;
+
+// Deleter for objects created by NsMakeUnique().
+    template<typename T>
+    struct NsDeleter {
+        NsAllocator *allocator = nullptr;
+
+        void operator()(T *p) const {
+            if (!allocator) {
+                delete p;
+                return;
+            }
+            p->~T();
+            allocator->Deallocate(p, sizeof(T), alignof(T));
+        }
+    };
+
+    template<typename T>
+    using NsUniquePtr = std::unique_ptr<T, NsDeleter<T>>;
+
+// Creates a T from |allocator|, or on the heap if |allocator| is null.
+    template<typename T, typename... Args>
+    NsUniquePtr<T> NsMakeUnique(NsAllocator *allocator, Args &&... args) {
+        if (!allocator) {
+            return NsUniquePtr<T>(new T(std::forward<Args>(args)...));
+        }
+        void *memory = allocator->Allocate(sizeof(T), alignof(T));
+        return NsUniquePtr<T>(new(memory) T(std::forward<Args>(args)...),
+                              NsDeleter<T>{allocator});
+    }
+
+// Deleter for arrays created by NsMakeAlignedArray().
+    template<typename T>
+    struct NsAlignedArrayDeleter {
+        NsAllocator *allocator = nullptr;
+        size_t size = 0;
+        size_t alignment = 0;
+
+        void operator()(T *p) const {
+            if (!allocator) {
+                AlignedFree(p);
+                return;
+            }
+            allocator->Deallocate(p, size * sizeof(T), alignment);
+        }
+    };
+
+    template<typename T>
+    using NsAlignedArray = std::unique_ptr<T[], NsAlignedArrayDeleter<T>>;
+
+// Creates an uninitialized array of |size| plain values aligned to
+// |alignment| from |allocator|, or with AlignedMalloc() if |allocator| is null.
+    template<typename T>
+    NsAlignedArray<T> NsMakeAlignedArray(NsAllocator *allocator,
+                                         size_t size,
+                                         size_t alignment) {
+        static_assert(std::is_trivial<T>::value, "Only plain values are supported");
+        void *memory = allocator ? allocator->Allocate(size * sizeof(T), alignment)
+                                 : AlignedMalloc(size * sizeof(T), alignment);
+        return NsAlignedArray<T>(static_cast<T *>(memory),
+                                 NsAlignedArrayDeleter<T>{allocator, size, alignment});
+    }
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_NS_NS_ALLOCATOR_H_
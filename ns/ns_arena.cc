@@ -0,0 +1,45 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "ns_arena.h"
+
+#include "checks.h"
+
+namespace webrtc {
+
+    constexpr size_t NsArenaLayout::kCacheLineSize;
+    constexpr size_t NsArena::kCacheLineSize;
+
+    size_t NsArenaLayout::Add(size_t size, size_t alignment) {
+        RTC_DCHECK_GT(alignment, 0);
+        RTC_DCHECK_LE(alignment, kCacheLineSize);
+        if (size >= kCacheLineSize) {
+            alignment = kCacheLineSize;
+        }
+        // The offsets are relative to the start of the block, which is aligned to
+        // a cache line.
+        const size_t offset = (size_ + alignment - 1) / alignment * alignment;
+        size_ = offset + size;
+        return offset;
+    }
+
+    NsArena::NsArena(void *block, size_t size)
+            : block_(static_cast<uint8_t *>(block)), size_(size) {
+        RTC_DCHECK(block_);
+        RTC_DCHECK_EQ(reinterpret_cast<uintptr_t>(block_) % kCacheLineSize, 0);
+    }
+
+    void *NsArena::Allocate(size_t size, size_t alignment) {
+        const size_t offset = layout_.Add(size, alignment);
+        RTC_CHECK_LE(layout_.size(), size_);
+        return block_ + offset;
+    }
+
+}  // namespace webrtc
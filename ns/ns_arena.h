@@ -0,0 +1,95 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_NS_NS_ARENA_H_
+#define MODULES_AUDIO_PROCESSING_NS_NS_ARENA_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ns_allocator.h"
+
+namespace webrtc {
+
+// The offsets at which an NsArena places a sequence of allocations, without
+// the memory. The classes that allocate from an NsAllocator have a static
+// AddToLayout() that adds the allocations of their constructor, in the same
+// order, so that the size of a block is computed without creating the objects.
+    class NsArenaLayout {
+    public:
+        static constexpr size_t kCacheLineSize = NsAllocator::kMaxAlignment;
+
+        // Adds |size| bytes aligned to |alignment|, which must not exceed
+        // kCacheLineSize, and returns their offset. Allocations of a cache line or
+        // more start on a cache line.
+        size_t Add(size_t size, size_t alignment);
+
+        // Adds an object created by NsMakeUnique().
+        template<typename T>
+        void AddObject() { Add(sizeof(T), alignof(T)); }
+
+        // Adds the buffer of an NsVector of |size| elements, of which there is none
+        // if the vector is empty.
+        template<typename T>
+        void AddVector(size_t size) {
+            if (size > 0) {
+                Add(size * sizeof(T), alignof(T));
+            }
+        }
+
+        // Adds an array created by NsMakeAlignedArray().
+        template<typename T>
+        void AddAlignedArray(size_t size, size_t alignment) {
+            Add(size * sizeof(T), alignment);
+        }
+
+        // The number of bytes taken up so far, including the padding.
+        size_t size() const { return size_; }
+
+    private:
+        size_t size_ = 0;
+    };
+
+// Bump allocator handing out the memory of one contiguous block, so that all
+// the state of a session lies together. The memory is only released with the
+// block, so the objects in it must be destroyed before the block is freed. The
+// block is sized with an NsArenaLayout.
+    class NsArena : public NsAllocator {
+    public:
+        static constexpr size_t kCacheLineSize = NsArenaLayout::kCacheLineSize;
+
+        // Creates an arena over the |size| bytes at |block|, which must be aligned
+        // to kCacheLineSize.
+        NsArena(void *block, size_t size);
+
+        NsArena(const NsArena &) = delete;
+
+        NsArena &operator=(const NsArena &) = delete;
+
+        // Returns |size| bytes placed as by NsArenaLayout::Add(). CHECKs that the
+        // block is large enough.
+        void *Allocate(size_t size, size_t alignment) override;
+
+        // The memory is only returned with the block.
+        void Deallocate(void * /* p */, size_t /* size */,
+                        size_t /* alignment */) override {}
+
+        // The number of bytes taken up so far, including the padding.
+        size_t bytes_used() const { return layout_.size(); }
+
+    private:
+        uint8_t *const block_;
+        const size_t size_;
+        NsArenaLayout layout_;
+    };
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_NS_NS_ARENA_H_
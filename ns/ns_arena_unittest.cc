@@ -0,0 +1,135 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "ns_arena.h"
+
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "aligned_malloc.h"
+#include "audio_buffer.h"
+#include "gtest/gtest.h"
+#include "noise_suppressor.h"
+#include "ns_compact_session.h"
+
+namespace webrtc {
+    namespace {
+
+        constexpr int kSampleRatesHz[] = {8000, 16000, 32000, 48000};
+        constexpr int kSuppressorSampleRatesHz[] = {16000, 32000, 48000};
+        // Up to more channels than the suppressor keeps on the stack.
+        constexpr size_t kNumChannels[] = {1, 2, 3, 8};
+
+        // Creates an object with |create| in an arena and verifies that it takes
+        // up exactly the size computed by |add_to_layout|. The block is larger,
+        // so that allocations missing from the layout are reported by the
+        // comparison rather than overrun the block.
+        template<typename CreateFn, typename LayoutFn>
+        void ExpectLayoutMatches(const LayoutFn &add_to_layout,
+                                 const CreateFn &create) {
+            NsArenaLayout layout;
+            add_to_layout(&layout);
+            const size_t block_size = 2 * layout.size() + 65536;
+            std::unique_ptr<uint8_t[], AlignedFreeDeleter> block(
+                    AlignedMalloc<uint8_t>(block_size, NsArena::kCacheLineSize));
+            NsArena arena(block.get(), block_size);
+            create(&arena);
+            EXPECT_EQ(layout.size(), arena.bytes_used());
+        }
+
+        template<typename Suppressor>
+        void ExpectSuppressorLayoutMatches() {
+            const NsConfig config;
+            for (int sample_rate_hz : kSuppressorSampleRatesHz) {
+                for (size_t num_channels : kNumChannels) {
+                    SCOPED_TRACE(sample_rate_hz);
+                    SCOPED_TRACE(num_channels);
+                    ExpectLayoutMatches(
+                            [&](NsArenaLayout *layout) {
+                                layout->AddObject<Suppressor>();
+                                Suppressor::AddToLayout(layout, sample_rate_hz,
+                                                        num_channels);
+                            },
+                            [&](NsArena *arena) {
+                                NsMakeUnique<Suppressor>(arena, config, sample_rate_hz,
+                                                         num_channels, arena);
+                            });
+                }
+            }
+        }
+
+    }  // namespace
+
+    TEST(NsArenaTest, LayoutPlacesAllocationsAsArena) {
+        NsArenaLayout layout;
+        EXPECT_EQ(0u, layout.Add(3, 1));
+        EXPECT_EQ(4u, layout.Add(4, 4));
+        // Allocations of a cache line or more start on a cache line.
+        EXPECT_EQ(NsArenaLayout::kCacheLineSize,
+                  layout.Add(NsArenaLayout::kCacheLineSize, 4));
+        layout.AddVector<float>(0);
+        EXPECT_EQ(2 * NsArenaLayout::kCacheLineSize, layout.size());
+    }
+
+    TEST(NsArenaTest, AudioBufferLayoutMatches) {
+        for (int input_rate : kSampleRatesHz) {
+            for (int buffer_rate : kSampleRatesHz) {
+                for (size_t num_channels : kNumChannels) {
+                    for (TwoBandsFilterMode mode :
+                            {TwoBandsFilterMode::kFixedPoint, TwoBandsFilterMode::kFloat}) {
+                        SCOPED_TRACE(input_rate);
+                        SCOPED_TRACE(buffer_rate);
+                        SCOPED_TRACE(num_channels);
+                        SCOPED_TRACE(static_cast<int>(mode));
+                        // The output is resampled back to the input rate.
+                        ExpectLayoutMatches(
+                                [&](NsArenaLayout *layout) {
+                                    layout->AddObject<AudioBuffer>();
+                                    AudioBuffer::AddToLayout(
+                                            layout, input_rate, num_channels, buffer_rate,
+                                            num_channels, input_rate, num_channels, mode);
+                                },
+                                [&](NsArena *arena) {
+                                    NsMakeUnique<AudioBuffer>(
+                                            arena, input_rate, num_channels, buffer_rate,
+                                            num_channels, input_rate, num_channels, mode,
+                                            arena);
+                                });
+                    }
+                }
+            }
+        }
+    }
+
+    TEST(NsArenaTest, NoiseSuppressorLayoutMatches) {
+        ExpectSuppressorLayoutMatches<NoiseSuppressor>();
+        ExpectSuppressorLayoutMatches<LowDelayNoiseSuppressor>();
+        ExpectSuppressorLayoutMatches<HighEfficiencyNoiseSuppressor>();
+    }
+
+// The session CHECKs that its objects take up exactly the computed block.
+    TEST(NsArenaTest, CompactSessionFitsBlock) {
+        const NsConfig config;
+        for (int sample_rate_hz : kSuppressorSampleRatesHz) {
+            for (size_t num_channels : kNumChannels) {
+                NsCompactSession session(config, sample_rate_hz, num_channels);
+                EXPECT_EQ(NsCompactSession::BytesPerSession(config, sample_rate_hz,
+                                                            num_channels),
+                          session.bytes_per_session());
+                std::vector<int16_t> x(
+                        StreamConfig(sample_rate_hz, num_channels).num_samples(), 100);
+                session.ProcessChunk(x);
+            }
+        }
+    }
+
+}  // namespace webrtc
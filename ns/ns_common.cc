@@ -0,0 +1,66 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "ns_common.h"
+
+#include "arch.h"
+#include "cpu_features_wrapper.h"
+
+namespace webrtc {
+
+    namespace {
+
+        NsOptimization DetectOptimizationOnce() {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#if defined(WEBRTC_ENABLE_AVX2)
+            if (WebRtc_GetCPUInfo(kAVX2) != 0) {
+                return NsOptimization::kAvx2;
+            }
+#endif
+            if (WebRtc_GetCPUInfo(kSSE2) != 0) {
+                return NsOptimization::kSse2;
+            }
+#endif
+
+#if defined(WEBRTC_HAS_NEON)
+            return NsOptimization::kNeon;
+#else
+            return NsOptimization::kNone;
+#endif
+        }
+
+    }  // namespace
+
+    NsOptimization DetectOptimization() {
+        // The CPU features are only queried once, as the query may be slow, e.g.
+        // when it traps into a hypervisor.
+        static const NsOptimization optimization = DetectOptimizationOnce();
+        return optimization;
+    }
+
+    std::vector<NsOptimization> AvailableOptimizations() {
+        std::vector<NsOptimization> optimizations = {NsOptimization::kNone};
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+        if (WebRtc_GetCPUInfo(kSSE2) != 0) {
+            optimizations.push_back(NsOptimization::kSse2);
+        }
+#if defined(WEBRTC_ENABLE_AVX2)
+        if (WebRtc_GetCPUInfo(kAVX2) != 0) {
+            optimizations.push_back(NsOptimization::kAvx2);
+        }
+#endif
+#endif
+#if defined(WEBRTC_HAS_NEON)
+        optimizations.push_back(NsOptimization::kNeon);
+#endif
+        return optimizations;
+    }
+
+}  // namespace webrtc
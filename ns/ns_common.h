@@ -12,6 +12,7 @@
 #define MODULES_AUDIO_PROCESSING_NS_NS_COMMON_H_
 
 #include <cstddef>
+#include <vector>
 
 namespace webrtc {
 
@@ -24,11 +25,58 @@ namespace webrtc {
     constexpr int kLongStartupPhaseBlocks = 200;
     constexpr int kFeatureUpdateWindowSize = 500;
 
+// Frame geometry of the suppressor: the FFT size, the frame size, i.e., the hop
+// between frames, and the time constants in frames, which are scaled with the
+// frame size so that they stay the same in seconds as for 10 ms frames.
+    template<size_t kFftSizeT, size_t kFrameSizeT>
+    struct NsGeometry {
+        static_assert(kFrameSizeT < kFftSizeT && 2 * kFrameSizeT >= kFftSizeT,
+                      "The frames must overlap by at most half an FFT");
+
+        static constexpr size_t kFftSize = kFftSizeT;
+        static constexpr size_t kFftSizeBy2Plus1 = kFftSize / 2 + 1;
+        static constexpr size_t kFrameSize = kFrameSizeT;
+        static constexpr size_t kOverlapSize = kFftSize - kFrameSize;
+
+        static constexpr int kShortStartupPhaseBlocks =
+                webrtc::kShortStartupPhaseBlocks * kNsFrameSize / kFrameSize;
+        static constexpr int kLongStartupPhaseBlocks =
+                webrtc::kLongStartupPhaseBlocks * kNsFrameSize / kFrameSize;
+        static constexpr int kFeatureUpdateWindowSize =
+                webrtc::kFeatureUpdateWindowSize * kNsFrameSize / kFrameSize;
+    };
+
+// The default geometry with 10 ms frames at 16 kHz.
+    using NsDefaultGeometry = NsGeometry<kFftSize, kNsFrameSize>;
+
+// Low-delay geometry with 5 ms frames at 16 kHz, which halves the algorithmic
+// delay to kOverlapSize = 48 samples (3 ms) at the cost of a coarser frequency
+// resolution.
+    using NsLowDelayGeometry = NsGeometry<128, 80>;
+
+// High-efficiency geometry with 20 ms frames at 16 kHz, which halves the number
+// of FFTs and estimator updates per second compared to the default geometry,
+// for offline processing where the delay does not matter.
+    using NsHighEfficiencyGeometry = NsGeometry<512, 320>;
+
     constexpr float kLtrFeatureThr = 0.5f;
     constexpr float kBinSizeLrt = 0.1f;
     constexpr float kBinSizeSpecFlat = 0.05f;
     constexpr float kBinSizeSpecDiff = 0.1f;
 
+// Instruction set extensions used by the optimized code paths.
+    enum class NsOptimization {
+        kNone, kSse2, kAvx2, kNeon
+    };
+
+// Detects the best optimization to use on the current CPU.
+    NsOptimization DetectOptimization();
+
+// Returns all optimizations that are compiled in and supported by the current
+// CPU, starting with kNone. Used to test every code path against the scalar
+// one.
+    std::vector<NsOptimization> AvailableOptimizations();
+
 }  // namespace webrtc
 
 #endif  // MODULES_AUDIO_PROCESSING_NS_NS_COMMON_H_
@@ -0,0 +1,102 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "ns_compact_session.h"
+
+#include "checks.h"
+
+namespace webrtc {
+
+    namespace {
+
+// Creates the objects of a session in |arena|, in the order in which
+// AddToLayout() adds them.
+        void CreateObjects(const NsConfig &config,
+                           int sample_rate_hz,
+                           size_t num_channels,
+                           NsArena *arena,
+                           NsUniquePtr<AudioBuffer> *audio,
+                           NsUniquePtr<NoiseSuppressor> *noise_suppressor) {
+            NsConfig single_threaded_config = config;
+            single_threaded_config.num_threads = 1;
+            *audio = NsMakeUnique<AudioBuffer>(
+                    arena, sample_rate_hz, num_channels, sample_rate_hz, num_channels,
+                    sample_rate_hz, num_channels, TwoBandsFilterMode::kFixedPoint, arena);
+            *noise_suppressor = NsMakeUnique<NoiseSuppressor>(
+                    arena, single_threaded_config, sample_rate_hz, num_channels, arena);
+        }
+
+        void AddToLayout(int sample_rate_hz,
+                         size_t num_channels,
+                         NsArenaLayout *layout) {
+            layout->AddObject<AudioBuffer>();
+            AudioBuffer::AddToLayout(layout, sample_rate_hz, num_channels,
+                                     sample_rate_hz, num_channels, sample_rate_hz,
+                                     num_channels);
+            layout->AddObject<NoiseSuppressor>();
+            NoiseSuppressor::AddToLayout(layout, sample_rate_hz, num_channels);
+        }
+
+    }  // namespace
+
+    NsCompactSession::NsCompactSession(const NsConfig &config,
+                                       int sample_rate_hz,
+                                       size_t num_channels)
+            : NsCompactSession(config, sample_rate_hz, num_channels,
+                               BlockSize(sample_rate_hz, num_channels),
+                               nullptr) {}
+
+    NsCompactSession::NsCompactSession(const NsConfig &config,
+                                       int sample_rate_hz,
+                                       size_t num_channels,
+                                       size_t block_size,
+                                       uint8_t *block)
+            : stream_config_(sample_rate_hz, num_channels),
+              block_size_(block_size),
+              block_(block ? nullptr
+                           : AlignedMalloc<uint8_t>(block_size_,
+                                                    NsArena::kCacheLineSize)),
+              arena_(block ? block : block_.get(), block_size_) {
+        CreateObjects(config, sample_rate_hz, num_channels, &arena_, &audio_,
+                      &noise_suppressor_);
+        // Any difference means that AddToLayout() is out of sync with the
+        // constructors.
+        RTC_CHECK_EQ(arena_.bytes_used(), block_size_);
+    }
+
+    NsCompactSession::~NsCompactSession() = default;
+
+    size_t NsCompactSession::BlockSize(int sample_rate_hz, size_t num_channels) {
+        NsArenaLayout layout;
+        AddToLayout(sample_rate_hz, num_channels, &layout);
+        return layout.size();
+    }
+
+    size_t NsCompactSession::BytesPerSession(const NsConfig & /* config */,
+                                             int sample_rate_hz,
+                                             size_t num_channels) {
+        return sizeof(NsCompactSession) + BlockSize(sample_rate_hz, num_channels);
+    }
+
+    void NsCompactSession::ProcessChunk(rtc::ArrayView<int16_t> interleaved) {
+        RTC_DCHECK_EQ(interleaved.size(), stream_config_.num_samples());
+        audio_->CopyFrom(interleaved.data(), stream_config_);
+        if (audio_->num_bands() > 1) {
+            audio_->SplitIntoFrequencyBands();
+        }
+        noise_suppressor_->Analyze(*audio_);
+        noise_suppressor_->Process(audio_.get());
+        if (audio_->num_bands() > 1) {
+            audio_->MergeFrequencyBands();
+        }
+        audio_->CopyTo(stream_config_, interleaved.data());
+    }
+
+}  // namespace webrtc
@@ -0,0 +1,89 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_NS_NS_COMPACT_SESSION_H_
+#define MODULES_AUDIO_PROCESSING_NS_NS_COMPACT_SESSION_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+
+#include "aligned_malloc.h"
+#include "array_view.h"
+#include "audio_buffer.h"
+#include "noise_suppressor.h"
+#include "ns_arena.h"
+#include "ns_config.h"
+
+namespace webrtc {
+
+// Noise suppression of one stream in the compact memory mode: the AudioBuffer
+// and the NoiseSuppressor, with all their buffers and channel states, are
+// packed into a single cache line aligned block. This minimizes the memory per
+// session and keeps the state of a session together in the cache. The
+// suppression runs on the calling thread, so NsConfig::num_threads is ignored.
+    class NsCompactSession {
+    public:
+        NsCompactSession(const NsConfig &config,
+                         int sample_rate_hz,
+                         size_t num_channels);
+
+        ~NsCompactSession();
+
+        NsCompactSession(const NsCompactSession &) = delete;
+
+        NsCompactSession &operator=(const NsCompactSession &) = delete;
+
+        // Returns the exact number of bytes that a session with the given
+        // configuration takes up: the session object and its block. The FFT
+        // tables, which all sessions share, are not included.
+        static size_t BytesPerSession(const NsConfig &config,
+                                      int sample_rate_hz,
+                                      size_t num_channels);
+
+        size_t bytes_per_session() const {
+            return sizeof(NsCompactSession) + block_size_;
+        }
+
+        // Suppresses one 10 ms chunk of interleaved samples in place.
+        void ProcessChunk(rtc::ArrayView<int16_t> interleaved);
+
+        // Gives access to the suppressor, e.g. for SeedNoiseProfile() or
+        // SaveState().
+        NoiseSuppressor *noise_suppressor() { return noise_suppressor_.get(); }
+
+    private:
+        friend class NsSessionPool;
+
+        // Creates a session in the |block_size| bytes at |block|, which must be
+        // aligned to a cache line, or in a block of its own if |block| is null.
+        NsCompactSession(const NsConfig &config,
+                         int sample_rate_hz,
+                         size_t num_channels,
+                         size_t block_size,
+                         uint8_t *block);
+
+        // Returns the size of the block of a session, computed from the layout of
+        // its objects.
+        static size_t BlockSize(int sample_rate_hz, size_t num_channels);
+
+        const StreamConfig stream_config_;
+        const size_t block_size_;
+        // The block, if the session owns it. Destroyed after the objects in it.
+        std::unique_ptr<uint8_t[], AlignedFreeDeleter> block_;
+        NsArena arena_;
+        NsUniquePtr<AudioBuffer> audio_;
+        NsUniquePtr<NoiseSuppressor> noise_suppressor_;
+    };
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_NS_NS_COMPACT_SESSION_H_
@@ -11,6 +11,8 @@
 #ifndef MODULES_AUDIO_PROCESSING_NS_NS_CONFIG_H_
 #define MODULES_AUDIO_PROCESSING_NS_NS_CONFIG_H_
 
+#include <stddef.h>
+
 namespace webrtc {
 
 // Config struct for the noise suppressor
@@ -19,6 +21,19 @@ namespace webrtc {
             k6dB, k12dB, k18dB, k21dB
         };
         SuppressionLevel target_level = SuppressionLevel::k12dB;
+        // Skips the filter bank and the Wiener filtering in Process() for frames
+        // that, together with the filter bank memories, are silent.
+        bool enable_silence_bypass = false;
+        // The mean power per sample, in the 16 bit sample range, at or below
+        // which a frame counts as silent. The default of 0 only bypasses digital
+        // silence, for which the output is unchanged. Above 0, the bypassed
+        // frames are processed as zeros, so the output deviates by up to a few
+        // times the floor level for a few frames after the audio rises above it.
+        float silence_floor = 0.f;
+        // The number of threads over which the channels are split for the
+        // analysis and the filter computation in Process(), including the calling
+        // thread. 1 runs everything on the calling thread.
+        size_t num_threads = 1;
     };
 
 }  // namespace webrtc
@@ -10,25 +10,129 @@
 
 #include "ns_fft.h"
 
+#include <math.h>
+
+#include <type_traits>
+
+#include "checks.h"
 #include "fft4g.h"
 
 namespace webrtc {
 
-    NrFft::NrFft() : bit_reversal_state_(kFftSize / 2), tables_(kFftSize / 2) {
-        // Initialize WebRtc_rdt (setting (bit_reversal_state_[0] to 0 triggers
-        // initialization)
-        bit_reversal_state_[0] = 0.f;
-        std::array<float, kFftSize> tmp_buffer{};
-        tmp_buffer.fill(0.f);
-        WebRtc_rdft(kFftSize, 1, tmp_buffer.data(), bit_reversal_state_.data(),
-                    tables_.data());
+    namespace {
+
+// The tables of the Ooura FFT of |kSize| points: the sizes of the cosine and
+// sine tables and the tables themselves, as set up by WebRtc_rdft_init.
+        template<size_t kSize>
+        struct OouraTables {
+            OouraTables() {
+                // Table sizes of 0 trigger the initialization.
+                std::array<size_t, kSize / 2> work_area;
+                work_area[0] = 0;
+                work_area[1] = 0;
+                WebRtc_rdft_init(kSize, work_area.data(), w.data());
+                table_sizes[0] = work_area[0];
+                table_sizes[1] = work_area[1];
+            }
+
+            size_t table_sizes[2];
+            std::array<float, kSize / 2> w;
+        };
+
+// The FFT tables are built on first use and shared read-only by all
+// transforms, so that the FFTs themselves are stateless.
+        template<size_t kSize>
+        const OouraTables<kSize> &GetOouraTables() {
+            static const OouraTables<kSize> tables;
+            return tables;
+        }
+
+        const SimdFftTables &GetSimdFftTables() {
+            static const SimdFftTables tables;
+            return tables;
+        }
+
+// The twiddle factors exp(2*pi*i*k/512), for k = 0..kFftSize/2, of the
+// radix-2 stage of NrFft512.
+        struct Radix2Twiddles {
+            Radix2Twiddles() {
+                constexpr double kPi = 3.14159265358979323846;
+                for (size_t k = 0; k < kFftSizeBy2Plus1; ++k) {
+                    const double phase = 2.0 * kPi * k / NrFft512::kSize;
+                    re[k] = static_cast<float>(cos(phase));
+                    im[k] = static_cast<float>(sin(phase));
+                }
+            }
+
+            std::array<float, kFftSizeBy2Plus1> re;
+            std::array<float, kFftSizeBy2Plus1> im;
+        };
+
+        const Radix2Twiddles &GetRadix2Twiddles() {
+            static const Radix2Twiddles twiddles;
+            return twiddles;
+        }
+
+// Runs the Ooura FFT of |kSize| points on |a|. The transform rebuilds the bit
+// reversal table in the work area on every call, so a local one is used.
+        template<size_t kSize>
+        void Rdft(int isgn, float *a) {
+            const OouraTables<kSize> &tables = GetOouraTables<kSize>();
+            std::array<size_t, kSize / 2> work_area;
+            work_area[0] = tables.table_sizes[0];
+            work_area[1] = tables.table_sizes[1];
+            WebRtc_rdft_transform(kSize, isgn, a, work_area.data(), tables.w.data());
+        }
+
+    }  // namespace
+
+    SimdFftTables::SimdFftTables() {
+        constexpr double kPi = 3.14159265358979323846;
+        for (size_t k2 = 0; k2 < 8; ++k2) {
+            for (size_t n1 = 0; n1 < 16; ++n1) {
+                const double phase = 2.0 * kPi * n1 * k2 / 128.0;
+                four_step_re[16 * k2 + n1] = static_cast<float>(cos(phase));
+                four_step_im[16 * k2 + n1] = static_cast<float>(sin(phase));
+            }
+        }
+        for (size_t k = 0; k < kFftSize / 2; ++k) {
+            const double phase = 2.0 * kPi * k / kFftSize;
+            real_split_re[k] = static_cast<float>(cos(phase));
+            real_split_im[k] = static_cast<float>(sin(phase));
+        }
     }
 
-    void NrFft::Fft(rtc::ArrayView<float, kFftSize> time_data,
+    static_assert(std::is_trivially_default_constructible<NrFft>::value,
+                  "NrFft holds no state");
+
+    void NrFft::Fft(NsOptimization optimization,
+                    rtc::ArrayView<float, kFftSize> time_data,
                     rtc::ArrayView<float, kFftSize> real,
                     rtc::ArrayView<float, kFftSize> imag) {
-        WebRtc_rdft(kFftSize, 1, time_data.data(), bit_reversal_state_.data(),
-                    tables_.data());
+        switch (optimization) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#if defined(WEBRTC_ENABLE_AVX2)
+            case NsOptimization::kAvx2:
+                FftAvx2(GetSimdFftTables(), time_data.data(), real.data(),
+                        imag.data());
+                return;
+#endif
+            case NsOptimization::kSse2:
+                FftSse2(GetSimdFftTables(), time_data.data(), real.data(),
+                        imag.data());
+                return;
+#endif
+#if defined(WEBRTC_HAS_NEON)
+            case NsOptimization::kNeon:
+                FftNeon(GetSimdFftTables(), time_data.data(), real.data(),
+                        imag.data());
+                return;
+#endif
+            default:
+                break;
+        }
+
+        Rdft<kFftSize>(1, time_data.data());
 
         imag[0] = 0;
         real[0] = time_data[0];
@@ -42,17 +146,43 @@ namespace webrtc {
         }
     }
 
-    void NrFft::Ifft(rtc::ArrayView<const float> real,
+    void NrFft::Ifft(NsOptimization optimization,
+                     rtc::ArrayView<const float> real,
                      rtc::ArrayView<const float> imag,
                      rtc::ArrayView<float> time_data) {
+        RTC_DCHECK_GE(real.size(), kFftSizeBy2Plus1);
+        RTC_DCHECK_GE(imag.size(), kFftSizeBy2Plus1);
+        RTC_DCHECK_EQ(kFftSize, time_data.size());
+        switch (optimization) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#if defined(WEBRTC_ENABLE_AVX2)
+            case NsOptimization::kAvx2:
+                IfftAvx2(GetSimdFftTables(), real.data(), imag.data(),
+                         time_data.data());
+                return;
+#endif
+            case NsOptimization::kSse2:
+                IfftSse2(GetSimdFftTables(), real.data(), imag.data(),
+                         time_data.data());
+                return;
+#endif
+#if defined(WEBRTC_HAS_NEON)
+            case NsOptimization::kNeon:
+                IfftNeon(GetSimdFftTables(), real.data(), imag.data(),
+                         time_data.data());
+                return;
+#endif
+            default:
+                break;
+        }
+
         time_data[0] = real[0];
         time_data[1] = real[kFftSizeBy2Plus1 - 1];
         for (size_t i = 1; i < kFftSizeBy2Plus1 - 1; ++i) {
             time_data[2 * i] = real[i];
             time_data[2 * i + 1] = imag[i];
         }
-        WebRtc_rdft(kFftSize, -1, time_data.data(), bit_reversal_state_.data(),
-                    tables_.data());
+        Rdft<kFftSize>(-1, time_data.data());
 
         // Scale the output
         constexpr float kScaling = 2.f / kFftSize;
@@ -61,4 +191,268 @@ namespace webrtc {
         }
     }
 
+    void NrFft::FftBatch(NsOptimization optimization,
+                         rtc::ArrayView<float *const> time_data,
+                         rtc::ArrayView<float *const> real,
+                         rtc::ArrayView<float *const> imag) {
+        RTC_DCHECK_EQ(time_data.size(), real.size());
+        RTC_DCHECK_EQ(time_data.size(), imag.size());
+        if (time_data.size() > 1) {
+            switch (optimization) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#if defined(WEBRTC_ENABLE_AVX2)
+                case NsOptimization::kAvx2:
+                    FftBatchAvx2(GetSimdFftTables(), time_data.data(), real.data(),
+                                 imag.data(), time_data.size());
+                    return;
+#endif
+                case NsOptimization::kSse2:
+                    FftBatchSse2(GetSimdFftTables(), time_data.data(), real.data(),
+                                 imag.data(), time_data.size());
+                    return;
+#endif
+#if defined(WEBRTC_HAS_NEON)
+                case NsOptimization::kNeon:
+                    FftBatchNeon(GetSimdFftTables(), time_data.data(), real.data(),
+                                 imag.data(), time_data.size());
+                    return;
+#endif
+                default:
+                    break;
+            }
+        }
+
+        for (size_t k = 0; k < time_data.size(); ++k) {
+            Fft(optimization,
+                rtc::ArrayView<float, kFftSize>(time_data[k], kFftSize),
+                rtc::ArrayView<float, kFftSize>(real[k], kFftSize),
+                rtc::ArrayView<float, kFftSize>(imag[k], kFftSize));
+        }
+    }
+
+    void NrFft::IfftBatch(NsOptimization optimization,
+                          rtc::ArrayView<const float *const> real,
+                          rtc::ArrayView<const float *const> imag,
+                          rtc::ArrayView<float *const> time_data) {
+        RTC_DCHECK_EQ(time_data.size(), real.size());
+        RTC_DCHECK_EQ(time_data.size(), imag.size());
+        if (time_data.size() > 1) {
+            switch (optimization) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#if defined(WEBRTC_ENABLE_AVX2)
+                case NsOptimization::kAvx2:
+                    IfftBatchAvx2(GetSimdFftTables(), real.data(), imag.data(),
+                                  time_data.data(), time_data.size());
+                    return;
+#endif
+                case NsOptimization::kSse2:
+                    IfftBatchSse2(GetSimdFftTables(), real.data(), imag.data(),
+                                  time_data.data(), time_data.size());
+                    return;
+#endif
+#if defined(WEBRTC_HAS_NEON)
+                case NsOptimization::kNeon:
+                    IfftBatchNeon(GetSimdFftTables(), real.data(), imag.data(),
+                                  time_data.data(), time_data.size());
+                    return;
+#endif
+                default:
+                    break;
+            }
+        }
+
+        for (size_t k = 0; k < time_data.size(); ++k) {
+            Ifft(optimization,
+                 rtc::ArrayView<const float>(real[k], kFftSize),
+                 rtc::ArrayView<const float>(imag[k], kFftSize),
+                 rtc::ArrayView<float>(time_data[k], kFftSize));
+        }
+    }
+
+    template<size_t kSize>
+    void ScalarNrFft<kSize>::Fft(rtc::ArrayView<float, kSize> time_data,
+                                 rtc::ArrayView<float, kSize> real,
+                                 rtc::ArrayView<float, kSize> imag) {
+        constexpr size_t kSizeBy2Plus1 = kSize / 2 + 1;
+        Rdft<kSize>(1, time_data.data());
+
+        imag[0] = 0;
+        real[0] = time_data[0];
+
+        imag[kSizeBy2Plus1 - 1] = 0;
+        real[kSizeBy2Plus1 - 1] = time_data[1];
+
+        for (size_t i = 1; i < kSizeBy2Plus1 - 1; ++i) {
+            real[i] = time_data[2 * i];
+            imag[i] = time_data[2 * i + 1];
+        }
+    }
+
+    template<size_t kSize>
+    void ScalarNrFft<kSize>::Ifft(rtc::ArrayView<const float> real,
+                                  rtc::ArrayView<const float> imag,
+                                  rtc::ArrayView<float> time_data) {
+        constexpr size_t kSizeBy2Plus1 = kSize / 2 + 1;
+        RTC_DCHECK_GE(real.size(), kSizeBy2Plus1);
+        RTC_DCHECK_GE(imag.size(), kSizeBy2Plus1);
+        RTC_DCHECK_EQ(kSize, time_data.size());
+        time_data[0] = real[0];
+        time_data[1] = real[kSizeBy2Plus1 - 1];
+        for (size_t i = 1; i < kSizeBy2Plus1 - 1; ++i) {
+            time_data[2 * i] = real[i];
+            time_data[2 * i + 1] = imag[i];
+        }
+        Rdft<kSize>(-1, time_data.data());
+
+        // Scale the output
+        constexpr float kScaling = 2.f / kSize;
+        for (float &d : time_data) {
+            d *= kScaling;
+        }
+    }
+
+    template<size_t kSize>
+    void ScalarNrFft<kSize>::FftBatch(rtc::ArrayView<float *const> time_data,
+                                      rtc::ArrayView<float *const> real,
+                                      rtc::ArrayView<float *const> imag) {
+        RTC_DCHECK_EQ(time_data.size(), real.size());
+        RTC_DCHECK_EQ(time_data.size(), imag.size());
+        for (size_t k = 0; k < time_data.size(); ++k) {
+            Fft(rtc::ArrayView<float, kSize>(time_data[k], kSize),
+                rtc::ArrayView<float, kSize>(real[k], kSize),
+                rtc::ArrayView<float, kSize>(imag[k], kSize));
+        }
+    }
+
+    template<size_t kSize>
+    void ScalarNrFft<kSize>::IfftBatch(rtc::ArrayView<const float *const> real,
+                                       rtc::ArrayView<const float *const> imag,
+                                       rtc::ArrayView<float *const> time_data) {
+        RTC_DCHECK_EQ(time_data.size(), real.size());
+        RTC_DCHECK_EQ(time_data.size(), imag.size());
+        for (size_t k = 0; k < time_data.size(); ++k) {
+            Ifft(rtc::ArrayView<const float>(real[k], kSize),
+                 rtc::ArrayView<const float>(imag[k], kSize),
+                 rtc::ArrayView<float>(time_data[k], kSize));
+        }
+    }
+
+    template class ScalarNrFft<NsLowDelayGeometry::kFftSize>;
+    template class ScalarNrFft<NsHighEfficiencyGeometry::kFftSize>;
+
+    constexpr size_t NrFft512::kSize;
+    constexpr size_t NrFft512::kSizeBy2Plus1;
+
+    void NrFft512::Fft(rtc::ArrayView<float, kSize> time_data,
+                       rtc::ArrayView<float, kSize> real,
+                       rtc::ArrayView<float, kSize> imag) {
+        // Transform the even and odd samples. The loops use raw pointers to be
+        // vectorized.
+        std::array<float, kFftSize> even;
+        std::array<float, kFftSize> odd;
+        const float *x = time_data.data();
+        for (size_t i = 0; i < kFftSize; ++i) {
+            even[i] = x[2 * i];
+            odd[i] = x[2 * i + 1];
+        }
+        std::array<float, kFftSize> even_re;
+        std::array<float, kFftSize> even_im;
+        std::array<float, kFftSize> odd_re;
+        std::array<float, kFftSize> odd_im;
+        fft_.Fft(even, even_re, even_im);
+        fft_.Fft(odd, odd_re, odd_im);
+
+        // X[k] = E[k] + W^k O[k] and X[N/2 - k] = conj(E[k] - W^k O[k]), where
+        // W^0 = 1 and W^(N/4) = i.
+        const Radix2Twiddles &twiddles = GetRadix2Twiddles();
+        const float *w_re = twiddles.re.data();
+        const float *w_im = twiddles.im.data();
+        float *re = real.data();
+        float *im = imag.data();
+        re[0] = even_re[0] + odd_re[0];
+        im[0] = 0.f;
+        re[kFftSize] = even_re[0] - odd_re[0];
+        im[kFftSize] = 0.f;
+        for (size_t k = 1; k < kFftSizeBy2Plus1 - 1; ++k) {
+            const float t_re = w_re[k] * odd_re[k] - w_im[k] * odd_im[k];
+            const float t_im = w_re[k] * odd_im[k] + w_im[k] * odd_re[k];
+            re[k] = even_re[k] + t_re;
+            im[k] = even_im[k] + t_im;
+            re[kFftSize - k] = even_re[k] - t_re;
+            im[kFftSize - k] = t_im - even_im[k];
+        }
+        re[kFftSize / 2] = even_re[kFftSize / 2] - odd_im[kFftSize / 2];
+        im[kFftSize / 2] = even_im[kFftSize / 2] + odd_re[kFftSize / 2];
+    }
+
+    void NrFft512::Ifft(rtc::ArrayView<const float> real,
+                        rtc::ArrayView<const float> imag,
+                        rtc::ArrayView<float> time_data) {
+        RTC_DCHECK_GE(real.size(), kSizeBy2Plus1);
+        RTC_DCHECK_GE(imag.size(), kSizeBy2Plus1);
+        RTC_DCHECK_EQ(kSize, time_data.size());
+        // E[k] = (X[k] + conj(X[N/2 - k])) / 2 and
+        // O[k] = (X[k] - conj(X[N/2 - k])) / (2 W^k), where the imaginary parts of
+        // X[0] and X[N/2] are ignored.
+        const float *re = real.data();
+        const float *im = imag.data();
+        std::array<float, kFftSize> even_re;
+        std::array<float, kFftSize> even_im;
+        std::array<float, kFftSize> odd_re;
+        std::array<float, kFftSize> odd_im;
+        even_re[0] = 0.5f * (re[0] + re[kFftSize]);
+        even_im[0] = 0.f;
+        odd_re[0] = 0.5f * (re[0] - re[kFftSize]);
+        odd_im[0] = 0.f;
+        const Radix2Twiddles &twiddles = GetRadix2Twiddles();
+        const float *w_re = twiddles.re.data();
+        const float *w_im = twiddles.im.data();
+        for (size_t k = 1; k < kFftSizeBy2Plus1; ++k) {
+            const float a_re = re[k];
+            const float a_im = im[k];
+            const float b_re = re[kFftSize - k];
+            const float b_im = -im[kFftSize - k];
+            even_re[k] = 0.5f * (a_re + b_re);
+            even_im[k] = 0.5f * (a_im + b_im);
+            const float d_re = 0.5f * (a_re - b_re);
+            const float d_im = 0.5f * (a_im - b_im);
+            odd_re[k] = w_re[k] * d_re + w_im[k] * d_im;
+            odd_im[k] = w_re[k] * d_im - w_im[k] * d_re;
+        }
+
+        std::array<float, kFftSize> even;
+        std::array<float, kFftSize> odd;
+        fft_.Ifft(even_re, even_im, even);
+        fft_.Ifft(odd_re, odd_im, odd);
+        float *x = time_data.data();
+        for (size_t i = 0; i < kFftSize; ++i) {
+            x[2 * i] = even[i];
+            x[2 * i + 1] = odd[i];
+        }
+    }
+
+    void NrFft512::FftBatch(rtc::ArrayView<float *const> time_data,
+                            rtc::ArrayView<float *const> real,
+                            rtc::ArrayView<float *const> imag) {
+        RTC_DCHECK_EQ(time_data.size(), real.size());
+        RTC_DCHECK_EQ(time_data.size(), imag.size());
+        for (size_t k = 0; k < time_data.size(); ++k) {
+            Fft(rtc::ArrayView<float, kSize>(time_data[k], kSize),
+                rtc::ArrayView<float, kSize>(real[k], kSize),
+                rtc::ArrayView<float, kSize>(imag[k], kSize));
+        }
+    }
+
+    void NrFft512::IfftBatch(rtc::ArrayView<const float *const> real,
+                             rtc::ArrayView<const float *const> imag,
+                             rtc::ArrayView<float *const> time_data) {
+        RTC_DCHECK_EQ(time_data.size(), real.size());
+        RTC_DCHECK_EQ(time_data.size(), imag.size());
+        for (size_t k = 0; k < time_data.size(); ++k) {
+            Ifft(rtc::ArrayView<const float>(real[k], kSize),
+                 rtc::ArrayView<const float>(imag[k], kSize),
+                 rtc::ArrayView<float>(time_data[k], kSize));
+        }
+    }
+
 }  // namespace webrtc
@@ -11,35 +11,159 @@
 #ifndef MODULES_AUDIO_PROCESSING_NS_NS_FFT_H_
 #define MODULES_AUDIO_PROCESSING_NS_NS_FFT_H_
 
-#include <vector>
+#include <array>
 
 #include "array_view.h"
 #include "ns_common.h"
+#include "ns_fft_simd.h"
 
 namespace webrtc {
 
-// Wrapper class providing 256 point FFT functionality.
+// Wrapper class providing 256 point FFT functionality. The FFT tables are
+// built once per process and shared, and the optimization is the one cached by
+// DetectOptimization(), so the class is stateless and trivially constructible.
     class NrFft {
     public:
-        NrFft();
+        NrFft() = default;
 
         NrFft(const NrFft &) = delete;
 
         NrFft &operator=(const NrFft &) = delete;
 
-        // Transforms the signal from time to frequency domain.
+        // Transforms the signal from time to frequency domain. The content of
+        // |time_data| is undefined afterwards.
         void Fft(rtc::ArrayView<float, kFftSize> time_data,
                  rtc::ArrayView<float, kFftSize> real,
-                 rtc::ArrayView<float, kFftSize> imag);
+                 rtc::ArrayView<float, kFftSize> imag) {
+            Fft(DetectOptimization(), time_data, real, imag);
+        }
 
         // Transforms the signal from frequency to time domain.
+        void Ifft(rtc::ArrayView<const float> real,
+                  rtc::ArrayView<const float> imag,
+                  rtc::ArrayView<float> time_data) {
+            Ifft(DetectOptimization(), real, imag, time_data);
+        }
+
+        // Transforms the frames time_data[k] into real[k] and imag[k], all of
+        // kFftSize values, for k = 0..K-1. With SIMD support the frames are
+        // interleaved with one frame per lane, otherwise they are transformed one
+        // at a time. The content of the time domain frames is undefined afterwards.
+        void FftBatch(rtc::ArrayView<float *const> time_data,
+                      rtc::ArrayView<float *const> real,
+                      rtc::ArrayView<float *const> imag) {
+            FftBatch(DetectOptimization(), time_data, real, imag);
+        }
+
+        // Batched counterpart of Ifft, with the same conventions as FftBatch.
+        void IfftBatch(rtc::ArrayView<const float *const> real,
+                       rtc::ArrayView<const float *const> imag,
+                       rtc::ArrayView<float *const> time_data) {
+            IfftBatch(DetectOptimization(), real, imag, time_data);
+        }
+
+        // The transforms above with the specified optimization, where kNone
+        // selects the scalar Ooura FFT. Mainly intended for testing.
+        static void Fft(NsOptimization optimization,
+                        rtc::ArrayView<float, kFftSize> time_data,
+                        rtc::ArrayView<float, kFftSize> real,
+                        rtc::ArrayView<float, kFftSize> imag);
+
+        static void Ifft(NsOptimization optimization,
+                         rtc::ArrayView<const float> real,
+                         rtc::ArrayView<const float> imag,
+                         rtc::ArrayView<float> time_data);
+
+        static void FftBatch(NsOptimization optimization,
+                             rtc::ArrayView<float *const> time_data,
+                             rtc::ArrayView<float *const> real,
+                             rtc::ArrayView<float *const> imag);
+
+        static void IfftBatch(NsOptimization optimization,
+                              rtc::ArrayView<const float *const> real,
+                              rtc::ArrayView<const float *const> imag,
+                              rtc::ArrayView<float *const> time_data);
+    };
+
+// Real FFT of |kSize| points with the scalar Ooura FFT, with the same
+// conventions as NrFft. Used by the frame geometries other than the default
+// one, since the SIMD FFTs are specific to 256 points. Instantiated for 128
+// and 512 points.
+    template<size_t kSize>
+    class ScalarNrFft {
+    public:
+        ScalarNrFft() = default;
+
+        ScalarNrFft(const ScalarNrFft &) = delete;
+
+        ScalarNrFft &operator=(const ScalarNrFft &) = delete;
+
+        void Fft(rtc::ArrayView<float, kSize> time_data,
+                 rtc::ArrayView<float, kSize> real,
+                 rtc::ArrayView<float, kSize> imag);
+
+        void Ifft(rtc::ArrayView<const float> real,
+                  rtc::ArrayView<const float> imag,
+                  rtc::ArrayView<float> time_data);
+
+        void FftBatch(rtc::ArrayView<float *const> time_data,
+                      rtc::ArrayView<float *const> real,
+                      rtc::ArrayView<float *const> imag);
+
+        void IfftBatch(rtc::ArrayView<const float *const> real,
+                       rtc::ArrayView<const float *const> imag,
+                       rtc::ArrayView<float *const> time_data);
+    };
+
+// Real FFT of 512 points, with the same conventions as NrFft, computed from
+// the 256 point NrFft transforms of the even and odd samples and one radix-2
+// stage, so that it benefits from the SIMD FFTs.
+    class NrFft512 {
+    public:
+        static constexpr size_t kSize = 2 * kFftSize;
+        static constexpr size_t kSizeBy2Plus1 = kSize / 2 + 1;
+
+        NrFft512() = default;
+
+        NrFft512(const NrFft512 &) = delete;
+
+        NrFft512 &operator=(const NrFft512 &) = delete;
+
+        void Fft(rtc::ArrayView<float, kSize> time_data,
+                 rtc::ArrayView<float, kSize> real,
+                 rtc::ArrayView<float, kSize> imag);
+
         void Ifft(rtc::ArrayView<const float> real,
                   rtc::ArrayView<const float> imag,
                   rtc::ArrayView<float> time_data);
 
+        void FftBatch(rtc::ArrayView<float *const> time_data,
+                      rtc::ArrayView<float *const> real,
+                      rtc::ArrayView<float *const> imag);
+
+        void IfftBatch(rtc::ArrayView<const float *const> real,
+                       rtc::ArrayView<const float *const> imag,
+                       rtc::ArrayView<float *const> time_data);
+
     private:
-        std::vector<size_t> bit_reversal_state_;
-        std::vector<float> tables_;
+        NrFft fft_;
+    };
+
+// Selects the FFT for a frame geometry: NrFft for 256 points, NrFft512 for 512
+// points and ScalarNrFft otherwise.
+    template<size_t kSize>
+    struct NsFftForSize {
+        using Type = ScalarNrFft<kSize>;
+    };
+
+    template<>
+    struct NsFftForSize<kFftSize> {
+        using Type = NrFft;
+    };
+
+    template<>
+    struct NsFftForSize<NrFft512::kSize> {
+        using Type = NrFft512;
     };
 
 }  // namespace webrtc
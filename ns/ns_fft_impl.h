@@ -0,0 +1,552 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Generic SIMD implementation of the 256 point real FFT. This header is only
+// to be included by the instruction set specific translation units, which
+// instantiate the templates below with their own vector operations. The Ops
+// type provides the vector type V, its width kWidth (4 or 8) and the
+// operations Load, Store, Set1, Add, Sub, Mul, Reverse, LoadDeinterleaved,
+// StoreInterleaved and Transpose (in-place kWidth x kWidth).
+//
+// The real FFT is computed as a 128 point complex FFT of the even and odd
+// samples, which is then split into the spectrum of the real signal. The
+// complex FFT uses a four-step decomposition 128 = 16 x 8 where both sets of
+// small FFTs are computed lane-wise, so no shuffles are needed besides one
+// transpose between the two steps.
+//
+// The batched variants transform one frame per lane, using the same
+// decomposition without any transposes inside the transform.
+
+#ifndef MODULES_AUDIO_PROCESSING_NS_NS_FFT_IMPL_H_
+#define MODULES_AUDIO_PROCESSING_NS_NS_FFT_IMPL_H_
+
+#include <stddef.h>
+
+#include <algorithm>
+
+#include "ns_common.h"
+#include "ns_fft_simd.h"
+
+namespace webrtc {
+
+    namespace ns_fft_impl {
+
+// exp(2*pi*i*k/16) for k = 0..7.
+        constexpr float kCos16[8] = {1.f, 0.92387953f, 0.70710678f, 0.38268343f,
+                                     0.f, -0.38268343f, -0.70710678f, -0.92387953f};
+        constexpr float kSin16[8] = {0.f, 0.38268343f, 0.70710678f, 0.92387953f,
+                                     1.f, 0.92387953f, 0.70710678f, 0.38268343f};
+
+// N point complex FFT with positive exponent, computed independently in each
+// lane of the vectors re[0..N-1], im[0..N-1]. N must be a power of two <= 16.
+        template<typename Ops, size_t N>
+        struct LaneFft {
+            using V = typename Ops::V;
+
+            static inline void Run(V *re, V *im) {
+                constexpr size_t kHalf = N / 2;
+                V even_re[kHalf];
+                V even_im[kHalf];
+                V odd_re[kHalf];
+                V odd_im[kHalf];
+                for (size_t k = 0; k < kHalf; ++k) {
+                    even_re[k] = re[2 * k];
+                    even_im[k] = im[2 * k];
+                    odd_re[k] = re[2 * k + 1];
+                    odd_im[k] = im[2 * k + 1];
+                }
+                LaneFft<Ops, kHalf>::Run(even_re, even_im);
+                LaneFft<Ops, kHalf>::Run(odd_re, odd_im);
+
+                for (size_t k = 0; k < kHalf; ++k) {
+                    const size_t t = k * (16 / N);
+                    V t_re;
+                    V t_im;
+                    if (t == 0) {
+                        t_re = odd_re[k];
+                        t_im = odd_im[k];
+                    } else if (t == 4) {
+                        // Multiplication by i.
+                        re[k] = Ops::Sub(even_re[k], odd_im[k]);
+                        im[k] = Ops::Add(even_im[k], odd_re[k]);
+                        re[k + kHalf] = Ops::Add(even_re[k], odd_im[k]);
+                        im[k + kHalf] = Ops::Sub(even_im[k], odd_re[k]);
+                        continue;
+                    } else {
+                        const V c = Ops::Set1(kCos16[t]);
+                        const V s = Ops::Set1(kSin16[t]);
+                        t_re = Ops::Sub(Ops::Mul(odd_re[k], c), Ops::Mul(odd_im[k], s));
+                        t_im = Ops::Add(Ops::Mul(odd_re[k], s), Ops::Mul(odd_im[k], c));
+                    }
+                    re[k] = Ops::Add(even_re[k], t_re);
+                    im[k] = Ops::Add(even_im[k], t_im);
+                    re[k + kHalf] = Ops::Sub(even_re[k], t_re);
+                    im[k + kHalf] = Ops::Sub(even_im[k], t_im);
+                }
+            }
+        };
+
+        template<typename Ops>
+        struct LaneFft<Ops, 1> {
+            static inline void Run(typename Ops::V *, typename Ops::V *) {}
+        };
+
+// 128 point complex FFT with positive exponent of split complex data in natural
+// order. The input and output may not alias.
+        template<typename Ops>
+        void ComplexFft128(const SimdFftTables &tables,
+                           const float *in_re,
+                           const float *in_im,
+                           float *out_re,
+                           float *out_im) {
+            using V = typename Ops::V;
+            constexpr size_t kW = Ops::kWidth;
+            static_assert(kW == 4 || kW == 8, "Unsupported vector width");
+
+            // The input z[n1 + 16 * n2] is viewed as an 8 x 16 matrix. First compute
+            // 8 point FFTs along n2 for all n1, which are laid out along the lanes.
+            alignas(32) float transposed_re[128];
+            alignas(32) float transposed_im[128];
+            for (size_t n1 = 0; n1 < 16; n1 += kW) {
+                V re[8];
+                V im[8];
+                for (size_t n2 = 0; n2 < 8; ++n2) {
+                    re[n2] = Ops::Load(&in_re[16 * n2 + n1]);
+                    im[n2] = Ops::Load(&in_im[16 * n2 + n1]);
+                }
+
+                LaneFft<Ops, 8>::Run(re, im);
+
+                // Apply the twiddle factors exp(2*pi*i*n1*k2/128).
+                for (size_t k2 = 1; k2 < 8; ++k2) {
+                    const V c = Ops::Load(&tables.four_step_re[16 * k2 + n1]);
+                    const V s = Ops::Load(&tables.four_step_im[16 * k2 + n1]);
+                    const V r = re[k2];
+                    re[k2] = Ops::Sub(Ops::Mul(r, c), Ops::Mul(im[k2], s));
+                    im[k2] = Ops::Add(Ops::Mul(r, s), Ops::Mul(im[k2], c));
+                }
+
+                // Store transposed as [n1][k2].
+                for (size_t k2 = 0; k2 < 8; k2 += kW) {
+                    Ops::Transpose(&re[k2]);
+                    Ops::Transpose(&im[k2]);
+                    for (size_t j = 0; j < kW; ++j) {
+                        Ops::Store(&transposed_re[8 * (n1 + j) + k2], re[k2 + j]);
+                        Ops::Store(&transposed_im[8 * (n1 + j) + k2], im[k2 + j]);
+                    }
+                }
+            }
+
+            // Compute 16 point FFTs along n1 for all k2. The result for k1 and k2 is
+            // the output at index 8 * k1 + k2, i.e., in natural order.
+            for (size_t k2 = 0; k2 < 8; k2 += kW) {
+                V re[16];
+                V im[16];
+                for (size_t n1 = 0; n1 < 16; ++n1) {
+                    re[n1] = Ops::Load(&transposed_re[8 * n1 + k2]);
+                    im[n1] = Ops::Load(&transposed_im[8 * n1 + k2]);
+                }
+
+                LaneFft<Ops, 16>::Run(re, im);
+
+                for (size_t k1 = 0; k1 < 16; ++k1) {
+                    Ops::Store(&out_re[8 * k1 + k2], re[k1]);
+                    Ops::Store(&out_im[8 * k1 + k2], im[k1]);
+                }
+            }
+        }
+
+        template<typename Ops>
+        void Fft(const SimdFftTables &tables,
+                 const float *time_data,
+                 float *real,
+                 float *imag) {
+            using V = typename Ops::V;
+            constexpr size_t kW = Ops::kWidth;
+            constexpr size_t kN = kFftSize / 2;
+
+            // Form the complex signal z[n] = x[2n] + i * x[2n + 1].
+            alignas(32) float z_re[kN];
+            alignas(32) float z_im[kN];
+            for (size_t n = 0; n < kN; n += kW) {
+                V even;
+                V odd;
+                Ops::LoadDeinterleaved(&time_data[2 * n], &even, &odd);
+                Ops::Store(&z_re[n], even);
+                Ops::Store(&z_im[n], odd);
+            }
+
+            // The spectrum is padded with Z[kN] = Z[0] to allow the mirrored
+            // loads below.
+            alignas(32) float spectrum_re[kN + kW];
+            alignas(32) float spectrum_im[kN + kW];
+            ComplexFft128<Ops>(tables, z_re, z_im, spectrum_re, spectrum_im);
+            spectrum_re[kN] = spectrum_re[0];
+            spectrum_im[kN] = spectrum_im[0];
+
+            // Split Z[k] into the spectra of the even and odd samples,
+            // E[k] = (Z[k] + conj(Z[kN - k])) / 2 and
+            // O[k] = (Z[k] - conj(Z[kN - k])) / 2i,
+            // and combine them as X[k] = E[k] + exp(2*pi*i*k/256) * O[k].
+            const V kHalf = Ops::Set1(0.5f);
+            for (size_t k = 0; k < kN; k += kW) {
+                const V z_k_re = Ops::Load(&spectrum_re[k]);
+                const V z_k_im = Ops::Load(&spectrum_im[k]);
+                const V z_mirror_re = Ops::Reverse(Ops::Load(&spectrum_re[kN - k - kW + 1]));
+                const V z_mirror_im = Ops::Reverse(Ops::Load(&spectrum_im[kN - k - kW + 1]));
+
+                const V e_re = Ops::Mul(Ops::Add(z_k_re, z_mirror_re), kHalf);
+                const V e_im = Ops::Mul(Ops::Sub(z_k_im, z_mirror_im), kHalf);
+                const V o_re = Ops::Mul(Ops::Add(z_k_im, z_mirror_im), kHalf);
+                const V o_im = Ops::Mul(Ops::Sub(z_mirror_re, z_k_re), kHalf);
+
+                const V c = Ops::Load(&tables.real_split_re[k]);
+                const V s = Ops::Load(&tables.real_split_im[k]);
+                Ops::Store(&real[k], Ops::Add(e_re, Ops::Sub(Ops::Mul(c, o_re),
+                                                             Ops::Mul(s, o_im))));
+                Ops::Store(&imag[k], Ops::Add(e_im, Ops::Add(Ops::Mul(s, o_re),
+                                                             Ops::Mul(c, o_im))));
+            }
+
+            real[0] = spectrum_re[0] + spectrum_im[0];
+            imag[0] = 0.f;
+            real[kN] = spectrum_re[0] - spectrum_im[0];
+            imag[kN] = 0.f;
+        }
+
+        template<typename Ops>
+        void Ifft(const SimdFftTables &tables,
+                  const float *real,
+                  const float *imag,
+                  float *time_data) {
+            using V = typename Ops::V;
+            constexpr size_t kW = Ops::kWidth;
+            constexpr size_t kN = kFftSize / 2;
+
+            // Copy the spectrum, using that the imaginary parts of the DC and
+            // Nyquist bins are zero.
+            alignas(32) float x_re[kN + kW];
+            alignas(32) float x_im[kN + kW];
+            for (size_t k = 0; k <= kN; ++k) {
+                x_re[k] = real[k];
+                x_im[k] = imag[k];
+            }
+            x_im[0] = 0.f;
+            x_im[kN] = 0.f;
+
+            // Form Z[k] = 2 * (E[k] + i * O[k]) from
+            // S[k] = X[k] + conj(X[kN - k]) = 2 * E[k] and
+            // D[k] = X[k] - conj(X[kN - k]) = 2 * exp(2*pi*i*k/256) * O[k].
+            // The inverse complex FFT is computed as the conjugate of the forward
+            // FFT of the conjugated input.
+            alignas(32) float z_re[kN];
+            alignas(32) float z_conj_im[kN];
+            for (size_t k = 0; k < kN; k += kW) {
+                const V x_k_re = Ops::Load(&x_re[k]);
+                const V x_k_im = Ops::Load(&x_im[k]);
+                const V x_mirror_re = Ops::Reverse(Ops::Load(&x_re[kN - k - kW + 1]));
+                const V x_mirror_im = Ops::Reverse(Ops::Load(&x_im[kN - k - kW + 1]));
+
+                const V s_re = Ops::Add(x_k_re, x_mirror_re);
+                const V s_im = Ops::Sub(x_k_im, x_mirror_im);
+                const V d_re = Ops::Sub(x_k_re, x_mirror_re);
+                const V d_im = Ops::Add(x_k_im, x_mirror_im);
+
+                const V c = Ops::Load(&tables.real_split_re[k]);
+                const V s = Ops::Load(&tables.real_split_im[k]);
+                Ops::Store(&z_re[k], Ops::Add(Ops::Sub(s_re, Ops::Mul(d_im, c)),
+                                              Ops::Mul(d_re, s)));
+                Ops::Store(&z_conj_im[k],
+                           Ops::Sub(Ops::Sub(Ops::Set1(0.f), s_im),
+                                    Ops::Add(Ops::Mul(d_re, c), Ops::Mul(d_im, s))));
+            }
+
+            alignas(32) float out_re[kN];
+            alignas(32) float out_im[kN];
+            ComplexFft128<Ops>(tables, z_re, z_conj_im, out_re, out_im);
+
+            // Interleave and scale, undoing the conjugation. The scaling matches
+            // that of NrFft::Ifft.
+            const V kScaling = Ops::Set1(1.f / kFftSize);
+            const V kNegScaling = Ops::Set1(-1.f / kFftSize);
+            for (size_t n = 0; n < kN; n += kW) {
+                Ops::StoreInterleaved(&time_data[2 * n],
+                                      Ops::Mul(Ops::Load(&out_re[n]), kScaling),
+                                      Ops::Mul(Ops::Load(&out_im[n]), kNegScaling));
+            }
+        }
+
+// Lane-interleaved counterpart of ComplexFft128, where each lane holds a
+// separate signal. The data is stored as [index][lane] and is transformed in
+// place.
+        template<typename Ops>
+        void ComplexFft128Lanes(const SimdFftTables &tables, float *re_data, float *im_data) {
+            using V = typename Ops::V;
+            constexpr size_t kW = Ops::kWidth;
+
+            alignas(32) float tmp_re[128 * kW];
+            alignas(32) float tmp_im[128 * kW];
+            for (size_t n1 = 0; n1 < 16; ++n1) {
+                V re[8];
+                V im[8];
+                for (size_t n2 = 0; n2 < 8; ++n2) {
+                    re[n2] = Ops::Load(&re_data[(16 * n2 + n1) * kW]);
+                    im[n2] = Ops::Load(&im_data[(16 * n2 + n1) * kW]);
+                }
+
+                LaneFft<Ops, 8>::Run(re, im);
+
+                Ops::Store(&tmp_re[8 * n1 * kW], re[0]);
+                Ops::Store(&tmp_im[8 * n1 * kW], im[0]);
+                for (size_t k2 = 1; k2 < 8; ++k2) {
+                    const V c = Ops::Set1(tables.four_step_re[16 * k2 + n1]);
+                    const V s = Ops::Set1(tables.four_step_im[16 * k2 + n1]);
+                    Ops::Store(&tmp_re[(8 * n1 + k2) * kW],
+                               Ops::Sub(Ops::Mul(re[k2], c), Ops::Mul(im[k2], s)));
+                    Ops::Store(&tmp_im[(8 * n1 + k2) * kW],
+                               Ops::Add(Ops::Mul(re[k2], s), Ops::Mul(im[k2], c)));
+                }
+            }
+
+            for (size_t k2 = 0; k2 < 8; ++k2) {
+                V re[16];
+                V im[16];
+                for (size_t n1 = 0; n1 < 16; ++n1) {
+                    re[n1] = Ops::Load(&tmp_re[(8 * n1 + k2) * kW]);
+                    im[n1] = Ops::Load(&tmp_im[(8 * n1 + k2) * kW]);
+                }
+
+                LaneFft<Ops, 16>::Run(re, im);
+
+                for (size_t k1 = 0; k1 < 16; ++k1) {
+                    Ops::Store(&re_data[(8 * k1 + k2) * kW], re[k1]);
+                    Ops::Store(&im_data[(8 * k1 + k2) * kW], im[k1]);
+                }
+            }
+        }
+
+// Computes the forward transforms of up to Ops::kWidth frames, one frame per
+// lane. Each lane performs the same arithmetic as Fft.
+        template<typename Ops>
+        void FftLanes(const SimdFftTables &tables,
+                      const float *const *time_data,
+                      float *const *real,
+                      float *const *imag,
+                      size_t num_frames) {
+            using V = typename Ops::V;
+            constexpr size_t kW = Ops::kWidth;
+            constexpr size_t kN = kFftSize / 2;
+
+            // Form the complex signals z[n] = x[2n] + i * x[2n + 1], transposed into
+            // the lanes. Unused lanes are zero.
+            alignas(32) float z_re[kN * kW];
+            alignas(32) float z_im[kN * kW];
+            // The transposes of the interleaved samples x[2n], x[2n + 1] directly give
+            // the real and imaginary parts of z[n] for all lanes.
+            for (size_t n = 0; n < kN; n += kW) {
+                V first[kW];
+                V second[kW];
+                for (size_t l = 0; l < kW; ++l) {
+                    if (l < num_frames) {
+                        first[l] = Ops::Load(&time_data[l][2 * n]);
+                        second[l] = Ops::Load(&time_data[l][2 * n + kW]);
+                    } else {
+                        first[l] = Ops::Set1(0.f);
+                        second[l] = Ops::Set1(0.f);
+                    }
+                }
+                Ops::Transpose(first);
+                Ops::Transpose(second);
+                for (size_t j = 0; j < kW; j += 2) {
+                    Ops::Store(&z_re[(n + j / 2) * kW], first[j]);
+                    Ops::Store(&z_im[(n + j / 2) * kW], first[j + 1]);
+                    Ops::Store(&z_re[(n + (kW + j) / 2) * kW], second[j]);
+                    Ops::Store(&z_im[(n + (kW + j) / 2) * kW], second[j + 1]);
+                }
+            }
+
+            ComplexFft128Lanes<Ops>(tables, z_re, z_im);
+            const float *spectrum_re = z_re;
+            const float *spectrum_im = z_im;
+
+            // Split the spectra as in Fft and transpose them back out of the lanes.
+            const V kHalf = Ops::Set1(0.5f);
+            for (size_t k0 = 0; k0 < kN; k0 += kW) {
+                V x_re[kW];
+                V x_im[kW];
+                for (size_t j = 0; j < kW; ++j) {
+                    const size_t k = k0 + j;
+                    const size_t mirror = (kN - k) % kN;
+                    const V z_k_re = Ops::Load(&spectrum_re[k * kW]);
+                    const V z_k_im = Ops::Load(&spectrum_im[k * kW]);
+                    const V z_mirror_re = Ops::Load(&spectrum_re[mirror * kW]);
+                    const V z_mirror_im = Ops::Load(&spectrum_im[mirror * kW]);
+
+                    const V e_re = Ops::Mul(Ops::Add(z_k_re, z_mirror_re), kHalf);
+                    const V e_im = Ops::Mul(Ops::Sub(z_k_im, z_mirror_im), kHalf);
+                    const V o_re = Ops::Mul(Ops::Add(z_k_im, z_mirror_im), kHalf);
+                    const V o_im = Ops::Mul(Ops::Sub(z_mirror_re, z_k_re), kHalf);
+
+                    const V c = Ops::Set1(tables.real_split_re[k]);
+                    const V s = Ops::Set1(tables.real_split_im[k]);
+                    x_re[j] = Ops::Add(e_re, Ops::Sub(Ops::Mul(c, o_re), Ops::Mul(s, o_im)));
+                    x_im[j] = Ops::Add(e_im, Ops::Add(Ops::Mul(s, o_re), Ops::Mul(c, o_im)));
+                }
+                Ops::Transpose(x_re);
+                Ops::Transpose(x_im);
+                for (size_t l = 0; l < num_frames; ++l) {
+                    Ops::Store(&real[l][k0], x_re[l]);
+                    Ops::Store(&imag[l][k0], x_im[l]);
+                }
+            }
+
+            for (size_t l = 0; l < num_frames; ++l) {
+                real[l][0] = spectrum_re[l] + spectrum_im[l];
+                imag[l][0] = 0.f;
+                real[l][kN] = spectrum_re[l] - spectrum_im[l];
+                imag[l][kN] = 0.f;
+            }
+        }
+
+// Computes the inverse transforms of up to Ops::kWidth frames, one frame per
+// lane. Each lane performs the same arithmetic as Ifft.
+        template<typename Ops>
+        void IfftLanes(const SimdFftTables &tables,
+                       const float *const *real,
+                       const float *const *imag,
+                       float *const *time_data,
+                       size_t num_frames) {
+            using V = typename Ops::V;
+            constexpr size_t kW = Ops::kWidth;
+            constexpr size_t kN = kFftSize / 2;
+
+            // Transpose the spectra into the lanes, using that the imaginary parts of
+            // the DC and Nyquist bins are zero.
+            alignas(32) float x_re[(kN + 1) * kW];
+            alignas(32) float x_im[(kN + 1) * kW];
+            for (size_t k = 0; k < kN; k += kW) {
+                V re[kW];
+                V im[kW];
+                for (size_t l = 0; l < kW; ++l) {
+                    re[l] = l < num_frames ? Ops::Load(&real[l][k]) : Ops::Set1(0.f);
+                    im[l] = l < num_frames ? Ops::Load(&imag[l][k]) : Ops::Set1(0.f);
+                }
+                Ops::Transpose(re);
+                Ops::Transpose(im);
+                for (size_t j = 0; j < kW; ++j) {
+                    Ops::Store(&x_re[(k + j) * kW], re[j]);
+                    Ops::Store(&x_im[(k + j) * kW], im[j]);
+                }
+            }
+            for (size_t l = 0; l < kW; ++l) {
+                x_re[kN * kW + l] = l < num_frames ? real[l][kN] : 0.f;
+                x_im[kN * kW + l] = 0.f;
+                x_im[l] = 0.f;
+            }
+
+            // Form Z[k] as in Ifft. The bins k and kN - k are computed together, which
+            // allows the result to be stored in place.
+            auto form_z = [&tables](size_t k, V x_k_re, V x_k_im, V x_mirror_re,
+                                    V x_mirror_im, V *z_re, V *z_conj_im) {
+                const V s_re = Ops::Add(x_k_re, x_mirror_re);
+                const V s_im = Ops::Sub(x_k_im, x_mirror_im);
+                const V d_re = Ops::Sub(x_k_re, x_mirror_re);
+                const V d_im = Ops::Add(x_k_im, x_mirror_im);
+
+                const V c = Ops::Set1(tables.real_split_re[k]);
+                const V s = Ops::Set1(tables.real_split_im[k]);
+                *z_re = Ops::Add(Ops::Sub(s_re, Ops::Mul(d_im, c)), Ops::Mul(d_re, s));
+                *z_conj_im = Ops::Sub(Ops::Sub(Ops::Set1(0.f), s_im),
+                                      Ops::Add(Ops::Mul(d_re, c), Ops::Mul(d_im, s)));
+            };
+            for (size_t k = 0; k <= kN / 2; ++k) {
+                const size_t mirror = kN - k;
+                const V x_k_re = Ops::Load(&x_re[k * kW]);
+                const V x_k_im = Ops::Load(&x_im[k * kW]);
+                const V x_mirror_re = Ops::Load(&x_re[mirror * kW]);
+                const V x_mirror_im = Ops::Load(&x_im[mirror * kW]);
+
+                V z_k_re;
+                V z_k_conj_im;
+                form_z(k, x_k_re, x_k_im, x_mirror_re, x_mirror_im, &z_k_re,
+                       &z_k_conj_im);
+                if (k > 0 && k < kN / 2) {
+                    V z_mirror_re;
+                    V z_mirror_conj_im;
+                    form_z(mirror, x_mirror_re, x_mirror_im, x_k_re, x_k_im,
+                           &z_mirror_re, &z_mirror_conj_im);
+                    Ops::Store(&x_re[mirror * kW], z_mirror_re);
+                    Ops::Store(&x_im[mirror * kW], z_mirror_conj_im);
+                }
+                Ops::Store(&x_re[k * kW], z_k_re);
+                Ops::Store(&x_im[k * kW], z_k_conj_im);
+            }
+            float *z_re = x_re;
+            float *z_conj_im = x_im;
+
+            ComplexFft128Lanes<Ops>(tables, z_re, z_conj_im);
+            const float *out_re = z_re;
+            const float *out_im = z_conj_im;
+
+            // Scale, undo the conjugation and transpose back out of the lanes.
+            const V kScaling = Ops::Set1(1.f / kFftSize);
+            const V kNegScaling = Ops::Set1(-1.f / kFftSize);
+            for (size_t n = 0; n < kN; n += kW) {
+                V first[kW];
+                V second[kW];
+                for (size_t j = 0; j < kW; j += 2) {
+                    first[j] = Ops::Mul(Ops::Load(&out_re[(n + j / 2) * kW]), kScaling);
+                    first[j + 1] =
+                            Ops::Mul(Ops::Load(&out_im[(n + j / 2) * kW]), kNegScaling);
+                    second[j] =
+                            Ops::Mul(Ops::Load(&out_re[(n + (kW + j) / 2) * kW]), kScaling);
+                    second[j + 1] = Ops::Mul(Ops::Load(&out_im[(n + (kW + j) / 2) * kW]),
+                                             kNegScaling);
+                }
+                Ops::Transpose(first);
+                Ops::Transpose(second);
+                for (size_t l = 0; l < num_frames; ++l) {
+                    Ops::Store(&time_data[l][2 * n], first[l]);
+                    Ops::Store(&time_data[l][2 * n + kW], second[l]);
+                }
+            }
+        }
+
+// Batched transforms of any number of frames, processed Ops::kWidth frames at
+// a time.
+        template<typename Ops>
+        void FftBatch(const SimdFftTables &tables,
+                      const float *const *time_data,
+                      float *const *real,
+                      float *const *imag,
+                      size_t num_frames) {
+            for (size_t k = 0; k < num_frames; k += Ops::kWidth) {
+                const size_t num_lanes = std::min(Ops::kWidth, num_frames - k);
+                FftLanes<Ops>(tables, &time_data[k], &real[k], &imag[k], num_lanes);
+            }
+        }
+
+        template<typename Ops>
+        void IfftBatch(const SimdFftTables &tables,
+                       const float *const *real,
+                       const float *const *imag,
+                       float *const *time_data,
+                       size_t num_frames) {
+            for (size_t k = 0; k < num_frames; k += Ops::kWidth) {
+                const size_t num_lanes = std::min(Ops::kWidth, num_frames - k);
+                IfftLanes<Ops>(tables, &real[k], &imag[k], &time_data[k], num_lanes);
+            }
+        }
+
+    }  // namespace ns_fft_impl
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_NS_NS_FFT_IMPL_H_
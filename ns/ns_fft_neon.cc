@@ -0,0 +1,52 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "ns_fft_simd.h"
+
+#if defined(WEBRTC_HAS_NEON)
+
+#include "ns_fft_impl.h"
+#include "simd_ops_neon.h"
+
+namespace webrtc {
+
+    void FftNeon(const SimdFftTables &tables,
+                 const float *time_data,
+                 float *real,
+                 float *imag) {
+        ns_fft_impl::Fft<NeonOps>(tables, time_data, real, imag);
+    }
+
+    void IfftNeon(const SimdFftTables &tables,
+                  const float *real,
+                  const float *imag,
+                  float *time_data) {
+        ns_fft_impl::Ifft<NeonOps>(tables, real, imag, time_data);
+    }
+
+    void FftBatchNeon(const SimdFftTables &tables,
+                    const float *const *time_data,
+                    float *const *real,
+                    float *const *imag,
+                    size_t num_frames) {
+        ns_fft_impl::FftBatch<NeonOps>(tables, time_data, real, imag, num_frames);
+    }
+
+    void IfftBatchNeon(const SimdFftTables &tables,
+                     const float *const *real,
+                     const float *const *imag,
+                     float *const *time_data,
+                     size_t num_frames) {
+        ns_fft_impl::IfftBatch<NeonOps>(tables, real, imag, time_data, num_frames);
+    }
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_HAS_NEON
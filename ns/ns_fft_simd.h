@@ -0,0 +1,118 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_NS_NS_FFT_SIMD_H_
+#define MODULES_AUDIO_PROCESSING_NS_NS_FFT_SIMD_H_
+
+#include <stddef.h>
+
+#include "arch.h"
+#include "ns_common.h"
+
+namespace webrtc {
+
+// Twiddle factors for the SIMD implementations of the 256 point real FFT.
+    struct SimdFftTables {
+        SimdFftTables();
+
+        // exp(2*pi*i*n1*k2/128), stored as [k2][n1], for the four-step
+        // 128 point complex FFT (8 x 16 decomposition).
+        alignas(32) float four_step_re[8 * 16];
+        alignas(32) float four_step_im[8 * 16];
+        // exp(2*pi*i*k/256), used for splitting the complex FFT into the
+        // spectrum of the real signal.
+        alignas(32) float real_split_re[kFftSize / 2];
+        alignas(32) float real_split_im[kFftSize / 2];
+    };
+
+// The SIMD transforms use the same conventions as NrFft::Fft and NrFft::Ifft,
+// except that the time domain data is left untouched by the forward
+// transform. The batched variants transform |num_frames| frames of kFftSize
+// values, one frame per SIMD lane.
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+
+    void FftSse2(const SimdFftTables &tables,
+                 const float *time_data,
+                 float *real,
+                 float *imag);
+
+    void IfftSse2(const SimdFftTables &tables,
+                  const float *real,
+                  const float *imag,
+                  float *time_data);
+
+    void FftBatchSse2(const SimdFftTables &tables,
+                    const float *const *time_data,
+                    float *const *real,
+                    float *const *imag,
+                    size_t num_frames);
+
+    void IfftBatchSse2(const SimdFftTables &tables,
+                     const float *const *real,
+                     const float *const *imag,
+                     float *const *time_data,
+                     size_t num_frames);
+
+#if defined(WEBRTC_ENABLE_AVX2)
+
+    void FftAvx2(const SimdFftTables &tables,
+                 const float *time_data,
+                 float *real,
+                 float *imag);
+
+    void IfftAvx2(const SimdFftTables &tables,
+                  const float *real,
+                  const float *imag,
+                  float *time_data);
+
+    void FftBatchAvx2(const SimdFftTables &tables,
+                    const float *const *time_data,
+                    float *const *real,
+                    float *const *imag,
+                    size_t num_frames);
+
+    void IfftBatchAvx2(const SimdFftTables &tables,
+                     const float *const *real,
+                     const float *const *imag,
+                     float *const *time_data,
+                     size_t num_frames);
+
+#endif
+#endif
+
+#if defined(WEBRTC_HAS_NEON)
+
+    void FftNeon(const SimdFftTables &tables,
+                 const float *time_data,
+                 float *real,
+                 float *imag);
+
+    void IfftNeon(const SimdFftTables &tables,
+                  const float *real,
+                  const float *imag,
+                  float *time_data);
+
+    void FftBatchNeon(const SimdFftTables &tables,
+                    const float *const *time_data,
+                    float *const *real,
+                    float *const *imag,
+                    size_t num_frames);
+
+    void IfftBatchNeon(const SimdFftTables &tables,
+                     const float *const *real,
+                     const float *const *imag,
+                     float *const *time_data,
+                     size_t num_frames);
+
+#endif
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_NS_NS_FFT_SIMD_H_
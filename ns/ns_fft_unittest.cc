@@ -0,0 +1,217 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "ns_fft.h"
+
+#include <math.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace webrtc {
+    namespace {
+
+// Max error of the optimized FFTs relative to the peak magnitude of the
+// output of the scalar Ooura FFT. The error measured with SSE2 and AVX2 is at
+// most 3.2e-7.
+        constexpr float kTolerance = 5e-7f;
+
+        constexpr size_t kNumFrames = 9;
+
+        void GenerateFrame(uint32_t *seed, rtc::ArrayView<float> x) {
+            for (float &v : x) {
+                *seed = *seed * 1664525u + 1013904223u;
+                v = static_cast<float>(static_cast<int>(*seed >> 16) - 32768);
+            }
+        }
+
+        float PeakMagnitude(rtc::ArrayView<const float> x) {
+            float peak = 0.f;
+            for (float v : x) {
+                peak = std::max(peak, fabsf(v));
+            }
+            return peak;
+        }
+
+        void ExpectNear(rtc::ArrayView<const float> reference,
+                        rtc::ArrayView<const float> x) {
+            ASSERT_EQ(reference.size(), x.size());
+            const float tolerance = kTolerance * PeakMagnitude(reference);
+            for (size_t i = 0; i < x.size(); ++i) {
+                ASSERT_NEAR(reference[i], x[i], tolerance) << "index " << i;
+            }
+        }
+
+        struct Spectrum {
+            std::array<float, kFftSize> real;
+            std::array<float, kFftSize> imag;
+        };
+
+        // Applies the forward and inverse transforms with |optimization| to
+        // |frames|, one frame at a time.
+        void Transform(NsOptimization optimization,
+                       const std::vector<std::array<float, kFftSize>> &frames,
+                       std::vector<Spectrum> *spectra,
+                       std::vector<std::array<float, kFftSize>> *inverse) {
+            spectra->resize(frames.size());
+            inverse->resize(frames.size());
+            for (size_t k = 0; k < frames.size(); ++k) {
+                std::array<float, kFftSize> x = frames[k];
+                NrFft::Fft(optimization, x, (*spectra)[k].real, (*spectra)[k].imag);
+                NrFft::Ifft(optimization, (*spectra)[k].real, (*spectra)[k].imag,
+                            (*inverse)[k]);
+            }
+        }
+
+        // Applies the batched forward and inverse transforms with |optimization|
+        // to |frames|.
+        void TransformBatch(NsOptimization optimization,
+                            const std::vector<std::array<float, kFftSize>> &frames,
+                            std::vector<Spectrum> *spectra,
+                            std::vector<std::array<float, kFftSize>> *inverse) {
+            std::vector<std::array<float, kFftSize>> x = frames;
+            spectra->resize(frames.size());
+            inverse->resize(frames.size());
+            std::vector<float *> x_ptrs;
+            std::vector<float *> real_ptrs;
+            std::vector<float *> imag_ptrs;
+            std::vector<float *> inverse_ptrs;
+            for (size_t k = 0; k < frames.size(); ++k) {
+                x_ptrs.push_back(x[k].data());
+                real_ptrs.push_back((*spectra)[k].real.data());
+                imag_ptrs.push_back((*spectra)[k].imag.data());
+                inverse_ptrs.push_back((*inverse)[k].data());
+            }
+            NrFft::FftBatch(optimization, x_ptrs, real_ptrs, imag_ptrs);
+            const std::vector<const float *> const_real_ptrs(real_ptrs.begin(),
+                                                             real_ptrs.end());
+            const std::vector<const float *> const_imag_ptrs(imag_ptrs.begin(),
+                                                             imag_ptrs.end());
+            NrFft::IfftBatch(optimization, const_real_ptrs, const_imag_ptrs,
+                             inverse_ptrs);
+        }
+
+        void ExpectSpectraNear(const std::vector<Spectrum> &reference,
+                               const std::vector<Spectrum> &spectra) {
+            ASSERT_EQ(reference.size(), spectra.size());
+            for (size_t k = 0; k < spectra.size(); ++k) {
+                SCOPED_TRACE(k);
+                std::vector<float> reference_bins(
+                        reference[k].real.begin(),
+                        reference[k].real.begin() + kFftSizeBy2Plus1);
+                reference_bins.insert(reference_bins.end(), reference[k].imag.begin(),
+                                      reference[k].imag.begin() + kFftSizeBy2Plus1);
+                std::vector<float> bins(spectra[k].real.begin(),
+                                        spectra[k].real.begin() + kFftSizeBy2Plus1);
+                bins.insert(bins.end(), spectra[k].imag.begin(),
+                            spectra[k].imag.begin() + kFftSizeBy2Plus1);
+                ExpectNear(reference_bins, bins);
+            }
+        }
+
+        void ExpectFramesNear(
+                const std::vector<std::array<float, kFftSize>> &reference,
+                const std::vector<std::array<float, kFftSize>> &frames) {
+            ASSERT_EQ(reference.size(), frames.size());
+            for (size_t k = 0; k < frames.size(); ++k) {
+                SCOPED_TRACE(k);
+                ExpectNear(reference[k], frames[k]);
+            }
+        }
+
+    }  // namespace
+
+// Verifies the single and batched transforms of every available optimization
+// against the scalar Ooura FFT.
+    TEST(NrFftTest, MatchesOouraFft) {
+        std::vector<std::array<float, kFftSize>> frames(kNumFrames);
+        uint32_t seed = 1;
+        for (auto &frame : frames) {
+            GenerateFrame(&seed, frame);
+        }
+        // A frame with only a DC and a Nyquist component.
+        for (size_t i = 0; i < kFftSize; ++i) {
+            frames[0][i] = i % 2 == 0 ? 1000.f : 0.f;
+        }
+
+        std::vector<Spectrum> reference_spectra;
+        std::vector<std::array<float, kFftSize>> reference_inverse;
+        Transform(NsOptimization::kNone, frames, &reference_spectra,
+                  &reference_inverse);
+        // The inverse transform restores the input.
+        ExpectFramesNear(frames, reference_inverse);
+
+        for (NsOptimization optimization : AvailableOptimizations()) {
+            SCOPED_TRACE(static_cast<int>(optimization));
+            std::vector<Spectrum> spectra;
+            std::vector<std::array<float, kFftSize>> inverse;
+            Transform(optimization, frames, &spectra, &inverse);
+            ExpectSpectraNear(reference_spectra, spectra);
+            ExpectFramesNear(reference_inverse, inverse);
+
+            // Batches of every size up to kNumFrames, which covers the full and
+            // partial groups of lanes.
+            for (size_t num_frames = 1; num_frames <= kNumFrames; ++num_frames) {
+                SCOPED_TRACE(num_frames);
+                const std::vector<std::array<float, kFftSize>> batch(
+                        frames.begin(), frames.begin() + num_frames);
+                TransformBatch(optimization, batch, &spectra, &inverse);
+                ExpectSpectraNear(
+                        std::vector<Spectrum>(reference_spectra.begin(),
+                                              reference_spectra.begin() + num_frames),
+                        spectra);
+                ExpectFramesNear(
+                        std::vector<std::array<float, kFftSize>>(
+                                reference_inverse.begin(),
+                                reference_inverse.begin() + num_frames),
+                        inverse);
+            }
+        }
+    }
+
+// Verifies the 512 point FFT built on NrFft against the scalar Ooura FFT.
+    TEST(NrFftTest, NrFft512MatchesOouraFft) {
+        constexpr size_t kSize = NrFft512::kSize;
+        uint32_t seed = 2;
+        std::array<float, kSize> frame;
+        GenerateFrame(&seed, frame);
+
+        std::array<float, kSize> x = frame;
+        std::array<float, kSize> reference_real;
+        std::array<float, kSize> reference_imag;
+        std::array<float, kSize> reference_inverse;
+        ScalarNrFft<kSize> ooura;
+        ooura.Fft(x, reference_real, reference_imag);
+        ooura.Ifft(reference_real, reference_imag, reference_inverse);
+
+        x = frame;
+        std::array<float, kSize> real;
+        std::array<float, kSize> imag;
+        std::array<float, kSize> inverse;
+        NrFft512 fft;
+        fft.Fft(x, real, imag);
+        fft.Ifft(real, imag, inverse);
+
+        std::vector<float> reference_bins(reference_real.begin(),
+                                          reference_real.begin() + NrFft512::kSizeBy2Plus1);
+        reference_bins.insert(reference_bins.end(), reference_imag.begin(),
+                              reference_imag.begin() + NrFft512::kSizeBy2Plus1);
+        std::vector<float> bins(real.begin(), real.begin() + NrFft512::kSizeBy2Plus1);
+        bins.insert(bins.end(), imag.begin(), imag.begin() + NrFft512::kSizeBy2Plus1);
+        ExpectNear(reference_bins, bins);
+        ExpectNear(reference_inverse, inverse);
+        ExpectNear(frame, inverse);
+    }
+
+}  // namespace webrtc
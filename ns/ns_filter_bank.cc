@@ -0,0 +1,224 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "ns_filter_bank.h"
+
+#include <math.h>
+#include <algorithm>
+#include <array>
+
+#include "fast_math.h"
+#include "checks.h"
+
+namespace webrtc {
+
+    namespace {
+
+// Hybrib Hanning and flat window for the filterbank.
+        constexpr std::array<float, 96> kBlocks160w256FirstHalf = {
+                0.00000000f, 0.01636173f, 0.03271908f, 0.04906767f, 0.06540313f,
+                0.08172107f, 0.09801714f, 0.11428696f, 0.13052619f, 0.14673047f,
+                0.16289547f, 0.17901686f, 0.19509032f, 0.21111155f, 0.22707626f,
+                0.24298018f, 0.25881905f, 0.27458862f, 0.29028468f, 0.30590302f,
+                0.32143947f, 0.33688985f, 0.35225005f, 0.36751594f, 0.38268343f,
+                0.39774847f, 0.41270703f, 0.42755509f, 0.44228869f, 0.45690388f,
+                0.47139674f, 0.48576339f, 0.50000000f, 0.51410274f, 0.52806785f,
+                0.54189158f, 0.55557023f, 0.56910015f, 0.58247770f, 0.59569930f,
+                0.60876143f, 0.62166057f, 0.63439328f, 0.64695615f, 0.65934582f,
+                0.67155895f, 0.68359230f, 0.69544264f, 0.70710678f, 0.71858162f,
+                0.72986407f, 0.74095113f, 0.75183981f, 0.76252720f, 0.77301045f,
+                0.78328675f, 0.79335334f, 0.80320753f, 0.81284668f, 0.82226822f,
+                0.83146961f, 0.84044840f, 0.84920218f, 0.85772861f, 0.86602540f,
+                0.87409034f, 0.88192126f, 0.88951608f, 0.89687274f, 0.90398929f,
+                0.91086382f, 0.91749450f, 0.92387953f, 0.93001722f, 0.93590593f,
+                0.94154407f, 0.94693013f, 0.95206268f, 0.95694034f, 0.96156180f,
+                0.96592583f, 0.97003125f, 0.97387698f, 0.97746197f, 0.98078528f,
+                0.98384601f, 0.98664333f, 0.98917651f, 0.99144486f, 0.99344778f,
+                0.99518473f, 0.99665524f, 0.99785892f, 0.99879546f, 0.99946459f,
+                0.99986614f};
+
+// The same window for 80 sample frames and a 128 point FFT.
+        constexpr std::array<float, 48> kBlocks80w128FirstHalf = {
+                0.00000000f, 0.03271908f, 0.06540313f, 0.09801714f, 0.13052619f,
+                0.16289547f, 0.19509032f, 0.22707626f, 0.25881905f, 0.29028468f,
+                0.32143947f, 0.35225005f, 0.38268343f, 0.41270703f, 0.44228869f,
+                0.47139674f, 0.50000000f, 0.52806785f, 0.55557023f, 0.58247770f,
+                0.60876143f, 0.63439328f, 0.65934582f, 0.68359230f, 0.70710678f,
+                0.72986407f, 0.75183981f, 0.77301045f, 0.79335334f, 0.81284668f,
+                0.83146961f, 0.84920218f, 0.86602540f, 0.88192126f, 0.89687274f,
+                0.91086382f, 0.92387953f, 0.93590593f, 0.94693013f, 0.95694034f,
+                0.96592583f, 0.97387698f, 0.98078528f, 0.98664333f, 0.99144486f,
+                0.99518473f, 0.99785892f, 0.99946459f};
+
+// The same window for 320 sample frames and a 512 point FFT.
+        constexpr std::array<float, 192> kBlocks320w512FirstHalf = {
+                0.00000000f, 0.00818114f, 0.01636173f, 0.02454123f, 0.03271908f,
+                0.04089475f, 0.04906767f, 0.05723732f, 0.06540313f, 0.07356456f,
+                0.08172107f, 0.08987211f, 0.09801714f, 0.10615561f, 0.11428696f,
+                0.12241068f, 0.13052619f, 0.13863297f, 0.14673047f, 0.15481816f,
+                0.16289547f, 0.17096189f, 0.17901686f, 0.18705985f, 0.19509032f,
+                0.20310773f, 0.21111155f, 0.21910124f, 0.22707626f, 0.23503609f,
+                0.24298018f, 0.25090801f, 0.25881905f, 0.26671276f, 0.27458862f,
+                0.28244610f, 0.29028468f, 0.29810383f, 0.30590302f, 0.31368174f,
+                0.32143947f, 0.32917568f, 0.33688985f, 0.34458148f, 0.35225005f,
+                0.35989504f, 0.36751594f, 0.37511224f, 0.38268343f, 0.39022901f,
+                0.39774847f, 0.40524131f, 0.41270703f, 0.42014512f, 0.42755509f,
+                0.43493645f, 0.44228869f, 0.44961133f, 0.45690388f, 0.46416584f,
+                0.47139674f, 0.47859608f, 0.48576339f, 0.49289819f, 0.50000000f,
+                0.50706834f, 0.51410274f, 0.52110274f, 0.52806785f, 0.53499762f,
+                0.54189158f, 0.54874927f, 0.55557023f, 0.56235401f, 0.56910015f,
+                0.57580819f, 0.58247770f, 0.58910822f, 0.59569930f, 0.60225052f,
+                0.60876143f, 0.61523159f, 0.62166057f, 0.62804795f, 0.63439328f,
+                0.64069616f, 0.64695615f, 0.65317284f, 0.65934582f, 0.66547466f,
+                0.67155895f, 0.67759830f, 0.68359230f, 0.68954054f, 0.69544264f,
+                0.70129818f, 0.70710678f, 0.71286806f, 0.71858162f, 0.72424708f,
+                0.72986407f, 0.73543221f, 0.74095113f, 0.74642045f, 0.75183981f,
+                0.75720885f, 0.76252720f, 0.76779452f, 0.77301045f, 0.77817464f,
+                0.78328675f, 0.78834643f, 0.79335334f, 0.79830715f, 0.80320753f,
+                0.80805415f, 0.81284668f, 0.81758481f, 0.82226822f, 0.82689659f,
+                0.83146961f, 0.83598698f, 0.84044840f, 0.84485357f, 0.84920218f,
+                0.85349396f, 0.85772861f, 0.86190585f, 0.86602540f, 0.87008699f,
+                0.87409034f, 0.87803519f, 0.88192126f, 0.88574831f, 0.88951608f,
+                0.89322430f, 0.89687274f, 0.90046115f, 0.90398929f, 0.90745693f,
+                0.91086382f, 0.91420976f, 0.91749450f, 0.92071783f, 0.92387953f,
+                0.92697940f, 0.93001722f, 0.93299280f, 0.93590593f, 0.93875641f,
+                0.94154407f, 0.94426870f, 0.94693013f, 0.94952818f, 0.95206268f,
+                0.95453345f, 0.95694034f, 0.95928317f, 0.96156180f, 0.96377607f,
+                0.96592583f, 0.96801094f, 0.97003125f, 0.97198664f, 0.97387698f,
+                0.97570213f, 0.97746197f, 0.97915640f, 0.98078528f, 0.98234852f,
+                0.98384601f, 0.98527764f, 0.98664333f, 0.98794298f, 0.98917651f,
+                0.99034383f, 0.99144486f, 0.99247953f, 0.99344778f, 0.99434953f,
+                0.99518473f, 0.99595331f, 0.99665524f, 0.99729046f, 0.99785892f,
+                0.99836060f, 0.99879546f, 0.99916346f, 0.99946459f, 0.99969882f,
+                0.99986614f, 0.99996653f};
+
+// Returns the rising half, sin(pi / 2 * i / kOverlapSize), of the window.
+        template<size_t kOverlapSize>
+        const std::array<float, kOverlapSize> &WindowFirstHalf();
+
+        template<>
+        const std::array<float, 96> &WindowFirstHalf<96>() {
+            return kBlocks160w256FirstHalf;
+        }
+
+        template<>
+        const std::array<float, 48> &WindowFirstHalf<48>() {
+            return kBlocks80w128FirstHalf;
+        }
+
+        template<>
+        const std::array<float, 192> &WindowFirstHalf<192>() {
+            return kBlocks320w512FirstHalf;
+        }
+
+    }  // namespace
+
+    template<typename Geometry>
+    void NsFilterBank<Geometry>::ApplyWindow(rtc::ArrayView<float, kFftSize> x) {
+        const std::array<float, kOverlapSize> &window =
+                WindowFirstHalf<kOverlapSize>();
+        for (size_t i = 0; i < kOverlapSize; ++i) {
+            x[i] = window[i] * x[i];
+        }
+
+        for (size_t i = kFrameSize + 1, k = kOverlapSize - 1; i < kFftSize;
+             ++i, --k) {
+            RTC_DCHECK_NE(0, k);
+            x[i] = window[k] * x[i];
+        }
+    }
+
+    template<typename Geometry>
+    void NsFilterBank<Geometry>::FormExtendedFrame(
+            rtc::ArrayView<const float, kFrameSize> frame,
+            rtc::ArrayView<float, kOverlapSize> old_data,
+            rtc::ArrayView<float, kFftSize> extended_frame) {
+        std::copy(old_data.begin(), old_data.end(), extended_frame.begin());
+        std::copy(frame.begin(), frame.end(),
+                  extended_frame.begin() + old_data.size());
+        std::copy(extended_frame.end() - old_data.size(), extended_frame.end(),
+                  old_data.begin());
+    }
+
+    template<typename Geometry>
+    void NsFilterBank<Geometry>::OverlapAndAdd(
+            rtc::ArrayView<const float, kFftSize> extended_frame,
+            rtc::ArrayView<float, kOverlapSize> overlap_memory,
+            rtc::ArrayView<float, kFrameSize> output_frame) {
+        for (size_t i = 0; i < kOverlapSize; ++i) {
+            output_frame[i] = overlap_memory[i] + extended_frame[i];
+        }
+        std::copy(extended_frame.begin() + kOverlapSize,
+                  extended_frame.begin() + kFrameSize,
+                  output_frame.begin() + kOverlapSize);
+        std::copy(extended_frame.begin() + kFrameSize, extended_frame.end(),
+                  overlap_memory.begin());
+    }
+
+    template<typename Geometry>
+    void NsFilterBank<Geometry>::DelaySignal(
+            rtc::ArrayView<const float, kFrameSize> frame,
+            rtc::ArrayView<float, kOverlapSize> delay_buffer,
+            rtc::ArrayView<float, kFrameSize> delayed_frame) {
+        constexpr size_t kSamplesFromFrame = kFrameSize - kOverlapSize;
+        std::copy(delay_buffer.begin(), delay_buffer.end(), delayed_frame.begin());
+        std::copy(frame.begin(), frame.begin() + kSamplesFromFrame,
+                  delayed_frame.begin() + delay_buffer.size());
+
+        std::copy(frame.begin() + kSamplesFromFrame, frame.end(),
+                  delay_buffer.begin());
+    }
+
+    template<typename Geometry>
+    float NsFilterBank<Geometry>::ComputeEnergyOfExtendedFrame(
+            rtc::ArrayView<const float, kFftSize> x) {
+        float energy = 0.f;
+        for (float x_k : x) {
+            energy += x_k * x_k;
+        }
+
+        return energy;
+    }
+
+    template<typename Geometry>
+    float NsFilterBank<Geometry>::ComputeEnergyOfExtendedFrame(
+            rtc::ArrayView<const float, kFrameSize> frame,
+            rtc::ArrayView<float, kOverlapSize> old_data) {
+        float energy = 0.f;
+        for (float v : old_data) {
+            energy += v * v;
+        }
+        for (float v : frame) {
+            energy += v * v;
+        }
+
+        return energy;
+    }
+
+    template<typename Geometry>
+    void NsFilterBank<Geometry>::ComputeMagnitudeSpectrum(
+            rtc::ArrayView<const float, kFftSize> real,
+            rtc::ArrayView<const float, kFftSize> imag,
+            rtc::ArrayView<float, kFftSizeBy2Plus1> signal_spectrum) {
+        signal_spectrum[0] = fabsf(real[0]) + 1.f;
+        signal_spectrum[kFftSizeBy2Plus1 - 1] =
+                fabsf(real[kFftSizeBy2Plus1 - 1]) + 1.f;
+
+        for (size_t i = 1; i < kFftSizeBy2Plus1 - 1; ++i) {
+            signal_spectrum[i] =
+                    SqrtFastApproximation(real[i] * real[i] + imag[i] * imag[i]) + 1.f;
+        }
+    }
+
+    template struct NsFilterBank<NsDefaultGeometry>;
+    template struct NsFilterBank<NsLowDelayGeometry>;
+    template struct NsFilterBank<NsHighEfficiencyGeometry>;
+
+}  // namespace webrtc
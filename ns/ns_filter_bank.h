@@ -0,0 +1,66 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_NS_NS_FILTER_BANK_H_
+#define MODULES_AUDIO_PROCESSING_NS_NS_FILTER_BANK_H_
+
+#include "array_view.h"
+#include "ns_common.h"
+
+namespace webrtc {
+
+// Filter bank operations for the frame geometry |Geometry|, see NsGeometry.
+// Instantiated for the geometries in ns_common.h.
+    template<typename Geometry>
+    struct NsFilterBank {
+        static constexpr size_t kFftSize = Geometry::kFftSize;
+        static constexpr size_t kFftSizeBy2Plus1 = Geometry::kFftSizeBy2Plus1;
+        static constexpr size_t kFrameSize = Geometry::kFrameSize;
+        static constexpr size_t kOverlapSize = Geometry::kOverlapSize;
+
+        // Applies the filterbank window to a buffer.
+        static void ApplyWindow(rtc::ArrayView<float, kFftSize> x);
+
+        // Extends a frame with previous data.
+        static void FormExtendedFrame(
+                rtc::ArrayView<const float, kFrameSize> frame,
+                rtc::ArrayView<float, kOverlapSize> old_data,
+                rtc::ArrayView<float, kFftSize> extended_frame);
+
+        // Uses overlap-and-add to produce an output frame.
+        static void OverlapAndAdd(
+                rtc::ArrayView<const float, kFftSize> extended_frame,
+                rtc::ArrayView<float, kOverlapSize> overlap_memory,
+                rtc::ArrayView<float, kFrameSize> output_frame);
+
+        // Produces a delayed frame.
+        static void DelaySignal(rtc::ArrayView<const float, kFrameSize> frame,
+                                rtc::ArrayView<float, kOverlapSize> delay_buffer,
+                                rtc::ArrayView<float, kFrameSize> delayed_frame);
+
+        // Computes the energy of an extended frame.
+        static float ComputeEnergyOfExtendedFrame(
+                rtc::ArrayView<const float, kFftSize> x);
+
+        // Computes the energy of an extended frame based on its subcomponents.
+        static float ComputeEnergyOfExtendedFrame(
+                rtc::ArrayView<const float, kFrameSize> frame,
+                rtc::ArrayView<float, kOverlapSize> old_data);
+
+        // Computes the magnitude spectrum based on an FFT output.
+        static void ComputeMagnitudeSpectrum(
+                rtc::ArrayView<const float, kFftSize> real,
+                rtc::ArrayView<const float, kFftSize> imag,
+                rtc::ArrayView<float, kFftSizeBy2Plus1> signal_spectrum);
+    };
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_NS_NS_FILTER_BANK_H_
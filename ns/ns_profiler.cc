@@ -0,0 +1,93 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "ns_profiler.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include <algorithm>
+
+namespace webrtc {
+
+    namespace {
+
+        const char *const kStageNames[kNumNsStages] = {
+                "framing", "fft", "magnitude_spectrum",
+                "noise_estimation", "speech_probability", "wiener_update",
+                "ifft", "overlap_add", "upper_band_gain", "channel_fan_out"};
+
+        const char *CounterName() {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+            return "tsc";
+#elif defined(WEBRTC_ARCH_ARM_FAMILY) && defined(WEBRTC_ARCH_64_BITS) && \
+    !defined(_MSC_VER)
+            return "cntvct";
+#else
+            return "ns";
+#endif
+        }
+
+        void Append(std::string *json, const char *format, uint64_t value) {
+            char buffer[64];
+            snprintf(buffer, sizeof(buffer), format, value);
+            json->append(buffer);
+        }
+
+    }  // namespace
+
+    constexpr size_t NsProfiler::kNumBuckets;
+
+    void NsProfiler::Add(NsStage stage, uint64_t ticks) {
+        StageHistogram &h = histograms_[static_cast<size_t>(stage)];
+        ++h.count;
+        h.total += ticks;
+        h.min = std::min(h.min, ticks);
+        h.max = std::max(h.max, ticks);
+        size_t bucket = 0;
+        while (bucket + 1 < kNumBuckets && (ticks >> (bucket + 1)) != 0) {
+            ++bucket;
+        }
+        ++h.buckets[bucket];
+    }
+
+    void NsProfiler::Reset() {
+        histograms_.fill(StageHistogram());
+    }
+
+    std::string NsProfiler::ToJson() const {
+        std::string json = "{\"counter\":\"";
+        json.append(CounterName());
+        json.append("\",\"stages\":{");
+        for (size_t k = 0; k < kNumNsStages; ++k) {
+            const StageHistogram &h = histograms_[k];
+            json.append(k > 0 ? ",\"" : "\"");
+            json.append(kStageNames[k]);
+            Append(&json, "\":{\"count\":%" PRIu64, h.count);
+            Append(&json, ",\"total\":%" PRIu64, h.total);
+            Append(&json, ",\"min\":%" PRIu64, h.count > 0 ? h.min : 0);
+            Append(&json, ",\"max\":%" PRIu64, h.max);
+            Append(&json, ",\"mean\":%" PRIu64, h.count > 0 ? h.total / h.count : 0);
+            // The trailing empty buckets are left out.
+            size_t num_buckets = kNumBuckets;
+            while (num_buckets > 0 && h.buckets[num_buckets - 1] == 0) {
+                --num_buckets;
+            }
+            json.append(",\"log2_buckets\":[");
+            for (size_t i = 0; i < num_buckets; ++i) {
+                Append(&json, i > 0 ? ",%" PRIu64 : "%" PRIu64, h.buckets[i]);
+            }
+            json.append("]}");
+        }
+        json.append("}}");
+        return json;
+    }
+
+}  // namespace webrtc
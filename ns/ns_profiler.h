@@ -0,0 +1,168 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_NS_NS_PROFILER_H_
+#define MODULES_AUDIO_PROCESSING_NS_NS_PROFILER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <string>
+
+#include "arch.h"
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#elif !defined(WEBRTC_ARCH_ARM_FAMILY) || !defined(WEBRTC_ARCH_64_BITS) || \
+    defined(_MSC_VER)
+#include <chrono>
+#endif
+
+namespace webrtc {
+
+// Stages of NoiseSuppressor::Analyze() and Process() that are profiled when
+// WEBRTC_NS_PROFILING is defined.
+    enum class NsStage {
+        kFraming,
+        kFft,
+        kMagnitudeSpectrum,
+        kNoiseEstimation,
+        kSpeechProbability,
+        kWienerUpdate,
+        kIfft,
+        kOverlapAdd,
+        kUpperBandGain,
+        // The per-channel work when it runs on several threads, see
+        // NsConfig::num_threads, which the stages above then leave out.
+        kChannelFanOut,
+        kNumStages
+    };
+
+    constexpr size_t kNumNsStages = static_cast<size_t>(NsStage::kNumStages);
+
+// Reads a free-running counter: the time stamp counter on x86, the virtual
+// counter on 64-bit ARM and a nanosecond clock elsewhere.
+    inline uint64_t ReadCycleCounter() {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+        return __rdtsc();
+#elif defined(WEBRTC_ARCH_ARM_FAMILY) && defined(WEBRTC_ARCH_64_BITS) && \
+    !defined(_MSC_VER)
+        uint64_t counter;
+        asm volatile("mrs %0, cntvct_el0" : "=r"(counter));
+        return counter;
+#else
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch())
+                .count();
+#endif
+    }
+
+// Per-stage histograms of the counter ticks spent in each stage per analyzed or
+// processed frame, summed over the channels. The buckets are powers of two:
+// bucket i counts the frames that took [2^i, 2^(i+1)) ticks.
+    class NsProfiler {
+    public:
+        static constexpr size_t kNumBuckets = 40;
+
+        struct StageHistogram {
+            uint64_t count = 0;
+            uint64_t total = 0;
+            uint64_t min = UINT64_MAX;
+            uint64_t max = 0;
+            std::array<uint64_t, kNumBuckets> buckets{};
+        };
+
+        NsProfiler() = default;
+
+        NsProfiler(const NsProfiler &) = delete;
+
+        NsProfiler &operator=(const NsProfiler &) = delete;
+
+        // Adds one call of |stage| that took |ticks| counter ticks.
+        void Add(NsStage stage, uint64_t ticks);
+
+        // Clears all histograms.
+        void Reset();
+
+        const StageHistogram &histogram(NsStage stage) const {
+            return histograms_[static_cast<size_t>(stage)];
+        }
+
+        // Returns the histograms as a JSON object.
+        std::string ToJson() const;
+
+    private:
+        std::array<StageHistogram, kNumNsStages> histograms_;
+    };
+
+// Attributes the ticks elapsed since construction or since the previous Lap()
+// to a stage, and adds the per-stage sums to the profiler when destroyed, i.e.,
+// once per profiled frame.
+    class NsStageTimer {
+    public:
+        explicit NsStageTimer(NsProfiler *profiler)
+                : profiler_(profiler), last_(ReadCycleCounter()) {}
+
+        NsStageTimer(const NsStageTimer &) = delete;
+
+        NsStageTimer &operator=(const NsStageTimer &) = delete;
+
+        ~NsStageTimer() {
+            for (size_t k = 0; k < kNumNsStages; ++k) {
+                if (used_stages_ & (1u << k)) {
+                    profiler_->Add(static_cast<NsStage>(k), ticks_[k]);
+                }
+            }
+        }
+
+        void Lap(NsStage stage) {
+            const uint64_t now = ReadCycleCounter();
+            const size_t k = static_cast<size_t>(stage);
+            ticks_[k] += now - last_;
+            used_stages_ |= 1u << k;
+            last_ = now;
+        }
+
+    private:
+        NsProfiler *const profiler_;
+        uint64_t last_;
+        uint32_t used_stages_ = 0;
+        std::array<uint64_t, kNumNsStages> ticks_{};
+    };
+
+}  // namespace webrtc
+
+// The stage timing compiles to nothing unless WEBRTC_NS_PROFILING is defined.
+#if defined(WEBRTC_NS_PROFILING)
+#define NS_STAGE_TIMER(profiler) \
+  webrtc::NsStageTimer ns_stage_timer(profiler)
+#define NS_STAGE_LAP(stage) ns_stage_timer.Lap(stage)
+// For functions called by the profiled one: the timer to pass to them, and a
+// lap on the timer |timer| they received, which may be null to skip the timing.
+#define NS_STAGE_TIMER_PTR() (&ns_stage_timer)
+#define NS_STAGE_LAP_ON(timer, stage) \
+  do {                                 \
+    if (timer) {                       \
+      (timer)->Lap(stage);             \
+    }                                  \
+  } while (0)
+#else
+#define NS_STAGE_TIMER(profiler)
+#define NS_STAGE_LAP(stage)
+#define NS_STAGE_TIMER_PTR() (static_cast<webrtc::NsStageTimer *>(nullptr))
+#define NS_STAGE_LAP_ON(timer, stage) (void) (timer)
+#endif
+
+#endif  // MODULES_AUDIO_PROCESSING_NS_NS_PROFILER_H_
@@ -0,0 +1,137 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "ns_profiler.h"
+
+#include <stdint.h>
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace webrtc {
+
+// The profiler and the stage timer are compiled regardless of
+// WEBRTC_NS_PROFILING, which only controls the timing in the suppressor.
+
+    TEST(NsProfilerTest, BucketAssignment) {
+        NsProfiler profiler;
+        // 0 and 1 tick share the first bucket.
+        profiler.Add(NsStage::kFft, 0);
+        profiler.Add(NsStage::kFft, 1);
+        const NsProfiler::StageHistogram &h = profiler.histogram(NsStage::kFft);
+        EXPECT_EQ(2u, h.buckets[0]);
+
+        for (size_t k = 1; k < NsProfiler::kNumBuckets; ++k) {
+            SCOPED_TRACE(k);
+            const uint64_t ticks = uint64_t{1} << k;
+            profiler.Add(NsStage::kFft, ticks);
+            EXPECT_EQ(1u, h.buckets[k]);
+            // The largest value of the bucket.
+            profiler.Add(NsStage::kFft, 2 * ticks - 1);
+            EXPECT_EQ(2u, h.buckets[k]);
+        }
+
+        // Values of 2^39 and above are clamped to the last bucket.
+        const size_t kLast = NsProfiler::kNumBuckets - 1;
+        profiler.Add(NsStage::kFft, uint64_t{1} << 40);
+        profiler.Add(NsStage::kFft, UINT64_MAX);
+        EXPECT_EQ(4u, h.buckets[kLast]);
+
+        EXPECT_EQ(2u + 2u * kLast + 2u, h.count);
+        EXPECT_EQ(0u, h.min);
+        EXPECT_EQ(UINT64_MAX, h.max);
+        // The other stages are untouched.
+        EXPECT_EQ(0u, profiler.histogram(NsStage::kIfft).count);
+    }
+
+    TEST(NsProfilerTest, CountTotalMinMax) {
+        NsProfiler profiler;
+        profiler.Add(NsStage::kIfft, 300);
+        profiler.Add(NsStage::kIfft, 100);
+        profiler.Add(NsStage::kIfft, 200);
+        const NsProfiler::StageHistogram &h = profiler.histogram(NsStage::kIfft);
+        EXPECT_EQ(3u, h.count);
+        EXPECT_EQ(600u, h.total);
+        EXPECT_EQ(100u, h.min);
+        EXPECT_EQ(300u, h.max);
+    }
+
+    TEST(NsProfilerTest, Reset) {
+        NsProfiler profiler;
+        profiler.Add(NsStage::kFraming, 5);
+        profiler.Add(NsStage::kChannelFanOut, 1000);
+        profiler.Reset();
+        for (size_t k = 0; k < kNumNsStages; ++k) {
+            const NsProfiler::StageHistogram &h =
+                    profiler.histogram(static_cast<NsStage>(k));
+            EXPECT_EQ(0u, h.count);
+            EXPECT_EQ(0u, h.total);
+            EXPECT_EQ(UINT64_MAX, h.min);
+            EXPECT_EQ(0u, h.max);
+            for (uint64_t bucket : h.buckets) {
+                EXPECT_EQ(0u, bucket);
+            }
+        }
+    }
+
+    TEST(NsProfilerTest, JsonShape) {
+        NsProfiler profiler;
+        profiler.Add(NsStage::kFft, 2);
+        profiler.Add(NsStage::kFft, 9);
+        const std::string json = profiler.ToJson();
+
+        // The counter name depends on the platform.
+        const std::string kPrefix = "{\"counter\":\"";
+        ASSERT_EQ(kPrefix, json.substr(0, kPrefix.size()));
+        const size_t stages = json.find("\",\"stages\":{\"framing\":{");
+        ASSERT_NE(std::string::npos, stages);
+        const std::string counter =
+                json.substr(kPrefix.size(), stages - kPrefix.size());
+        EXPECT_TRUE(counter == "tsc" || counter == "cntvct" || counter == "ns")
+                            << counter;
+
+        // All stages in order, the empty ones without buckets and the others
+        // without the trailing empty buckets.
+        const std::string kEmpty =
+                "{\"count\":0,\"total\":0,\"min\":0,\"max\":0,\"mean\":0,"
+                "\"log2_buckets\":[]}";
+        const std::string kStages =
+                "\"stages\":{"
+                "\"framing\":" + kEmpty + ","
+                "\"fft\":{\"count\":2,\"total\":11,\"min\":2,\"max\":9,\"mean\":5,"
+                "\"log2_buckets\":[0,1,0,1]},"
+                "\"magnitude_spectrum\":" + kEmpty + ","
+                "\"noise_estimation\":" + kEmpty + ","
+                "\"speech_probability\":" + kEmpty + ","
+                "\"wiener_update\":" + kEmpty + ","
+                "\"ifft\":" + kEmpty + ","
+                "\"overlap_add\":" + kEmpty + ","
+                "\"upper_band_gain\":" + kEmpty + ","
+                "\"channel_fan_out\":" + kEmpty + "}}";
+        EXPECT_EQ(kStages, json.substr(stages + 2));
+    }
+
+    // Verifies that a timer adds one call per used stage when destroyed.
+    TEST(NsProfilerTest, StageTimerAddsUsedStages) {
+        NsProfiler profiler;
+        {
+            NsStageTimer timer(&profiler);
+            timer.Lap(NsStage::kFraming);
+            timer.Lap(NsStage::kFft);
+            timer.Lap(NsStage::kFraming);
+            EXPECT_EQ(0u, profiler.histogram(NsStage::kFraming).count);
+        }
+        EXPECT_EQ(1u, profiler.histogram(NsStage::kFraming).count);
+        EXPECT_EQ(1u, profiler.histogram(NsStage::kFft).count);
+        EXPECT_EQ(0u, profiler.histogram(NsStage::kIfft).count);
+    }
+
+}  // namespace webrtc
@@ -0,0 +1,85 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "ns_session_pool.h"
+
+#include <new>
+
+#include "checks.h"
+
+namespace webrtc {
+
+    namespace {
+
+        constexpr size_t kCacheLineSize = NsArena::kCacheLineSize;
+
+        // The block of a session follows the session object, on a cache line.
+        constexpr size_t kBlockOffset =
+                (sizeof(NsCompactSession) + kCacheLineSize - 1) / kCacheLineSize *
+                kCacheLineSize;
+
+    }  // namespace
+
+    NsSessionPool::NsSessionPool(const NsConfig &config,
+                                 int sample_rate_hz,
+                                 size_t num_channels,
+                                 size_t num_sessions)
+            : config_(config),
+              sample_rate_hz_(sample_rate_hz),
+              num_channels_(num_channels),
+              block_size_(NsCompactSession::BlockSize(sample_rate_hz, num_channels)),
+              slab_size_(kBlockOffset + (block_size_ + kCacheLineSize - 1) /
+                                        kCacheLineSize * kCacheLineSize),
+              num_sessions_(num_sessions),
+              slabs_(AlignedMalloc<uint8_t>(num_sessions_ * slab_size_,
+                                            kCacheLineSize)) {
+        RTC_CHECK_GT(num_sessions_, 0);
+        RTC_CHECK(slabs_);
+        free_slabs_.reserve(num_sessions_);
+        // Hands out the first slabs first.
+        for (size_t i = num_sessions_; i > 0; --i) {
+            free_slabs_.push_back(slabs_.get() + (i - 1) * slab_size_);
+        }
+    }
+
+    NsSessionPool::~NsSessionPool() {
+        RTC_DCHECK_EQ(free_slabs_.size(), num_sessions_);
+    }
+
+    NsCompactSession *NsSessionPool::CreateSession() {
+        uint8_t *slab;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (free_slabs_.empty()) {
+                return nullptr;
+            }
+            slab = free_slabs_.back();
+            free_slabs_.pop_back();
+        }
+        return new(slab) NsCompactSession(config_, sample_rate_hz_, num_channels_,
+                                          block_size_, slab + kBlockOffset);
+    }
+
+    void NsSessionPool::DestroySession(NsCompactSession *session) {
+        uint8_t *slab = reinterpret_cast<uint8_t *>(session);
+        RTC_DCHECK_GE(slab, slabs_.get());
+        RTC_DCHECK_LT(slab, slabs_.get() + num_sessions_ * slab_size_);
+        RTC_DCHECK_EQ((slab - slabs_.get()) % slab_size_, 0);
+        session->~NsCompactSession();
+        std::lock_guard<std::mutex> lock(mutex_);
+        free_slabs_.push_back(slab);
+    }
+
+    size_t NsSessionPool::num_free_slabs() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return free_slabs_.size();
+    }
+
+}  // namespace webrtc
@@ -0,0 +1,76 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_NS_NS_SESSION_POOL_H_
+#define MODULES_AUDIO_PROCESSING_NS_NS_SESSION_POOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "aligned_malloc.h"
+#include "ns_compact_session.h"
+#include "ns_config.h"
+
+namespace webrtc {
+
+// Fixed-size pool of compact sessions of one configuration, for servers that
+// create and destroy sessions at a high rate. The memory of |num_sessions|
+// sessions is reserved up front as equally sized slabs, each holding a session
+// object and its block, so creating and destroying a session does not touch
+// the heap and takes no sizing pass.
+    class NsSessionPool {
+    public:
+        NsSessionPool(const NsConfig &config,
+                      int sample_rate_hz,
+                      size_t num_channels,
+                      size_t num_sessions);
+
+        // All sessions must have been destroyed.
+        ~NsSessionPool();
+
+        NsSessionPool(const NsSessionPool &) = delete;
+
+        NsSessionPool &operator=(const NsSessionPool &) = delete;
+
+        // Creates a session in a free slab. Returns null if all slabs are taken.
+        // May be called from any thread.
+        NsCompactSession *CreateSession();
+
+        // Destroys a session created by CreateSession() and frees its slab. May be
+        // called from any thread.
+        void DestroySession(NsCompactSession *session);
+
+        // The bytes reserved per session, a multiple of the cache line size.
+        size_t slab_size() const { return slab_size_; }
+
+        size_t num_sessions() const { return num_sessions_; }
+
+        size_t num_free_slabs() const;
+
+    private:
+        const NsConfig config_;
+        const int sample_rate_hz_;
+        const size_t num_channels_;
+        const size_t block_size_;
+        const size_t slab_size_;
+        const size_t num_sessions_;
+        std::unique_ptr<uint8_t[], AlignedFreeDeleter> slabs_;
+        mutable std::mutex mutex_;
+        // Reserved for all slabs, so that it never reallocates.
+        std::vector<uint8_t *> free_slabs_;
+    };
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_NS_NS_SESSION_POOL_H_
@@ -0,0 +1,174 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "ns_session_pool.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace webrtc {
+    namespace {
+
+        constexpr int kSampleRateHz = 48000;
+        constexpr size_t kNumChannels = 2;
+        constexpr size_t kCacheLineSize = NsArena::kCacheLineSize;
+
+        size_t RoundUpToCacheLine(size_t size) {
+            return (size + kCacheLineSize - 1) / kCacheLineSize * kCacheLineSize;
+        }
+
+        // Suppresses |num_chunks| chunks of noise with |session| and returns the
+        // output.
+        std::vector<int16_t> ProcessChunks(NsCompactSession *session, int num_chunks,
+                                           uint32_t seed) {
+            std::vector<int16_t> x(
+                    StreamConfig(kSampleRateHz, kNumChannels).num_samples());
+            std::vector<int16_t> output;
+            for (int chunk = 0; chunk < num_chunks; ++chunk) {
+                for (int16_t &v : x) {
+                    seed = seed * 1664525u + 1013904223u;
+                    v = static_cast<int16_t>(static_cast<int>((seed >> 16) & 0xfff) - 2048);
+                }
+                session->ProcessChunk(x);
+                output.insert(output.end(), x.begin(), x.end());
+            }
+            return output;
+        }
+
+    }  // namespace
+
+    TEST(NsSessionPoolTest, SlabSizeAndAlignment) {
+        const NsConfig config;
+        constexpr size_t kNumSessions = 3;
+        NsSessionPool pool(config, kSampleRateHz, kNumChannels, kNumSessions);
+        const size_t block_size =
+                NsCompactSession::BytesPerSession(config, kSampleRateHz, kNumChannels) -
+                sizeof(NsCompactSession);
+        EXPECT_EQ(RoundUpToCacheLine(sizeof(NsCompactSession)) +
+                  RoundUpToCacheLine(block_size),
+                  pool.slab_size());
+        EXPECT_EQ(0u, pool.slab_size() % kCacheLineSize);
+
+        std::vector<NsCompactSession *> sessions;
+        for (size_t k = 0; k < kNumSessions; ++k) {
+            sessions.push_back(pool.CreateSession());
+            ASSERT_NE(nullptr, sessions.back());
+            EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(sessions.back()) % kCacheLineSize);
+        }
+        // The slabs are consecutive.
+        std::sort(sessions.begin(), sessions.end());
+        for (size_t k = 1; k < kNumSessions; ++k) {
+            EXPECT_EQ(pool.slab_size(),
+                      static_cast<size_t>(reinterpret_cast<uint8_t *>(sessions[k]) -
+                                          reinterpret_cast<uint8_t *>(sessions[k - 1])));
+        }
+        for (NsCompactSession *session : sessions) {
+            pool.DestroySession(session);
+        }
+    }
+
+    TEST(NsSessionPoolTest, CreateUntilFull) {
+        const NsConfig config;
+        constexpr size_t kNumSessions = 4;
+        NsSessionPool pool(config, kSampleRateHz, kNumChannels, kNumSessions);
+        EXPECT_EQ(kNumSessions, pool.num_sessions());
+        std::set<NsCompactSession *> sessions;
+        for (size_t k = 0; k < kNumSessions; ++k) {
+            EXPECT_EQ(kNumSessions - k, pool.num_free_slabs());
+            NsCompactSession *session = pool.CreateSession();
+            ASSERT_NE(nullptr, session);
+            EXPECT_TRUE(sessions.insert(session).second);
+        }
+        EXPECT_EQ(0u, pool.num_free_slabs());
+        EXPECT_EQ(nullptr, pool.CreateSession());
+        EXPECT_EQ(nullptr, pool.CreateSession());
+
+        for (NsCompactSession *session : sessions) {
+            pool.DestroySession(session);
+        }
+        EXPECT_EQ(kNumSessions, pool.num_free_slabs());
+    }
+
+    // Verifies that a destroyed session frees its slab for the next session, and
+    // that a session in a reused slab starts from a clean state.
+    TEST(NsSessionPoolTest, DestroyAndReuse) {
+        const NsConfig config;
+        NsSessionPool pool(config, kSampleRateHz, kNumChannels, 2);
+        NsCompactSession *first = pool.CreateSession();
+        NsCompactSession *second = pool.CreateSession();
+        ASSERT_NE(nullptr, first);
+        ASSERT_NE(nullptr, second);
+        ASSERT_EQ(nullptr, pool.CreateSession());
+        ProcessChunks(first, 50, 1);
+
+        pool.DestroySession(first);
+        EXPECT_EQ(1u, pool.num_free_slabs());
+        NsCompactSession *reused = pool.CreateSession();
+        EXPECT_EQ(first, reused);
+        EXPECT_EQ(0u, pool.num_free_slabs());
+
+        NsCompactSession reference(config, kSampleRateHz, kNumChannels);
+        EXPECT_EQ(ProcessChunks(&reference, 20, 2), ProcessChunks(reused, 20, 2));
+
+        pool.DestroySession(reused);
+        pool.DestroySession(second);
+        EXPECT_EQ(2u, pool.num_free_slabs());
+    }
+
+    // Creates, uses and destroys sessions on several threads, with as many slabs
+    // as the threads hold sessions at most, so that no creation fails and every
+    // slab is handed out many times.
+    TEST(NsSessionPoolTest, ConcurrentCreateAndDestroy) {
+        const NsConfig config;
+        constexpr size_t kNumThreads = 4;
+        constexpr size_t kSessionsPerThread = 2;
+        constexpr int kNumRounds = 100;
+        NsSessionPool pool(config, kSampleRateHz, kNumChannels,
+                           kNumThreads * kSessionsPerThread);
+
+        std::vector<int> num_failures(kNumThreads, 0);
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < kNumThreads; ++t) {
+            threads.emplace_back([&pool, &num_failures, t] {
+                for (int round = 0; round < kNumRounds; ++round) {
+                    NsCompactSession *sessions[kSessionsPerThread];
+                    for (NsCompactSession *&session : sessions) {
+                        session = pool.CreateSession();
+                        if (!session) {
+                            ++num_failures[t];
+                            continue;
+                        }
+                        ProcessChunks(session, 1, static_cast<uint32_t>(round));
+                    }
+                    for (NsCompactSession *session : sessions) {
+                        if (session) {
+                            pool.DestroySession(session);
+                        }
+                    }
+                    std::this_thread::yield();
+                }
+            });
+        }
+        for (std::thread &thread : threads) {
+            thread.join();
+        }
+        for (int failures : num_failures) {
+            EXPECT_EQ(0, failures);
+        }
+        EXPECT_EQ(kNumThreads * kSessionsPerThread, pool.num_free_slabs());
+    }
+
+}  // namespace webrtc
@@ -0,0 +1,318 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "ns_session_scheduler.h"
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+
+#include "checks.h"
+
+namespace webrtc {
+
+    namespace {
+
+        constexpr size_t kChunkSizeMs = 10;
+
+// The interval at which an idle worker looks for sessions to steal, in case
+// no busy worker woke it up.
+        constexpr std::chrono::milliseconds kStealInterval(1);
+
+        int64_t TimeMicros() {
+            return std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch())
+                    .count();
+        }
+
+// The number of chunks that fit in the ring buffers of the
+// StreamingNoiseSuppressor.
+        size_t NumBufferedChunks(size_t buffer_size_ms) {
+            return std::max<size_t>(
+                    1, (buffer_size_ms + kChunkSizeMs - 1) / kChunkSizeMs);
+        }
+
+        void PinToCore(std::thread *thread, size_t core) {
+#if defined(__linux__)
+            cpu_set_t cpu_set;
+            CPU_ZERO(&cpu_set);
+            CPU_SET(core % CPU_SETSIZE, &cpu_set);
+            // The pinning is only a hint, e.g. the core may be outside the allowed
+            // set of the process, so failures are ignored.
+            pthread_setaffinity_np(thread->native_handle(), sizeof(cpu_set),
+                                   &cpu_set);
+#else
+            (void) thread;
+            (void) core;
+#endif
+        }
+
+    }  // namespace
+
+    NsSession::NsSession(NsSessionScheduler *scheduler,
+                         size_t home_worker,
+                         const NsConfig &config,
+                         int sample_rate_hz,
+                         size_t num_channels,
+                         size_t buffer_size_ms)
+            : scheduler_(scheduler),
+              home_worker_(home_worker),
+              num_channels_(num_channels),
+              chunk_frames_(StreamConfig(sample_rate_hz, num_channels).num_frames()),
+              max_chunks_per_run_(NumBufferedChunks(buffer_size_ms)),
+              stream_(config, sample_rate_hz, num_channels, buffer_size_ms),
+              // One more than the buffered chunks, as a chunk may be pushed after
+              // a suppressed chunk leaves the input buffer and before its time is
+              // read.
+              chunk_ready_times_(max_chunks_per_run_ + 1) {}
+
+    size_t NsSession::Push(rtc::ArrayView<const int16_t> interleaved) {
+        RTC_DCHECK_EQ(interleaved.size() % num_channels_, 0);
+        // The times of the completed chunks are written before the samples, so
+        // that they are available when the chunks are suppressed.
+        const size_t num_frames =
+                std::min(interleaved.size() / num_channels_, stream_.push_available());
+        const uint64_t num_chunks_before = num_pushed_frames_ / chunk_frames_;
+        num_pushed_frames_ += num_frames;
+        const uint64_t num_completed_chunks =
+                num_pushed_frames_ / chunk_frames_ - num_chunks_before;
+        const int64_t now_us = TimeMicros();
+        for (uint64_t k = 0; k < num_completed_chunks; ++k) {
+            const size_t written =
+                    chunk_ready_times_.Write(rtc::ArrayView<const int64_t>(&now_us, 1));
+            RTC_DCHECK_EQ(written, 1);
+        }
+
+        const size_t pushed =
+                stream_.Push(interleaved.subview(0, num_frames * num_channels_));
+        RTC_DCHECK_EQ(pushed, num_frames);
+        if (num_completed_chunks > 0) {
+            // Pairs with the fence in Run().
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (stream_.CanProcess()) {
+                Schedule();
+            }
+        }
+        return pushed;
+    }
+
+    size_t NsSession::Pull(rtc::ArrayView<int16_t> interleaved) {
+        const size_t pulled = stream_.Pull(interleaved);
+        if (pulled > 0) {
+            // Chunks may have been held back by a full output buffer.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (stream_.CanProcess()) {
+                Schedule();
+            }
+        }
+        return pulled;
+    }
+
+    NsSessionStats NsSession::GetStats() const {
+        NsSessionStats stats;
+        stats.num_chunks = num_chunks_.load(std::memory_order_relaxed);
+        stats.num_overruns = num_overruns_.load(std::memory_order_relaxed);
+        stats.num_stolen_runs = num_stolen_runs_.load(std::memory_order_relaxed);
+        stats.max_latency_us = max_latency_us_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    void NsSession::Schedule() {
+        if (removed_.load() || scheduled_.exchange(true)) {
+            return;
+        }
+        scheduler_->Enqueue(this);
+    }
+
+    void NsSession::Run(size_t worker) {
+        // Counted while still scheduled, so that RemoveSession() either sees the
+        // session scheduled or the run counted.
+        num_runs_.fetch_add(1);
+        if (worker != home_worker_) {
+            num_stolen_runs_.store(num_stolen_runs_.load(std::memory_order_relaxed) + 1,
+                                   std::memory_order_relaxed);
+        }
+
+        // The statistics are only written here, and the session only runs on one
+        // worker at a time.
+        const int64_t deadline_us = scheduler_->deadline_us();
+        uint64_t num_chunks = num_chunks_.load(std::memory_order_relaxed);
+        uint64_t num_overruns = num_overruns_.load(std::memory_order_relaxed);
+        int64_t max_latency_us = max_latency_us_.load(std::memory_order_relaxed);
+        for (size_t k = 0; k < max_chunks_per_run_ && stream_.Process(1) == 1; ++k) {
+            int64_t ready_us = 0;
+            const size_t read =
+                    chunk_ready_times_.Read(rtc::ArrayView<int64_t>(&ready_us, 1));
+            RTC_DCHECK_EQ(read, 1);
+            const int64_t latency_us = TimeMicros() - ready_us;
+            ++num_chunks;
+            if (latency_us > deadline_us) {
+                ++num_overruns;
+            }
+            max_latency_us = std::max(max_latency_us, latency_us);
+        }
+        num_chunks_.store(num_chunks, std::memory_order_relaxed);
+        num_overruns_.store(num_overruns, std::memory_order_relaxed);
+        max_latency_us_.store(max_latency_us, std::memory_order_relaxed);
+
+        // Release the session and queue it again if chunks remain, which includes
+        // those pushed while it ran, as Push() found it still scheduled then.
+        scheduled_.store(false);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (stream_.CanProcess()) {
+            Schedule();
+        }
+        num_runs_.fetch_sub(1);
+    }
+
+    NsSessionScheduler::NsSessionScheduler(const NsSchedulerConfig &config)
+            : deadline_us_(config.deadline_us) {
+        const size_t num_cores =
+                std::max<size_t>(1, std::thread::hardware_concurrency());
+        const size_t num_workers =
+                config.num_workers > 0 ? config.num_workers : num_cores;
+        for (size_t k = 0; k < num_workers; ++k) {
+            workers_.push_back(std::unique_ptr<Worker>(new Worker()));
+        }
+        // The workers are started once all of them exist, as they steal from each
+        // other.
+        for (size_t k = 0; k < num_workers; ++k) {
+            workers_[k]->thread = std::thread([this, k]() { WorkerLoop(k); });
+            if (config.pin_workers) {
+                PinToCore(&workers_[k]->thread, k % num_cores);
+            }
+        }
+    }
+
+    NsSessionScheduler::~NsSessionScheduler() {
+        stop_.store(true);
+        for (auto &worker : workers_) {
+            std::lock_guard<std::mutex> lock(worker->mutex);
+            worker->wakeup.notify_one();
+        }
+        for (auto &worker : workers_) {
+            worker->thread.join();
+        }
+    }
+
+    NsSession *NsSessionScheduler::AddSession(const NsConfig &config,
+                                              int sample_rate_hz,
+                                              size_t num_channels,
+                                              size_t buffer_size_ms) {
+        std::lock_guard<std::mutex> lock(sessions_mutex_);
+        size_t home_worker = 0;
+        for (size_t k = 1; k < workers_.size(); ++k) {
+            if (workers_[k]->num_sessions < workers_[home_worker]->num_sessions) {
+                home_worker = k;
+            }
+        }
+        ++workers_[home_worker]->num_sessions;
+        sessions_.push_back(std::unique_ptr<NsSession>(
+                new NsSession(this, home_worker, config, sample_rate_hz,
+                              num_channels, buffer_size_ms)));
+        return sessions_.back().get();
+    }
+
+    void NsSessionScheduler::RemoveSession(NsSession *session) {
+        // Once removed, the session is not queued again, so it is done when it
+        // has left its queue and its last run has finished. |scheduled_| is read
+        // first, as a run is counted before it clears |scheduled_|.
+        session->removed_.store(true);
+        while (session->scheduled_.load() || session->num_runs_.load() > 0) {
+            std::this_thread::yield();
+        }
+
+        std::lock_guard<std::mutex> lock(sessions_mutex_);
+        --workers_[session->home_worker_]->num_sessions;
+        auto it = std::find_if(sessions_.begin(), sessions_.end(),
+                               [session](const std::unique_ptr<NsSession> &s) {
+                                   return s.get() == session;
+                               });
+        RTC_DCHECK(it != sessions_.end());
+        sessions_.erase(it);
+    }
+
+    void NsSessionScheduler::Enqueue(NsSession *session) {
+        Worker &home = *workers_[session->home_worker_];
+        {
+            std::lock_guard<std::mutex> lock(home.mutex);
+            home.queue.push_back(session);
+        }
+        home.wakeup.notify_one();
+        if (home.idle.load()) {
+            return;
+        }
+
+        // The home worker is busy, so wake up an idle worker to steal the session
+        // should the home worker not get to it first.
+        for (auto &worker : workers_) {
+            if (worker.get() != &home && worker->idle.load()) {
+                {
+                    std::lock_guard<std::mutex> lock(worker->mutex);
+                    worker->steal = true;
+                }
+                worker->wakeup.notify_one();
+                break;
+            }
+        }
+    }
+
+    NsSession *NsSessionScheduler::Dequeue(size_t worker) {
+        {
+            Worker &own = *workers_[worker];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.queue.empty()) {
+                NsSession *session = own.queue.front();
+                own.queue.pop_front();
+                return session;
+            }
+        }
+
+        // Steal the session that was queued last, as the sessions queued first
+        // are the most likely to be run by their home worker next.
+        for (size_t k = 1; k < workers_.size(); ++k) {
+            Worker &victim = *workers_[(worker + k) % workers_.size()];
+            if (victim.idle.load()) {
+                continue;
+            }
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.queue.empty()) {
+                NsSession *session = victim.queue.back();
+                victim.queue.pop_back();
+                return session;
+            }
+        }
+        return nullptr;
+    }
+
+    void NsSessionScheduler::WorkerLoop(size_t worker) {
+        Worker &own = *workers_[worker];
+        while (!stop_.load()) {
+            NsSession *session = Dequeue(worker);
+            if (session) {
+                session->Run(worker);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(own.mutex);
+            own.idle.store(true);
+            own.wakeup.wait_for(lock, kStealInterval, [this, &own]() {
+                return stop_.load() || own.steal || !own.queue.empty();
+            });
+            own.steal = false;
+            own.idle.store(false);
+        }
+    }
+
+}  // namespace webrtc
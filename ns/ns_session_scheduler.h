@@ -0,0 +1,185 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_NS_NS_SESSION_SCHEDULER_H_
+#define MODULES_AUDIO_PROCESSING_NS_NS_SESSION_SCHEDULER_H_
+
+#include <stdint.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "array_view.h"
+#include "ns_config.h"
+#include "spsc_ring_buffer.h"
+#include "streaming_noise_suppressor.h"
+
+namespace webrtc {
+
+    class NsSessionScheduler;
+
+// Config struct for NsSessionScheduler.
+    struct NsSchedulerConfig {
+        // The number of worker threads, where 0 selects one per core.
+        size_t num_workers = 0;
+        // Pins worker k to core k, where supported.
+        bool pin_workers = true;
+        // The time within which a 10 ms chunk should be suppressed once its last
+        // sample has been pushed.
+        int64_t deadline_us = 10000;
+    };
+
+// Statistics of an NsSession. The latency of a chunk is the time from its last
+// sample being pushed until it has been suppressed.
+    struct NsSessionStats {
+        uint64_t num_chunks = 0;
+        // The number of chunks whose latency exceeded the deadline.
+        uint64_t num_overruns = 0;
+        // The number of times the session ran on a worker other than its own.
+        uint64_t num_stolen_runs = 0;
+        int64_t max_latency_us = 0;
+    };
+
+// Live stream suppressed on the workers of an NsSessionScheduler. As for
+// StreamingNoiseSuppressor, Push() and Pull() must each only be called from its
+// own thread, but the chunks are suppressed by the scheduler.
+    class NsSession {
+    public:
+        NsSession(const NsSession &) = delete;
+
+        NsSession &operator=(const NsSession &) = delete;
+
+        // Capture thread. See StreamingNoiseSuppressor::Push().
+        size_t Push(rtc::ArrayView<const int16_t> interleaved);
+
+        // Output thread. See StreamingNoiseSuppressor::Pull().
+        size_t Pull(rtc::ArrayView<int16_t> interleaved);
+
+        size_t delay_samples() const { return stream_.delay_samples(); }
+
+        // The worker that the session is queued on, and that it stays on while it
+        // is idle.
+        size_t home_worker() const { return home_worker_; }
+
+        // May be called from any thread.
+        NsSessionStats GetStats() const;
+
+    private:
+        friend class NsSessionScheduler;
+
+        NsSession(NsSessionScheduler *scheduler,
+                  size_t home_worker,
+                  const NsConfig &config,
+                  int sample_rate_hz,
+                  size_t num_channels,
+                  size_t buffer_size_ms);
+
+        // Queues the session on its home worker, unless it is already queued or
+        // running.
+        void Schedule();
+
+        // Worker thread. Suppresses the pushed chunks, at most a buffer full, and
+        // queues the session again if there are more.
+        void Run(size_t worker);
+
+        NsSessionScheduler *const scheduler_;
+        const size_t home_worker_;
+        const size_t num_channels_;
+        const size_t chunk_frames_;
+        const size_t max_chunks_per_run_;
+        StreamingNoiseSuppressor stream_;
+        // The times at which the pushed chunks were completed, in microseconds.
+        SpscRingBuffer<int64_t> chunk_ready_times_;
+        // Only accessed by the capture thread.
+        uint64_t num_pushed_frames_ = 0;
+        // Set while the session is queued or running, which makes sure that it
+        // only runs on one worker at a time.
+        std::atomic<bool> scheduled_{false};
+        // The number of calls to Run() that may still access the session. The end
+        // of one run overlaps with the start of the next once |scheduled_| is
+        // cleared, so a flag would be cleared by the earlier run too early.
+        std::atomic<int> num_runs_{0};
+        std::atomic<bool> removed_{false};
+        std::atomic<uint64_t> num_chunks_{0};
+        std::atomic<uint64_t> num_overruns_{0};
+        std::atomic<uint64_t> num_stolen_runs_{0};
+        std::atomic<int64_t> max_latency_us_{0};
+    };
+
+// Suppresses many live streams on a pool of worker threads, one per core by
+// default. Each session has a home worker with its own run queue, to which it
+// is queued whenever a chunk is pushed, so that its state stays in the cache of
+// that core. A worker that runs out of sessions steals from the queues of the
+// workers that are busy, which bounds the latency when a core falls behind.
+    class NsSessionScheduler {
+    public:
+        explicit NsSessionScheduler(const NsSchedulerConfig &config);
+
+        // Stops the workers and destroys the remaining sessions.
+        ~NsSessionScheduler();
+
+        NsSessionScheduler(const NsSessionScheduler &) = delete;
+
+        NsSessionScheduler &operator=(const NsSessionScheduler &) = delete;
+
+        // Adds a session on the worker with the fewest sessions. The session is
+        // owned by the scheduler.
+        NsSession *AddSession(const NsConfig &config,
+                              int sample_rate_hz,
+                              size_t num_channels,
+                              size_t buffer_size_ms = 100);
+
+        // Waits until |session| is no longer running and destroys it. Push() and
+        // Pull() must not be called on it concurrently or afterwards.
+        void RemoveSession(NsSession *session);
+
+        size_t num_workers() const { return workers_.size(); }
+
+        int64_t deadline_us() const { return deadline_us_; }
+
+    private:
+        friend class NsSession;
+
+        struct Worker {
+            std::mutex mutex;
+            std::condition_variable wakeup;
+            std::deque<NsSession *> queue;
+            // Set while the worker waits for sessions.
+            std::atomic<bool> idle{false};
+            // Set, under |mutex|, to wake the worker up to steal a session.
+            bool steal = false;
+            // Guarded by sessions_mutex_.
+            size_t num_sessions = 0;
+            std::thread thread;
+        };
+
+        void Enqueue(NsSession *session);
+
+        // Takes the first session of the queue of |worker|, or else the last
+        // session of the queue of a busy worker.
+        NsSession *Dequeue(size_t worker);
+
+        void WorkerLoop(size_t worker);
+
+        const int64_t deadline_us_;
+        std::vector<std::unique_ptr<Worker>> workers_;
+        std::mutex sessions_mutex_;
+        std::vector<std::unique_ptr<NsSession>> sessions_;
+        std::atomic<bool> stop_{false};
+    };
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_NS_NS_SESSION_SCHEDULER_H_
@@ -0,0 +1,83 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "ns_session_scheduler.h"
+
+#include <stdint.h>
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace webrtc {
+    namespace {
+
+        constexpr int kSampleRateHz = 16000;
+        constexpr size_t kChunkSize = kSampleRateHz / 100;
+        constexpr size_t kNumWorkers = 4;
+        constexpr size_t kNumSessions = 8;
+        constexpr int kNumRounds = 20;
+        constexpr int kNumChunks = 30;
+
+        // Pushes and pulls |kNumChunks| chunks of noise on |session| in half chunks,
+        // so that the pushes often find the session running, and removes it right
+        // after the last push while its chunks are still being suppressed.
+        void PushPullAndRemove(NsSessionScheduler *scheduler, NsSession *session,
+                               uint32_t seed, uint64_t *num_pulled_frames) {
+            std::vector<int16_t> x(kChunkSize / 2);
+            std::vector<int16_t> y(kChunkSize);
+            for (int k = 0; k < 2 * kNumChunks; ++k) {
+                for (int16_t &v : x) {
+                    seed = seed * 1664525u + 1013904223u;
+                    v = static_cast<int16_t>(static_cast<int>((seed >> 16) & 0xfff) - 2048);
+                }
+                session->Push(x);
+                *num_pulled_frames += session->Pull(y);
+                std::this_thread::yield();
+            }
+            scheduler->RemoveSession(session);
+        }
+
+    }  // namespace
+
+// Verifies that sessions can be removed while other sessions are pushed to and
+// pulled from, and while their own last chunks are queued or running, on more
+// workers than sessions per worker so that the sessions are also stolen.
+    TEST(NsSessionSchedulerTest, ConcurrentPushPullAndRemove) {
+        NsSchedulerConfig scheduler_config;
+        scheduler_config.num_workers = kNumWorkers;
+        scheduler_config.pin_workers = false;
+        NsSessionScheduler scheduler(scheduler_config);
+        const NsConfig config;
+
+        uint64_t total_pulled_frames = 0;
+        for (int round = 0; round < kNumRounds; ++round) {
+            std::vector<NsSession *> sessions;
+            for (size_t k = 0; k < kNumSessions; ++k) {
+                sessions.push_back(scheduler.AddSession(config, kSampleRateHz, 1));
+            }
+            std::vector<uint64_t> num_pulled_frames(kNumSessions, 0);
+            std::vector<std::thread> threads;
+            for (size_t k = 0; k < kNumSessions; ++k) {
+                threads.emplace_back(PushPullAndRemove, &scheduler, sessions[k],
+                                     static_cast<uint32_t>(round * kNumSessions + k),
+                                     &num_pulled_frames[k]);
+            }
+            for (size_t k = 0; k < kNumSessions; ++k) {
+                threads[k].join();
+                EXPECT_LE(num_pulled_frames[k], kNumChunks * kChunkSize);
+                total_pulled_frames += num_pulled_frames[k];
+            }
+        }
+        EXPECT_GT(total_pulled_frames, 0u);
+    }
+
+}  // namespace webrtc
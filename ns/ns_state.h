@@ -0,0 +1,80 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_NS_NS_STATE_H_
+#define MODULES_AUDIO_PROCESSING_NS_NS_STATE_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#include <type_traits>
+#include <vector>
+
+#include "array_view.h"
+#include "checks.h"
+
+namespace webrtc {
+
+// Appends plain values, in host byte order, to a binary state blob.
+    class NsStateWriter {
+    public:
+        explicit NsStateWriter(std::vector<uint8_t> *blob) : blob_(blob) {
+            RTC_DCHECK(blob_);
+        }
+
+        NsStateWriter(const NsStateWriter &) = delete;
+
+        NsStateWriter &operator=(const NsStateWriter &) = delete;
+
+        template<typename T>
+        void Write(const T &value) {
+            static_assert(std::is_trivially_copyable<T>::value,
+                          "Only plain values can be written");
+            const uint8_t *data = reinterpret_cast<const uint8_t *>(&value);
+            blob_->insert(blob_->end(), data, data + sizeof(T));
+        }
+
+    private:
+        std::vector<uint8_t> *const blob_;
+    };
+
+// Reads back the values appended by NsStateWriter. A read past the end of the
+// blob fails and leaves the value untouched.
+    class NsStateReader {
+    public:
+        explicit NsStateReader(rtc::ArrayView<const uint8_t> blob) : blob_(blob) {}
+
+        NsStateReader(const NsStateReader &) = delete;
+
+        NsStateReader &operator=(const NsStateReader &) = delete;
+
+        template<typename T>
+        bool Read(T *value) {
+            static_assert(std::is_trivially_copyable<T>::value,
+                          "Only plain values can be read");
+            if (blob_.size() - position_ < sizeof(T)) {
+                return false;
+            }
+            memcpy(value, blob_.data() + position_, sizeof(T));
+            position_ += sizeof(T);
+            return true;
+        }
+
+        // Returns the number of bytes not yet read.
+        size_t remaining() const { return blob_.size() - position_; }
+
+    private:
+        const rtc::ArrayView<const uint8_t> blob_;
+        size_t position_ = 0;
+    };
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_NS_NS_STATE_H_
@@ -0,0 +1,124 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "ns_thread_pool.h"
+
+#include "checks.h"
+
+namespace webrtc {
+
+    namespace {
+
+// The number of polls of the job counter before an idle worker blocks, and of
+// the finished tasks before the calling thread blocks, which covers a few
+// microseconds.
+        constexpr int kNumSpinIterations = 2000;
+
+    }  // namespace
+
+    NsThreadPool::NsThreadPool(size_t num_threads)
+            : num_spin_iterations_(
+                      std::thread::hardware_concurrency() >= num_threads
+                      ? kNumSpinIterations : 0) {
+        RTC_DCHECK_GT(num_threads, 0);
+        for (size_t k = 1; k < num_threads; ++k) {
+            workers_.emplace_back([this]() { WorkerLoop(); });
+        }
+    }
+
+    NsThreadPool::~NsThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wakeup_.notify_all();
+        for (auto &worker : workers_) {
+            worker.join();
+        }
+    }
+
+    void NsThreadPool::RunJob(size_t num_tasks, TaskInvoker invoker,
+                              const void *task) {
+        if (workers_.empty() || num_tasks <= 1) {
+            for (size_t k = 0; k < num_tasks; ++k) {
+                invoker(task, k);
+            }
+            return;
+        }
+
+        {
+            // Wait for the workers that still take part in the previous job, after
+            // its last task, as they would otherwise join this one.
+            std::unique_lock<std::mutex> lock(mutex_);
+            done_.wait(lock, [this]() { return num_active_workers_ == 0; });
+            invoker_ = invoker;
+            task_ = task;
+            num_tasks_ = num_tasks;
+            next_task_.store(0);
+            num_finished_tasks_.store(0);
+            generation_.fetch_add(1);
+        }
+        wakeup_.notify_all();
+
+        RunTasks();
+        for (int k = 0; k < num_spin_iterations_ &&
+                        num_finished_tasks_.load(std::memory_order_acquire) < num_tasks;
+             ++k) {
+        }
+        if (num_finished_tasks_.load(std::memory_order_acquire) < num_tasks) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            done_.wait(lock, [this, num_tasks]() {
+                return num_finished_tasks_.load(std::memory_order_acquire) == num_tasks;
+            });
+        }
+    }
+
+    void NsThreadPool::RunTasks() {
+        for (size_t k = next_task_.fetch_add(1); k < num_tasks_;
+             k = next_task_.fetch_add(1)) {
+            invoker_(task_, k);
+            if (num_finished_tasks_.fetch_add(1, std::memory_order_release) + 1 ==
+                num_tasks_) {
+                // Under |mutex_|, so that the notification cannot slip in between
+                // the check of the waiting thread and its wait.
+                std::lock_guard<std::mutex> lock(mutex_);
+                done_.notify_all();
+            }
+        }
+    }
+
+    void NsThreadPool::WorkerLoop() {
+        uint64_t generation = 0;
+        for (;;) {
+            for (int k = 0; k < num_spin_iterations_ &&
+                            generation_.load(std::memory_order_acquire) == generation;
+                 ++k) {
+            }
+
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wakeup_.wait(lock, [this, generation]() {
+                    return stop_ || generation_.load() != generation;
+                });
+                if (stop_) {
+                    return;
+                }
+                generation = generation_.load();
+                ++num_active_workers_;
+            }
+            RunTasks();
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--num_active_workers_ == 0) {
+                done_.notify_all();
+            }
+        }
+    }
+
+}  // namespace webrtc
@@ -0,0 +1,88 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_NS_NS_THREAD_POOL_H_
+#define MODULES_AUDIO_PROCESSING_NS_NS_THREAD_POOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace webrtc {
+
+// Fork-join pool for running the per-channel work of a frame in parallel. The
+// calling thread takes part in the work, so a pool of N threads starts N - 1
+// worker threads. The workers, and the calling thread while it waits for them,
+// spin for a short while before they block, as the jobs of a frame follow each
+// other closely, unless there are fewer cores than threads.
+    class NsThreadPool {
+    public:
+        explicit NsThreadPool(size_t num_threads);
+
+        ~NsThreadPool();
+
+        NsThreadPool(const NsThreadPool &) = delete;
+
+        NsThreadPool &operator=(const NsThreadPool &) = delete;
+
+        size_t num_threads() const { return workers_.size() + 1; }
+
+        // Runs task(k) for k = 0..num_tasks-1, spread over the threads, and
+        // returns when all of them have finished. Must not be called concurrently.
+        // |task| is only referenced for the duration of the call, so it is not
+        // copied or wrapped into an allocated callable.
+        template<typename F>
+        void Run(size_t num_tasks, const F &task) {
+            RunJob(num_tasks, &InvokeTask<F>, &task);
+        }
+
+    private:
+        using TaskInvoker = void (*)(const void *task, size_t k);
+
+        template<typename F>
+        static void InvokeTask(const void *task, size_t k) {
+            (*static_cast<const F *>(task))(k);
+        }
+
+        void RunJob(size_t num_tasks, TaskInvoker invoker, const void *task);
+
+        void WorkerLoop();
+
+        // Runs tasks of the current job until none are left.
+        void RunTasks();
+
+        const int num_spin_iterations_;
+        std::vector<std::thread> workers_;
+        std::mutex mutex_;
+        std::condition_variable wakeup_;
+        // Notified when the last task of the job has finished and when the last
+        // worker has left the job.
+        std::condition_variable done_;
+        bool stop_ = false;
+        // Bumped for every job, under |mutex_|.
+        std::atomic<uint64_t> generation_{0};
+        // The job, which only changes when no worker takes part in it.
+        TaskInvoker invoker_ = nullptr;
+        const void *task_ = nullptr;
+        size_t num_tasks_ = 0;
+        // The number of workers that take part in the job, under |mutex_|.
+        size_t num_active_workers_ = 0;
+        std::atomic<size_t> next_task_{0};
+        std::atomic<size_t> num_finished_tasks_{0};
+    };
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_NS_NS_THREAD_POOL_H_
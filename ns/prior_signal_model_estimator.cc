@@ -23,7 +23,7 @@ namespace webrtc {
 // Identifies the first of the two largest peaks in the histogram.
         void FindFirstOfTwoLargestPeaks(
                 float bin_size,
-                rtc::ArrayView<const int, kHistogramSize> spectral_flatness,
+                rtc::ArrayView<const uint16_t, kHistogramSize> spectral_flatness,
                 float *peak_position,
                 int *peak_weight) {
             RTC_DCHECK(peak_position);
@@ -64,9 +64,11 @@ namespace webrtc {
             }
         }
 
-        void UpdateLrt(rtc::ArrayView<const int, kHistogramSize> lrt_histogram,
-                       float *prior_model_lrt,
-                       bool *low_lrt_fluctuations) {
+        void UpdateLrt(
+                rtc::ArrayView<const uint16_t, kHistogramSize> lrt_histogram,
+                int feature_update_window_size,
+                float *prior_model_lrt,
+                bool *low_lrt_fluctuations) {
             RTC_DCHECK(prior_model_lrt);
             RTC_DCHECK(low_lrt_fluctuations);
 
@@ -89,9 +91,10 @@ namespace webrtc {
                 average_squared += lrt_histogram[i] * bin_mid * bin_mid;
                 average_compl += lrt_histogram[i] * bin_mid;
             }
-            constexpr float kOneFeatureUpdateWindowSize = 1.f / kFeatureUpdateWindowSize;
-            average_squared = average_squared * kOneFeatureUpdateWindowSize;
-            average_compl = average_compl * kOneFeatureUpdateWindowSize;
+            const float one_by_feature_update_window_size =
+                    1.f / feature_update_window_size;
+            average_squared = average_squared * one_by_feature_update_window_size;
+            average_compl = average_compl * one_by_feature_update_window_size;
 
             // Fluctuation limit of LRT feature.
             *low_lrt_fluctuations = average_squared - average * average_compl < 0.05f;
@@ -109,13 +112,17 @@ namespace webrtc {
 
     }  // namespace
 
-    PriorSignalModelEstimator::PriorSignalModelEstimator(float lrt_initial_value)
-            : prior_model_(lrt_initial_value) {}
+    PriorSignalModelEstimator::PriorSignalModelEstimator(
+            float lrt_initial_value,
+            int feature_update_window_size)
+            : feature_update_window_size_(feature_update_window_size),
+              prior_model_(lrt_initial_value) {}
 
 // Extract thresholds for feature parameters and computes the threshold/weights.
     void PriorSignalModelEstimator::Update(const Histograms &histograms) {
         bool low_lrt_fluctuations;
-        UpdateLrt(histograms.get_lrt(), &prior_model_.lrt, &low_lrt_fluctuations);
+        UpdateLrt(histograms.get_lrt(), feature_update_window_size_,
+                  &prior_model_.lrt, &low_lrt_fluctuations);
 
         // For spectral flatness and spectral difference: compute the main peaks of
         // the histograms.
@@ -133,7 +140,8 @@ namespace webrtc {
 
         // Reject if weight of peaks is not large enough, or peak value too small.
         // Peak limit for spectral flatness (varies between 0 and 1).
-        const int use_spec_flat = spectral_flatness_peak_weight < 0.3f * 500 ||
+        const int use_spec_flat = spectral_flatness_peak_weight <
+                                  0.3f * feature_update_window_size_ ||
                                   spectral_flatness_peak_position < 0.6f
                                   ? 0
                                   : 1;
@@ -141,7 +149,8 @@ namespace webrtc {
         // Reject if weight of peaks is not large enough or if fluctuation of the LRT
         // feature are very low, indicating a noise state.
         const int use_spec_diff =
-                spectral_diff_peak_weight < 0.3f * 500 || low_lrt_fluctuations ? 0 : 1;
+                spectral_diff_peak_weight < 0.3f * feature_update_window_size_ ||
+                low_lrt_fluctuations ? 0 : 1;
 
         // Update the model.
         prior_model_.template_diff_threshold = 1.2f * spectral_diff_peak_position;
@@ -167,4 +176,42 @@ namespace webrtc {
         }
     }
 
+    void PriorSignalModelEstimator::Seed(const NoiseProfileParameters &profile) {
+        prior_model_.lrt = profile.lrt;
+        prior_model_.flatness_threshold = profile.flatness_threshold;
+        prior_model_.template_diff_threshold = profile.template_diff_threshold;
+        prior_model_.lrt_weighting = profile.lrt_weighting;
+        prior_model_.flatness_weighting = profile.flatness_weighting;
+        prior_model_.difference_weighting = profile.difference_weighting;
+    }
+
+    void PriorSignalModelEstimator::GetProfile(
+            NoiseProfileParameters *profile) const {
+        RTC_DCHECK(profile);
+        profile->lrt = prior_model_.lrt;
+        profile->flatness_threshold = prior_model_.flatness_threshold;
+        profile->template_diff_threshold = prior_model_.template_diff_threshold;
+        profile->lrt_weighting = prior_model_.lrt_weighting;
+        profile->flatness_weighting = prior_model_.flatness_weighting;
+        profile->difference_weighting = prior_model_.difference_weighting;
+    }
+
+    void PriorSignalModelEstimator::SaveState(NsStateWriter *writer) const {
+        writer->Write(prior_model_.lrt);
+        writer->Write(prior_model_.flatness_threshold);
+        writer->Write(prior_model_.template_diff_threshold);
+        writer->Write(prior_model_.lrt_weighting);
+        writer->Write(prior_model_.flatness_weighting);
+        writer->Write(prior_model_.difference_weighting);
+    }
+
+    bool PriorSignalModelEstimator::LoadState(NsStateReader *reader) {
+        return reader->Read(&prior_model_.lrt) &&
+               reader->Read(&prior_model_.flatness_threshold) &&
+               reader->Read(&prior_model_.template_diff_threshold) &&
+               reader->Read(&prior_model_.lrt_weighting) &&
+               reader->Read(&prior_model_.flatness_weighting) &&
+               reader->Read(&prior_model_.difference_weighting);
+    }
+
 }  // namespace webrtc
@@ -12,14 +12,18 @@
 #define MODULES_AUDIO_PROCESSING_NS_PRIOR_SIGNAL_MODEL_ESTIMATOR_H_
 
 #include "histograms.h"
+#include "noise_profile.h"
+#include "ns_state.h"
 #include "prior_signal_model.h"
 
 namespace webrtc {
 
-// Estimator of the prior signal model parameters.
+// Estimator of the prior signal model parameters, from histograms collected
+// over |feature_update_window_size| frames.
     class PriorSignalModelEstimator {
     public:
-        explicit PriorSignalModelEstimator(float lrt_initial_value);
+        PriorSignalModelEstimator(float lrt_initial_value,
+                                  int feature_update_window_size);
 
         PriorSignalModelEstimator(const PriorSignalModelEstimator &) = delete;
 
@@ -32,7 +36,30 @@ namespace webrtc {
         // Returns the estimated model.
         const PriorSignalModel &get_prior_model() const { return prior_model_; }
 
+        // Sets the model to the parameters of |profile|.
+        void Seed(const NoiseProfileParameters &profile);
+
+        // Stores the model parameters in |profile|.
+        void GetProfile(NoiseProfileParameters *profile) const;
+
+        // Appends the adaptive state to |writer|.
+        void SaveState(NsStateWriter *writer) const;
+
+        // Restores a state appended by SaveState(). Returns false if |reader| runs
+        // out of data.
+        bool LoadState(NsStateReader *reader);
+
+        // The number of bytes appended by SaveState().
+        static constexpr size_t StateSize() {
+            return sizeof(prior_model_.lrt) + sizeof(prior_model_.flatness_threshold) +
+                   sizeof(prior_model_.template_diff_threshold) +
+                   sizeof(prior_model_.lrt_weighting) +
+                   sizeof(prior_model_.flatness_weighting) +
+                   sizeof(prior_model_.difference_weighting);
+        }
+
     private:
+        const int feature_update_window_size_;
         PriorSignalModel prior_model_;
     };
 
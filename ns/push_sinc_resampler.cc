@@ -17,29 +17,40 @@
 namespace webrtc {
 
     PushSincResampler::PushSincResampler(size_t source_frames,
-                                         size_t destination_frames)
-            : resampler_(new SincResampler(source_frames * 1.0 / destination_frames,
-                                           source_frames,
-                                           this)),
+                                         size_t destination_frames,
+                                         NsAllocator *allocator)
+            : resampler_(NsMakeUnique<SincResampler>(
+                      allocator, source_frames * 1.0 / destination_frames,
+                      source_frames, this, allocator)),
+              float_buffer_(allocator ? destination_frames : 0, allocator),
               source_ptr_(nullptr),
               source_ptr_int_(nullptr),
               destination_frames_(destination_frames),
               first_pass_(true),
               source_available_(0) {}
 
+    void PushSincResampler::AddToLayout(NsArenaLayout *layout,
+                                        size_t source_frames,
+                                        size_t destination_frames) {
+        layout->AddObject<SincResampler>();
+        SincResampler::AddToLayout(layout, source_frames);
+        layout->AddVector<float>(destination_frames);
+    }
+
     PushSincResampler::~PushSincResampler() = default;
 
     size_t PushSincResampler::Resample(const int16_t *source,
                                        size_t source_length,
                                        int16_t *destination,
                                        size_t destination_capacity) {
-        if (!float_buffer_)
-            float_buffer_.reset(new float[destination_frames_]);
+        RTC_DCHECK_GE(destination_capacity, destination_frames_);
+        if (float_buffer_.empty())
+            float_buffer_.resize(destination_frames_);
 
         source_ptr_int_ = source;
         // Pass nullptr as the float source to have Run() read from the int16 source.
-        Resample(nullptr, source_length, float_buffer_.get(), destination_frames_);
-        FloatS16ToS16(float_buffer_.get(), destination_frames_, destination);
+        Resample(nullptr, source_length, float_buffer_.data(), destination_frames_);
+        FloatS16ToS16(float_buffer_.data(), destination_frames_, destination);
         source_ptr_int_ = nullptr;
         return destination_frames_;
     }
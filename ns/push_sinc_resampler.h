@@ -16,8 +16,10 @@
 
 #include <memory>
 
-#include "sinc_resampler.h"
 #include "constructor_magic.h"
+#include "ns_allocator.h"
+#include "ns_arena.h"
+#include "sinc_resampler.h"
 
 namespace webrtc {
 
@@ -29,8 +31,18 @@ namespace webrtc {
     public:
         // Provide the size of the source and destination blocks in samples. These
         // must correspond to the same time duration (typically 10 ms) as the sample
-        // ratio is inferred from them.
-        PushSincResampler(size_t source_frames, size_t destination_frames);
+        // ratio is inferred from them. If |allocator| is not null, the resampler
+        // and its buffers are allocated from it, which must then outlive this
+        // object.
+        PushSincResampler(size_t source_frames,
+                          size_t destination_frames,
+                          NsAllocator *allocator = nullptr);
+
+        // Adds the allocations of a PushSincResampler constructed with the same
+        // arguments and an allocator to |layout|.
+        static void AddToLayout(NsArenaLayout *layout,
+                                size_t source_frames,
+                                size_t destination_frames);
 
         ~PushSincResampler() override;
 
@@ -64,8 +76,11 @@ namespace webrtc {
 
         SincResampler *get_resampler_for_testing() { return resampler_.get(); }
 
-        std::unique_ptr<SincResampler> resampler_;
-        std::unique_ptr<float[]> float_buffer_;
+        NsUniquePtr<SincResampler> resampler_;
+        // Holds the output of the int16 Resample(). Allocated on first use, or
+        // at construction when there is an allocator, as an arena only hands out
+        // memory while a session is created.
+        NsVector<float> float_buffer_;
         const float *source_ptr_;
         const int16_t *source_ptr_int_;
         const size_t destination_frames_;
@@ -12,25 +12,167 @@
 
 #include <algorithm>
 
+#include "arch.h"
 #include "fast_math.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define WEBRTC_QUANTILE_NOISE_ESTIMATOR_SSE2
+#include <emmintrin.h>
+#elif defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace webrtc {
 
-    QuantileNoiseEstimator::QuantileNoiseEstimator() {
+    namespace {
+
+        constexpr float kWidth = 0.01f;
+        constexpr float kOneByWidthPlus2 = 1.f / (2.f * kWidth);
+
+        // Updates the log quantile and density estimates of one bin.
+        void UpdateQuantileBin(float log_spectrum,
+                               float counter,
+                               float one_by_counter_plus_1,
+                               float *density,
+                               float *log_quantile) {
+            // Update log quantile estimate.
+            const float delta = *density > 1.f ? 40.f / *density : 40.f;
+
+            const float multiplier = delta * one_by_counter_plus_1;
+            if (log_spectrum > *log_quantile) {
+                *log_quantile += 0.25f * multiplier;
+            } else {
+                *log_quantile -= 0.75f * multiplier;
+            }
+
+            // Update density estimate.
+            if (fabs(log_spectrum - *log_quantile) < kWidth) {
+                *density = (counter * *density + kOneByWidthPlus2) * one_by_counter_plus_1;
+            }
+        }
+
+        // Updates the estimates of one of the simultaneous quantile tracks. The
+        // branches of UpdateQuantileBin are replaced by masks in the vectorized
+        // loop, which produces results identical to the scalar code.
+        template<size_t kFftSizeBy2Plus1>
+        void UpdateQuantileTrack(
+                rtc::ArrayView<const float, kFftSizeBy2Plus1> log_spectrum,
+                float counter,
+                float one_by_counter_plus_1,
+                float *density,
+                float *log_quantile) {
+            size_t i = 0;
+#if defined(WEBRTC_QUANTILE_NOISE_ESTIMATOR_SSE2)
+            const __m128 one = _mm_set1_ps(1.f);
+            const __m128 forty = _mm_set1_ps(40.f);
+            const __m128 up_step = _mm_set1_ps(0.25f);
+            const __m128 down_step = _mm_set1_ps(-0.75f);
+            const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+            const __m128 width = _mm_set1_ps(kWidth);
+            const __m128 one_by_width_plus_2 = _mm_set1_ps(kOneByWidthPlus2);
+            const __m128 counter_v = _mm_set1_ps(counter);
+            const __m128 one_by_counter_plus_1_v = _mm_set1_ps(one_by_counter_plus_1);
+            for (; i + 4 <= kFftSizeBy2Plus1; i += 4) {
+                const __m128 log_spectrum_i = _mm_loadu_ps(&log_spectrum[i]);
+                __m128 density_i = _mm_loadu_ps(&density[i]);
+                __m128 log_quantile_i = _mm_loadu_ps(&log_quantile[i]);
+
+                const __m128 use_ratio = _mm_cmpgt_ps(density_i, one);
+                const __m128 delta =
+                        _mm_or_ps(_mm_and_ps(use_ratio, _mm_div_ps(forty, density_i)),
+                                  _mm_andnot_ps(use_ratio, forty));
+                const __m128 multiplier = _mm_mul_ps(delta, one_by_counter_plus_1_v);
+
+                // Subtracting 0.75 * multiplier equals adding -0.75 * multiplier.
+                const __m128 step_up = _mm_cmpgt_ps(log_spectrum_i, log_quantile_i);
+                const __m128 step = _mm_or_ps(
+                        _mm_and_ps(step_up, _mm_mul_ps(up_step, multiplier)),
+                        _mm_andnot_ps(step_up, _mm_mul_ps(down_step, multiplier)));
+                log_quantile_i = _mm_add_ps(log_quantile_i, step);
+
+                const __m128 distance =
+                        _mm_and_ps(_mm_sub_ps(log_spectrum_i, log_quantile_i), abs_mask);
+                const __m128 update_density = _mm_cmplt_ps(distance, width);
+                const __m128 new_density = _mm_mul_ps(
+                        _mm_add_ps(_mm_mul_ps(counter_v, density_i), one_by_width_plus_2),
+                        one_by_counter_plus_1_v);
+                density_i = _mm_or_ps(_mm_and_ps(update_density, new_density),
+                                      _mm_andnot_ps(update_density, density_i));
+
+                _mm_storeu_ps(&log_quantile[i], log_quantile_i);
+                _mm_storeu_ps(&density[i], density_i);
+            }
+#elif defined(WEBRTC_HAS_NEON)
+            const float32x4_t one = vdupq_n_f32(1.f);
+            const float32x4_t forty = vdupq_n_f32(40.f);
+            const float32x4_t up_step = vdupq_n_f32(0.25f);
+            const float32x4_t down_step = vdupq_n_f32(-0.75f);
+            const float32x4_t width = vdupq_n_f32(kWidth);
+            const float32x4_t one_by_width_plus_2 = vdupq_n_f32(kOneByWidthPlus2);
+            const float32x4_t counter_v = vdupq_n_f32(counter);
+            const float32x4_t one_by_counter_plus_1_v =
+                    vdupq_n_f32(one_by_counter_plus_1);
+            for (; i + 4 <= kFftSizeBy2Plus1; i += 4) {
+                const float32x4_t log_spectrum_i = vld1q_f32(&log_spectrum[i]);
+                float32x4_t density_i = vld1q_f32(&density[i]);
+                float32x4_t log_quantile_i = vld1q_f32(&log_quantile[i]);
+
+                // The division is done per lane since 32-bit NEON lacks vdivq_f32.
+                float ratio[4];
+                for (size_t k = 0; k < 4; ++k) {
+                    ratio[k] = 40.f / density[i + k];
+                }
+                const uint32x4_t use_ratio = vcgtq_f32(density_i, one);
+                const float32x4_t delta =
+                        vbslq_f32(use_ratio, vld1q_f32(ratio), forty);
+                const float32x4_t multiplier =
+                        vmulq_f32(delta, one_by_counter_plus_1_v);
+
+                // Subtracting 0.75 * multiplier equals adding -0.75 * multiplier.
+                const uint32x4_t step_up = vcgtq_f32(log_spectrum_i, log_quantile_i);
+                const float32x4_t step = vbslq_f32(step_up, vmulq_f32(up_step, multiplier),
+                                                   vmulq_f32(down_step, multiplier));
+                log_quantile_i = vaddq_f32(log_quantile_i, step);
+
+                const float32x4_t distance =
+                        vabsq_f32(vsubq_f32(log_spectrum_i, log_quantile_i));
+                const uint32x4_t update_density = vcltq_f32(distance, width);
+                const float32x4_t new_density = vmulq_f32(
+                        vaddq_f32(vmulq_f32(counter_v, density_i), one_by_width_plus_2),
+                        one_by_counter_plus_1_v);
+                density_i = vbslq_f32(update_density, new_density, density_i);
+
+                vst1q_f32(&log_quantile[i], log_quantile_i);
+                vst1q_f32(&density[i], density_i);
+            }
+#endif
+            for (; i < kFftSizeBy2Plus1; ++i) {
+                UpdateQuantileBin(log_spectrum[i], counter, one_by_counter_plus_1,
+                                  &density[i], &log_quantile[i]);
+            }
+        }
+
+    }  // namespace
+
+    template<typename Geometry>
+    BasicQuantileNoiseEstimator<Geometry>::BasicQuantileNoiseEstimator() {
         quantile_.fill(0.f);
         density_.fill(0.3f);
         log_quantile_.fill(8.f);
 
         constexpr float kOneBySimult = 1.f / kSimult;
         for (size_t i = 0; i < kSimult; ++i) {
-            counter_[i] = floor(kLongStartupPhaseBlocks * (i + 1.f) * kOneBySimult);
+            counter_[i] = floor(Geometry::kLongStartupPhaseBlocks * (i + 1.f) *
+                                kOneBySimult);
         }
     }
 
-    void QuantileNoiseEstimator::Estimate(
+    template<typename Geometry>
+    void BasicQuantileNoiseEstimator<Geometry>::Estimate(
             rtc::ArrayView<const float, kFftSizeBy2Plus1> signal_spectrum,
             rtc::ArrayView<float, kFftSizeBy2Plus1> noise_spectrum) {
-        std::array<float, kFftSizeBy2Plus1> log_spectrum{};
+        std::array<float, kFftSizeBy2Plus1> log_spectrum;
         LogApproximation(signal_spectrum, log_spectrum);
 
         int quantile_index_to_return = -1;
@@ -38,29 +180,13 @@ namespace webrtc {
         for (int s = 0, k = 0; s < kSimult;
              ++s, k += static_cast<int>(kFftSizeBy2Plus1)) {
             const float one_by_counter_plus_1 = 1.f / (counter_[s] + 1.f);
-            for (int i = 0, j = k; i < static_cast<int>(kFftSizeBy2Plus1); ++i, ++j) {
-                // Update log quantile estimate.
-                const float delta = density_[j] > 1.f ? 40.f / density_[j] : 40.f;
-
-                const float multiplier = delta * one_by_counter_plus_1;
-                if (log_spectrum[i] > log_quantile_[j]) {
-                    log_quantile_[j] += 0.25f * multiplier;
-                } else {
-                    log_quantile_[j] -= 0.75f * multiplier;
-                }
-
-                // Update density estimate.
-                constexpr float kWidth = 0.01f;
-                constexpr float kOneByWidthPlus2 = 1.f / (2.f * kWidth);
-                if (fabs(log_spectrum[i] - log_quantile_[j]) < kWidth) {
-                    density_[j] = (counter_[s] * density_[j] + kOneByWidthPlus2) *
-                                  one_by_counter_plus_1;
-                }
-            }
+            UpdateQuantileTrack<kFftSizeBy2Plus1>(log_spectrum, counter_[s],
+                                                  one_by_counter_plus_1,
+                                                  &density_[k], &log_quantile_[k]);
 
-            if (counter_[s] >= kLongStartupPhaseBlocks) {
+            if (counter_[s] >= Geometry::kLongStartupPhaseBlocks) {
                 counter_[s] = 0;
-                if (num_updates_ >= kLongStartupPhaseBlocks) {
+                if (num_updates_ >= Geometry::kLongStartupPhaseBlocks) {
                     quantile_index_to_return = k;
                 }
             }
@@ -69,7 +195,7 @@ namespace webrtc {
         }
 
         // Sequentially update the noise during startup.
-        if (num_updates_ < kLongStartupPhaseBlocks) {
+        if (num_updates_ < Geometry::kLongStartupPhaseBlocks) {
             // Use the last "s" to get noise during startup that differ from zero.
             quantile_index_to_return = kFftSizeBy2Plus1 * (kSimult - 1);
             ++num_updates_;
@@ -85,4 +211,38 @@ namespace webrtc {
         std::copy(quantile_.begin(), quantile_.end(), noise_spectrum.begin());
     }
 
+    template<typename Geometry>
+    void BasicQuantileNoiseEstimator<Geometry>::Seed(
+            rtc::ArrayView<const float, kFftSizeBy2Plus1> noise_spectrum) {
+        std::copy(noise_spectrum.begin(), noise_spectrum.end(), quantile_.begin());
+        std::array<float, kFftSizeBy2Plus1> log_noise_spectrum;
+        LogApproximation(noise_spectrum, log_noise_spectrum);
+        for (size_t k = 0; k < log_quantile_.size(); k += kFftSizeBy2Plus1) {
+            std::copy(log_noise_spectrum.begin(), log_noise_spectrum.end(),
+                      &log_quantile_[k]);
+        }
+        num_updates_ = Geometry::kLongStartupPhaseBlocks;
+    }
+
+    template<typename Geometry>
+    void BasicQuantileNoiseEstimator<Geometry>::SaveState(
+            NsStateWriter *writer) const {
+        writer->Write(density_);
+        writer->Write(log_quantile_);
+        writer->Write(quantile_);
+        writer->Write(counter_);
+        writer->Write(num_updates_);
+    }
+
+    template<typename Geometry>
+    bool BasicQuantileNoiseEstimator<Geometry>::LoadState(NsStateReader *reader) {
+        return reader->Read(&density_) && reader->Read(&log_quantile_) &&
+               reader->Read(&quantile_) && reader->Read(&counter_) &&
+               reader->Read(&num_updates_);
+    }
+
+    template class BasicQuantileNoiseEstimator<NsDefaultGeometry>;
+    template class BasicQuantileNoiseEstimator<NsLowDelayGeometry>;
+    template class BasicQuantileNoiseEstimator<NsHighEfficiencyGeometry>;
+
 }  // namespace webrtc
@@ -16,24 +16,46 @@
 
 #include "array_view.h"
 #include "ns_common.h"
+#include "ns_state.h"
 
 namespace webrtc {
 
     constexpr int kSimult = 3;
 
-// For quantile noise estimation.
-    class QuantileNoiseEstimator {
+// For quantile noise estimation, with the frame geometry |Geometry|, see
+// NsGeometry. Instantiated for the geometries in ns_common.h.
+    template<typename Geometry>
+    class BasicQuantileNoiseEstimator {
     public:
-        QuantileNoiseEstimator();
+        static constexpr size_t kFftSizeBy2Plus1 = Geometry::kFftSizeBy2Plus1;
 
-        QuantileNoiseEstimator(const QuantileNoiseEstimator &) = delete;
+        BasicQuantileNoiseEstimator();
 
-        QuantileNoiseEstimator &operator=(const QuantileNoiseEstimator &) = delete;
+        BasicQuantileNoiseEstimator(const BasicQuantileNoiseEstimator &) = delete;
+
+        BasicQuantileNoiseEstimator &operator=(const BasicQuantileNoiseEstimator &) =
+        delete;
 
         // Estimate noise.
         void Estimate(rtc::ArrayView<const float, kFftSizeBy2Plus1> signal_spectrum,
                       rtc::ArrayView<float, kFftSizeBy2Plus1> noise_spectrum);
 
+        // Starts the estimates at |noise_spectrum| with the startup phase completed.
+        void Seed(rtc::ArrayView<const float, kFftSizeBy2Plus1> noise_spectrum);
+
+        // Appends the adaptive state to |writer|.
+        void SaveState(NsStateWriter *writer) const;
+
+        // Restores a state appended by SaveState(). Returns false if |reader| runs
+        // out of data.
+        bool LoadState(NsStateReader *reader);
+
+        // The number of bytes appended by SaveState().
+        static constexpr size_t StateSize() {
+            return sizeof(density_) + sizeof(log_quantile_) + sizeof(quantile_) +
+                   sizeof(counter_) + sizeof(num_updates_);
+        }
+
     private:
         std::array<float, kSimult * kFftSizeBy2Plus1> density_{};
         std::array<float, kSimult * kFftSizeBy2Plus1> log_quantile_{};
@@ -42,6 +64,8 @@ namespace webrtc {
         int num_updates_ = 1;
     };
 
+    using QuantileNoiseEstimator = BasicQuantileNoiseEstimator<NsDefaultGeometry>;
+
 }  // namespace webrtc
 
 #endif  // MODULES_AUDIO_PROCESSING_NS_QUANTILE_NOISE_ESTIMATOR_H_
@@ -0,0 +1,143 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "quantile_noise_estimator.h"
+
+#include <math.h>
+#include <stdint.h>
+
+#include <array>
+
+#include "fast_math.h"
+#include "gtest/gtest.h"
+
+namespace webrtc {
+    namespace {
+
+        // Scalar quantile noise estimator with one branch per decision, as before
+        // the update was vectorized with masks.
+        template<typename Geometry>
+        class ReferenceQuantileNoiseEstimator {
+        public:
+            static constexpr size_t kFftSizeBy2Plus1 = Geometry::kFftSizeBy2Plus1;
+
+            ReferenceQuantileNoiseEstimator() {
+                quantile_.fill(0.f);
+                density_.fill(0.3f);
+                log_quantile_.fill(8.f);
+                constexpr float kOneBySimult = 1.f / kSimult;
+                for (size_t i = 0; i < kSimult; ++i) {
+                    counter_[i] = floor(Geometry::kLongStartupPhaseBlocks * (i + 1.f) *
+                                        kOneBySimult);
+                }
+            }
+
+            void Estimate(const std::array<float, kFftSizeBy2Plus1> &signal_spectrum,
+                          std::array<float, kFftSizeBy2Plus1> *noise_spectrum) {
+                constexpr float kWidth = 0.01f;
+                constexpr float kOneByWidthPlus2 = 1.f / (2.f * kWidth);
+
+                std::array<float, kFftSizeBy2Plus1> log_spectrum;
+                for (size_t i = 0; i < kFftSizeBy2Plus1; ++i) {
+                    log_spectrum[i] = LogApproximation(signal_spectrum[i]);
+                }
+
+                int quantile_index_to_return = -1;
+                for (int s = 0, k = 0; s < kSimult;
+                     ++s, k += static_cast<int>(kFftSizeBy2Plus1)) {
+                    const float one_by_counter_plus_1 = 1.f / (counter_[s] + 1.f);
+                    for (size_t i = 0, j = k; i < kFftSizeBy2Plus1; ++i, ++j) {
+                        const float delta = density_[j] > 1.f ? 40.f / density_[j] : 40.f;
+                        const float multiplier = delta * one_by_counter_plus_1;
+                        if (log_spectrum[i] > log_quantile_[j]) {
+                            log_quantile_[j] += 0.25f * multiplier;
+                        } else {
+                            log_quantile_[j] -= 0.75f * multiplier;
+                        }
+                        if (fabs(log_spectrum[i] - log_quantile_[j]) < kWidth) {
+                            density_[j] = (counter_[s] * density_[j] + kOneByWidthPlus2) *
+                                          one_by_counter_plus_1;
+                        }
+                    }
+
+                    if (counter_[s] >= Geometry::kLongStartupPhaseBlocks) {
+                        counter_[s] = 0;
+                        if (num_updates_ >= Geometry::kLongStartupPhaseBlocks) {
+                            quantile_index_to_return = k;
+                        }
+                    }
+                    ++counter_[s];
+                }
+
+                if (num_updates_ < Geometry::kLongStartupPhaseBlocks) {
+                    quantile_index_to_return = kFftSizeBy2Plus1 * (kSimult - 1);
+                    ++num_updates_;
+                }
+
+                if (quantile_index_to_return >= 0) {
+                    for (size_t i = 0; i < kFftSizeBy2Plus1; ++i) {
+                        quantile_[i] =
+                                ExpApproximation(log_quantile_[quantile_index_to_return + i]);
+                    }
+                }
+                *noise_spectrum = quantile_;
+            }
+
+        private:
+            std::array<float, kSimult * kFftSizeBy2Plus1> density_;
+            std::array<float, kSimult * kFftSizeBy2Plus1> log_quantile_;
+            std::array<float, kFftSizeBy2Plus1> quantile_;
+            std::array<int, kSimult> counter_;
+            int num_updates_ = 1;
+        };
+
+        // Verifies that the vectorized estimator matches the reference bit-exactly
+        // for a stationary noise floor with speech-like bursts, so that the
+        // estimates both rise and fall and the densities are updated.
+        template<typename Geometry>
+        void RunAgainstReference() {
+            constexpr size_t kFftSizeBy2Plus1 = Geometry::kFftSizeBy2Plus1;
+            BasicQuantileNoiseEstimator<Geometry> estimator;
+            ReferenceQuantileNoiseEstimator<Geometry> reference;
+            std::array<float, kFftSizeBy2Plus1> signal_spectrum;
+            std::array<float, kFftSizeBy2Plus1> noise_spectrum;
+            std::array<float, kFftSizeBy2Plus1> reference_noise_spectrum;
+            uint32_t seed = 1;
+            for (int frame = 0; frame < 2000; ++frame) {
+                const bool burst = (frame / 37) % 3 == 0;
+                for (size_t i = 0; i < kFftSizeBy2Plus1; ++i) {
+                    seed = seed * 1664525u + 1013904223u;
+                    const float noise = 1.f + (seed >> 16) / 65536.f;
+                    signal_spectrum[i] = (burst ? 3000.f : 100.f) * noise / (1.f + i);
+                }
+                estimator.Estimate(signal_spectrum, noise_spectrum);
+                reference.Estimate(signal_spectrum, &reference_noise_spectrum);
+                for (size_t i = 0; i < kFftSizeBy2Plus1; ++i) {
+                    ASSERT_EQ(reference_noise_spectrum[i], noise_spectrum[i])
+                                                << "frame " << frame << ", bin " << i;
+                }
+            }
+        }
+
+    }  // namespace
+
+    TEST(QuantileNoiseEstimatorTest, MatchesScalarReference) {
+        RunAgainstReference<NsDefaultGeometry>();
+    }
+
+    TEST(QuantileNoiseEstimatorTest, MatchesScalarReferenceLowDelay) {
+        RunAgainstReference<NsLowDelayGeometry>();
+    }
+
+    TEST(QuantileNoiseEstimatorTest, MatchesScalarReferenceHighEfficiency) {
+        RunAgainstReference<NsHighEfficiencyGeometry>();
+    }
+
+}  // namespace webrtc
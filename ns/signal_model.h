@@ -17,20 +17,35 @@
 
 namespace webrtc {
 
-    struct SignalModel {
-        SignalModel();
-
-        SignalModel(const SignalModel &) = delete;
-
-        SignalModel &operator=(const SignalModel &) = delete;
-
+// Features of the signal that are tracked by the signal model.
+    struct SignalFeatures {
         float lrt;
         float spectral_diff;
         float spectral_flatness;
+    };
+
+// Signal model for the frame geometry |Geometry|, see NsGeometry.
+    template<typename Geometry>
+    struct BasicSignalModel : SignalFeatures {
+        BasicSignalModel() {
+            constexpr float kSfFeatureThr = 0.5f;
+
+            lrt = kLtrFeatureThr;
+            spectral_flatness = kSfFeatureThr;
+            spectral_diff = kSfFeatureThr;
+            avg_log_lrt.fill(kLtrFeatureThr);
+        }
+
+        BasicSignalModel(const BasicSignalModel &) = delete;
+
+        BasicSignalModel &operator=(const BasicSignalModel &) = delete;
+
         // Log LRT factor with time-smoothing.
-        std::array<float, kFftSizeBy2Plus1> avg_log_lrt{};
+        std::array<float, Geometry::kFftSizeBy2Plus1> avg_log_lrt{};
     };
 
+    using SignalModel = BasicSignalModel<NsDefaultGeometry>;
+
 }  // namespace webrtc
 
 #endif  // MODULES_AUDIO_PROCESSING_NS_SIGNAL_MODEL_H_
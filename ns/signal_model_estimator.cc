@@ -10,21 +10,23 @@
 
 #include "signal_model_estimator.h"
 
+#include "checks.h"
 #include "fast_math.h"
 
 namespace webrtc {
 
     namespace {
 
-        constexpr float kOneByFftSizeBy2Plus1 = 1.f / kFftSizeBy2Plus1;
-
 // Computes the difference measure between input spectrum and a template/learned
 // noise spectrum.
+        template<size_t kFftSizeBy2Plus1>
         float ComputeSpectralDiff(
                 rtc::ArrayView<const float, kFftSizeBy2Plus1> conservative_noise_spectrum,
                 rtc::ArrayView<const float, kFftSizeBy2Plus1> signal_spectrum,
                 float signal_spectral_sum,
                 float diff_normalization) {
+            constexpr float kOneByFftSizeBy2Plus1 = 1.f / kFftSizeBy2Plus1;
+
             // spectral_diff = var(signal_spectrum) - cov(signal_spectrum, magnAvgPause)^2
             // / var(magnAvgPause)
 
@@ -60,11 +62,13 @@ namespace webrtc {
         }
 
 // Updates the spectral flatness based on the input spectrum.
+        template<size_t kFftSizeBy2Plus1>
         void UpdateSpectralFlatness(
                 rtc::ArrayView<const float, kFftSizeBy2Plus1> signal_spectrum,
                 float signal_spectral_sum,
                 float *spectral_flatness) {
             RTC_DCHECK(spectral_flatness);
+            constexpr float kOneByFftSizeBy2Plus1 = 1.f / kFftSizeBy2Plus1;
 
             // Compute log of ratio of the geometric to arithmetic mean (handle the log(0)
             // separately).
@@ -77,8 +81,10 @@ namespace webrtc {
                 }
             }
 
-            for (size_t i = 1; i < kFftSizeBy2Plus1; ++i) {
-                avg_spect_flatness_num += LogApproximation(signal_spectrum[i]);
+            std::array<float, kFftSizeBy2Plus1 - 1> log_signal_spectrum;
+            LogApproximation(signal_spectrum.subview(1), log_signal_spectrum);
+            for (float log_signal : log_signal_spectrum) {
+                avg_spect_flatness_num += log_signal;
             }
 
             float avg_spect_flatness_denom = signal_spectral_sum - signal_spectrum[0];
@@ -94,18 +100,25 @@ namespace webrtc {
         }
 
 // Updates the log LRT measures.
+        template<size_t kFftSizeBy2Plus1>
         void UpdateSpectralLrt(rtc::ArrayView<const float, kFftSizeBy2Plus1> prior_snr,
                                rtc::ArrayView<const float, kFftSizeBy2Plus1> post_snr,
                                rtc::ArrayView<float, kFftSizeBy2Plus1> avg_log_lrt,
                                float *lrt) {
             RTC_DCHECK(lrt);
+            constexpr float kOneByFftSizeBy2Plus1 = 1.f / kFftSizeBy2Plus1;
+
+            std::array<float, kFftSizeBy2Plus1> tmp1;
+            for (size_t i = 0; i < kFftSizeBy2Plus1; ++i) {
+                tmp1[i] = 1.f + 2.f * prior_snr[i];
+            }
+            std::array<float, kFftSizeBy2Plus1> log_tmp1;
+            LogApproximation(tmp1, log_tmp1);
 
             for (size_t i = 0; i < kFftSizeBy2Plus1; ++i) {
-                float tmp1 = 1.f + 2.f * prior_snr[i];
-                float tmp2 = 2.f * prior_snr[i] / (tmp1 + 0.0001f);
+                float tmp2 = 2.f * prior_snr[i] / (tmp1[i] + 0.0001f);
                 float bessel_tmp = (post_snr[i] + 1.f) * tmp2;
-                avg_log_lrt[i] +=
-                        .5f * (bessel_tmp - LogApproximation(tmp1) - avg_log_lrt[i]);
+                avg_log_lrt[i] += .5f * (bessel_tmp - log_tmp1[i] - avg_log_lrt[i]);
             }
 
             float log_lrt_time_avg_k_sum = 0.f;
@@ -117,18 +130,24 @@ namespace webrtc {
 
     }  // namespace
 
-    SignalModelEstimator::SignalModelEstimator()
-            : prior_model_estimator_(kLtrFeatureThr) {}
+    template<typename Geometry>
+    BasicSignalModelEstimator<Geometry>::BasicSignalModelEstimator()
+            : histogram_analysis_counter_(Geometry::kFeatureUpdateWindowSize),
+              prior_model_estimator_(kLtrFeatureThr,
+                                     Geometry::kFeatureUpdateWindowSize) {}
 
-    void SignalModelEstimator::AdjustNormalization(int32_t num_analyzed_frames,
-                                                   float signal_energy) {
+    template<typename Geometry>
+    void BasicSignalModelEstimator<Geometry>::AdjustNormalization(
+            int32_t num_analyzed_frames,
+            float signal_energy) {
         diff_normalization_ *= num_analyzed_frames;
         diff_normalization_ += signal_energy;
         diff_normalization_ /= (num_analyzed_frames + 1);
     }
 
 // Update the noise features.
-    void SignalModelEstimator::Update(
+    template<typename Geometry>
+    void BasicSignalModelEstimator<Geometry>::Update(
             rtc::ArrayView<const float, kFftSizeBy2Plus1> prior_snr,
             rtc::ArrayView<const float, kFftSizeBy2Plus1> post_snr,
             rtc::ArrayView<const float, kFftSizeBy2Plus1> conservative_noise_spectrum,
@@ -136,12 +155,12 @@ namespace webrtc {
             float signal_spectral_sum,
             float signal_energy) {
         // Compute spectral flatness on input spectrum.
-        UpdateSpectralFlatness(signal_spectrum, signal_spectral_sum,
+        UpdateSpectralFlatness<kFftSizeBy2Plus1>(signal_spectrum, signal_spectral_sum,
                                &features_.spectral_flatness);
 
         // Compute difference of input spectrum with learned/estimated noise spectrum.
         float spectral_diff =
-                ComputeSpectralDiff(conservative_noise_spectrum, signal_spectrum,
+                ComputeSpectralDiff<kFftSizeBy2Plus1>(conservative_noise_spectrum, signal_spectrum,
                                     signal_spectral_sum, diff_normalization_);
         // Compute time-avg update of difference feature.
         features_.spectral_diff += 0.3f * (spectral_diff - features_.spectral_diff);
@@ -159,17 +178,62 @@ namespace webrtc {
             // Clear histograms for next update.
             histograms_.Clear();
 
-            histogram_analysis_counter_ = kFeatureUpdateWindowSize;
+            histogram_analysis_counter_ = Geometry::kFeatureUpdateWindowSize;
 
             // Update every window:
             // Compute normalization for the spectral difference for next estimation.
-            signal_energy_sum_ = signal_energy_sum_ / kFeatureUpdateWindowSize;
+            signal_energy_sum_ =
+                    signal_energy_sum_ / Geometry::kFeatureUpdateWindowSize;
             diff_normalization_ = 0.5f * (signal_energy_sum_ + diff_normalization_);
             signal_energy_sum_ = 0.f;
         }
 
         // Compute the LRT.
-        UpdateSpectralLrt(prior_snr, post_snr, features_.avg_log_lrt, &features_.lrt);
+        UpdateSpectralLrt<kFftSizeBy2Plus1>(prior_snr, post_snr,
+                                            features_.avg_log_lrt, &features_.lrt);
+    }
+
+    template<typename Geometry>
+    void BasicSignalModelEstimator<Geometry>::Seed(const NoiseProfileParameters &profile) {
+        diff_normalization_ = profile.spectral_diff_normalization;
+        prior_model_estimator_.Seed(profile);
+    }
+
+    template<typename Geometry>
+    void BasicSignalModelEstimator<Geometry>::GetProfile(NoiseProfileParameters *profile) const {
+        RTC_DCHECK(profile);
+        profile->spectral_diff_normalization = diff_normalization_;
+        prior_model_estimator_.GetProfile(profile);
+    }
+
+    template<typename Geometry>
+    void BasicSignalModelEstimator<Geometry>::SaveState(
+            NsStateWriter *writer) const {
+        writer->Write(diff_normalization_);
+        writer->Write(signal_energy_sum_);
+        histograms_.SaveState(writer);
+        writer->Write(histogram_analysis_counter_);
+        prior_model_estimator_.SaveState(writer);
+        writer->Write(features_.lrt);
+        writer->Write(features_.spectral_diff);
+        writer->Write(features_.spectral_flatness);
+        writer->Write(features_.avg_log_lrt);
+    }
+
+    template<typename Geometry>
+    bool BasicSignalModelEstimator<Geometry>::LoadState(
+            NsStateReader *reader) {
+        return reader->Read(&diff_normalization_) &&
+               reader->Read(&signal_energy_sum_) && histograms_.LoadState(reader) &&
+               reader->Read(&histogram_analysis_counter_) &&
+               prior_model_estimator_.LoadState(reader) &&
+               reader->Read(&features_.lrt) && reader->Read(&features_.spectral_diff) &&
+               reader->Read(&features_.spectral_flatness) &&
+               reader->Read(&features_.avg_log_lrt);
     }
 
+    template class BasicSignalModelEstimator<NsDefaultGeometry>;
+    template class BasicSignalModelEstimator<NsLowDelayGeometry>;
+    template class BasicSignalModelEstimator<NsHighEfficiencyGeometry>;
+
 }  // namespace webrtc
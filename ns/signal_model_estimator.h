@@ -15,20 +15,31 @@
 
 #include "array_view.h"
 #include "histograms.h"
+#include "noise_profile.h"
 #include "ns_common.h"
+#include "ns_state.h"
 #include "prior_signal_model.h"
 #include "prior_signal_model_estimator.h"
 #include "signal_model.h"
 
 namespace webrtc {
 
-    class SignalModelEstimator {
+// Estimator of the signal model, with the frame geometry |Geometry|, see
+// NsGeometry. Instantiated for the geometries in ns_common.h.
+    template<typename Geometry>
+    class BasicSignalModelEstimator {
     public:
-        SignalModelEstimator();
+        static constexpr size_t kFftSizeBy2Plus1 = Geometry::kFftSizeBy2Plus1;
+        static_assert(Geometry::kFeatureUpdateWindowSize <= Histograms::kMaxCount,
+                      "The histogram counts of a feature update window must fit "
+                      "in their 16 bits");
 
-        SignalModelEstimator(const SignalModelEstimator &) = delete;
+        BasicSignalModelEstimator();
 
-        SignalModelEstimator &operator=(const SignalModelEstimator &) = delete;
+        BasicSignalModelEstimator(const BasicSignalModelEstimator &) = delete;
+
+        BasicSignalModelEstimator &operator=(const BasicSignalModelEstimator &) =
+        delete;
 
         // Compute signal normalization during the initial startup phase.
         void AdjustNormalization(int32_t num_analyzed_frames, float signal_energy);
@@ -45,17 +56,41 @@ namespace webrtc {
             return prior_model_estimator_.get_prior_model();
         }
 
-        const SignalModel &get_model() { return features_; }
+        const BasicSignalModel<Geometry> &get_model() { return features_; }
+
+        // Sets the normalization and prior model to those of |profile|.
+        void Seed(const NoiseProfileParameters &profile);
+
+        // Stores the normalization and prior model in |profile|.
+        void GetProfile(NoiseProfileParameters *profile) const;
+
+        // Appends the adaptive state to |writer|.
+        void SaveState(NsStateWriter *writer) const;
+
+        // Restores a state appended by SaveState(). Returns false if |reader| runs
+        // out of data.
+        bool LoadState(NsStateReader *reader);
+
+        // The number of bytes appended by SaveState().
+        static constexpr size_t StateSize() {
+            return sizeof(diff_normalization_) + sizeof(signal_energy_sum_) +
+                   Histograms::StateSize() + sizeof(histogram_analysis_counter_) +
+                   PriorSignalModelEstimator::StateSize() + sizeof(features_.lrt) +
+                   sizeof(features_.spectral_diff) +
+                   sizeof(features_.spectral_flatness) + sizeof(features_.avg_log_lrt);
+        }
 
     private:
         float diff_normalization_ = 0.f;
         float signal_energy_sum_ = 0.f;
         Histograms histograms_;
-        int histogram_analysis_counter_ = 500;
+        int histogram_analysis_counter_;
         PriorSignalModelEstimator prior_model_estimator_;
-        SignalModel features_;
+        BasicSignalModel<Geometry> features_;
     };
 
+    using SignalModelEstimator = BasicSignalModelEstimator<NsDefaultGeometry>;
+
 }  // namespace webrtc
 
 #endif  // MODULES_AUDIO_PROCESSING_NS_SIGNAL_MODEL_ESTIMATOR_H_
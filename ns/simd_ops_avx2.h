@@ -0,0 +1,88 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_NS_SIMD_OPS_AVX2_H_
+#define MODULES_AUDIO_PROCESSING_NS_SIMD_OPS_AVX2_H_
+
+#include <stddef.h>
+
+#include <immintrin.h>
+
+namespace webrtc {
+
+// Wrappers of the AVX2 intrinsics used by the templated SIMD kernels. Must only
+// be included from the *_avx2.cc files, which are built with -mavx2.
+    struct Avx2Ops {
+        using V = __m256;
+        static constexpr size_t kWidth = 8;
+
+        static V Load(const float *p) { return _mm256_loadu_ps(p); }
+
+        static void Store(float *p, V v) { _mm256_storeu_ps(p, v); }
+
+        static V Set1(float x) { return _mm256_set1_ps(x); }
+
+        static V Add(V a, V b) { return _mm256_add_ps(a, b); }
+
+        static V Sub(V a, V b) { return _mm256_sub_ps(a, b); }
+
+        static V Mul(V a, V b) { return _mm256_mul_ps(a, b); }
+
+        static V Reverse(V v) {
+            return _mm256_permutevar8x32_ps(v, _mm256_set_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+        }
+
+        static void LoadDeinterleaved(const float *p, V *even, V *odd) {
+            const V a = _mm256_loadu_ps(p);
+            const V b = _mm256_loadu_ps(p + 8);
+            const V lo = _mm256_permute2f128_ps(a, b, 0x20);
+            const V hi = _mm256_permute2f128_ps(a, b, 0x31);
+            *even = _mm256_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0));
+            *odd = _mm256_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1));
+        }
+
+        static void StoreInterleaved(float *p, V even, V odd) {
+            const V lo = _mm256_unpacklo_ps(even, odd);
+            const V hi = _mm256_unpackhi_ps(even, odd);
+            _mm256_storeu_ps(p, _mm256_permute2f128_ps(lo, hi, 0x20));
+            _mm256_storeu_ps(p + 8, _mm256_permute2f128_ps(lo, hi, 0x31));
+        }
+
+        static void Transpose(V *rows) {
+            const V t0 = _mm256_unpacklo_ps(rows[0], rows[1]);
+            const V t1 = _mm256_unpackhi_ps(rows[0], rows[1]);
+            const V t2 = _mm256_unpacklo_ps(rows[2], rows[3]);
+            const V t3 = _mm256_unpackhi_ps(rows[2], rows[3]);
+            const V t4 = _mm256_unpacklo_ps(rows[4], rows[5]);
+            const V t5 = _mm256_unpackhi_ps(rows[4], rows[5]);
+            const V t6 = _mm256_unpacklo_ps(rows[6], rows[7]);
+            const V t7 = _mm256_unpackhi_ps(rows[6], rows[7]);
+            const V u0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+            const V u1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+            const V u2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+            const V u3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+            const V u4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+            const V u5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+            const V u6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+            const V u7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+            rows[0] = _mm256_permute2f128_ps(u0, u4, 0x20);
+            rows[1] = _mm256_permute2f128_ps(u1, u5, 0x20);
+            rows[2] = _mm256_permute2f128_ps(u2, u6, 0x20);
+            rows[3] = _mm256_permute2f128_ps(u3, u7, 0x20);
+            rows[4] = _mm256_permute2f128_ps(u0, u4, 0x31);
+            rows[5] = _mm256_permute2f128_ps(u1, u5, 0x31);
+            rows[6] = _mm256_permute2f128_ps(u2, u6, 0x31);
+            rows[7] = _mm256_permute2f128_ps(u3, u7, 0x31);
+        }
+    };
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_NS_SIMD_OPS_AVX2_H_
@@ -0,0 +1,106 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_NS_SIMD_OPS_NEON_H_
+#define MODULES_AUDIO_PROCESSING_NS_SIMD_OPS_NEON_H_
+
+#include <stddef.h>
+
+#include <arm_neon.h>
+
+#include "arch.h"
+
+namespace webrtc {
+
+// Wrappers of the NEON intrinsics used by the templated SIMD kernels. Must only
+// be included when WEBRTC_HAS_NEON is defined.
+    struct NeonOps {
+        using V = float32x4_t;
+        // Lane mask, with all bits set in the selected lanes.
+        using M = uint32x4_t;
+        static constexpr size_t kWidth = 4;
+
+        static V Load(const float *p) { return vld1q_f32(p); }
+
+        static void Store(float *p, V v) { vst1q_f32(p, v); }
+
+        static V Set1(float x) { return vdupq_n_f32(x); }
+
+        static V Add(V a, V b) { return vaddq_f32(a, b); }
+
+        static V Sub(V a, V b) { return vsubq_f32(a, b); }
+
+        static V Mul(V a, V b) { return vmulq_f32(a, b); }
+
+        static V Div(V a, V b) {
+#if defined(WEBRTC_ARCH_64_BITS)
+            return vdivq_f32(a, b);
+#else
+            // 32-bit NEON lacks vdivq_f32, and its reciprocal estimate is not
+            // exact, so the lanes are divided one at a time.
+            float x[4];
+            float y[4];
+            vst1q_f32(x, a);
+            vst1q_f32(y, b);
+            for (size_t k = 0; k < 4; ++k) {
+                x[k] /= y[k];
+            }
+            return vld1q_f32(x);
+#endif
+        }
+
+        static V Min(V a, V b) { return vminq_f32(a, b); }
+
+        static V Max(V a, V b) { return vmaxq_f32(a, b); }
+
+        static V Abs(V v) { return vabsq_f32(v); }
+
+        static M Greater(V a, V b) { return vcgtq_f32(a, b); }
+
+        static M Less(V a, V b) { return vcltq_f32(a, b); }
+
+        static M LoadMask(const int *p) {
+            return vreinterpretq_u32_s32(vnegq_s32(vld1q_s32(p)));
+        }
+
+        // Returns a in the lanes selected by |mask| and b in the others.
+        static V Select(M mask, V a, V b) { return vbslq_f32(mask, a, b); }
+
+        static V Reverse(V v) {
+            const V r = vrev64q_f32(v);
+            return vcombine_f32(vget_high_f32(r), vget_low_f32(r));
+        }
+
+        static void LoadDeinterleaved(const float *p, V *even, V *odd) {
+            const float32x4x2_t v = vld2q_f32(p);
+            *even = v.val[0];
+            *odd = v.val[1];
+        }
+
+        static void StoreInterleaved(float *p, V even, V odd) {
+            float32x4x2_t v;
+            v.val[0] = even;
+            v.val[1] = odd;
+            vst2q_f32(p, v);
+        }
+
+        static void Transpose(V *rows) {
+            const float32x4x2_t t01 = vtrnq_f32(rows[0], rows[1]);
+            const float32x4x2_t t23 = vtrnq_f32(rows[2], rows[3]);
+            rows[0] = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+            rows[1] = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+            rows[2] = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+            rows[3] = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+        }
+    };
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_NS_SIMD_OPS_NEON_H_
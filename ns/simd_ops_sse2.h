@@ -0,0 +1,89 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_NS_SIMD_OPS_SSE2_H_
+#define MODULES_AUDIO_PROCESSING_NS_SIMD_OPS_SSE2_H_
+
+#include <stddef.h>
+
+#include <emmintrin.h>
+
+namespace webrtc {
+
+// Wrappers of the SSE2 intrinsics used by the templated SIMD kernels. SSE2 is
+// part of the x86-64 baseline; 32-bit x86 files including this header are
+// built with -msse2.
+    struct Sse2Ops {
+        using V = __m128;
+        // Lane mask, with all bits set in the selected lanes.
+        using M = __m128;
+        static constexpr size_t kWidth = 4;
+
+        static V Load(const float *p) { return _mm_loadu_ps(p); }
+
+        static void Store(float *p, V v) { _mm_storeu_ps(p, v); }
+
+        static V Set1(float x) { return _mm_set1_ps(x); }
+
+        static V Add(V a, V b) { return _mm_add_ps(a, b); }
+
+        static V Sub(V a, V b) { return _mm_sub_ps(a, b); }
+
+        static V Mul(V a, V b) { return _mm_mul_ps(a, b); }
+
+        static V Div(V a, V b) { return _mm_div_ps(a, b); }
+
+        static V Min(V a, V b) { return _mm_min_ps(a, b); }
+
+        static V Max(V a, V b) { return _mm_max_ps(a, b); }
+
+        static V Abs(V v) {
+            return _mm_and_ps(v, _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff)));
+        }
+
+        static M Greater(V a, V b) { return _mm_cmpgt_ps(a, b); }
+
+        static M Less(V a, V b) { return _mm_cmplt_ps(a, b); }
+
+        static M LoadMask(const int *p) {
+            return _mm_castsi128_ps(_mm_sub_epi32(
+                    _mm_setzero_si128(),
+                    _mm_loadu_si128(reinterpret_cast<const __m128i *>(p))));
+        }
+
+        // Returns a in the lanes selected by |mask| and b in the others.
+        static V Select(M mask, V a, V b) {
+            return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+        }
+
+        static V Reverse(V v) {
+            return _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 1, 2, 3));
+        }
+
+        static void LoadDeinterleaved(const float *p, V *even, V *odd) {
+            const V a = _mm_loadu_ps(p);
+            const V b = _mm_loadu_ps(p + 4);
+            *even = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+            *odd = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+        }
+
+        static void StoreInterleaved(float *p, V even, V odd) {
+            _mm_storeu_ps(p, _mm_unpacklo_ps(even, odd));
+            _mm_storeu_ps(p + 4, _mm_unpackhi_ps(even, odd));
+        }
+
+        static void Transpose(V *rows) {
+            _MM_TRANSPOSE4_PS(rows[0], rows[1], rows[2], rows[3]);
+        }
+    };
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_NS_SIMD_OPS_SSE2_H_
@@ -18,9 +18,12 @@
 
 #include <memory>
 
+#include "aligned_malloc.h"
+#include "arch.h"
 #include "constructor_magic.h"
 #include "gtest_prod_util.h"
-#include "aligned_malloc.h"
+#include "ns_allocator.h"
+#include "ns_arena.h"
 
 namespace webrtc {
 
@@ -58,10 +61,17 @@ namespace webrtc {
         // of input / output sample rates.  |request_frames| controls the size in
         // frames of the buffer requested by each |read_cb| call.  The value must be
         // greater than kKernelSize.  Specify kDefaultRequestSize if there are no
-        // request size constraints.
+        // request size constraints.  If |allocator| is not null, the kernel and
+        // input buffers are allocated from it, which must then outlive the
+        // resampler.
         SincResampler(double io_sample_rate_ratio,
                       size_t request_frames,
-                      SincResamplerCallback *read_cb);
+                      SincResamplerCallback *read_cb,
+                      NsAllocator *allocator = nullptr);
+
+        // Adds the buffers of a SincResampler constructed with |request_frames|
+        // and an allocator to |layout|.
+        static void AddToLayout(NsArenaLayout *layout, size_t request_frames);
 
         virtual ~SincResampler();
 
@@ -97,10 +107,8 @@ namespace webrtc {
 
         void UpdateRegions(bool second_load);
 
-        // Selects runtime specific CPU features like SSE.  Must be called before
-        // using SincResampler.
-        // TODO(ajm): Currently managed by the class internally. See the note with
-        // |convolve_proc_| below.
+        // Selects runtime specific CPU features like SSE, AVX2 and AVX-512.  Must
+        // be called before using SincResampler.
         void InitializeCPUSpecificFeatures();
 
         // Compute convolution of |k1| and |k2| over |input_ptr|, resultant sums are
@@ -112,14 +120,26 @@ namespace webrtc {
                                 double kernel_interpolation_factor);
 
 #if defined(WEBRTC_ARCH_X86_FAMILY)
-        static float Convolve_SSE(const float* input_ptr,
-                                  const float* k1,
-                                  const float* k2,
+        static float Convolve_SSE(const float *input_ptr,
+                                  const float *k1,
+                                  const float *k2,
                                   double kernel_interpolation_factor);
+#if defined(WEBRTC_ENABLE_AVX2)
+        static float Convolve_AVX2(const float *input_ptr,
+                                   const float *k1,
+                                   const float *k2,
+                                   double kernel_interpolation_factor);
+#endif
+#if defined(WEBRTC_ENABLE_AVX512)
+        static float Convolve_AVX512(const float *input_ptr,
+                                     const float *k1,
+                                     const float *k2,
+                                     double kernel_interpolation_factor);
+#endif
 #elif defined(WEBRTC_HAS_NEON)
-        static float Convolve_NEON(const float* input_ptr,
-                                   const float* k1,
-                                   const float* k2,
+        static float Convolve_NEON(const float *input_ptr,
+                                   const float *k1,
+                                   const float *k2,
                                    double kernel_interpolation_factor);
 #endif
 
@@ -148,24 +168,19 @@ namespace webrtc {
         // Contains kKernelOffsetCount kernels back-to-back, each of size kKernelSize.
         // The kernel offsets are sub-sample shifts of a windowed sinc shifted from
         // 0.0 to 1.0 sample.
-        std::unique_ptr<float[], AlignedFreeDeleter> kernel_storage_;
-        std::unique_ptr<float[], AlignedFreeDeleter> kernel_pre_sinc_storage_;
-        std::unique_ptr<float[], AlignedFreeDeleter> kernel_window_storage_;
+        NsAlignedArray<float> kernel_storage_;
+        NsAlignedArray<float> kernel_pre_sinc_storage_;
+        NsAlignedArray<float> kernel_window_storage_;
 
         // Data from the source is copied into this buffer for each processing pass.
-        std::unique_ptr<float[], AlignedFreeDeleter> input_buffer_;
-
-// Stores the runtime selection of which Convolve function to use.
-// TODO(ajm): Move to using a global static which must only be initialized
-// once by the user. We're not doing this initially, because we don't have
-// e.g. a LazyInstance helper in webrtc.
-#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(__SSE2__)
-        typedef float (*ConvolveProc)(const float*,
-                                      const float*,
-                                      const float*,
+        NsAlignedArray<float> input_buffer_;
+
+        // Stores the runtime selection of which Convolve function to use.
+        typedef float (*ConvolveProc)(const float *,
+                                      const float *,
+                                      const float *,
                                       double);
         ConvolveProc convolve_proc_;
-#endif
 
         // Pointers to the various regions inside |input_buffer_|.  See the diagram at
         // the top of the .cc file for more information.
@@ -0,0 +1,64 @@
+/*
+ *  Copyright (c) 2013 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// AVX-512 implementation of the convolution in SincResampler.
+
+#include "sinc_resampler.h"
+
+#if defined(WEBRTC_ARCH_X86_FAMILY) && defined(WEBRTC_ENABLE_AVX512)
+
+#include <immintrin.h>
+
+namespace webrtc {
+
+    float SincResampler::Convolve_AVX512(const float *input_ptr,
+                                         const float *k1,
+                                         const float *k2,
+                                         double kernel_interpolation_factor) {
+        static_assert(kKernelSize == 32, "The loop below assumes 32 taps.");
+
+        // The 32 taps fit in two registers. The input is generally unaligned, while
+        // the kernels are 64-byte aligned.
+        const __m512 m_input_lo = _mm512_loadu_ps(input_ptr);
+        const __m512 m_input_hi = _mm512_loadu_ps(input_ptr + 16);
+        __m512 m_sums1 = _mm512_mul_ps(m_input_lo, _mm512_load_ps(k1));
+        __m512 m_sums2 = _mm512_mul_ps(m_input_lo, _mm512_load_ps(k2));
+        m_sums1 = _mm512_fmadd_ps(m_input_hi, _mm512_load_ps(k1 + 16), m_sums1);
+        m_sums2 = _mm512_fmadd_ps(m_input_hi, _mm512_load_ps(k2 + 16), m_sums2);
+
+        // Linearly interpolate the two "convolutions".
+        const __m512 m_interpolated = _mm512_fmadd_ps(
+                m_sums2, _mm512_set1_ps(static_cast<float>(kernel_interpolation_factor)),
+                _mm512_mul_ps(m_sums1, _mm512_set1_ps(static_cast<float>(
+                        1.0 - kernel_interpolation_factor))));
+
+        // Sum components together. The halves are taken with masked extractions
+        // into zeros rather than with _mm512_reduce_add_ps or
+        // _mm512_castps512_ps256, whose unmasked extractions read an undefined
+        // register, which GCC reports as used uninitialized.
+        const __m512d m_interpolated_pd = _mm512_castps_pd(m_interpolated);
+        const __m256 m256_sums = _mm256_add_ps(
+                _mm256_castpd_ps(_mm512_mask_extractf64x4_pd(
+                        _mm256_setzero_pd(), 0xff, m_interpolated_pd, 0)),
+                _mm256_castpd_ps(_mm512_mask_extractf64x4_pd(
+                        _mm256_setzero_pd(), 0xff, m_interpolated_pd, 1)));
+        __m128 m128_sums = _mm_add_ps(_mm256_castps256_ps128(m256_sums),
+                                      _mm256_extractf128_ps(m256_sums, 1));
+        float result;
+        m128_sums = _mm_add_ps(_mm_movehl_ps(m128_sums, m128_sums), m128_sums);
+        _mm_store_ss(&result, _mm_add_ss(m128_sums,
+                                         _mm_shuffle_ps(m128_sums, m128_sums, 1)));
+
+        return result;
+    }
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_ARCH_X86_FAMILY && WEBRTC_ENABLE_AVX512
@@ -0,0 +1,91 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "sinc_resampler.h"
+
+#include <string.h>
+
+#include <utility>
+#include <vector>
+
+#include "cpu_features_wrapper.h"
+#include "gtest/gtest.h"
+
+namespace webrtc {
+    namespace {
+
+        constexpr double kSampleRateRatio = 192000.0 / 44100.0;
+        constexpr double kKernelInterpolationFactor = 0.5;
+
+        class ZeroSource : public SincResamplerCallback {
+        public:
+            void Run(size_t frames, float *destination) override {
+                memset(destination, 0, sizeof(*destination) * frames);
+            }
+        };
+
+    }  // namespace
+
+// Verifies the optimized Convolve methods that are compiled in and supported by
+// the CPU against Convolve_C(), for aligned and unaligned input and for all
+// kernel offsets.
+    TEST(SincResamplerTest, Convolve) {
+        ZeroSource source;
+        SincResampler resampler(kSampleRateRatio, SincResampler::kDefaultRequestSize,
+                                &source);
+
+        using ConvolveProc = float (*)(const float *, const float *, const float *,
+                                       double);
+        std::vector<std::pair<const char *, ConvolveProc>> convolve_procs;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+        if (WebRtc_GetCPUInfo(kSSE2)) {
+            convolve_procs.emplace_back("SSE", SincResampler::Convolve_SSE);
+        }
+#if defined(WEBRTC_ENABLE_AVX2)
+        if (WebRtc_GetCPUInfo(kAVX2)) {
+            convolve_procs.emplace_back("AVX2", SincResampler::Convolve_AVX2);
+        }
+#endif
+#if defined(WEBRTC_ENABLE_AVX512)
+        if (WebRtc_GetCPUInfo(kAVX512)) {
+            convolve_procs.emplace_back("AVX512", SincResampler::Convolve_AVX512);
+        }
+#endif
+#elif defined(WEBRTC_HAS_NEON)
+        convolve_procs.emplace_back("NEON", SincResampler::Convolve_NEON);
+#endif
+
+        // The optimized methods sum in a different order than Convolve_C() and may
+        // fuse multiply-adds, so the comparison is done with an epsilon.
+        constexpr double kEpsilon = 0.00000005;
+
+        // Use the kernels of the resampler as input and kernel data, which are
+        // properly sized and aligned.
+        const float *kernels = resampler.kernel_storage_.get();
+        for (const auto &convolve_proc : convolve_procs) {
+            SCOPED_TRACE(convolve_proc.first);
+            for (size_t offset = 0; offset < SincResampler::kKernelOffsetCount;
+                 ++offset) {
+                SCOPED_TRACE(offset);
+                const float *k1 = kernels + offset * SincResampler::kKernelSize;
+                const float *k2 = k1 + SincResampler::kKernelSize;
+                for (size_t misalignment : {0, 1}) {
+                    const float *input = kernels + misalignment;
+                    const double result = SincResampler::Convolve_C(
+                            input, k1, k2, kKernelInterpolationFactor);
+                    const double result2 = convolve_proc.second(
+                            input, k1, k2, kKernelInterpolationFactor);
+                    EXPECT_NEAR(result2, result, kEpsilon);
+                }
+            }
+        }
+    }
+
+}  // namespace webrtc
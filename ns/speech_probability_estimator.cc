@@ -18,11 +18,13 @@
 
 namespace webrtc {
 
-    SpeechProbabilityEstimator::SpeechProbabilityEstimator() {
+    template<typename Geometry>
+    BasicSpeechProbabilityEstimator<Geometry>::BasicSpeechProbabilityEstimator() {
         speech_probability_.fill(0.f);
     }
 
-    void SpeechProbabilityEstimator::Update(
+    template<typename Geometry>
+    void BasicSpeechProbabilityEstimator<Geometry>::Update(
             int32_t num_analyzed_frames,
             rtc::ArrayView<const float, kFftSizeBy2Plus1> prior_snr,
             rtc::ArrayView<const float, kFftSizeBy2Plus1> post_snr,
@@ -31,7 +33,7 @@ namespace webrtc {
             float signal_spectral_sum,
             float signal_energy) {
         // Update models.
-        if (num_analyzed_frames < kLongStartupPhaseBlocks) {
+        if (num_analyzed_frames < Geometry::kLongStartupPhaseBlocks) {
             signal_model_estimator_.AdjustNormalization(num_analyzed_frames,
                                                         signal_energy);
         }
@@ -39,7 +41,8 @@ namespace webrtc {
                                        conservative_noise_spectrum, signal_spectrum,
                                        signal_spectral_sum, signal_energy);
 
-        const SignalModel &model = signal_model_estimator_.get_model();
+        const BasicSignalModel<Geometry> &model =
+                signal_model_estimator_.get_model();
         const PriorSignalModel &prior_model =
                 signal_model_estimator_.get_prior_model();
 
@@ -53,7 +56,8 @@ namespace webrtc {
 
         // Compute indicator function: sigmoid map.
         float indicator0 =
-                0.5f * (tanh(width_prior * (model.lrt - prior_model.lrt)) + 1.f);
+                0.5f * (TanhApproximation(width_prior * (model.lrt - prior_model.lrt)) +
+                         1.f);
 
         // Spectral flatness feature: use larger width in tanh map for pause regions.
         width_prior = model.spectral_flatness > prior_model.flatness_threshold
@@ -62,8 +66,9 @@ namespace webrtc {
 
         // Compute indicator function: sigmoid map.
         float indicator1 =
-                0.5f * (tanh(1.f * width_prior *
-                             (prior_model.flatness_threshold - model.spectral_flatness)) +
+                0.5f * (TanhApproximation(1.f * width_prior *
+                                          (prior_model.flatness_threshold -
+                                           model.spectral_flatness)) +
                         1.f);
 
         // For template spectrum-difference : use larger width in tanh map for pause
@@ -74,8 +79,9 @@ namespace webrtc {
 
         // Compute indicator function: sigmoid map.
         float indicator2 =
-                0.5f * (tanh(width_prior * (model.spectral_diff -
-                                            prior_model.template_diff_threshold)) +
+                0.5f * (TanhApproximation(width_prior *
+                                          (model.spectral_diff -
+                                           prior_model.template_diff_threshold)) +
                         1.f);
 
         // Combine the indicator function with the feature weights.
@@ -93,11 +99,30 @@ namespace webrtc {
         float gain_prior =
                 (1.f - prior_speech_prob_) / (prior_speech_prob_ + 0.0001f);
 
-        std::array<float, kFftSizeBy2Plus1> inv_lrt{};
+        std::array<float, kFftSizeBy2Plus1> inv_lrt;
         ExpApproximationSignFlip(model.avg_log_lrt, inv_lrt);
         for (size_t i = 0; i < kFftSizeBy2Plus1; ++i) {
             speech_probability_[i] = 1.f / (1.f + gain_prior * inv_lrt[i]);
         }
     }
 
+    template<typename Geometry>
+    void BasicSpeechProbabilityEstimator<Geometry>::SaveState(
+            NsStateWriter *writer) const {
+        signal_model_estimator_.SaveState(writer);
+        writer->Write(prior_speech_prob_);
+        writer->Write(speech_probability_);
+    }
+
+    template<typename Geometry>
+    bool BasicSpeechProbabilityEstimator<Geometry>::LoadState(
+            NsStateReader *reader) {
+        return signal_model_estimator_.LoadState(reader) &&
+               reader->Read(&prior_speech_prob_) && reader->Read(&speech_probability_);
+    }
+
+    template class BasicSpeechProbabilityEstimator<NsDefaultGeometry>;
+    template class BasicSpeechProbabilityEstimator<NsLowDelayGeometry>;
+    template class BasicSpeechProbabilityEstimator<NsHighEfficiencyGeometry>;
+
 }  // namespace webrtc
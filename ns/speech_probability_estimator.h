@@ -15,20 +15,26 @@
 
 #include "array_view.h"
 #include "ns_common.h"
+#include "ns_state.h"
 #include "signal_model_estimator.h"
 
 namespace webrtc {
 
-// Class for estimating the probability of speech.
-    class SpeechProbabilityEstimator {
+// Class for estimating the probability of speech, with the frame geometry
+// |Geometry|, see NsGeometry. Instantiated for the geometries in ns_common.h.
+    template<typename Geometry>
+    class BasicSpeechProbabilityEstimator {
     public:
-        SpeechProbabilityEstimator();
+        static constexpr size_t kFftSizeBy2Plus1 = Geometry::kFftSizeBy2Plus1;
 
-        SpeechProbabilityEstimator(const SpeechProbabilityEstimator &) = delete;
+        BasicSpeechProbabilityEstimator();
 
-        SpeechProbabilityEstimator &operator=(const SpeechProbabilityEstimator &) =
+        BasicSpeechProbabilityEstimator(const BasicSpeechProbabilityEstimator &) =
         delete;
 
+        BasicSpeechProbabilityEstimator &operator=(
+                const BasicSpeechProbabilityEstimator &) = delete;
+
         // Compute speech probability.
         void Update(
                 int32_t num_analyzed_frames,
@@ -43,12 +49,38 @@ namespace webrtc {
 
         rtc::ArrayView<const float> get_probability() { return speech_probability_; }
 
+        // Sets the signal model parameters to those of |profile|.
+        void Seed(const NoiseProfileParameters &profile) {
+            signal_model_estimator_.Seed(profile);
+        }
+
+        // Stores the signal model parameters in |profile|.
+        void GetProfile(NoiseProfileParameters *profile) const {
+            signal_model_estimator_.GetProfile(profile);
+        }
+
+        // Appends the adaptive state to |writer|.
+        void SaveState(NsStateWriter *writer) const;
+
+        // Restores a state appended by SaveState(). Returns false if |reader| runs
+        // out of data.
+        bool LoadState(NsStateReader *reader);
+
+        // The number of bytes appended by SaveState().
+        static constexpr size_t StateSize() {
+            return BasicSignalModelEstimator<Geometry>::StateSize() +
+                   sizeof(prior_speech_prob_) + sizeof(speech_probability_);
+        }
+
     private:
-        SignalModelEstimator signal_model_estimator_;
+        BasicSignalModelEstimator<Geometry> signal_model_estimator_;
         float prior_speech_prob_ = .5f;
         std::array<float, kFftSizeBy2Plus1> speech_probability_{};
     };
 
+    using SpeechProbabilityEstimator =
+    BasicSpeechProbabilityEstimator<NsDefaultGeometry>;
+
 }  // namespace webrtc
 
 #endif  // MODULES_AUDIO_PROCESSING_NS_SPEECH_PROBABILITY_ESTIMATOR_H_
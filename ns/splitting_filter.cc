@@ -10,6 +10,7 @@
 
 #include "splitting_filter.h"
 
+#include <algorithm>
 #include <array>
 
 #include "array_view.h"
@@ -22,17 +23,81 @@ namespace webrtc {
         constexpr size_t kSamplesPerBand = 160;
         constexpr size_t kTwoBandFilterSamplesPerFrame = 320;
 
+        // The all-pass coefficients of splitting_filter.c, converted from Q16.
+        constexpr std::array<float, 3> kAllPassFilter1 = {
+                6418.f / 65536.f, 36982.f / 65536.f, 57261.f / 65536.f};
+        constexpr std::array<float, 3> kAllPassFilter2 = {
+                21333.f / 65536.f, 49062.f / 65536.f, 63010.f / 65536.f};
+
+        template<size_t kNumLanes>
+        using LaneFrame = std::array<std::array<float, kNumLanes>, kSamplesPerBand>;
+
+        // Filters the signals of kNumLanes channels in-place with a cascade of three
+        // first order all-pass filters,
+        //   y[n] = x[n-1] + a * (x[n] - y[n-1]).
+        // The state holds x[-1] and y[-1] of each cascade, indexed as [state][lane].
+        // The recursion runs over time, so the lanes are the vectorized dimension.
+        template<size_t kNumLanes>
+        void AllPassQmfLanes(const std::array<float, 3> &coefficients,
+                             LaneFrame<kNumLanes> *data,
+                             std::array<std::array<float, kNumLanes>, 6> *state) {
+            for (size_t c = 0; c < 3; ++c) {
+                const float a = coefficients[c];
+                std::array<float, kNumLanes> x_prev = (*state)[2 * c];
+                std::array<float, kNumLanes> y_prev = (*state)[2 * c + 1];
+                for (size_t n = 0; n < kSamplesPerBand; ++n) {
+                    std::array<float, kNumLanes> &x = (*data)[n];
+                    for (size_t l = 0; l < kNumLanes; ++l) {
+                        const float y = x_prev[l] + a * (x[l] - y_prev[l]);
+                        x_prev[l] = x[l];
+                        y_prev[l] = y;
+                        x[l] = y;
+                    }
+                }
+                (*state)[2 * c] = x_prev;
+                (*state)[2 * c + 1] = y_prev;
+            }
+        }
+
     }  // namespace
 
     SplittingFilter::SplittingFilter(size_t num_channels,
                                      size_t num_bands,
-                                     size_t num_frames)
+                                     size_t /* num_frames */,
+                                     TwoBandsFilterMode two_bands_mode,
+                                     NsAllocator *allocator)
             : num_bands_(num_bands),
-              two_bands_states_(num_bands_ == 2 ? num_channels : 0),
-              three_band_filter_banks_(num_bands_ == 3 ? num_channels : 0) {
+              two_bands_mode_(two_bands_mode),
+              two_bands_states_(
+                      num_bands_ == 2 && two_bands_mode == TwoBandsFilterMode::kFixedPoint
+                      ? num_channels
+                      : 0,
+                      allocator),
+              two_bands_float_states_(
+                      num_bands_ == 2 && two_bands_mode == TwoBandsFilterMode::kFloat
+                      ? (num_channels + kNumQmfLanes - 1) / kNumQmfLanes
+                      : 0,
+                      allocator),
+              three_band_filter_banks_(num_bands_ == 3 ? num_channels : 0,
+                                       allocator) {
         RTC_CHECK(num_bands_ == 2 || num_bands_ == 3);
     }
 
+    void SplittingFilter::AddToLayout(NsArenaLayout *layout,
+                                      size_t num_channels,
+                                      size_t num_bands,
+                                      TwoBandsFilterMode two_bands_mode) {
+        layout->AddVector<TwoBandsStates>(
+                num_bands == 2 && two_bands_mode == TwoBandsFilterMode::kFixedPoint
+                ? num_channels
+                : 0);
+        layout->AddVector<TwoBandsFloatStates>(
+                num_bands == 2 && two_bands_mode == TwoBandsFilterMode::kFloat
+                ? (num_channels + kNumQmfLanes - 1) / kNumQmfLanes
+                : 0);
+        layout->AddVector<ThreeBandFilterBank>(num_bands == 3 ? num_channels : 0);
+    }
+
     SplittingFilter::~SplittingFilter() = default;
 
     void SplittingFilter::Analysis(const ChannelBuffer<float> *data,
@@ -42,7 +107,11 @@ namespace webrtc {
         RTC_DCHECK_EQ(data->num_frames(),
                       bands->num_frames_per_band() * bands->num_bands());
         if (bands->num_bands() == 2) {
-            TwoBandsAnalysis(data, bands);
+            if (two_bands_mode_ == TwoBandsFilterMode::kFloat) {
+                TwoBandsFloatAnalysis(data, bands);
+            } else {
+                TwoBandsAnalysis(data, bands);
+            }
         } else if (bands->num_bands() == 3) {
             ThreeBandsAnalysis(data, bands);
         }
@@ -55,7 +124,11 @@ namespace webrtc {
         RTC_DCHECK_EQ(data->num_frames(),
                       bands->num_frames_per_band() * bands->num_bands());
         if (bands->num_bands() == 2) {
-            TwoBandsSynthesis(bands, data);
+            if (two_bands_mode_ == TwoBandsFilterMode::kFloat) {
+                TwoBandsFloatSynthesis(bands, data);
+            } else {
+                TwoBandsSynthesis(bands, data);
+            }
         } else if (bands->num_bands() == 3) {
             ThreeBandsSynthesis(bands, data);
         }
@@ -96,6 +169,83 @@ namespace webrtc {
         }
     }
 
+    void SplittingFilter::TwoBandsFloatAnalysis(const ChannelBuffer<float> *data,
+                                                ChannelBuffer<float> *bands) {
+        RTC_DCHECK_EQ(two_bands_float_states_.size(),
+                      (data->num_channels() + kNumQmfLanes - 1) / kNumQmfLanes);
+        RTC_DCHECK_EQ(data->num_frames(), kTwoBandFilterSamplesPerFrame);
+
+        for (size_t g = 0; g < two_bands_float_states_.size(); ++g) {
+            const size_t first_channel = g * kNumQmfLanes;
+            const size_t num_lanes =
+                    std::min(kNumQmfLanes, data->num_channels() - first_channel);
+
+            // Split the even and odd samples of each channel into lanes.
+            LaneFrame<kNumQmfLanes> even{};
+            LaneFrame<kNumQmfLanes> odd{};
+            for (size_t l = 0; l < num_lanes; ++l) {
+                const float *in = data->channels(0)[first_channel + l];
+                for (size_t n = 0; n < kSamplesPerBand; ++n) {
+                    even[n][l] = in[2 * n];
+                    odd[n][l] = in[2 * n + 1];
+                }
+            }
+
+            TwoBandsFloatStates &states = two_bands_float_states_[g];
+            AllPassQmfLanes(kAllPassFilter1, &odd, &states.analysis_state1);
+            AllPassQmfLanes(kAllPassFilter2, &even, &states.analysis_state2);
+
+            // The sum and difference of the filtered branches form the lower and
+            // upper bands.
+            for (size_t l = 0; l < num_lanes; ++l) {
+                float *low_band = bands->channels(0)[first_channel + l];
+                float *high_band = bands->channels(1)[first_channel + l];
+                for (size_t n = 0; n < kSamplesPerBand; ++n) {
+                    low_band[n] = 0.5f * (odd[n][l] + even[n][l]);
+                    high_band[n] = 0.5f * (odd[n][l] - even[n][l]);
+                }
+            }
+        }
+    }
+
+    void SplittingFilter::TwoBandsFloatSynthesis(const ChannelBuffer<float> *bands,
+                                                 ChannelBuffer<float> *data) {
+        RTC_DCHECK_LE((data->num_channels() + kNumQmfLanes - 1) / kNumQmfLanes,
+                      two_bands_float_states_.size());
+        RTC_DCHECK_EQ(data->num_frames(), kTwoBandFilterSamplesPerFrame);
+
+        for (size_t first_channel = 0, g = 0; first_channel < data->num_channels();
+             first_channel += kNumQmfLanes, ++g) {
+            const size_t num_lanes =
+                    std::min(kNumQmfLanes, data->num_channels() - first_channel);
+
+            // Form the sum and difference of the bands.
+            LaneFrame<kNumQmfLanes> sum{};
+            LaneFrame<kNumQmfLanes> difference{};
+            for (size_t l = 0; l < num_lanes; ++l) {
+                const float *low_band = bands->channels(0)[first_channel + l];
+                const float *high_band = bands->channels(1)[first_channel + l];
+                for (size_t n = 0; n < kSamplesPerBand; ++n) {
+                    sum[n][l] = low_band[n] + high_band[n];
+                    difference[n][l] = low_band[n] - high_band[n];
+                }
+            }
+
+            TwoBandsFloatStates &states = two_bands_float_states_[g];
+            AllPassQmfLanes(kAllPassFilter2, &sum, &states.synthesis_state1);
+            AllPassQmfLanes(kAllPassFilter1, &difference, &states.synthesis_state2);
+
+            // The filtered signals are the even and odd output samples.
+            for (size_t l = 0; l < num_lanes; ++l) {
+                float *out = data->channels(0)[first_channel + l];
+                for (size_t n = 0; n < kSamplesPerBand; ++n) {
+                    out[2 * n] = difference[n][l];
+                    out[2 * n + 1] = sum[n][l];
+                }
+            }
+        }
+    }
+
     void SplittingFilter::ThreeBandsAnalysis(const ChannelBuffer<float> *data,
                                              ChannelBuffer<float> *bands) {
         RTC_DCHECK_EQ(three_band_filter_banks_.size(), data->num_channels());
@@ -11,11 +11,14 @@
 #ifndef MODULES_AUDIO_PROCESSING_SPLITTING_FILTER_H_
 #define MODULES_AUDIO_PROCESSING_SPLITTING_FILTER_H_
 
+#include <array>
 #include <cstring>
 #include <memory>
 #include <vector>
 
 #include "channel_buffer.h"
+#include "ns_allocator.h"
+#include "ns_arena.h"
 #include "three_band_filter_bank.h"
 
 #ifdef __cplusplus
@@ -54,6 +57,21 @@ namespace webrtc {
         int synthesis_state2[kStateSize]{};
     };
 
+// Implementation used for the 2-band split at 32 kHz. kFixedPoint runs the
+// int16 all-pass QMF of splitting_filter.c. kFloat runs the same all-pass QMF in
+// floating point, which avoids the int16 conversions and their saturation, and
+// processes the channels in parallel lanes.
+    enum class TwoBandsFilterMode {
+        kFixedPoint, kFloat
+    };
+
+// Delays, in full band samples, of Analysis() followed by Synthesis() for 2 and
+// 3 bands. They are the positions of the main taps of the impulse responses,
+// which are the same for every position of the impulse within the block and
+// for both TwoBandsFilterModes.
+    constexpr size_t kTwoBandsDelay = 4;
+    constexpr size_t kThreeBandsDelay = 46;
+
 // Splitting filter which is able to split into and merge from 2 or 3 frequency
 // bands. The number of channels needs to be provided at construction time.
 //
@@ -63,7 +81,20 @@ namespace webrtc {
 // used.
     class SplittingFilter {
     public:
-        SplittingFilter(size_t num_channels, size_t num_bands, size_t num_frames);
+        // If |allocator| is not null, the filter states are allocated from it.
+        SplittingFilter(size_t num_channels,
+                        size_t num_bands,
+                        size_t num_frames,
+                        TwoBandsFilterMode two_bands_mode = TwoBandsFilterMode::kFixedPoint,
+                        NsAllocator *allocator = nullptr);
+
+        // Adds the filter states of a SplittingFilter constructed with the same
+        // arguments and an allocator to |layout|.
+        static void AddToLayout(NsArenaLayout *layout,
+                                size_t num_channels,
+                                size_t num_bands,
+                                TwoBandsFilterMode two_bands_mode =
+                                TwoBandsFilterMode::kFixedPoint);
 
         ~SplittingFilter();
 
@@ -72,6 +103,19 @@ namespace webrtc {
         void Synthesis(const ChannelBuffer<float> *bands, ChannelBuffer<float> *data);
 
     private:
+        static constexpr size_t kNumQmfLanes = 4;
+        using QmfLaneArray = std::array<float, kNumQmfLanes>;
+
+        // Floating point all-pass filter states of kNumQmfLanes channels, indexed
+        // as [state][lane].
+        struct TwoBandsFloatStates {
+            static const int kStateSize = 6;
+            std::array<QmfLaneArray, kStateSize> analysis_state1{};
+            std::array<QmfLaneArray, kStateSize> analysis_state2{};
+            std::array<QmfLaneArray, kStateSize> synthesis_state1{};
+            std::array<QmfLaneArray, kStateSize> synthesis_state2{};
+        };
+
         // Two-band analysis and synthesis work for 640 samples or less.
         void TwoBandsAnalysis(const ChannelBuffer<float> *data,
                               ChannelBuffer<float> *bands);
@@ -79,6 +123,12 @@ namespace webrtc {
         void TwoBandsSynthesis(const ChannelBuffer<float> *bands,
                                ChannelBuffer<float> *data);
 
+        void TwoBandsFloatAnalysis(const ChannelBuffer<float> *data,
+                                   ChannelBuffer<float> *bands);
+
+        void TwoBandsFloatSynthesis(const ChannelBuffer<float> *bands,
+                                    ChannelBuffer<float> *data);
+
         void ThreeBandsAnalysis(const ChannelBuffer<float> *data,
                                 ChannelBuffer<float> *bands);
 
@@ -86,8 +136,10 @@ namespace webrtc {
                                  ChannelBuffer<float> *data);
 
         const size_t num_bands_;
-        std::vector<TwoBandsStates> two_bands_states_;
-        std::vector<ThreeBandFilterBank> three_band_filter_banks_;
+        const TwoBandsFilterMode two_bands_mode_;
+        NsVector<TwoBandsStates> two_bands_states_;
+        NsVector<TwoBandsFloatStates> two_bands_float_states_;
+        NsVector<ThreeBandFilterBank> three_band_filter_banks_;
     };
 
 }  // namespace webrtc
@@ -0,0 +1,142 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "splitting_filter.h"
+
+#include <math.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace webrtc {
+    namespace {
+
+        constexpr size_t kSamplesPer32kHzChannel = 320;
+        // Not a multiple of the number of lanes of the float QMF.
+        constexpr size_t kNumChannels = 6;
+        constexpr int kNumFrames = 100;
+
+        // Fills |data| with a tone in each band and noise, with a peak level of
+        // |amplitude|.
+        void GenerateFrame(int frame, float amplitude, uint32_t *seed,
+                           ChannelBuffer<float> *data) {
+            for (size_t ch = 0; ch < data->num_channels(); ++ch) {
+                for (size_t n = 0; n < kSamplesPer32kHzChannel; ++n) {
+                    const float t = static_cast<float>(frame * kSamplesPer32kHzChannel + n);
+                    *seed = *seed * 1664525u + 1013904223u;
+                    const float noise = static_cast<int>(*seed >> 16) / 32768.f - 1.f;
+                    data->channels()[ch][n] =
+                            amplitude * (0.4f * sinf(0.05f * (ch + 1) * t) +
+                                         0.4f * sinf(2.5f + 0.1f * ch * t) + 0.2f * noise);
+                }
+            }
+        }
+
+        class SnrMeter {
+        public:
+            void Add(const float *reference, const float *x, size_t size) {
+                for (size_t k = 0; k < size; ++k) {
+                    signal_ += reference[k] * reference[k];
+                    error_ += (x[k] - reference[k]) * (x[k] - reference[k]);
+                }
+            }
+
+            double SnrDb() const { return 10. * log10(signal_ / error_); }
+
+        private:
+            double signal_ = 0.;
+            double error_ = 0.;
+        };
+
+    }  // namespace
+
+// Verifies the bands and the split and merged output of the float QMF against
+// WebRtcSpl_AnalysisQMF and WebRtcSpl_SynthesisQMF, whose int16 rounding bounds
+// the SNR.
+    TEST(SplittingFilterTest, FloatQmfMatchesFixedPointQmf) {
+        SplittingFilter fixed_point_filter(kNumChannels, 2, kSamplesPer32kHzChannel,
+                                           TwoBandsFilterMode::kFixedPoint);
+        SplittingFilter float_filter(kNumChannels, 2, kSamplesPer32kHzChannel,
+                                     TwoBandsFilterMode::kFloat);
+        ChannelBuffer<float> in(kSamplesPer32kHzChannel, kNumChannels);
+        ChannelBuffer<float> fixed_point_bands(kSamplesPer32kHzChannel, kNumChannels, 2);
+        ChannelBuffer<float> float_bands(kSamplesPer32kHzChannel, kNumChannels, 2);
+        ChannelBuffer<float> fixed_point_out(kSamplesPer32kHzChannel, kNumChannels);
+        ChannelBuffer<float> float_out(kSamplesPer32kHzChannel, kNumChannels);
+
+        SnrMeter bands_snr;
+        SnrMeter out_snr;
+        uint32_t seed = 1;
+        for (int frame = 0; frame < kNumFrames; ++frame) {
+            GenerateFrame(frame, 16000.f, &seed, &in);
+            fixed_point_filter.Analysis(&in, &fixed_point_bands);
+            float_filter.Analysis(&in, &float_bands);
+            fixed_point_filter.Synthesis(&fixed_point_bands, &fixed_point_out);
+            float_filter.Synthesis(&float_bands, &float_out);
+            for (size_t ch = 0; ch < kNumChannels; ++ch) {
+                for (size_t band = 0; band < 2; ++band) {
+                    bands_snr.Add(fixed_point_bands.bands(ch)[band],
+                                  float_bands.bands(ch)[band],
+                                  fixed_point_bands.num_frames_per_band());
+                }
+                out_snr.Add(fixed_point_out.channels()[ch], float_out.channels()[ch],
+                            kSamplesPer32kHzChannel);
+            }
+        }
+        EXPECT_GE(bands_snr.SnrDb(), 78.);
+        EXPECT_GE(out_snr.SnrDb(), 78.);
+    }
+
+// Verifies that the float QMF is linear for input beyond the int16 range, by
+// comparing the output for loud input with the scaled output for the same
+// input at a quarter of the level. The fixed point QMF saturates the loud input.
+    TEST(SplittingFilterTest, FloatQmfDoesNotSaturate) {
+        for (TwoBandsFilterMode mode :
+                {TwoBandsFilterMode::kFixedPoint, TwoBandsFilterMode::kFloat}) {
+            SCOPED_TRACE(static_cast<int>(mode));
+            SplittingFilter quiet_filter(kNumChannels, 2, kSamplesPer32kHzChannel, mode);
+            SplittingFilter loud_filter(kNumChannels, 2, kSamplesPer32kHzChannel, mode);
+            ChannelBuffer<float> in(kSamplesPer32kHzChannel, kNumChannels);
+            ChannelBuffer<float> bands(kSamplesPer32kHzChannel, kNumChannels, 2);
+            ChannelBuffer<float> quiet_out(kSamplesPer32kHzChannel, kNumChannels);
+            ChannelBuffer<float> loud_out(kSamplesPer32kHzChannel, kNumChannels);
+
+            SnrMeter snr;
+            uint32_t quiet_seed = 1;
+            uint32_t loud_seed = 1;
+            for (int frame = 0; frame < kNumFrames; ++frame) {
+                GenerateFrame(frame, 16000.f, &quiet_seed, &in);
+                quiet_filter.Analysis(&in, &bands);
+                quiet_filter.Synthesis(&bands, &quiet_out);
+                GenerateFrame(frame, 64000.f, &loud_seed, &in);
+                loud_filter.Analysis(&in, &bands);
+                loud_filter.Synthesis(&bands, &loud_out);
+                for (size_t ch = 0; ch < kNumChannels; ++ch) {
+                    std::vector<float> scaled_quiet_out(
+                            quiet_out.channels()[ch],
+                            quiet_out.channels()[ch] + kSamplesPer32kHzChannel);
+                    for (float &v : scaled_quiet_out) {
+                        v *= 4.f;
+                    }
+                    snr.Add(scaled_quiet_out.data(), loud_out.channels()[ch],
+                            kSamplesPer32kHzChannel);
+                }
+            }
+            if (mode == TwoBandsFilterMode::kFloat) {
+                EXPECT_GE(snr.SnrDb(), 100.);
+            } else {
+                EXPECT_LT(snr.SnrDb(), 20.);
+            }
+        }
+    }
+
+}  // namespace webrtc
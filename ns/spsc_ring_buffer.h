@@ -0,0 +1,139 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_NS_SPSC_RING_BUFFER_H_
+#define MODULES_AUDIO_PROCESSING_NS_SPSC_RING_BUFFER_H_
+
+#include <stddef.h>
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <type_traits>
+
+#include "array_view.h"
+#include "checks.h"
+
+namespace webrtc {
+
+// Lock-free ring buffer for one producer thread and one consumer thread. The
+// producer calls the Write*() methods and the consumer the Read*() methods;
+// the available sizes may be queried from either thread.
+//
+// Besides copying in and out, the contiguous regions of the buffer can be
+// accessed directly through ReadSpan()/AdvanceRead() and
+// WriteSpan()/AdvanceWrite(). The capacity does not need to be a power of two,
+// so a side that always moves blocks of a fixed size that divides the capacity
+// never sees a block wrap around.
+    template<typename T>
+    class SpscRingBuffer {
+    public:
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "The ring buffer copies its elements with memcpy");
+
+        explicit SpscRingBuffer(size_t capacity)
+                : capacity_(capacity), buffer_(new T[capacity]) {
+            RTC_DCHECK_GT(capacity_, 0);
+        }
+
+        SpscRingBuffer(const SpscRingBuffer &) = delete;
+
+        SpscRingBuffer &operator=(const SpscRingBuffer &) = delete;
+
+        size_t capacity() const { return capacity_; }
+
+        // Returns the number of elements that can be read.
+        size_t ReadAvailable() const {
+            return write_index_.load(std::memory_order_acquire) -
+                   read_index_.load(std::memory_order_acquire);
+        }
+
+        // Returns the number of elements that can be written.
+        size_t WriteAvailable() const { return capacity_ - ReadAvailable(); }
+
+        // Writes as many elements of |data| as fit and returns their number.
+        size_t Write(rtc::ArrayView<const T> data) {
+            size_t written = 0;
+            while (written < data.size()) {
+                rtc::ArrayView<T> span = WriteSpan();
+                const size_t size = std::min(span.size(), data.size() - written);
+                if (size == 0) {
+                    break;
+                }
+                memcpy(span.data(), &data[written], size * sizeof(T));
+                AdvanceWrite(size);
+                written += size;
+            }
+            return written;
+        }
+
+        // Reads up to |data.size()| elements and returns their number.
+        size_t Read(rtc::ArrayView<T> data) {
+            size_t read = 0;
+            while (read < data.size()) {
+                rtc::ArrayView<const T> span = ReadSpan();
+                const size_t size = std::min(span.size(), data.size() - read);
+                if (size == 0) {
+                    break;
+                }
+                memcpy(&data[read], span.data(), size * sizeof(T));
+                AdvanceRead(size);
+                read += size;
+            }
+            return read;
+        }
+
+        // Returns the contiguous readable elements starting at the read position.
+        rtc::ArrayView<const T> ReadSpan() const {
+            const size_t read_index = read_index_.load(std::memory_order_relaxed);
+            const size_t available =
+                    write_index_.load(std::memory_order_acquire) - read_index;
+            const size_t position = read_index % capacity_;
+            return rtc::ArrayView<const T>(
+                    &buffer_[position], std::min(available, capacity_ - position));
+        }
+
+        // Releases |size| elements of ReadSpan() to the producer.
+        void AdvanceRead(size_t size) {
+            RTC_DCHECK_LE(size, ReadAvailable());
+            read_index_.store(read_index_.load(std::memory_order_relaxed) + size,
+                              std::memory_order_release);
+        }
+
+        // Returns the contiguous writable elements starting at the write position.
+        rtc::ArrayView<T> WriteSpan() {
+            const size_t write_index = write_index_.load(std::memory_order_relaxed);
+            const size_t available =
+                    capacity_ - (write_index - read_index_.load(std::memory_order_acquire));
+            const size_t position = write_index % capacity_;
+            return rtc::ArrayView<T>(&buffer_[position],
+                                     std::min(available, capacity_ - position));
+        }
+
+        // Publishes |size| elements written to WriteSpan() to the consumer.
+        void AdvanceWrite(size_t size) {
+            RTC_DCHECK_LE(size, WriteAvailable());
+            write_index_.store(write_index_.load(std::memory_order_relaxed) + size,
+                               std::memory_order_release);
+        }
+
+    private:
+        const size_t capacity_;
+        const std::unique_ptr<T[]> buffer_;
+        // The indices only increase; they are kept on separate cache lines to
+        // avoid false sharing between the producer and the consumer.
+        alignas(64) std::atomic<size_t> read_index_{0};
+        alignas(64) std::atomic<size_t> write_index_{0};
+    };
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_NS_SPSC_RING_BUFFER_H_
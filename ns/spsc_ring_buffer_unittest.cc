@@ -0,0 +1,89 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "spsc_ring_buffer.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace webrtc {
+
+    TEST(SpscRingBufferTest, SpansStopAtTheEndOfTheBuffer) {
+        SpscRingBuffer<int> buffer(10);
+        const std::vector<int> x = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+        EXPECT_EQ(7u, buffer.Write(rtc::ArrayView<const int>(x.data(), 7)));
+        std::vector<int> y(5);
+        EXPECT_EQ(5u, buffer.Read(y));
+        EXPECT_EQ(std::vector<int>({0, 1, 2, 3, 4}), y);
+        EXPECT_EQ(2u, buffer.ReadAvailable());
+        EXPECT_EQ(8u, buffer.WriteAvailable());
+
+        // The writable span ends at the end of the buffer, and Write() continues
+        // at its start.
+        EXPECT_EQ(3u, buffer.WriteSpan().size());
+        EXPECT_EQ(5u, buffer.Write(rtc::ArrayView<const int>(&x[7], 5)));
+        EXPECT_EQ(3u, buffer.WriteSpan().size());
+        EXPECT_EQ(3u, buffer.Write(rtc::ArrayView<const int>(x.data(), 4)));
+        EXPECT_EQ(0u, buffer.WriteAvailable());
+        EXPECT_EQ(0u, buffer.WriteSpan().size());
+        EXPECT_EQ(0u, buffer.Write(rtc::ArrayView<const int>(x.data(), 1)));
+
+        EXPECT_EQ(5u, buffer.ReadSpan().size());
+        y.resize(10);
+        EXPECT_EQ(10u, buffer.Read(y));
+        EXPECT_EQ(std::vector<int>({5, 6, 7, 8, 9, 10, 11, 0, 1, 2}), y);
+        EXPECT_EQ(0u, buffer.ReadAvailable());
+        EXPECT_EQ(0u, buffer.ReadSpan().size());
+    }
+
+    // Verifies that a sequence written on one thread is read unchanged on another,
+    // in blocks that do not divide the capacity, so that both sides wrap around
+    // at all positions.
+    TEST(SpscRingBufferTest, ConcurrentWriteAndRead) {
+        constexpr uint32_t kNumValues = 200000;
+        constexpr size_t kWriteBlockSize = 128;
+        constexpr size_t kReadBlockSize = 441;
+        SpscRingBuffer<uint32_t> buffer(1000);
+
+        std::thread producer([&] {
+            std::vector<uint32_t> block(kWriteBlockSize);
+            uint32_t next = 0;
+            while (next < kNumValues) {
+                const size_t size =
+                        std::min<size_t>(kWriteBlockSize, kNumValues - next);
+                for (size_t k = 0; k < size; ++k) {
+                    block[k] = next + static_cast<uint32_t>(k);
+                }
+                next += static_cast<uint32_t>(
+                        buffer.Write(rtc::ArrayView<const uint32_t>(block.data(), size)));
+                std::this_thread::yield();
+            }
+        });
+
+        std::vector<uint32_t> block(kReadBlockSize);
+        uint32_t expected = 0;
+        while (expected < kNumValues) {
+            const size_t size = buffer.Read(block);
+            for (size_t k = 0; k < size; ++k) {
+                ASSERT_EQ(expected, block[k]);
+                ++expected;
+            }
+            std::this_thread::yield();
+        }
+        producer.join();
+        EXPECT_EQ(0u, buffer.ReadAvailable());
+    }
+
+}  // namespace webrtc
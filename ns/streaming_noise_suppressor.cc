@@ -0,0 +1,138 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "streaming_noise_suppressor.h"
+
+#include <algorithm>
+
+#include "checks.h"
+#include "ns_common.h"
+#include "push_sinc_resampler.h"
+#include "splitting_filter.h"
+
+namespace webrtc {
+
+    namespace {
+
+        constexpr int kNsSampleRateHz = 16000;
+        constexpr size_t kChunkSizeMs = 10;
+
+// Returns the lowest rate supported by NoiseSuppressor that is at least
+// |sample_rate_hz|, to which the audio is resampled.
+        int BufferRateForRate(int sample_rate_hz) {
+            RTC_CHECK_EQ(sample_rate_hz % 100, 0);
+            RTC_CHECK_GT(sample_rate_hz, 0);
+            RTC_CHECK_LE(sample_rate_hz, 3 * kNsSampleRateHz);
+            return (sample_rate_hz + kNsSampleRateHz - 1) / kNsSampleRateHz *
+                   kNsSampleRateHz;
+        }
+
+// The suppressor processes each band at 16 kHz and delays all of them by the
+// overlap between consecutive analysis windows. When the audio is resampled,
+// each resampler adds the delay of its filter kernel.
+        size_t DelaySamples(int sample_rate_hz, int buffer_rate_hz) {
+            const size_t num_bands = buffer_rate_hz / kNsSampleRateHz;
+            size_t ns_delay = kOverlapSize * num_bands;
+            switch (num_bands) {
+                case 2:
+                    ns_delay += kTwoBandsDelay;
+                    break;
+                case 3:
+                    ns_delay += kThreeBandsDelay;
+                    break;
+                default:
+                    break;
+            }
+            if (sample_rate_hz == buffer_rate_hz) {
+                return ns_delay;
+            }
+            const float delay_seconds =
+                    PushSincResampler::AlgorithmicDelaySeconds(sample_rate_hz) +
+                    static_cast<float>(ns_delay) / buffer_rate_hz +
+                    PushSincResampler::AlgorithmicDelaySeconds(buffer_rate_hz);
+            return static_cast<size_t>(delay_seconds * sample_rate_hz + 0.5f);
+        }
+
+// Rounds the buffer size up to whole chunks, so that the chunks never wrap
+// around the end of the ring buffers.
+        size_t RingBufferSize(const StreamConfig &stream_config,
+                              size_t buffer_size_ms) {
+            const size_t num_chunks = std::max<size_t>(
+                    1, (buffer_size_ms + kChunkSizeMs - 1) / kChunkSizeMs);
+            return num_chunks * stream_config.num_samples();
+        }
+
+    }  // namespace
+
+    StreamingNoiseSuppressor::StreamingNoiseSuppressor(const NsConfig &config,
+                                                       int sample_rate_hz,
+                                                       size_t num_channels,
+                                                       size_t buffer_size_ms)
+            : stream_config_(sample_rate_hz, num_channels),
+              buffer_rate_hz_(BufferRateForRate(sample_rate_hz)),
+              delay_samples_(DelaySamples(sample_rate_hz, buffer_rate_hz_)),
+              audio_(sample_rate_hz, num_channels, buffer_rate_hz_, num_channels,
+                     sample_rate_hz, num_channels),
+              noise_suppressor_(config, buffer_rate_hz_, num_channels),
+              input_(RingBufferSize(stream_config_, buffer_size_ms)),
+              output_(RingBufferSize(stream_config_, buffer_size_ms)) {}
+
+    size_t StreamingNoiseSuppressor::Push(
+            rtc::ArrayView<const int16_t> interleaved) {
+        const size_t num_channels = stream_config_.num_channels();
+        RTC_DCHECK_EQ(interleaved.size() % num_channels, 0);
+        const size_t size = std::min(interleaved.size(), input_.WriteAvailable()) /
+                            num_channels * num_channels;
+        const size_t written = input_.Write(interleaved.subview(0, size));
+        RTC_DCHECK_EQ(written, size);
+        return written / num_channels;
+    }
+
+    size_t StreamingNoiseSuppressor::Process(size_t max_chunks) {
+        const size_t chunk_size = stream_config_.num_samples();
+        const bool split_bands = buffer_rate_hz_ > kNsSampleRateHz;
+        size_t num_chunks = 0;
+        while (num_chunks < max_chunks) {
+            rtc::ArrayView<const int16_t> input = input_.ReadSpan();
+            rtc::ArrayView<int16_t> output = output_.WriteSpan();
+            if (input.size() < chunk_size || output.size() < chunk_size) {
+                break;
+            }
+
+            audio_.CopyFrom(input.data(), stream_config_);
+            input_.AdvanceRead(chunk_size);
+            if (split_bands) {
+                audio_.SplitIntoFrequencyBands();
+            }
+            noise_suppressor_.Analyze(audio_);
+            noise_suppressor_.Process(&audio_);
+            if (split_bands) {
+                audio_.MergeFrequencyBands();
+            }
+            audio_.CopyTo(stream_config_, output.data());
+            output_.AdvanceWrite(chunk_size);
+            ++num_chunks;
+        }
+        return num_chunks;
+    }
+
+    bool StreamingNoiseSuppressor::CanProcess() const {
+        const size_t chunk_size = stream_config_.num_samples();
+        return input_.ReadAvailable() >= chunk_size &&
+               output_.WriteAvailable() >= chunk_size;
+    }
+
+    size_t StreamingNoiseSuppressor::Pull(rtc::ArrayView<int16_t> interleaved) {
+        const size_t num_channels = stream_config_.num_channels();
+        RTC_DCHECK_EQ(interleaved.size() % num_channels, 0);
+        return output_.Read(interleaved) / num_channels;
+    }
+
+}  // namespace webrtc
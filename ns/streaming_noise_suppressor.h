@@ -0,0 +1,101 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_NS_STREAMING_NOISE_SUPPRESSOR_H_
+#define MODULES_AUDIO_PROCESSING_NS_STREAMING_NOISE_SUPPRESSOR_H_
+
+#include <stdint.h>
+
+#include "array_view.h"
+#include "audio_buffer.h"
+#include "noise_suppressor.h"
+#include "ns_config.h"
+#include "spsc_ring_buffer.h"
+
+namespace webrtc {
+
+// Front end to NoiseSuppressor for audio delivered in blocks of arbitrary size.
+// The interleaved int16 input is pushed from a capture thread into a lock-free
+// ring buffer, suppressed on a processing thread in the 10 ms chunks that
+// NoiseSuppressor requires, and pulled from a second ring buffer by an output
+// thread, which may be the processing thread itself. Each of Push(), Process()
+// and Pull() must only be called from its own thread.
+//
+// The 10 ms chunks are read from and written to the ring buffers in place, so
+// the audio is only copied when it is pushed and pulled.
+    class StreamingNoiseSuppressor {
+    public:
+        // |sample_rate_hz| must be a multiple of 100 Hz of at most 48 kHz. Rates
+        // other than the 16, 32 and 48 kHz of NoiseSuppressor are resampled to
+        // the next higher of those and back, e.g. 44.1 kHz to 48 kHz.
+        // |buffer_size_ms| is the capacity of each ring buffer, rounded up to
+        // whole 10 ms chunks.
+        StreamingNoiseSuppressor(const NsConfig &config,
+                                 int sample_rate_hz,
+                                 size_t num_channels,
+                                 size_t buffer_size_ms = 100);
+
+        StreamingNoiseSuppressor(const StreamingNoiseSuppressor &) = delete;
+
+        StreamingNoiseSuppressor &operator=(const StreamingNoiseSuppressor &) =
+        delete;
+
+        // Capture thread. Pushes interleaved samples, whose number must be a
+        // multiple of the number of channels. Returns the number of samples per
+        // channel that fit in the input buffer.
+        size_t Push(rtc::ArrayView<const int16_t> interleaved);
+
+        // Processing thread. Suppresses all complete 10 ms chunks that have been
+        // pushed and that fit in the output buffer, up to |max_chunks|. Returns the
+        // number of chunks.
+        size_t Process(size_t max_chunks = SIZE_MAX);
+
+        // Returns true if Process() would suppress at least one chunk. May be
+        // called from any thread.
+        bool CanProcess() const;
+
+        // Returns the number of samples per channel that Push() would accept. May
+        // be called from any thread; only grows until the next Push().
+        size_t push_available() const {
+            return input_.WriteAvailable() / stream_config_.num_channels();
+        }
+
+        // Output thread. Pulls up to |interleaved.size()| suppressed interleaved
+        // samples, a multiple of the number of channels. Returns the number of
+        // samples per channel pulled.
+        size_t Pull(rtc::ArrayView<int16_t> interleaved);
+
+        // Returns the delay, in samples per channel, of the pulled audio relative to
+        // the pushed audio: the overlap of the analysis and synthesis in
+        // NoiseSuppressor plus the delay of the band splitting filter and, for
+        // resampled rates, of the resamplers, rounded to whole samples. The
+        // buffering adds no delay beyond this, but a pushed sample can only be
+        // pulled once the 10 ms chunk it belongs to has been completed and
+        // processed.
+        size_t delay_samples() const { return delay_samples_; }
+
+        // Gives access to the suppressor, e.g. for SeedNoiseProfile() or
+        // SaveState(). Must only be used on the processing thread.
+        NoiseSuppressor *noise_suppressor() { return &noise_suppressor_; }
+
+    private:
+        const StreamConfig stream_config_;
+        // The rate at which the suppressor runs.
+        const int buffer_rate_hz_;
+        const size_t delay_samples_;
+        AudioBuffer audio_;
+        NoiseSuppressor noise_suppressor_;
+        SpscRingBuffer<int16_t> input_;
+        SpscRingBuffer<int16_t> output_;
+    };
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_NS_STREAMING_NOISE_SUPPRESSOR_H_
@@ -0,0 +1,162 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "streaming_noise_suppressor.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace webrtc {
+    namespace {
+
+        constexpr int kNumChunks = 100;
+        // Rates processed natively and a rate that is resampled to 48 kHz.
+        constexpr int kSampleRatesHz[] = {16000, 32000, 48000, 44100};
+
+        // Returns |kNumChunks| 10 ms chunks of interleaved noise.
+        std::vector<int16_t> GenerateNoise(int sample_rate_hz, size_t num_channels) {
+            std::vector<int16_t> x(
+                    kNumChunks * StreamConfig(sample_rate_hz, num_channels).num_samples());
+            uint32_t seed = 1;
+            for (int16_t &v : x) {
+                seed = seed * 1664525u + 1013904223u;
+                v = static_cast<int16_t>(static_cast<int>((seed >> 16) & 0x3fff) - 8192);
+            }
+            return x;
+        }
+
+        // Suppresses |input| chunk by chunk with a NoiseSuppressor, resampling
+        // 44.1 kHz to 48 kHz as the streaming suppressor does.
+        std::vector<int16_t> SuppressDirectly(int sample_rate_hz, size_t num_channels,
+                                              const std::vector<int16_t> &input) {
+            const int buffer_rate_hz = sample_rate_hz == 44100 ? 48000 : sample_rate_hz;
+            const StreamConfig stream_config(sample_rate_hz, num_channels);
+            const NsConfig config;
+            NoiseSuppressor ns(config, buffer_rate_hz, num_channels);
+            AudioBuffer audio(sample_rate_hz, num_channels, buffer_rate_hz,
+                              num_channels, sample_rate_hz, num_channels);
+            std::vector<int16_t> output(input.size());
+            for (size_t k = 0; k < input.size(); k += stream_config.num_samples()) {
+                audio.CopyFrom(&input[k], stream_config);
+                if (buffer_rate_hz > 16000) {
+                    audio.SplitIntoFrequencyBands();
+                }
+                ns.Analyze(audio);
+                ns.Process(&audio);
+                if (buffer_rate_hz > 16000) {
+                    audio.MergeFrequencyBands();
+                }
+                audio.CopyTo(stream_config, &output[k]);
+            }
+            return output;
+        }
+
+        // Pushes |input| in blocks of |block_size| frames on a capture thread, and
+        // processes and pulls it in blocks of the same size on this thread.
+        std::vector<int16_t> SuppressStreaming(StreamingNoiseSuppressor *ns,
+                                               size_t num_channels,
+                                               size_t block_size,
+                                               const std::vector<int16_t> &input) {
+            std::thread capture([&] {
+                size_t pushed = 0;
+                while (pushed < input.size()) {
+                    const size_t size =
+                            std::min(block_size * num_channels, input.size() - pushed);
+                    pushed += num_channels *
+                              ns->Push(rtc::ArrayView<const int16_t>(&input[pushed], size));
+                    std::this_thread::yield();
+                }
+            });
+
+            std::vector<int16_t> output(input.size());
+            size_t pulled = 0;
+            while (pulled < output.size()) {
+                ns->Process();
+                const size_t size =
+                        std::min(block_size * num_channels, output.size() - pulled);
+                pulled += num_channels *
+                          ns->Pull(rtc::ArrayView<int16_t>(&output[pulled], size));
+                std::this_thread::yield();
+            }
+            capture.join();
+            return output;
+        }
+
+        // Returns the lag of |y| relative to |x| in frames, up to |max_lag|, for
+        // which the cross-correlation of the first channels is largest.
+        size_t FindLag(const std::vector<int16_t> &x, const std::vector<int16_t> &y,
+                       size_t num_channels, size_t max_lag) {
+            const size_t num_frames = x.size() / num_channels;
+            size_t best_lag = 0;
+            double best_correlation = 0.;
+            for (size_t lag = 0; lag <= max_lag; ++lag) {
+                double correlation = 0.;
+                for (size_t n = 0; n + lag < num_frames; ++n) {
+                    correlation += static_cast<double>(x[n * num_channels]) *
+                                   y[(n + lag) * num_channels];
+                }
+                if (correlation > best_correlation) {
+                    best_correlation = correlation;
+                    best_lag = lag;
+                }
+            }
+            return best_lag;
+        }
+
+    }  // namespace
+
+    // Verifies that the audio pulled on one thread equals the output of a
+    // NoiseSuppressor for the audio pushed on another, for blocks that do not
+    // divide the 10 ms chunks.
+    TEST(StreamingNoiseSuppressorTest, MatchesNoiseSuppressorAcrossThreads) {
+        const NsConfig config;
+        for (int sample_rate_hz : kSampleRatesHz) {
+            for (size_t num_channels : {1, 2}) {
+                for (size_t block_size : {128, 441}) {
+                    SCOPED_TRACE(sample_rate_hz);
+                    SCOPED_TRACE(num_channels);
+                    SCOPED_TRACE(block_size);
+                    const std::vector<int16_t> input =
+                            GenerateNoise(sample_rate_hz, num_channels);
+                    StreamingNoiseSuppressor ns(config, sample_rate_hz, num_channels);
+                    EXPECT_EQ(SuppressDirectly(sample_rate_hz, num_channels, input),
+                              SuppressStreaming(&ns, num_channels, block_size, input));
+                }
+            }
+        }
+    }
+
+    // Verifies delay_samples() against the lag of the output that correlates best
+    // with the input. The delay of the resampled rate is rounded.
+    TEST(StreamingNoiseSuppressorTest, DelaySamples) {
+        const NsConfig config;
+        const struct {
+            int sample_rate_hz;
+            size_t delay_samples;
+        } kDelays[] = {{16000, 96}, {32000, 196}, {48000, 334}, {44100, 338}};
+        for (const auto &delay : kDelays) {
+            SCOPED_TRACE(delay.sample_rate_hz);
+            StreamingNoiseSuppressor ns(config, delay.sample_rate_hz, 1);
+            EXPECT_EQ(delay.delay_samples, ns.delay_samples());
+            const std::vector<int16_t> input = GenerateNoise(delay.sample_rate_hz, 1);
+            const std::vector<int16_t> output = SuppressStreaming(&ns, 1, 441, input);
+            const int lag = static_cast<int>(FindLag(input, output, 1, 1000));
+            EXPECT_LE(abs(lag - static_cast<int>(ns.delay_samples())),
+                      delay.sample_rate_hz % 16000 == 0 ? 0 : 1);
+        }
+    }
+
+}  // namespace webrtc
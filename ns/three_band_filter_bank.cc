@@ -35,70 +35,17 @@
 #include <array>
 
 #include "checks.h"
+#include "three_band_filter_bank_impl.h"
+#include "three_band_filter_bank_simd.h"
 
 namespace webrtc {
     namespace {
 
-// Factors to take into account when choosing |kFilterSize|:
-//   1. Higher |kFilterSize|, means faster transition, which ensures less
-//      aliasing. This is especially important when there is non-linear
-//      processing between the splitting and merging.
-//   2. The delay that this filter bank introduces is
-//      |kNumBands| * |kSparsity| * |kFilterSize| / 2, so it increases linearly
-//      with |kFilterSize|.
-//   3. The computation complexity also increases linearly with |kFilterSize|.
-
-// The Matlab code to generate these |kFilterCoeffs| is:
-//
-// N = kNumBands * kSparsity * kFilterSize - 1;
-// h = fir1(N, 1 / (2 * kNumBands), kaiser(N + 1, 3.5));
-// reshape(h, kNumBands * kSparsity, kFilterSize);
-//
-// The code below uses the values of kFilterSize, kNumBands and kSparsity
-// specified in the header.
-
-// Because the total bandwidth of the lower and higher band is double the middle
-// one (because of the spectrum parity), the low-pass prototype is half the
-// bandwidth of 1 / (2 * |kNumBands|) and is then shifted with cosine modulation
-// to the right places.
-// A Kaiser window is used because of its flexibility and the alpha is set to
-// 3.5, since that sets a stop band attenuation of 40dB ensuring a fast
-// transition.
-
-        constexpr int kSubSampling = ThreeBandFilterBank::kNumBands;
-        constexpr int kDctSize = ThreeBandFilterBank::kNumBands;
-        static_assert(ThreeBandFilterBank::kNumBands *
-                      ThreeBandFilterBank::kSplitBandSize ==
-                      ThreeBandFilterBank::kFullBandSize,
-                      "The full band must be split in equally sized subbands");
-
-        const float
-                kFilterCoeffs[ThreeBandFilterBank::kNumNonZeroFilters][kFilterSize] = {
-                {-0.00047749f, -0.00496888f, +0.16547118f, +0.00425496f},
-                {-0.00173287f, -0.01585778f, +0.14989004f, +0.00994113f},
-                {-0.00304815f, -0.02536082f, +0.12154542f, +0.01157993f},
-                {-0.00346946f, -0.02587886f, +0.04760441f, +0.00607594f},
-                {-0.00154717f, -0.01136076f, +0.01387458f, +0.00186353f},
-                {+0.00186353f, +0.01387458f, -0.01136076f, -0.00154717f},
-                {+0.00607594f, +0.04760441f, -0.02587886f, -0.00346946f},
-                {+0.00983212f, +0.08543175f, -0.02982767f, -0.00383509f},
-                {+0.00994113f, +0.14989004f, -0.01585778f, -0.00173287f},
-                {+0.00425496f, +0.16547118f, -0.00496888f, -0.00047749f}};
-
-        constexpr int kZeroFilterIndex1 = 3;
-        constexpr int kZeroFilterIndex2 = 9;
-
-        const float kDctModulation[ThreeBandFilterBank::kNumNonZeroFilters][kDctSize] =
-                {{2.f,          2.f,  2.f},
-                 {1.73205077f,  0.f,  -1.73205077f},
-                 {1.f,          -2.f, 1.f},
-                 {-1.f,         2.f,  -1.f},
-                 {-1.73205077f, 0.f,  1.73205077f},
-                 {-2.f,         -2.f, -2.f},
-                 {-1.73205077f, 0.f,  1.73205077f},
-                 {-1.f,         2.f,  -1.f},
-                 {1.f,          -2.f, 1.f},
-                 {1.73205077f,  0.f,  -1.73205077f}};
+        using three_band_filter_bank_impl::kDctModulation;
+        using three_band_filter_bank_impl::kDctSize;
+        using three_band_filter_bank_impl::kFilterCoeffs;
+        using three_band_filter_bank_impl::kSubSampling;
+        using three_band_filter_bank_impl::NonZeroFilterIndex;
 
 // Filters the input signal |in| with the filter |filter| using a shift by
 // |in_shift|, taking into account the previous state.
@@ -149,7 +96,11 @@ namespace webrtc {
 // Because the low-pass filter prototype has half bandwidth it is possible to
 // use a DCT to shift it in both directions at the same time, to the center
 // frequencies [1 / 12, 3 / 12, 5 / 12].
-    ThreeBandFilterBank::ThreeBandFilterBank() {
+    ThreeBandFilterBank::ThreeBandFilterBank()
+            : ThreeBandFilterBank(DetectOptimization()) {}
+
+    ThreeBandFilterBank::ThreeBandFilterBank(NsOptimization optimization)
+            : optimization_(optimization) {
         RTC_DCHECK_EQ(state_analysis_.size(), kNumNonZeroFilters);
         RTC_DCHECK_EQ(state_synthesis_.size(), kNumNonZeroFilters);
         for (int k = 0; k < kNumNonZeroFilters; ++k) {
@@ -173,9 +124,33 @@ namespace webrtc {
             rtc::ArrayView<const float, kFullBandSize> in,
             rtc::ArrayView<const rtc::ArrayView<float>, ThreeBandFilterBank::kNumBands>
             out) {
-        // Initialize the output to zero.
         for (int band = 0; band < ThreeBandFilterBank::kNumBands; ++band) {
             RTC_DCHECK_EQ(out[band].size(), kSplitBandSize);
+        }
+        float *const out_bands[kNumBands] = {out[0].data(), out[1].data(),
+                                             out[2].data()};
+        switch (optimization_) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#if defined(WEBRTC_ENABLE_AVX2)
+            case NsOptimization::kAvx2:
+                ThreeBandAnalysisAvx2(in.data(), out_bands, &state_analysis_);
+                return;
+#endif
+            case NsOptimization::kSse2:
+                ThreeBandAnalysisSse2(in.data(), out_bands, &state_analysis_);
+                return;
+#endif
+#if defined(WEBRTC_HAS_NEON)
+            case NsOptimization::kNeon:
+                ThreeBandAnalysisNeon(in.data(), out_bands, &state_analysis_);
+                return;
+#endif
+            default:
+                break;
+        }
+
+        // Initialize the output to zero.
+        for (int band = 0; band < ThreeBandFilterBank::kNumBands; ++band) {
             std::fill(out[band].begin(), out[band].end(), 0);
         }
 
@@ -191,13 +166,10 @@ namespace webrtc {
             for (int in_shift = 0; in_shift < kStride; ++in_shift) {
                 // Choose filter, skip zero filters.
                 const int index = downsampling_index + in_shift * kSubSampling;
-                if (index == kZeroFilterIndex1 || index == kZeroFilterIndex2) {
+                const int filter_index = NonZeroFilterIndex(index);
+                if (filter_index < 0) {
                     continue;
                 }
-                const int filter_index =
-                        index < kZeroFilterIndex1
-                        ? index
-                        : (index < kZeroFilterIndex2 ? index - 1 : index - 2);
 
                 rtc::ArrayView<const float, kFilterSize> filter(
                         kFilterCoeffs[filter_index]);
@@ -229,19 +201,41 @@ namespace webrtc {
             rtc::ArrayView<const rtc::ArrayView<float>, ThreeBandFilterBank::kNumBands>
             in,
             rtc::ArrayView<float, kFullBandSize> out) {
+        for (int band = 0; band < ThreeBandFilterBank::kNumBands; ++band) {
+            RTC_DCHECK_EQ(in[band].size(), kSplitBandSize);
+        }
+        const float *const in_bands[kNumBands] = {in[0].data(), in[1].data(),
+                                                  in[2].data()};
+        switch (optimization_) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#if defined(WEBRTC_ENABLE_AVX2)
+            case NsOptimization::kAvx2:
+                ThreeBandSynthesisAvx2(in_bands, out.data(), &state_synthesis_);
+                return;
+#endif
+            case NsOptimization::kSse2:
+                ThreeBandSynthesisSse2(in_bands, out.data(), &state_synthesis_);
+                return;
+#endif
+#if defined(WEBRTC_HAS_NEON)
+            case NsOptimization::kNeon:
+                ThreeBandSynthesisNeon(in_bands, out.data(), &state_synthesis_);
+                return;
+#endif
+            default:
+                break;
+        }
+
         std::fill(out.begin(), out.end(), 0);
         for (int upsampling_index = 0; upsampling_index < kSubSampling;
              ++upsampling_index) {
             for (int in_shift = 0; in_shift < kStride; ++in_shift) {
                 // Choose filter, skip zero filters.
                 const int index = upsampling_index + in_shift * kSubSampling;
-                if (index == kZeroFilterIndex1 || index == kZeroFilterIndex2) {
+                const int filter_index = NonZeroFilterIndex(index);
+                if (filter_index < 0) {
                     continue;
                 }
-                const int filter_index =
-                        index < kZeroFilterIndex1
-                        ? index
-                        : (index < kZeroFilterIndex2 ? index - 1 : index - 2);
 
                 rtc::ArrayView<const float, kFilterSize> filter(
                         kFilterCoeffs[filter_index]);
@@ -253,7 +247,6 @@ namespace webrtc {
                 std::array<float, kSplitBandSize> in_subsampled;
                 std::fill(in_subsampled.begin(), in_subsampled.end(), 0.f);
                 for (int band = 0; band < ThreeBandFilterBank::kNumBands; ++band) {
-                    RTC_DCHECK_EQ(in[band].size(), kSplitBandSize);
                     for (int n = 0; n < kSplitBandSize; ++n) {
                         in_subsampled[n] += dct_modulation[band] * in[band][n];
                     }
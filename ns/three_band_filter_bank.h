@@ -17,6 +17,7 @@
 #include <vector>
 
 #include "array_view.h"
+#include "ns_common.h"
 
 namespace webrtc {
 
@@ -52,8 +53,14 @@ namespace webrtc {
         static const int kNumNonZeroFilters =
                 kSparsity * ThreeBandFilterBank::kNumBands - kNumZeroFilters;
 
+        // Polyphase filter states, indexed as [filter][sample].
+        using FilterStates =
+                std::array<std::array<float, kMemorySize>, kNumNonZeroFilters>;
+
         ThreeBandFilterBank();
 
+        explicit ThreeBandFilterBank(NsOptimization optimization);
+
         ~ThreeBandFilterBank();
 
         // Splits |in| of size kFullBandSize into 3 downsampled frequency bands in
@@ -66,11 +73,12 @@ namespace webrtc {
         void Synthesis(rtc::ArrayView<const rtc::ArrayView<float>, kNumBands> in,
                        rtc::ArrayView<float, kFullBandSize> out);
 
+        NsOptimization optimization() const { return optimization_; }
+
     private:
-        std::array<std::array<float, kMemorySize>, kNumNonZeroFilters>
-                state_analysis_;
-        std::array<std::array<float, kMemorySize>, kNumNonZeroFilters>
-                state_synthesis_;
+        const NsOptimization optimization_;
+        FilterStates state_analysis_;
+        FilterStates state_synthesis_;
     };
 
 }  // namespace webrtc
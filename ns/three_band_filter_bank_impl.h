@@ -0,0 +1,246 @@
+/*
+ *  Copyright (c) 2015 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_NS_THREE_BAND_FILTER_BANK_IMPL_H_
+#define MODULES_AUDIO_PROCESSING_NS_THREE_BAND_FILTER_BANK_IMPL_H_
+
+#include <algorithm>
+#include <array>
+
+#include "three_band_filter_bank.h"
+
+// Filter tables shared by the scalar and the SIMD implementations of
+// ThreeBandFilterBank, and the templated SIMD implementation itself. The
+// template is instantiated in the *_sse2.cc, *_avx2.cc and *_neon.cc files with
+// the matching SimdOps.
+//
+// The SIMD implementation vectorizes the polyphase filters over time. Each
+// filter input is prefixed with the kMemorySize samples of filter state, so
+// that
+//   out[k] = sum_i filter[i] * extended_in[kMemorySize + k - in_shift - kStride * i]
+// needs no special handling at the frame start. The products are accumulated
+// in the same order as in the scalar FilterCore, so without fused multiply-add
+// the results are bit-exact to it.
+
+namespace webrtc {
+    namespace three_band_filter_bank_impl {
+
+// Factors to take into account when choosing |kFilterSize|:
+//   1. Higher |kFilterSize|, means faster transition, which ensures less
+//      aliasing. This is especially important when there is non-linear
+//      processing between the splitting and merging.
+//   2. The delay that this filter bank introduces is
+//      |kNumBands| * |kSparsity| * |kFilterSize| / 2, so it increases linearly
+//      with |kFilterSize|.
+//   3. The computation complexity also increases linearly with |kFilterSize|.
+
+// The Matlab code to generate these |kFilterCoeffs| is:
+//
+// N = kNumBands * kSparsity * kFilterSize - 1;
+// h = fir1(N, 1 / (2 * kNumBands), kaiser(N + 1, 3.5));
+// reshape(h, kNumBands * kSparsity, kFilterSize);
+//
+// The code below uses the values of kFilterSize, kNumBands and kSparsity
+// specified in the header.
+
+// Because the total bandwidth of the lower and higher band is double the middle
+// one (because of the spectrum parity), the low-pass prototype is half the
+// bandwidth of 1 / (2 * |kNumBands|) and is then shifted with cosine modulation
+// to the right places.
+// A Kaiser window is used because of its flexibility and the alpha is set to
+// 3.5, since that sets a stop band attenuation of 40dB ensuring a fast
+// transition.
+
+        constexpr int kSubSampling = ThreeBandFilterBank::kNumBands;
+        constexpr int kDctSize = ThreeBandFilterBank::kNumBands;
+        static_assert(ThreeBandFilterBank::kNumBands *
+                      ThreeBandFilterBank::kSplitBandSize ==
+                      ThreeBandFilterBank::kFullBandSize,
+                      "The full band must be split in equally sized subbands");
+
+        const float
+                kFilterCoeffs[ThreeBandFilterBank::kNumNonZeroFilters][kFilterSize] = {
+                {-0.00047749f, -0.00496888f, +0.16547118f, +0.00425496f},
+                {-0.00173287f, -0.01585778f, +0.14989004f, +0.00994113f},
+                {-0.00304815f, -0.02536082f, +0.12154542f, +0.01157993f},
+                {-0.00346946f, -0.02587886f, +0.04760441f, +0.00607594f},
+                {-0.00154717f, -0.01136076f, +0.01387458f, +0.00186353f},
+                {+0.00186353f, +0.01387458f, -0.01136076f, -0.00154717f},
+                {+0.00607594f, +0.04760441f, -0.02587886f, -0.00346946f},
+                {+0.00983212f, +0.08543175f, -0.02982767f, -0.00383509f},
+                {+0.00994113f, +0.14989004f, -0.01585778f, -0.00173287f},
+                {+0.00425496f, +0.16547118f, -0.00496888f, -0.00047749f}};
+
+        constexpr int kZeroFilterIndex1 = 3;
+        constexpr int kZeroFilterIndex2 = 9;
+
+        const float kDctModulation[ThreeBandFilterBank::kNumNonZeroFilters][kDctSize] =
+                {{2.f,          2.f,  2.f},
+                 {1.73205077f,  0.f,  -1.73205077f},
+                 {1.f,          -2.f, 1.f},
+                 {-1.f,         2.f,  -1.f},
+                 {-1.73205077f, 0.f,  1.73205077f},
+                 {-2.f,         -2.f, -2.f},
+                 {-1.73205077f, 0.f,  1.73205077f},
+                 {-1.f,         2.f,  -1.f},
+                 {1.f,          -2.f, 1.f},
+                 {1.73205077f,  0.f,  -1.73205077f}};
+
+// Returns the index into kFilterCoeffs of the polyphase filter |index|, or -1
+// for the zero filters.
+        inline int NonZeroFilterIndex(int index) {
+            if (index == kZeroFilterIndex1 || index == kZeroFilterIndex2) {
+                return -1;
+            }
+            return index < kZeroFilterIndex1
+                   ? index
+                   : (index < kZeroFilterIndex2 ? index - 1 : index - 2);
+        }
+
+        using FilterStates = ThreeBandFilterBank::FilterStates;
+
+        constexpr int kExtendedSize = kMemorySize + ThreeBandFilterBank::kSplitBandSize;
+
+// Filters the extended input, whose first kMemorySize values must hold the
+// filter state, and calls |consume(k, out_k)| for each vector of outputs.
+        template<typename Ops, typename Consumer>
+        void FilterExtended(const float *filter,
+                            const float *extended_in,
+                            int in_shift,
+                            Consumer consume) {
+            static_assert(ThreeBandFilterBank::kSplitBandSize % Ops::kWidth == 0, "");
+            const typename Ops::V f0 = Ops::Set1(filter[0]);
+            const typename Ops::V f1 = Ops::Set1(filter[1]);
+            const typename Ops::V f2 = Ops::Set1(filter[2]);
+            const typename Ops::V f3 = Ops::Set1(filter[3]);
+            const float *x = extended_in + kMemorySize - in_shift;
+            for (int k = 0; k < ThreeBandFilterBank::kSplitBandSize;
+                 k += static_cast<int>(Ops::kWidth)) {
+                typename Ops::V acc = Ops::Set1(0.f);
+                acc = Ops::Add(acc, Ops::Mul(Ops::Load(x + k), f0));
+                acc = Ops::Add(acc, Ops::Mul(Ops::Load(x + k - kStride), f1));
+                acc = Ops::Add(acc, Ops::Mul(Ops::Load(x + k - 2 * kStride), f2));
+                acc = Ops::Add(acc, Ops::Mul(Ops::Load(x + k - 3 * kStride), f3));
+                consume(k, acc);
+            }
+        }
+
+        template<typename Ops>
+        void Analysis(const float *in, float *const *out, FilterStates *state) {
+            using V = typename Ops::V;
+            constexpr int kSplitBandSize = ThreeBandFilterBank::kSplitBandSize;
+            for (int band = 0; band < ThreeBandFilterBank::kNumBands; ++band) {
+                std::fill(out[band], out[band] + kSplitBandSize, 0.f);
+            }
+
+            for (int downsampling_index = 0; downsampling_index < kSubSampling;
+                 ++downsampling_index) {
+                // Downsample to form the filter input.
+                alignas(32) float extended_in[kExtendedSize];
+                for (int k = 0; k < kSplitBandSize; ++k) {
+                    extended_in[kMemorySize + k] =
+                            in[(kSubSampling - 1) - downsampling_index + kSubSampling * k];
+                }
+
+                for (int in_shift = 0; in_shift < kStride; ++in_shift) {
+                    const int filter_index =
+                            NonZeroFilterIndex(downsampling_index + in_shift * kSubSampling);
+                    if (filter_index < 0) {
+                        continue;
+                    }
+                    std::array<float, kMemorySize> &filter_state = (*state)[filter_index];
+                    std::copy(filter_state.begin(), filter_state.end(), extended_in);
+
+                    // Filter, then band and modulate the output.
+                    const V dct0 = Ops::Set1(kDctModulation[filter_index][0]);
+                    const V dct1 = Ops::Set1(kDctModulation[filter_index][1]);
+                    const V dct2 = Ops::Set1(kDctModulation[filter_index][2]);
+                    FilterExtended<Ops>(
+                            kFilterCoeffs[filter_index], extended_in, in_shift,
+                            [&](int k, V out_k) {
+                                Ops::Store(out[0] + k, Ops::Add(Ops::Load(out[0] + k),
+                                                                Ops::Mul(dct0, out_k)));
+                                Ops::Store(out[1] + k, Ops::Add(Ops::Load(out[1] + k),
+                                                                Ops::Mul(dct1, out_k)));
+                                Ops::Store(out[2] + k, Ops::Add(Ops::Load(out[2] + k),
+                                                                Ops::Mul(dct2, out_k)));
+                            });
+
+                    // Update current state.
+                    std::copy(extended_in + kSplitBandSize, extended_in + kExtendedSize,
+                              filter_state.begin());
+                }
+            }
+        }
+
+        template<typename Ops>
+        void Synthesis(const float *const *in, float *out, FilterStates *state) {
+            using V = typename Ops::V;
+            constexpr int kSplitBandSize = ThreeBandFilterBank::kSplitBandSize;
+            constexpr float kUpsamplingScaling = kSubSampling;
+            const V upsampling_scaling = Ops::Set1(kUpsamplingScaling);
+
+            // The output is accumulated per upsampling index and interleaved in the
+            // end.
+            alignas(32) float out_subsampled[kSubSampling][kSplitBandSize] = {};
+            for (int upsampling_index = 0; upsampling_index < kSubSampling;
+                 ++upsampling_index) {
+                float *accumulated = out_subsampled[upsampling_index];
+                for (int in_shift = 0; in_shift < kStride; ++in_shift) {
+                    const int filter_index =
+                            NonZeroFilterIndex(upsampling_index + in_shift * kSubSampling);
+                    if (filter_index < 0) {
+                        continue;
+                    }
+
+                    // Prepare filter input by modulating the banded input.
+                    alignas(32) float extended_in[kExtendedSize];
+                    std::array<float, kMemorySize> &filter_state = (*state)[filter_index];
+                    std::copy(filter_state.begin(), filter_state.end(), extended_in);
+                    const V dct0 = Ops::Set1(kDctModulation[filter_index][0]);
+                    const V dct1 = Ops::Set1(kDctModulation[filter_index][1]);
+                    const V dct2 = Ops::Set1(kDctModulation[filter_index][2]);
+                    for (int n = 0; n < kSplitBandSize; n += static_cast<int>(Ops::kWidth)) {
+                        V x = Ops::Set1(0.f);
+                        x = Ops::Add(x, Ops::Mul(dct0, Ops::Load(in[0] + n)));
+                        x = Ops::Add(x, Ops::Mul(dct1, Ops::Load(in[1] + n)));
+                        x = Ops::Add(x, Ops::Mul(dct2, Ops::Load(in[2] + n)));
+                        Ops::Store(extended_in + kMemorySize + n, x);
+                    }
+
+                    // Filter and accumulate.
+                    FilterExtended<Ops>(
+                            kFilterCoeffs[filter_index], extended_in, in_shift,
+                            [&](int k, V out_k) {
+                                Ops::Store(accumulated + k,
+                                           Ops::Add(Ops::Load(accumulated + k),
+                                                    Ops::Mul(upsampling_scaling, out_k)));
+                            });
+
+                    // Update current state.
+                    std::copy(extended_in + kSplitBandSize, extended_in + kExtendedSize,
+                              filter_state.begin());
+                }
+            }
+
+            // Upsample.
+            for (int k = 0; k < kSplitBandSize; ++k) {
+                for (int upsampling_index = 0; upsampling_index < kSubSampling;
+                     ++upsampling_index) {
+                    out[upsampling_index + kSubSampling * k] =
+                            out_subsampled[upsampling_index][k];
+                }
+            }
+        }
+
+    }  // namespace three_band_filter_bank_impl
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_NS_THREE_BAND_FILTER_BANK_IMPL_H_
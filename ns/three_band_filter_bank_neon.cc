@@ -0,0 +1,34 @@
+/*
+ *  Copyright (c) 2015 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "three_band_filter_bank_simd.h"
+
+#if defined(WEBRTC_HAS_NEON)
+
+#include "simd_ops_neon.h"
+#include "three_band_filter_bank_impl.h"
+
+namespace webrtc {
+
+    void ThreeBandAnalysisNeon(const float *in,
+                               float *const *out,
+                               ThreeBandFilterBank::FilterStates *state) {
+        three_band_filter_bank_impl::Analysis<NeonOps>(in, out, state);
+    }
+
+    void ThreeBandSynthesisNeon(const float *const *in,
+                                float *out,
+                                ThreeBandFilterBank::FilterStates *state) {
+        three_band_filter_bank_impl::Synthesis<NeonOps>(in, out, state);
+    }
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_HAS_NEON
@@ -0,0 +1,58 @@
+/*
+ *  Copyright (c) 2015 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_NS_THREE_BAND_FILTER_BANK_SIMD_H_
+#define MODULES_AUDIO_PROCESSING_NS_THREE_BAND_FILTER_BANK_SIMD_H_
+
+#include "arch.h"
+#include "three_band_filter_bank.h"
+
+namespace webrtc {
+
+// SIMD implementations of ThreeBandFilterBank::Analysis and Synthesis. |out|
+// and |in| point to the kNumBands split bands.
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+
+    void ThreeBandAnalysisSse2(const float *in,
+                               float *const *out,
+                               ThreeBandFilterBank::FilterStates *state);
+
+    void ThreeBandSynthesisSse2(const float *const *in,
+                                float *out,
+                                ThreeBandFilterBank::FilterStates *state);
+
+#if defined(WEBRTC_ENABLE_AVX2)
+
+    void ThreeBandAnalysisAvx2(const float *in,
+                               float *const *out,
+                               ThreeBandFilterBank::FilterStates *state);
+
+    void ThreeBandSynthesisAvx2(const float *const *in,
+                                float *out,
+                                ThreeBandFilterBank::FilterStates *state);
+
+#endif
+#endif
+
+#if defined(WEBRTC_HAS_NEON)
+
+    void ThreeBandAnalysisNeon(const float *in,
+                               float *const *out,
+                               ThreeBandFilterBank::FilterStates *state);
+
+    void ThreeBandSynthesisNeon(const float *const *in,
+                                float *out,
+                                ThreeBandFilterBank::FilterStates *state);
+
+#endif
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_NS_THREE_BAND_FILTER_BANK_SIMD_H_
@@ -0,0 +1,34 @@
+/*
+ *  Copyright (c) 2015 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "three_band_filter_bank_simd.h"
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+
+#include "simd_ops_sse2.h"
+#include "three_band_filter_bank_impl.h"
+
+namespace webrtc {
+
+    void ThreeBandAnalysisSse2(const float *in,
+                               float *const *out,
+                               ThreeBandFilterBank::FilterStates *state) {
+        three_band_filter_bank_impl::Analysis<Sse2Ops>(in, out, state);
+    }
+
+    void ThreeBandSynthesisSse2(const float *const *in,
+                                float *out,
+                                ThreeBandFilterBank::FilterStates *state) {
+        three_band_filter_bank_impl::Synthesis<Sse2Ops>(in, out, state);
+    }
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_ARCH_X86_FAMILY
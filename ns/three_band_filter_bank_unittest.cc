@@ -0,0 +1,94 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "three_band_filter_bank.h"
+
+#include <math.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <array>
+
+#include "gtest/gtest.h"
+
+namespace webrtc {
+    namespace {
+
+// Max difference of the optimized kernels to the scalar ones, relative to the
+// peak magnitude of the input. The kernels perform the same operations, but
+// the compiler may fuse multiply-adds with AVX2, which changes the rounding.
+        constexpr float kTolerance = 1e-6f;
+
+        constexpr int kNumFrames = 50;
+        constexpr float kPeak = 16000.f;
+
+        using Bands = std::array<std::array<float, ThreeBandFilterBank::kSplitBandSize>,
+                ThreeBandFilterBank::kNumBands>;
+
+        void GenerateFrame(int frame, uint32_t *seed,
+                           std::array<float, ThreeBandFilterBank::kFullBandSize> *x) {
+            for (size_t n = 0; n < x->size(); ++n) {
+                const float t = static_cast<float>(frame * x->size() + n);
+                *seed = *seed * 1664525u + 1013904223u;
+                const float noise = static_cast<int>(*seed >> 16) / 32768.f - 1.f;
+                (*x)[n] = kPeak * (0.3f * sinf(0.02f * t) + 0.3f * sinf(0.7f * t) +
+                                   0.2f * sinf(2.3f * t) + 0.2f * noise);
+            }
+        }
+
+        // Splits and merges |frame| with |filter_bank|.
+        void SplitAndMerge(
+                ThreeBandFilterBank *filter_bank,
+                const std::array<float, ThreeBandFilterBank::kFullBandSize> &frame,
+                Bands *bands,
+                std::array<float, ThreeBandFilterBank::kFullBandSize> *out) {
+            const std::array<rtc::ArrayView<float>, ThreeBandFilterBank::kNumBands>
+                    band_views = {(*bands)[0], (*bands)[1], (*bands)[2]};
+            filter_bank->Analysis(frame, band_views);
+            filter_bank->Synthesis(band_views, *out);
+        }
+
+    }  // namespace
+
+// Verifies the analysis and synthesis of every available optimization against
+// the scalar kernels.
+    TEST(ThreeBandFilterBankTest, MatchesScalarFilterBank) {
+        const float tolerance = kTolerance * kPeak;
+        for (NsOptimization optimization : AvailableOptimizations()) {
+            SCOPED_TRACE(static_cast<int>(optimization));
+            ThreeBandFilterBank reference(NsOptimization::kNone);
+            ThreeBandFilterBank filter_bank(optimization);
+            ASSERT_EQ(optimization, filter_bank.optimization());
+
+            std::array<float, ThreeBandFilterBank::kFullBandSize> frame;
+            Bands reference_bands;
+            Bands bands;
+            std::array<float, ThreeBandFilterBank::kFullBandSize> reference_out;
+            std::array<float, ThreeBandFilterBank::kFullBandSize> out;
+            uint32_t seed = 1;
+            for (int k = 0; k < kNumFrames; ++k) {
+                SCOPED_TRACE(k);
+                GenerateFrame(k, &seed, &frame);
+                SplitAndMerge(&reference, frame, &reference_bands, &reference_out);
+                SplitAndMerge(&filter_bank, frame, &bands, &out);
+                for (size_t band = 0; band < bands.size(); ++band) {
+                    for (size_t n = 0; n < bands[band].size(); ++n) {
+                        ASSERT_NEAR(reference_bands[band][n], bands[band][n], tolerance)
+                                                    << "band " << band << ", sample " << n;
+                    }
+                }
+                for (size_t n = 0; n < out.size(); ++n) {
+                    ASSERT_NEAR(reference_out[n], out[n], tolerance) << "sample " << n;
+                }
+            }
+        }
+    }
+
+}  // namespace webrtc
@@ -0,0 +1,96 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "upper_bands_gain.h"
+
+#include <algorithm>
+
+#include "checks.h"
+#include "fast_math.h"
+
+namespace webrtc {
+
+    template<typename Geometry>
+    float ComputeUpperBandsGain(
+            float minimum_attenuating_gain,
+            rtc::ArrayView<const float, Geometry::kFftSizeBy2Plus1> filter,
+            rtc::ArrayView<const float> speech_probability,
+            rtc::ArrayView<const float, Geometry::kFftSizeBy2Plus1>
+                    prev_analysis_signal_spectrum,
+            rtc::ArrayView<const float, Geometry::kFftSizeBy2Plus1> signal_spectrum) {
+        constexpr size_t kFftSizeBy2Plus1 = Geometry::kFftSizeBy2Plus1;
+        // Average speech prob and filter gain for the end of the lowest band, over
+        // the 32 top bins of the default geometry, which is the same frequency
+        // range for all geometries.
+        constexpr int kNumAvgBins =
+                32 * Geometry::kFftSize / NsDefaultGeometry::kFftSize;
+        static_assert(kNumAvgBins > 0 && kNumAvgBins < kFftSizeBy2Plus1 - 1,
+                      "The averaging range must fit in the lowest band");
+        constexpr float kOneByNumAvgBins = 1.f / kNumAvgBins;
+
+        float avg_prob_speech = 0.f;
+        float avg_filter_gain = 0.f;
+        for (size_t i = kFftSizeBy2Plus1 - kNumAvgBins - 1; i < kFftSizeBy2Plus1 - 1;
+             i++) {
+            avg_prob_speech += speech_probability[i];
+            avg_filter_gain += filter[i];
+        }
+        avg_prob_speech = avg_prob_speech * kOneByNumAvgBins;
+        avg_filter_gain = avg_filter_gain * kOneByNumAvgBins;
+
+        // If the speech was suppressed by a component between Analyze and Process, an
+        // example being by an AEC, it should not be considered speech for the purpose
+        // of high band suppression. To that end, the speech probability is scaled
+        // accordingly.
+        float sum_analysis_spectrum = 0.f;
+        float sum_processing_spectrum = 0.f;
+        for (size_t i = 0; i < kFftSizeBy2Plus1; ++i) {
+            sum_analysis_spectrum += prev_analysis_signal_spectrum[i];
+            sum_processing_spectrum += signal_spectrum[i];
+        }
+
+        // The magnitude spectrum computation enforces the spectrum to be strictly
+        // positive.
+        RTC_DCHECK_GT(sum_analysis_spectrum, 0.f);
+        avg_prob_speech *= sum_processing_spectrum / sum_analysis_spectrum;
+
+        // Compute gain based on speech probability.
+        float gain =
+                0.5f * (1.f + TanhApproximation(2.f * avg_prob_speech - 1.f));
+
+        // Combine gain with low band gain.
+        if (avg_prob_speech >= 0.5f) {
+            gain = 0.25f * gain + 0.75f * avg_filter_gain;
+        } else {
+            gain = 0.5f * gain + 0.5f * avg_filter_gain;
+        }
+
+        // Make sure gain is within flooring range.
+        return std::min(std::max(gain, minimum_attenuating_gain), 1.f);
+    }
+
+    template float ComputeUpperBandsGain<NsDefaultGeometry>(
+            float, rtc::ArrayView<const float, NsDefaultGeometry::kFftSizeBy2Plus1>,
+            rtc::ArrayView<const float>,
+            rtc::ArrayView<const float, NsDefaultGeometry::kFftSizeBy2Plus1>,
+            rtc::ArrayView<const float, NsDefaultGeometry::kFftSizeBy2Plus1>);
+    template float ComputeUpperBandsGain<NsLowDelayGeometry>(
+            float, rtc::ArrayView<const float, NsLowDelayGeometry::kFftSizeBy2Plus1>,
+            rtc::ArrayView<const float>,
+            rtc::ArrayView<const float, NsLowDelayGeometry::kFftSizeBy2Plus1>,
+            rtc::ArrayView<const float, NsLowDelayGeometry::kFftSizeBy2Plus1>);
+    template float ComputeUpperBandsGain<NsHighEfficiencyGeometry>(
+            float,
+            rtc::ArrayView<const float, NsHighEfficiencyGeometry::kFftSizeBy2Plus1>,
+            rtc::ArrayView<const float>,
+            rtc::ArrayView<const float, NsHighEfficiencyGeometry::kFftSizeBy2Plus1>,
+            rtc::ArrayView<const float, NsHighEfficiencyGeometry::kFftSizeBy2Plus1>);
+
+}  // namespace webrtc
@@ -0,0 +1,33 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_NS_UPPER_BANDS_GAIN_H_
+#define MODULES_AUDIO_PROCESSING_NS_UPPER_BANDS_GAIN_H_
+
+#include "array_view.h"
+#include "ns_common.h"
+
+namespace webrtc {
+
+// Computes the attenuating gain for the noise suppression of the upper bands,
+// with the frame geometry |Geometry|, see NsGeometry. Instantiated for the
+// geometries in ns_common.h.
+    template<typename Geometry>
+    float ComputeUpperBandsGain(
+            float minimum_attenuating_gain,
+            rtc::ArrayView<const float, Geometry::kFftSizeBy2Plus1> filter,
+            rtc::ArrayView<const float> speech_probability,
+            rtc::ArrayView<const float, Geometry::kFftSizeBy2Plus1>
+                    prev_analysis_signal_spectrum,
+            rtc::ArrayView<const float, Geometry::kFftSizeBy2Plus1> signal_spectrum);
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_NS_UPPER_BANDS_GAIN_H_
@@ -20,14 +20,17 @@
 
 namespace webrtc {
 
-    WienerFilter::WienerFilter(const SuppressionParams &suppression_params)
+    template<typename Geometry>
+    BasicWienerFilter<Geometry>::BasicWienerFilter(
+            const SuppressionParams &suppression_params)
             : suppression_params_(suppression_params) {
         filter_.fill(1.f);
         initial_spectral_estimate_.fill(0.f);
         spectrum_prev_process_.fill(0.f);
     }
 
-    void WienerFilter::Update(
+    template<typename Geometry>
+    void BasicWienerFilter<Geometry>::Update(
             int32_t num_analyzed_frames,
             rtc::ArrayView<const float, kFftSizeBy2Plus1> noise_spectrum,
             rtc::ArrayView<const float, kFftSizeBy2Plus1> prev_noise_spectrum,
@@ -55,7 +58,7 @@ namespace webrtc {
                                   suppression_params_.minimum_attenuating_gain);
         }
 
-        if (num_analyzed_frames < kShortStartupPhaseBlocks) {
+        if (num_analyzed_frames < Geometry::kShortStartupPhaseBlocks) {
             for (size_t i = 0; i < kFftSizeBy2Plus1; ++i) {
                 initial_spectral_estimate_[i] += signal_spectrum[i];
                 float filter_initial = initial_spectral_estimate_[i] -
@@ -68,8 +71,9 @@ namespace webrtc {
 
                 // Weight the two suppression filters.
                 constexpr float kOnyByShortStartupPhaseBlocks =
-                        1.f / kShortStartupPhaseBlocks;
-                filter_initial *= kShortStartupPhaseBlocks - num_analyzed_frames;
+                        1.f / Geometry::kShortStartupPhaseBlocks;
+                filter_initial *=
+                        Geometry::kShortStartupPhaseBlocks - num_analyzed_frames;
                 filter_[i] *= num_analyzed_frames;
                 filter_[i] += filter_initial;
                 filter_[i] *= kOnyByShortStartupPhaseBlocks;
@@ -80,13 +84,15 @@ namespace webrtc {
                   spectrum_prev_process_.begin());
     }
 
-    float WienerFilter::ComputeOverallScalingFactor(
+    template<typename Geometry>
+    float BasicWienerFilter<Geometry>::ComputeOverallScalingFactor(
+            const SuppressionParams &suppression_params,
             int32_t num_analyzed_frames,
             float prior_speech_probability,
             float energy_before_filtering,
-            float energy_after_filtering) const {
-        if (!suppression_params_.use_attenuation_adjustment ||
-            num_analyzed_frames <= kLongStartupPhaseBlocks) {
+            float energy_after_filtering) {
+        if (!suppression_params.use_attenuation_adjustment ||
+            num_analyzed_frames <= Geometry::kLongStartupPhaseBlocks) {
             return 1.f;
         }
 
@@ -107,7 +113,7 @@ namespace webrtc {
         if (gain < kBLim) {
             // Do not reduce scale too much for pause regions: attenuation here should
             // be controlled by flooring.
-            gain = std::max(gain, suppression_params_.minimum_attenuating_gain);
+            gain = std::max(gain, suppression_params.minimum_attenuating_gain);
             scale_factor2 = 1.f - 0.3f * (kBLim - gain);
         }
 
@@ -117,4 +123,30 @@ namespace webrtc {
                (1.f - prior_speech_probability) * scale_factor2;
     }
 
+    template<typename Geometry>
+    void BasicWienerFilter<Geometry>::Seed(
+            rtc::ArrayView<const float, kFftSizeBy2Plus1> noise_spectrum) {
+        std::copy(noise_spectrum.begin(), noise_spectrum.end(),
+                  spectrum_prev_process_.begin());
+        filter_.fill(suppression_params_.minimum_attenuating_gain);
+    }
+
+    template<typename Geometry>
+    void BasicWienerFilter<Geometry>::SaveState(
+            NsStateWriter *writer) const {
+        writer->Write(spectrum_prev_process_);
+        writer->Write(initial_spectral_estimate_);
+        writer->Write(filter_);
+    }
+
+    template<typename Geometry>
+    bool BasicWienerFilter<Geometry>::LoadState(NsStateReader *reader) {
+        return reader->Read(&spectrum_prev_process_) &&
+               reader->Read(&initial_spectral_estimate_) && reader->Read(&filter_);
+    }
+
+    template class BasicWienerFilter<NsDefaultGeometry>;
+    template class BasicWienerFilter<NsLowDelayGeometry>;
+    template class BasicWienerFilter<NsHighEfficiencyGeometry>;
+
 }  // namespace webrtc
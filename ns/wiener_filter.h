@@ -15,18 +15,24 @@
 
 #include "array_view.h"
 #include "ns_common.h"
+#include "ns_state.h"
 #include "suppression_params.h"
 
 namespace webrtc {
 
-// Estimates a Wiener-filter based frequency domain noise reduction filter.
-    class WienerFilter {
+// Estimates a Wiener-filter based frequency domain noise reduction filter, with
+// the frame geometry |Geometry|, see NsGeometry. Instantiated for the
+// geometries in ns_common.h.
+    template<typename Geometry>
+    class BasicWienerFilter {
     public:
-        explicit WienerFilter(const SuppressionParams &suppression_params);
+        static constexpr size_t kFftSizeBy2Plus1 = Geometry::kFftSizeBy2Plus1;
 
-        WienerFilter(const WienerFilter &) = delete;
+        explicit BasicWienerFilter(const SuppressionParams &suppression_params);
 
-        WienerFilter &operator=(const WienerFilter &) = delete;
+        BasicWienerFilter(const BasicWienerFilter &) = delete;
+
+        BasicWienerFilter &operator=(const BasicWienerFilter &) = delete;
 
         // Updates the filter estimate.
         void Update(
@@ -36,17 +42,38 @@ namespace webrtc {
                 rtc::ArrayView<const float, kFftSizeBy2Plus1> parametric_noise_spectrum,
                 rtc::ArrayView<const float, kFftSizeBy2Plus1> signal_spectrum);
 
-        // Compute an overall gain scaling factor.
-        float ComputeOverallScalingFactor(int32_t num_analyzed_frames,
-                                          float prior_speech_probability,
-                                          float energy_before_filtering,
-                                          float energy_after_filtering) const;
+        // Compute an overall gain scaling factor. Static, as it only depends on
+        // the parameters, so that it can also be used for filters that are not
+        // stored in a BasicWienerFilter.
+        static float ComputeOverallScalingFactor(
+                const SuppressionParams &suppression_params,
+                int32_t num_analyzed_frames,
+                float prior_speech_probability,
+                float energy_before_filtering,
+                float energy_after_filtering);
 
         // Returns the filter.
         rtc::ArrayView<const float, kFftSizeBy2Plus1> get_filter() const {
             return filter_;
         }
 
+        // Starts the filter as if the previous frame was fully attenuated noise
+        // with spectrum |noise_spectrum|.
+        void Seed(rtc::ArrayView<const float, kFftSizeBy2Plus1> noise_spectrum);
+
+        // Appends the adaptive state to |writer|.
+        void SaveState(NsStateWriter *writer) const;
+
+        // Restores a state appended by SaveState(). Returns false if |reader| runs
+        // out of data.
+        bool LoadState(NsStateReader *reader);
+
+        // The number of bytes appended by SaveState().
+        static constexpr size_t StateSize() {
+            return sizeof(spectrum_prev_process_) + sizeof(initial_spectral_estimate_) +
+                   sizeof(filter_);
+        }
+
     private:
         const SuppressionParams &suppression_params_;
         std::array<float, kFftSizeBy2Plus1> spectrum_prev_process_;
@@ -54,6 +81,8 @@ namespace webrtc {
         std::array<float, kFftSizeBy2Plus1> filter_;
     };
 
+    using WienerFilter = BasicWienerFilter<NsDefaultGeometry>;
+
 }  // namespace webrtc
 
 #endif  // MODULES_AUDIO_PROCESSING_NS_WIENER_FILTER_H_
@@ -0,0 +1,641 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Microbenchmarks of the noise suppression kernels and of the end-to-end
+// processing, on synthetic deterministic input. Every benchmark iteration
+// handles one 10 ms frame, so the time per iteration is the time per frame and
+// the real-time factor (RTF) is that time divided by 10 ms.
+//
+// usage: ./ns_benchmark [--benchmark_filter=<regex>] [--benchmark_min_time=<s>]
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <memory>
+#include <regex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ns/audio_buffer.h"
+#include "ns/cpu_features_wrapper.h"
+#include "ns/noise_suppressor.h"
+#include "ns/ns_compact_session.h"
+#include "ns/ns_session_pool.h"
+#include "ns/ns_session_scheduler.h"
+#include "ns/ns_fft.h"
+#include "ns/quantile_noise_estimator.h"
+#include "ns/signal_model_estimator.h"
+#include "ns/sinc_resampler.h"
+#include "ns/splitting_filter.h"
+#include "ns/suppression_params.h"
+#include "ns/three_band_filter_bank.h"
+#include "ns/wiener_filter.h"
+#include "timing.h"
+
+namespace webrtc {
+
+    namespace {
+
+        constexpr double kFrameDurationNs = 10e6;
+        constexpr size_t kNumSyntheticFrames = 100;
+
+        std::regex benchmark_filter(".*");
+        double benchmark_min_time = 0.5;
+
+        // Times |iteration| until it has run for at least benchmark_min_time and
+        // prints the time per iteration, i.e., per 10 ms frame.
+        void RunBenchmark(const std::string &name,
+                          const std::function<void()> &iteration) {
+            if (!std::regex_search(name, benchmark_filter)) {
+                return;
+            }
+            for (int i = 0; i < 10; ++i) {
+                iteration();
+            }
+            size_t iterations = 1;
+            double elapsed = 0.0;
+            for (;;) {
+                const double start = now();
+                for (size_t i = 0; i < iterations; ++i) {
+                    iteration();
+                }
+                elapsed = now() - start;
+                if (elapsed >= benchmark_min_time || iterations >= (1u << 30)) {
+                    break;
+                }
+                // Aim for 1.4x the minimum time, like Google Benchmark does.
+                const double scale = elapsed > 0.0
+                                     ? 1.4 * benchmark_min_time / elapsed : 10.0;
+                iterations = static_cast<size_t>(iterations * std::min(std::max(scale, 2.0), 10.0));
+            }
+            const double ns_per_frame = elapsed * 1e9 / iterations;
+            printf("%-56s %12.1f ns %12zu %12.6f\n", name.c_str(), ns_per_frame,
+                   iterations, ns_per_frame / kFrameDurationNs);
+        }
+
+        // Deterministic linear congruential generator, uniform in [-1, 1).
+        class Random {
+        public:
+            float Next() {
+                state_ = state_ * 1664525u + 1013904223u;
+                return static_cast<int32_t>(state_) * (1.f / 2147483648.f);
+            }
+
+        private:
+            uint32_t state_ = 1;
+        };
+
+        // Speech-like synthetic audio in FloatS16: amplitude modulated harmonics
+        // over a white noise floor, with a slightly different pitch per channel.
+        std::vector<float> SyntheticAudio(int sample_rate_hz,
+                                          size_t num_channels,
+                                          size_t num_frames) {
+            constexpr double kPi = 3.14159265358979323846;
+            Random random;
+            std::vector<float> audio(num_frames * num_channels);
+            for (size_t j = 0; j < num_frames; ++j) {
+                const double t = static_cast<double>(j) / sample_rate_hz;
+                const double envelope = 0.5 + 0.5 * sin(2.0 * kPi * 4.0 * t);
+                for (size_t ch = 0; ch < num_channels; ++ch) {
+                    const double pitch = 150.0 + 10.0 * ch;
+                    double voice = 0.0;
+                    for (int h = 1; h <= 8; ++h) {
+                        voice += sin(2.0 * kPi * pitch * h * t) / h;
+                    }
+                    audio[j * num_channels + ch] = static_cast<float>(
+                            3000.0 * envelope * voice + 300.0 * random.Next());
+                }
+            }
+            return audio;
+        }
+
+        // Synthetic magnitude spectra: a noise floor with harmonic peaks.
+        std::vector<std::array<float, kFftSizeBy2Plus1>> SyntheticSpectra() {
+            Random random;
+            std::vector<std::array<float, kFftSizeBy2Plus1>> spectra(
+                    kNumSyntheticFrames);
+            for (size_t n = 0; n < spectra.size(); ++n) {
+                const float envelope = 1.f + 10.f * (n % 25 < 12);
+                for (size_t i = 0; i < kFftSizeBy2Plus1; ++i) {
+                    const float peak = i % 10 == 2 ? envelope * 1000.f : 0.f;
+                    spectra[n][i] = 100.f * (1.5f + random.Next()) + peak;
+                }
+            }
+            return spectra;
+        }
+
+        std::vector<NsOptimization> AvailableOptimizations() {
+            std::vector<NsOptimization> optimizations = {NsOptimization::kNone};
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+            if (WebRtc_GetCPUInfo(kSSE2)) {
+                optimizations.push_back(NsOptimization::kSse2);
+            }
+#if defined(WEBRTC_ENABLE_AVX2)
+            if (WebRtc_GetCPUInfo(kAVX2)) {
+                optimizations.push_back(NsOptimization::kAvx2);
+            }
+#endif
+#elif defined(WEBRTC_HAS_NEON)
+            optimizations.push_back(NsOptimization::kNeon);
+#endif
+            return optimizations;
+        }
+
+        const char *OptimizationName(NsOptimization optimization) {
+            switch (optimization) {
+                case NsOptimization::kSse2:
+                    return "sse2";
+                case NsOptimization::kAvx2:
+                    return "avx2";
+                case NsOptimization::kNeon:
+                    return "neon";
+                default:
+                    return "c";
+            }
+        }
+
+        // Benchmarks an FFT of |kSize| points, for the frame geometries other
+        // than the default.
+        template<typename FftT, size_t kSize>
+        void BenchmarkFftOfSize(
+                const std::string &name,
+                const std::vector<std::array<float, kFftSizeBy2Plus1>> &spectra) {
+            FftT fft;
+            std::array<float, kSize> time_data;
+            std::array<float, kSize> real;
+            std::array<float, kSize> imag;
+            size_t n = 0;
+            // The frames are formed by repeating the first kFftSize / 2 values of
+            // the synthetic spectra.
+            constexpr size_t kBlockSize = kFftSize / 2;
+            static_assert(kSize % kBlockSize == 0, "Unsupported FFT size");
+            RunBenchmark("BM_Fft/" + name, [&]() {
+                const auto &x = spectra[n++ % spectra.size()];
+                for (size_t i = 0; i < kSize; i += kBlockSize) {
+                    std::copy(x.begin(), x.begin() + kBlockSize, time_data.begin() + i);
+                }
+                fft.Fft(time_data, real, imag);
+            });
+            RunBenchmark("BM_Ifft/" + name, [&]() {
+                const auto &x = spectra[n++ % spectra.size()];
+                for (size_t i = 0; i < kSize; i += kBlockSize) {
+                    std::copy(x.begin(), x.begin() + kBlockSize, real.begin() + i);
+                    std::copy(x.begin(), x.begin() + kBlockSize, imag.begin() + i);
+                }
+                fft.Ifft(real, imag, time_data);
+            });
+        }
+
+        void BenchmarkFft() {
+            const auto spectra = SyntheticSpectra();
+            for (NsOptimization optimization : AvailableOptimizations()) {
+                std::array<float, kFftSize> time_data;
+                std::array<float, kFftSize> real;
+                std::array<float, kFftSize> imag;
+                size_t n = 0;
+                RunBenchmark(std::string("BM_Fft/") + OptimizationName(optimization),
+                             [&]() {
+                                 const auto &x = spectra[n++ % spectra.size()];
+                                 std::copy(x.begin(), x.end() - 1, time_data.begin());
+                                 std::copy(x.begin(), x.end() - 1, time_data.begin() + 128);
+                                 NrFft::Fft(optimization, time_data, real, imag);
+                             });
+                RunBenchmark(std::string("BM_Ifft/") + OptimizationName(optimization),
+                             [&]() {
+                                 const auto &x = spectra[n++ % spectra.size()];
+                                 std::copy(x.begin(), x.end(), real.begin());
+                                 std::copy(x.begin(), x.end(), imag.begin());
+                                 NrFft::Ifft(optimization, real, imag, time_data);
+                             });
+            }
+
+            BenchmarkFftOfSize<ScalarNrFft<128>, 128>("low_delay", spectra);
+            BenchmarkFftOfSize<ScalarNrFft<512>, 512>("high_efficiency_c", spectra);
+            BenchmarkFftOfSize<NrFft512, 512>("high_efficiency", spectra);
+        }
+
+        void BenchmarkEstimators() {
+            const auto spectra = SyntheticSpectra();
+            std::array<float, kFftSizeBy2Plus1> noise_spectrum;
+            std::fill(noise_spectrum.begin(), noise_spectrum.end(), 100.f);
+            size_t n = 0;
+
+            QuantileNoiseEstimator quantile_noise_estimator;
+            std::array<float, kFftSizeBy2Plus1> quantile_noise;
+            RunBenchmark("BM_QuantileNoiseEstimator_Estimate", [&]() {
+                quantile_noise_estimator.Estimate(spectra[n++ % spectra.size()],
+                                                  quantile_noise);
+            });
+
+            SignalModelEstimator signal_model_estimator;
+            std::array<float, kFftSizeBy2Plus1> prior_snr;
+            std::array<float, kFftSizeBy2Plus1> post_snr;
+            RunBenchmark("BM_SignalModelEstimator_Update", [&]() {
+                const auto &signal_spectrum = spectra[n++ % spectra.size()];
+                float signal_spectral_sum = 0.f;
+                for (size_t i = 0; i < kFftSizeBy2Plus1; ++i) {
+                    post_snr[i] = signal_spectrum[i] / noise_spectrum[i];
+                    prior_snr[i] = 0.5f * post_snr[i];
+                    signal_spectral_sum += signal_spectrum[i];
+                }
+                signal_model_estimator.Update(prior_snr, post_snr, noise_spectrum,
+                                              signal_spectrum, signal_spectral_sum,
+                                              signal_spectral_sum * signal_spectral_sum);
+            });
+
+            const SuppressionParams suppression_params(
+                    NsConfig::SuppressionLevel::k12dB);
+            WienerFilter wiener_filter(suppression_params);
+            RunBenchmark("BM_WienerFilter_Update", [&]() {
+                // Run after the startup phase, as in steady state.
+                wiener_filter.Update(1000, noise_spectrum, noise_spectrum,
+                                     noise_spectrum, spectra[n++ % spectra.size()]);
+            });
+        }
+
+        void BenchmarkFilterBanks() {
+            const std::vector<float> audio48 =
+                    SyntheticAudio(48000, 1, kNumSyntheticFrames * 480);
+            for (NsOptimization optimization : AvailableOptimizations()) {
+                ThreeBandFilterBank filter_bank(optimization);
+                std::array<std::array<float, 160>, 3> bands;
+                std::array<rtc::ArrayView<float>, 3> band_views = {
+                        rtc::ArrayView<float>(bands[0]), rtc::ArrayView<float>(bands[1]),
+                        rtc::ArrayView<float>(bands[2])};
+                std::array<float, 480> out;
+                size_t n = 0;
+                RunBenchmark(std::string("BM_ThreeBandFilterBank_Analysis/") +
+                             OptimizationName(optimization),
+                             [&]() {
+                                 filter_bank.Analysis(
+                                         rtc::ArrayView<const float, 480>(
+                                                 &audio48[480 * (n++ % kNumSyntheticFrames)], 480),
+                                         band_views);
+                             });
+                RunBenchmark(std::string("BM_ThreeBandFilterBank_Synthesis/") +
+                             OptimizationName(optimization),
+                             [&]() { filter_bank.Synthesis(band_views, out); });
+            }
+
+            struct SplittingFilterConfig {
+                const char *name;
+                int sample_rate_hz;
+                size_t num_channels;
+                TwoBandsFilterMode mode;
+            };
+            const SplittingFilterConfig configs[] = {
+                    {"2band_fixed/1ch", 32000, 1, TwoBandsFilterMode::kFixedPoint},
+                    {"2band_float/1ch", 32000, 1, TwoBandsFilterMode::kFloat},
+                    {"2band_fixed/2ch", 32000, 2, TwoBandsFilterMode::kFixedPoint},
+                    {"2band_float/2ch", 32000, 2, TwoBandsFilterMode::kFloat},
+                    {"3band/1ch", 48000, 1, TwoBandsFilterMode::kFixedPoint},
+                    {"3band/2ch", 48000, 2, TwoBandsFilterMode::kFixedPoint}};
+            for (const auto &config : configs) {
+                const size_t num_frames = config.sample_rate_hz / 100;
+                const size_t num_bands = config.sample_rate_hz / 16000;
+                const std::vector<float> audio = SyntheticAudio(
+                        config.sample_rate_hz, config.num_channels,
+                        kNumSyntheticFrames * num_frames);
+                SplittingFilter filter(config.num_channels, num_bands, num_frames,
+                                       config.mode);
+                ChannelBuffer<float> data(num_frames, config.num_channels);
+                ChannelBuffer<float> bands(num_frames, config.num_channels, num_bands);
+                size_t n = 0;
+                RunBenchmark(std::string("BM_SplittingFilter/") + config.name, [&]() {
+                    const float *frame = &audio[(n++ % kNumSyntheticFrames) * num_frames *
+                                                config.num_channels];
+                    for (size_t ch = 0; ch < config.num_channels; ++ch) {
+                        for (size_t j = 0; j < num_frames; ++j) {
+                            data.channels()[ch][j] = frame[j * config.num_channels + ch];
+                        }
+                    }
+                    filter.Analysis(&data, &bands);
+                    filter.Synthesis(&bands, &data);
+                });
+            }
+        }
+
+        // Feeds synthetic audio to a SincResampler.
+        class SyntheticSource : public SincResamplerCallback {
+        public:
+            explicit SyntheticSource(int sample_rate_hz)
+                    : audio_(SyntheticAudio(sample_rate_hz, 1, sample_rate_hz)) {}
+
+            void Run(size_t frames, float *destination) override {
+                for (size_t i = 0; i < frames; ++i) {
+                    destination[i] = audio_[position_];
+                    position_ = (position_ + 1) % audio_.size();
+                }
+            }
+
+        private:
+            const std::vector<float> audio_;
+            size_t position_ = 0;
+        };
+
+        void BenchmarkResampler() {
+            const std::array<std::array<int, 2>, 3> rates = {
+                    {{48000, 16000}, {16000, 48000}, {44100, 48000}}};
+            for (const auto &rate : rates) {
+                SyntheticSource source(rate[0]);
+                SincResampler resampler(static_cast<double>(rate[0]) / rate[1],
+                                        SincResampler::kDefaultRequestSize, &source);
+                std::vector<float> destination(rate[1] / 100);
+                RunBenchmark("BM_SincResampler_Resample/" + std::to_string(rate[0]) +
+                             "_to_" + std::to_string(rate[1]),
+                             [&]() {
+                                 resampler.Resample(destination.size(), destination.data());
+                             });
+            }
+        }
+
+        void BenchmarkAudioBuffer() {
+            for (int sample_rate_hz : {16000, 48000}) {
+                for (size_t num_channels : {1, 2}) {
+                    const StreamConfig stream_config(sample_rate_hz, num_channels);
+                    const std::vector<float> audio = SyntheticAudio(
+                            sample_rate_hz, num_channels, stream_config.num_frames());
+                    std::vector<int16_t> interleaved(audio.begin(), audio.end());
+                    AudioBuffer buffer(sample_rate_hz, num_channels, sample_rate_hz,
+                                       num_channels, sample_rate_hz, num_channels);
+                    const std::string suffix = "/" + std::to_string(sample_rate_hz) +
+                                               "Hz_" + std::to_string(num_channels) + "ch";
+                    RunBenchmark("BM_AudioBuffer_CopyFrom" + suffix, [&]() {
+                        buffer.CopyFrom(interleaved.data(), stream_config);
+                    });
+                    RunBenchmark("BM_AudioBuffer_CopyTo" + suffix, [&]() {
+                        buffer.CopyTo(stream_config, interleaved.data());
+                    });
+                }
+            }
+        }
+
+        template<typename NoiseSuppressorT>
+        void BenchmarkNoiseSuppressor(const std::string &name) {
+            for (int sample_rate_hz : {16000, 32000, 48000}) {
+                for (size_t num_channels : {1, 2, 8}) {
+                    const StreamConfig stream_config(sample_rate_hz, num_channels);
+                    const size_t frame_size = stream_config.num_samples();
+                    const std::vector<float> audio =
+                            SyntheticAudio(sample_rate_hz, num_channels,
+                                           kNumSyntheticFrames * stream_config.num_frames());
+                    const std::vector<int16_t> input(audio.begin(), audio.end());
+                    std::vector<int16_t> output(frame_size);
+                    AudioBuffer buffer(sample_rate_hz, num_channels, sample_rate_hz,
+                                       num_channels, sample_rate_hz, num_channels);
+                    NsConfig config;
+                    NoiseSuppressorT ns(config, sample_rate_hz, num_channels);
+                    const bool split_bands = sample_rate_hz > 16000;
+                    size_t n = 0;
+                    RunBenchmark(name + "_AnalyzeProcess/" +
+                                 std::to_string(sample_rate_hz) + "Hz_" +
+                                 std::to_string(num_channels) + "ch",
+                                 [&]() {
+                                     buffer.CopyFrom(
+                                             &input[(n++ % kNumSyntheticFrames) * frame_size],
+                                             stream_config);
+                                     if (split_bands) {
+                                         buffer.SplitIntoFrequencyBands();
+                                     }
+                                     ns.Analyze(buffer);
+                                     ns.Process(&buffer);
+                                     if (split_bands) {
+                                         buffer.MergeFrequencyBands();
+                                     }
+                                     buffer.CopyTo(stream_config, output.data());
+                                 });
+                }
+            }
+        }
+
+// Benchmarks Analyze() and Process() on a muted stream, with and without the
+// silence bypass.
+        void BenchmarkMutedNoiseSuppressor() {
+            for (bool enable_silence_bypass : {false, true}) {
+                const StreamConfig stream_config(16000, 1);
+                const std::vector<int16_t> input(stream_config.num_samples(), 0);
+                std::vector<int16_t> output(stream_config.num_samples());
+                AudioBuffer buffer(16000, 1, 16000, 1, 16000, 1);
+                NsConfig config;
+                config.enable_silence_bypass = enable_silence_bypass;
+                NoiseSuppressor ns(config, 16000, 1);
+                RunBenchmark(std::string("BM_NoiseSuppressor_Muted/") +
+                             (enable_silence_bypass ? "bypass" : "no_bypass"),
+                             [&]() {
+                                 buffer.CopyFrom(input.data(), stream_config);
+                                 ns.Analyze(buffer);
+                                 ns.Process(&buffer);
+                                 buffer.CopyTo(stream_config, output.data());
+                             });
+            }
+        }
+
+// Benchmarks a 10 ms chunk of each of |num_sessions| sessions on an
+// NsSessionScheduler with one worker per core, from pushing the chunks until
+// all of them have been pulled.
+        void BenchmarkSessionScheduler(size_t num_sessions) {
+            const StreamConfig stream_config(16000, 1);
+            const size_t chunk_size = stream_config.num_samples();
+            const std::vector<float> audio = SyntheticAudio(
+                    16000, 1, kNumSyntheticFrames * stream_config.num_frames());
+            const std::vector<int16_t> input(audio.begin(), audio.end());
+            std::vector<int16_t> output(chunk_size);
+            NsSessionScheduler scheduler((NsSchedulerConfig()));
+            std::vector<NsSession *> sessions;
+            for (size_t k = 0; k < num_sessions; ++k) {
+                sessions.push_back(scheduler.AddSession(NsConfig(), 16000, 1));
+            }
+            size_t n = 0;
+            RunBenchmark("BM_NsSessionScheduler/" + std::to_string(num_sessions) +
+                         "x16000Hz_1ch",
+                         [&]() {
+                             const int16_t *chunk =
+                                     &input[(n++ % kNumSyntheticFrames) * chunk_size];
+                             for (NsSession *session : sessions) {
+                                 session->Push(rtc::ArrayView<const int16_t>(
+                                         chunk, chunk_size));
+                             }
+                             for (NsSession *session : sessions) {
+                                 while (session->Pull(output) == 0) {
+                                     std::this_thread::yield();
+                                 }
+                             }
+                         });
+        }
+
+
+// Benchmarks a 10 ms chunk of each of |num_sessions| sessions processed in
+// turn, with the AudioBuffer and NoiseSuppressor of each session allocated on
+// the heap or packed into an NsCompactSession. The name of the compact variant
+// includes its bytes per session.
+        void BenchmarkCompactSessions(size_t num_sessions) {
+            const StreamConfig stream_config(16000, 1);
+            const size_t chunk_size = stream_config.num_samples();
+            const std::vector<float> audio = SyntheticAudio(
+                    16000, 1, kNumSyntheticFrames * stream_config.num_frames());
+            const std::vector<int16_t> input(audio.begin(), audio.end());
+            std::vector<int16_t> chunk(chunk_size);
+            const std::string suffix =
+                    "/" + std::to_string(num_sessions) + "x16000Hz_1ch";
+
+            std::vector<std::unique_ptr<AudioBuffer>> buffers;
+            std::vector<std::unique_ptr<NoiseSuppressor>> suppressors;
+            for (size_t k = 0; k < num_sessions; ++k) {
+                buffers.push_back(std::make_unique<AudioBuffer>(16000, 1, 16000, 1,
+                                                                16000, 1));
+                suppressors.push_back(
+                        std::make_unique<NoiseSuppressor>(NsConfig(), 16000, 1));
+            }
+            size_t n = 0;
+            RunBenchmark("BM_Sessions_Heap" + suffix, [&]() {
+                const int16_t *x = &input[(n++ % kNumSyntheticFrames) * chunk_size];
+                for (size_t k = 0; k < num_sessions; ++k) {
+                    buffers[k]->CopyFrom(x, stream_config);
+                    suppressors[k]->Analyze(*buffers[k]);
+                    suppressors[k]->Process(buffers[k].get());
+                    buffers[k]->CopyTo(stream_config, chunk.data());
+                }
+            });
+
+            std::vector<std::unique_ptr<NsCompactSession>> sessions;
+            for (size_t k = 0; k < num_sessions; ++k) {
+                sessions.push_back(
+                        std::make_unique<NsCompactSession>(NsConfig(), 16000, 1));
+            }
+            n = 0;
+            RunBenchmark("BM_Sessions_Compact" + suffix + "_" +
+                         std::to_string(sessions[0]->bytes_per_session()) + "B",
+                         [&]() {
+                             const int16_t *x =
+                                     &input[(n++ % kNumSyntheticFrames) * chunk_size];
+                             for (auto &session : sessions) {
+                                 std::copy(x, x + chunk_size, chunk.begin());
+                                 session->ProcessChunk(chunk);
+                             }
+                         });
+        }
+
+// Benchmarks creating and destroying a 48 kHz stereo session, with its objects
+// on the heap, in an NsCompactSession, which sizes and allocates its block each
+// time, and in a slab of an NsSessionPool.
+        void BenchmarkSessionChurn() {
+            const std::string suffix = "/48000Hz_2ch";
+            RunBenchmark("BM_SessionChurn_Heap" + suffix, [&]() {
+                AudioBuffer audio(48000, 2, 48000, 2, 48000, 2);
+                NoiseSuppressor noise_suppressor(NsConfig(), 48000, 2);
+            });
+            RunBenchmark("BM_SessionChurn_Compact" + suffix, [&]() {
+                NsCompactSession session(NsConfig(), 48000, 2);
+            });
+            NsSessionPool pool(NsConfig(), 48000, 2, 1);
+            RunBenchmark("BM_SessionChurn_Pool" + suffix, [&]() {
+                pool.DestroySession(pool.CreateSession());
+            });
+        }
+
+    }  // namespace
+
+// Befriended by SincResampler, which gives access to the Convolve variants.
+    class SincResamplerTest_ConvolveBenchmark_Test {
+    public:
+        static void Run() {
+            SyntheticSource source(48000);
+            SincResampler resampler(25.0 / 24.0, SincResampler::kDefaultRequestSize,
+                                    &source);
+            Random random;
+            float *const input = resampler.input_buffer_.get();
+            for (size_t i = 0; i < resampler.input_buffer_size_; ++i) {
+                input[i] = random.Next();
+            }
+            const float *const k1 = resampler.kernel_storage_.get();
+            const float *const k2 = k1 + SincResampler::kKernelSize;
+
+            // A 10 ms frame at 48 kHz takes one convolution per output sample.
+            auto benchmark = [&](const char *name, SincResampler::ConvolveProc convolve) {
+                for (int unaligned = 0; unaligned < 2; ++unaligned) {
+                    const float *const input_ptr = input + unaligned;
+                    float sum = 0.f;
+                    RunBenchmark(std::string("BM_SincResampler_Convolve/") + name +
+                                 (unaligned ? "_unaligned" : "_aligned"),
+                                 [&]() {
+                                     for (int i = 0; i < 480; ++i) {
+                                         sum += convolve(input_ptr, k1, k2, 0.5);
+                                     }
+                                 });
+                    if (sum == 12345.f) {
+                        printf("\n");
+                    }
+                }
+            };
+            benchmark("c", SincResampler::Convolve_C);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+            if (WebRtc_GetCPUInfo(kSSE2)) {
+                benchmark("sse", SincResampler::Convolve_SSE);
+            }
+#if defined(WEBRTC_ENABLE_AVX2)
+            if (WebRtc_GetCPUInfo(kAVX2)) {
+                benchmark("avx2", SincResampler::Convolve_AVX2);
+            }
+#endif
+#if defined(WEBRTC_ENABLE_AVX512)
+            if (WebRtc_GetCPUInfo(kAVX512)) {
+                benchmark("avx512", SincResampler::Convolve_AVX512);
+            }
+#endif
+#elif defined(WEBRTC_HAS_NEON)
+            benchmark("neon", SincResampler::Convolve_NEON);
+#endif
+        }
+    };
+
+}  // namespace webrtc
+
+int main(int argc, char *argv[]) {
+    using namespace webrtc;
+    for (int i = 1; i < argc; ++i) {
+        const char *kFilter = "--benchmark_filter=";
+        const char *kMinTime = "--benchmark_min_time=";
+        if (strncmp(argv[i], kFilter, strlen(kFilter)) == 0) {
+            benchmark_filter = std::regex(argv[i] + strlen(kFilter));
+        } else if (strncmp(argv[i], kMinTime, strlen(kMinTime)) == 0) {
+            benchmark_min_time = atof(argv[i] + strlen(kMinTime));
+        } else {
+            printf("usage: %s [--benchmark_filter=<regex>] [--benchmark_min_time=<s>]\n",
+                   argv[0]);
+            return -1;
+        }
+    }
+
+    printf("%-56s %15s %12s %12s\n", "Benchmark", "Time/frame", "Iterations",
+           "RTF");
+    printf("%s\n", std::string(98, '-').c_str());
+    BenchmarkFft();
+    BenchmarkEstimators();
+    BenchmarkFilterBanks();
+    BenchmarkResampler();
+    SincResamplerTest_ConvolveBenchmark_Test::Run();
+    BenchmarkAudioBuffer();
+    BenchmarkNoiseSuppressor<NoiseSuppressor>("BM_NoiseSuppressor");
+    BenchmarkNoiseSuppressor<LowDelayNoiseSuppressor>(
+            "BM_LowDelayNoiseSuppressor");
+    BenchmarkNoiseSuppressor<HighEfficiencyNoiseSuppressor>(
+            "BM_HighEfficiencyNoiseSuppressor");
+    BenchmarkMutedNoiseSuppressor();
+    BenchmarkSessionScheduler(64);
+    BenchmarkCompactSessions(256);
+    BenchmarkSessionChurn();
+    return 0;
+}